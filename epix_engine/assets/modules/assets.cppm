@@ -12,18 +12,23 @@ export import :handle;
 export import :meta;
 export import :store;
 export import :server.info;
+export import :server.diagnostics;
 export import :server.loader;
 export import :server;
 export import :saver;
 export import :transformer;
 export import :processor.process;
 export import :processor.log;
+export import :io.disk_cache;
+export import :processor.cache;
 export import :processor;
 export import :io.processor_gated;
 export import :io.memory;
 export import :io.memory.asset;
 export import :io.reader;
+export import :io.debounce;
 export import :io.source;
+export import :io.archive;
 export import :io.embedded;
 
 using namespace epix::core;
@@ -52,6 +57,11 @@ export struct AssetPlugin {
      *  When set, a FileAssetReader/Writer rooted at {workspace}/{path} is used for the embedded
      *  source's processed IO. */
     std::optional<std::filesystem::path> embedded_processed_path = std::nullopt;
+    /** @brief Optional directory of a ProcessedAssetCache shared with other processed trees.
+     *  Point several checkouts, or CI jobs, at the same directory to reuse each other's outputs. */
+    std::optional<std::filesystem::path> processed_cache_path = std::nullopt;
+    /** @brief Size the processed cache is trimmed to once processing finishes. */
+    std::uint64_t processed_cache_size = DEFAULT_PROCESSED_CACHE_SIZE;
     /** @brief Asset server mode. */
     AssetServerMode mode = AssetServerMode::Processed;
     /** @brief Optional watch override (mirrors Bevy's watch_for_changes_override). */
@@ -71,11 +81,29 @@ export struct AssetPlugin {
     void finish(App& app);
 };
 
+/** @brief What `publish_asset_server_diagnostics` keeps between frames. */
+export struct AssetDiagnosticsSample {
+    std::chrono::steady_clock::time_point time;
+    std::uint64_t bytes_read = 0;
+    std::optional<ProcessorState> processor_state;
+};
+
+/** @brief System publishing AssetServerDiagnostics every frame, with the read rate over the last frame
+ *  and the per-asset timings of the AssetProcessor, if one runs. Added to `Last` by AssetPlugin.
+ *  Processor timings are gathered while it processes and once when it finishes. */
+export void publish_asset_server_diagnostics(ResMut<AssetServerDiagnostics> diagnostics,
+                                             Res<AssetServer> server,
+                                             std::optional<Res<AssetProcessor>> processor,
+                                             Local<std::optional<AssetDiagnosticsSample>> last_sample);
+
 /** @brief AssetApp-style helper: register an asset type directly on an App with an existing AssetServer. */
 export template <std::movable T>
 App& app_register_asset(App& app) {
     if (app.world_mut().get_resource<Assets<T>>().has_value()) return app;
     app.world_mut().init_resource<Assets<T>>();
+    if (!app.world_mut().get_resource<AssetMemoryUsage>().has_value()) {
+        app.world_mut().init_resource<AssetMemoryUsage>();
+    }
     app.resource_mut<AssetServer>().register_asset(app.resource<Assets<T>>());
     app.add_events<AssetEvent<T>>();
     app.add_events<AssetLoadFailedEvent<T>>();
@@ -95,9 +123,12 @@ App& app_register_asset(App& app) {
     app.add_systems(Last, into(Assets<T>::asset_events)
                               .in_set(AssetSystems::WriteEvents)
                               .set_names(std::array{std::format("send {} asset events", meta::type_id<T>::name())}));
-    app.add_systems(PostUpdate, into(Assets<T>::handle_events)
-                                    .in_set(AssetSystems::HandleEvents)
-                                    .set_name(std::format("handle {} asset events", meta::type_id<T>::name())));
+    app.add_systems(PostUpdate,
+                    into(into(Assets<T>::handle_events).in_set(AssetSystems::HandleEvents),
+                         into(Assets<T>::manage_memory).in_set(AssetSystems::HandleEvents))
+                        .chain()
+                        .set_names(std::array{std::format("handle {} asset events", meta::type_id<T>::name()),
+                                              std::format("manage {} asset memory", meta::type_id<T>::name())}));
     return app;
 }
 
@@ -12,12 +12,7 @@ import :path;
 import :meta;
 
 namespace epix::assets {
-using core::Receiver;
-using core::Sender;
-struct DestructionEvent {
-    InternalAssetId id;
-    bool asset_server_managed;
-};
+export struct HandleProvider;
 struct NonCopyNonMove {
     NonCopyNonMove()                                 = default;
     NonCopyNonMove(const NonCopyNonMove&)            = delete;
@@ -25,9 +20,10 @@ struct NonCopyNonMove {
     NonCopyNonMove& operator=(const NonCopyNonMove&) = delete;
     NonCopyNonMove& operator=(NonCopyNonMove&&)      = delete;
 };
+/** @brief The shared state behind strong handles. Counts itself in the slot of its index while alive. */
 struct StrongHandle : NonCopyNonMove {
     UntypedAssetId id;
-    Sender<DestructionEvent> event_sender;
+    std::shared_ptr<const HandleProvider> provider;
     std::optional<AssetPath> path;
     bool asset_server_managed;
     /// Modifies asset meta. Stored on the handle because it is:
@@ -36,7 +32,7 @@ struct StrongHandle : NonCopyNonMove {
     std::optional<MetaTransform> meta_transform;
 
     StrongHandle(const UntypedAssetId& id,
-                 const Sender<DestructionEvent>& event_sender,
+                 std::shared_ptr<const HandleProvider> provider,
                  bool asset_server_managed                   = false,
                  const std::optional<AssetPath>& path        = std::nullopt,
                  std::optional<MetaTransform> meta_transform = std::nullopt);
@@ -292,13 +288,23 @@ Handle<T>& Handle<T>::operator=(UntypedHandle&& other) {
     return *this;
 }
 
-export struct HandleProvider {
+/** @brief Creates the strong handles of one asset type and tracks their lifetimes.
+ *  Handles to indices are counted lock-free in the slots of the index allocator. Handles to uuids
+ *  have no slot; their drops are collected in a short list instead. */
+export struct HandleProvider : std::enable_shared_from_this<HandleProvider> {
    private:
     AssetIndexAllocator index_allocator;
-    Sender<DestructionEvent> event_sender;
-    Receiver<DestructionEvent> event_receiver;
+    mutable std::mutex m_dropped_uuids_mutex;
+    /** @brief Dropped uuid handles, with whether the AssetServer created them. */
+    mutable std::vector<std::pair<uuids::uuid, bool>> m_dropped_uuids;
     meta::type_index type;
 
+    /** @brief Called by a dropped StrongHandle. */
+    void handle_dropped(const StrongHandle& handle) const;
+    /** @brief Take the uuid handles dropped since the last call. */
+    std::vector<std::pair<uuids::uuid, bool>> take_dropped_uuids() const;
+
+    friend struct StrongHandle;
     friend struct AssetInfos;
     template <Asset T>
     friend struct Assets;
@@ -318,6 +324,8 @@ export struct HandleProvider {
     std::shared_ptr<StrongHandle> reserve(bool asset_server_managed,
                                           const std::optional<AssetPath>& path,
                                           std::optional<MetaTransform> meta_transform = std::nullopt) const;
+    /** @brief Number of dropped handles the next `Assets<T>::handle_events` run looks at. */
+    std::size_t pending_drops() const;
 };
 
 /** @brief Concept for asset types that can report their asset handle dependencies.
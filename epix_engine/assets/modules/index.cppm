@@ -13,9 +13,6 @@ export template <typename T>
 struct Handle;
 struct AssetIndexAllocator;
 
-using core::Receiver;
-using core::Sender;
-
 /** @brief Generational index into an asset storage.
  *  Pairs a slot index with a generation counter so stale references
  *  can be detected after the slot is recycled. */
@@ -50,24 +47,70 @@ export struct AssetIndex {
     friend struct Assets;
 };
 
+/** @brief Hands out asset indices and counts the strong handles referring to each of them.
+ *
+ *  Every index owns a slot holding its handle count and generation. Slots live in segments that
+ *  double in size and never move, so handles update the count of their slot from any thread
+ *  without a lock. A handle that drops the count of its slot to zero marks the slot in a bitset,
+ *  which `take_unreferenced` sweeps once a frame. Released indices go to a lock-free freelist and
+ *  come back from `reserve` with their generation bumped. */
 struct AssetIndexAllocator {
    private:
+    struct Slot {
+        std::atomic<std::uint32_t> handles    = 0;
+        std::atomic<std::uint32_t> generation = 0;
+        /** @brief Next entry of the freelist while the slot is free, as index + 1, 0 at the end. */
+        std::atomic<std::uint32_t> next_free = 0;
+    };
+    struct Segment {
+        std::unique_ptr<Slot[]> slots;
+        /** @brief One bit per slot, set when its handle count dropped to zero. */
+        std::unique_ptr<std::atomic<std::uint64_t>[]> unreferenced;
+    };
+    /** @brief Slots in the first segment; segment `s > 0` holds `FIRST_SEGMENT << (s - 1)` slots. */
+    static constexpr std::uint32_t FIRST_SEGMENT_BITS = 6;
+    static constexpr std::uint32_t FIRST_SEGMENT      = 1u << FIRST_SEGMENT_BITS;
+    static constexpr std::size_t SEGMENT_COUNT        = 32 - FIRST_SEGMENT_BITS + 1;
+
+    mutable std::array<std::atomic<Segment*>, SEGMENT_COUNT> m_segments{};
+    /** @brief Taken only to allocate a segment, once per doubling. */
+    mutable std::mutex m_grow_mutex;
     mutable std::atomic<std::uint32_t> m_next = 0;
-    Sender<AssetIndex> m_free_indices_sender;
-    Receiver<AssetIndex> m_free_indices_receiver;
-    Receiver<AssetIndex> m_reserved;
-    Sender<AssetIndex> m_reserved_sender;
+    /** @brief Head of the freelist: a pop counter in the high half against ABA, index + 1 in the low half. */
+    mutable std::atomic<std::uint64_t> m_free_head = 0;
+
+    static std::uint32_t segment_of(std::uint32_t index);
+    static std::uint32_t segment_start(std::uint32_t segment);
+    static std::uint32_t segment_size(std::uint32_t segment);
+    Slot& slot(std::uint32_t index) const;
+    std::atomic<std::uint64_t>& unreferenced_word(std::uint32_t index) const;
+    void ensure_segment(std::uint32_t index) const;
 
    public:
-    AssetIndexAllocator();
+    AssetIndexAllocator() = default;
+    ~AssetIndexAllocator();
     AssetIndexAllocator(const AssetIndexAllocator&)            = delete;
     AssetIndexAllocator(AssetIndexAllocator&&)                 = delete;
     AssetIndexAllocator& operator=(const AssetIndexAllocator&) = delete;
     AssetIndexAllocator& operator=(AssetIndexAllocator&&)      = delete;
 
+    /** @brief Take a free index, or a new one if none is free. Thread-safe. */
     AssetIndex reserve() const;
+    /** @brief Return an index whose handles are all gone, for `reserve` to hand out again. */
     void release(const AssetIndex& index) const;
-    Receiver<AssetIndex> reserved_receiver() const;
+    /** @brief Number of indices handed out so far; storages indexed by slot need this many entries. */
+    std::uint32_t slot_count() const { return m_next.load(std::memory_order_acquire); }
+
+    /** @brief Count a new strong handle to `index`. Lock-free. */
+    void acquire_handle(std::uint32_t index) const;
+    /** @brief Uncount a dropped strong handle to `index`, marking the slot when it was the last. Lock-free. */
+    void release_handle(std::uint32_t index) const;
+    /** @brief Number of strong handles currently referring to `index`. */
+    std::uint32_t handle_count(std::uint32_t index) const;
+    /** @brief Clear the marked slots and return the indices among them that still have no handles. */
+    std::vector<AssetIndex> take_unreferenced() const;
+    /** @brief Number of marked slots, the handle drops the next `take_unreferenced` looks at. */
+    std::size_t unreferenced_count() const;
 };
 }  // namespace epix::assets
 
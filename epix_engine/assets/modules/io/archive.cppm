@@ -0,0 +1,115 @@
+module;
+
+export module epix.assets:io.archive;
+
+import std;
+import epix.utils;
+
+import :meta;
+import :io.reader;
+import :io.file.asset;
+
+namespace epix::assets {
+/** @brief Compression of an archive blob. Only `None` is written today, the field keeps the
+ *  format open for compressed blobs without a version bump. */
+export enum class ArchiveCompression : std::uint32_t {
+    None = 0,
+};
+
+/** @brief Magic bytes at the start of every asset archive. */
+export inline constexpr std::array<char, 4> ARCHIVE_MAGIC = {'E', 'P', 'A', 'K'};
+/** @brief Version of the archive layout, bumped on any change to the header or index. */
+export inline constexpr std::uint32_t ARCHIVE_VERSION = 1;
+/** @brief Alignment of every blob in an archive, so loaders can read mapped data in place. */
+export inline constexpr std::size_t ARCHIVE_ALIGNMENT = 16;
+
+/** @brief Archive header, at offset 0. All integers are little-endian. */
+struct ArchiveHeader {
+    std::array<char, 4> magic;
+    std::uint32_t version;
+    std::uint64_t entry_count;
+    std::uint64_t index_offset;
+    std::uint64_t names_offset;
+    std::uint64_t names_size;
+};
+static_assert(sizeof(ArchiveHeader) == 40);
+
+/** @brief One asset in the archive index. The index is sorted by (path_hash, path) so a lookup is a
+ *  binary search over the mapped index, with no allocation and no syscall. */
+struct ArchiveEntry {
+    std::uint64_t path_hash;
+    std::uint32_t name_offset;
+    std::uint32_t name_size;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+    std::uint64_t meta_offset;
+    std::uint32_t meta_size;
+    ArchiveCompression compression;
+    AssetHash hash;
+};
+static_assert(sizeof(ArchiveEntry) == 80);
+static_assert(std::is_trivially_copyable_v<ArchiveHeader> && std::is_trivially_copyable_v<ArchiveEntry>);
+
+/** @brief Hash of a normalized archive path (FNV-1a, 64 bit). */
+std::uint64_t archive_path_hash(std::string_view path);
+/** @brief Normalize a reader path to its archive form: generic separators, no leading `./`. */
+std::string archive_path(const std::filesystem::path& path);
+
+/** @brief Pack every asset readable from `reader` into a single archive file at `output`.
+ *
+ *  Assets are collected recursively from the reader root. Each entry carries the asset bytes,
+ *  its `.meta` bytes if there are any, and its AssetHash: the hash recorded in the processed
+ *  info of the meta when present, otherwise the hash of meta and asset bytes. The archive is
+ *  written next to `output` and renamed over it once complete.
+ *  @return The number of packed assets. */
+export std::expected<std::size_t, AssetWriterError> write_asset_archive(const AssetReader& reader,
+                                                                        const std::filesystem::path& output);
+
+/** @brief Reader serving assets from an archive written by `write_asset_archive`.
+ *
+ *  The archive is mapped once when the reader is constructed. Lookups binary-search the mapped
+ *  index and reads return views into the mapping, so no further syscall is made per asset.
+ *  Views returned by `read_bytes_view` keep the mapping alive past the reader. */
+export struct ArchiveAssetReader : public AssetReader {
+   private:
+    AssetBytes m_archive;
+    std::span<const ArchiveEntry> m_entries;
+    std::string_view m_names;
+
+    const ArchiveEntry* find(const std::filesystem::path& path) const;
+    std::string_view name(const ArchiveEntry& entry) const {
+        return m_names.substr(entry.name_offset, entry.name_size);
+    }
+    AssetBytes slice(std::uint64_t offset, std::uint64_t size) const {
+        return AssetBytes(m_archive.owner(), m_archive.bytes().subspan(offset, size));
+    }
+
+   public:
+    /** @brief Map and validate the archive. An archive that is missing or malformed is logged and
+     *  leaves the reader empty, every read then reports NotFound. */
+    explicit ArchiveAssetReader(const std::filesystem::path& archive);
+
+    /** @brief Check if the archive was mapped and validated. */
+    bool is_open() const { return m_archive.owner() != nullptr; }
+    /** @brief Number of assets in the archive. */
+    std::size_t size() const { return m_entries.size(); }
+    /** @brief Get the AssetHash stored for `path`. */
+    std::optional<AssetHash> asset_hash(const std::filesystem::path& path) const;
+
+    std::expected<std::unique_ptr<std::istream>, AssetReaderError> read(
+        const std::filesystem::path& path) const override;
+    std::expected<std::unique_ptr<std::istream>, AssetReaderError> read_meta(
+        const std::filesystem::path& path) const override;
+    /** @brief View the asset bytes inside the mapping. */
+    std::optional<AssetBytes> read_bytes_view(const std::filesystem::path& path) const override;
+    /** @brief Completes inline: the bytes are already mapped, a task would cost more than the read. */
+    void read_bytes_async(const std::filesystem::path& path, AssetBytesCallback on_complete) const override {
+        on_complete(read_bytes(path));
+    }
+    /** @brief List the assets and subdirectories directly below `path`. Linear in the archive size. */
+    std::expected<utils::input_iterable<std::filesystem::path>, AssetReaderError> read_directory(
+        const std::filesystem::path& path) const override;
+    std::expected<bool, AssetReaderError> is_directory(const std::filesystem::path& path) const override;
+};
+static_assert(!std::is_abstract_v<ArchiveAssetReader>);
+}  // namespace epix::assets
@@ -0,0 +1,86 @@
+module;
+
+export module epix.assets:io.debounce;
+
+import std;
+import epix.utils;
+
+import :io.reader;
+
+namespace epix::assets {
+/** @brief A change as reported by a platform file watcher, before it is classified. */
+export struct RawFileChange {
+    enum class Kind {
+        Added,
+        Modified,
+        Removed,
+        Moved, /**< `old_path` was renamed to `path`. */
+    } kind;
+    std::filesystem::path path;
+    std::filesystem::path old_path = {};
+};
+
+/** @brief What a path is on disk when its change is delivered. */
+export struct FileStatus {
+    bool exists       = false;
+    bool is_directory = false;
+};
+
+/** @brief Get the FileStatus of a path on disk. */
+export FileStatus disk_file_status(const std::filesystem::path& path);
+
+/** @brief Debounces raw file changes per path and coalesces them into AssetSourceEvents.
+ *
+ *  A change stays pending until its path has seen no change for the debounce window, so an
+ *  editor writing a file in several steps yields one event. While pending, changes to a path
+ *  merge: added then modified is added, added then removed is nothing, removed then added is
+ *  modified, and a chain of renames a -> b -> c is one rename a -> c. A new file renamed into
+ *  place, as editors do on save, is a single add or modify of the destination.
+ *
+ *  Paths are only classified (directory, meta or asset, and whether they still exist) once their
+ *  change settles, one stat per path instead of one per raw change. Not thread-safe. */
+export struct AssetEventDebouncer {
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief A settled change, ready to be classified. */
+    struct Settled {
+        enum class Kind { Renamed, Added, Modified, Removed } kind;
+        std::filesystem::path path;
+        /** @brief Where the path was renamed from, if it was. A renamed path may also be modified. */
+        std::optional<std::filesystem::path> renamed_from;
+    };
+
+   private:
+    struct Pending {
+        Settled::Kind kind;
+        std::optional<std::filesystem::path> renamed_from;
+        Clock::time_point last_change;
+    };
+    Clock::duration m_window;
+    std::map<std::filesystem::path, Pending> m_pending;
+
+    /** @brief The file that was at `origin` is gone, unless a new one was created there since. */
+    void remove_origin(const std::filesystem::path& origin, Clock::time_point now);
+
+   public:
+    explicit AssetEventDebouncer(Clock::duration window) : m_window(window) {}
+
+    /** @brief Record a raw change seen at `now`. */
+    void push(const RawFileChange& change, Clock::time_point now);
+    /** @brief Take the changes of the paths quiet for the whole window, in path order. */
+    std::vector<Settled> take_settled(Clock::time_point now);
+    /** @brief Take every pending change, settled or not. */
+    std::vector<Settled> take_all() { return take_settled(Clock::time_point::max()); }
+    /** @brief Time at which the next pending change settles, nullopt if none is pending. */
+    std::optional<Clock::time_point> next_deadline() const;
+    /** @brief Number of paths with a pending change. */
+    std::size_t pending() const { return m_pending.size(); }
+    Clock::duration window() const { return m_window; }
+
+    /** @brief Turn settled changes into source events.
+     *  @param status Looked up once per added, modified or renamed path. Added and modified paths
+     *  that no longer exist are dropped: their removal is pending or already delivered. */
+    static std::vector<AssetSourceEvent> to_events(
+        std::span<const Settled> settled, utils::function_ref<FileStatus(const std::filesystem::path&)> status);
+};
+}  // namespace epix::assets
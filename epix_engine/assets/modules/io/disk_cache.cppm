@@ -0,0 +1,72 @@
+module;
+
+export module epix.assets:io.disk_cache;
+
+import std;
+
+import :meta;
+
+namespace epix::assets {
+/** @brief Counters of a DiskCacheStore since it was created. */
+export struct DiskCacheStats {
+    std::uint64_t hits    = 0;
+    std::uint64_t misses  = 0;
+    std::uint64_t stores  = 0;
+    std::uint64_t evicted = 0;
+};
+
+/** @brief The on-disk layout shared by the persistent caches, such as ProcessedAssetCache and the shader
+ *  disk cache. Callers own the format of the files; this owns where they live, how they are written and
+ *  how the cache is trimmed.
+ *
+ *  An entry is one or more files under `root` named after its key and differing by extension only,
+ *  fanned out over 256 directories. Files are written to a temporary name and renamed into place, so
+ *  several processes may share a cache. The use time of an entry is the write time of its marker file,
+ *  the one with `marker_extension`: it is stored last and evicted first, and an entry without it is an
+ *  interrupted store. Thread-safe. */
+export struct DiskCacheStore {
+    /** @brief One file of an entry. */
+    struct File {
+        std::string_view extension;
+        /** @brief Content of the file, written back to back. */
+        std::vector<std::span<const std::byte>> parts;
+    };
+
+   private:
+    std::filesystem::path m_root;
+    std::string m_marker_extension;
+    std::atomic<std::uint64_t> m_hits    = 0;
+    std::atomic<std::uint64_t> m_misses  = 0;
+    std::atomic<std::uint64_t> m_stores  = 0;
+    std::atomic<std::uint64_t> m_evicted = 0;
+
+   public:
+    /** @brief Open the cache at `root`, creating the directory if needed. */
+    DiskCacheStore(std::filesystem::path root, std::string marker_extension);
+
+    /** @brief Path of an entry file relative to `root`. */
+    static std::filesystem::path entry_name(const AssetHash& key, std::string_view extension);
+    std::filesystem::path entry_path(const AssetHash& key, std::string_view extension) const {
+        return m_root / entry_name(key, extension);
+    }
+
+    /** @brief Write the files of an entry in order, replacing an existing entry. The marker file goes last.
+     *  @return False if a file could not be written; files renamed in before it are left in place. */
+    bool store(const AssetHash& key, std::initializer_list<File> files);
+    /** @brief Mark an entry used now, keeping it from `collect_garbage` longer. */
+    void touch(const AssetHash& key) const;
+    void record_hit() { m_hits.fetch_add(1, std::memory_order_relaxed); }
+    void record_miss() { m_misses.fetch_add(1, std::memory_order_relaxed); }
+    /** @brief Remove the least recently used entries until the cache fits `max_bytes`, and any leftover
+     *  of interrupted stores.
+     *  @return The number of bytes removed. */
+    std::uint64_t collect_garbage(std::uint64_t max_bytes);
+    /** @brief Total size of the files in the cache. Walks the cache directory. */
+    std::uint64_t size_bytes() const;
+    /** @brief Remove every entry. */
+    void clear();
+
+    DiskCacheStats stats() const;
+    const std::filesystem::path& root() const { return m_root; }
+};
+}  // namespace epix::assets
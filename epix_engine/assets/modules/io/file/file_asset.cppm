@@ -9,6 +9,19 @@ import epix.utils;
 import :io.reader;
 
 namespace epix::assets {
+/** @brief Read a whole file through the process-wide io_uring queue.
+ *  @return False, leaving `on_complete` untouched, if io_uring is unavailable on this platform or kernel. */
+bool uring_read_file(const std::filesystem::path& path, AssetBytesCallback& on_complete);
+/** @brief Memory-map a whole file read-only. The mapping is released when the last view is dropped.
+ *  @param sequential Hint the kernel to read ahead, for files decoded front to back.
+ *  @return nullopt if the file cannot be opened or mapped. */
+std::optional<AssetBytes> map_file(const std::filesystem::path& path, bool sequential = true);
+/** @brief Memory-map the first `size` bytes of an open file read-only, on POSIX. The mapping keeps its
+ *  own reference to the file, so `fd` may be closed right after. Shared by map_file and the io_uring
+ *  reader, which opens files itself.
+ *  @return nullopt if the file cannot be mapped. */
+std::optional<AssetBytes> map_file_descriptor(int fd, std::size_t size, bool sequential);
+
 export struct FileAssetReader : public AssetReader {
    private:
     std::filesystem::path m_root;
@@ -21,6 +34,11 @@ export struct FileAssetReader : public AssetReader {
         const std::filesystem::path& path) const override {
         return read(get_meta_path(path));
     }
+    /** @brief Memory-map the file read-only. The mapping is released when the last view is dropped. */
+    std::optional<AssetBytes> read_bytes_view(const std::filesystem::path& path) const override;
+    /** @brief Read through io_uring on Linux, many reads stay in flight without parking threads.
+     *  Falls back to the IOTaskPool where io_uring is unavailable. */
+    void read_bytes_async(const std::filesystem::path& path, AssetBytesCallback on_complete) const override;
     std::expected<utils::input_iterable<std::filesystem::path>, AssetReaderError> read_directory(
         const std::filesystem::path& path) const override;
     std::expected<bool, AssetReaderError> is_directory(const std::filesystem::path& path) const override;
@@ -58,6 +76,9 @@ export struct FileAssetWriter : public AssetWriter {
     std::expected<void, AssetWriterError> create_directory(const std::filesystem::path& path) const override;
     std::expected<void, AssetWriterError> remove_directory(const std::filesystem::path& path) const override;
     std::expected<void, AssetWriterError> clear_directory(const std::filesystem::path& path) const override;
+    /** @brief Hard-link `file` in place, copying it when linking fails, e.g. across volumes. */
+    std::expected<void, AssetWriterError> write_from_file(const std::filesystem::path& path,
+                                                          const std::filesystem::path& file) const override;
 };
 static_assert(!std::is_abstract_v<FileAssetWriter>);
 }  // namespace epix::assets
\ No newline at end of file
@@ -9,14 +9,29 @@ import epix.meta;
 import epix.utils;
 
 import :io.reader;
+import :io.debounce;
 
 namespace epix::assets {
+/** @brief Default debounce window of the file watcher. */
+export inline constexpr std::chrono::milliseconds DEFAULT_WATCHER_DEBOUNCE{300};
+
+/** @brief Watches a directory tree and sends AssetSourceEvents with paths relative to it.
+ *
+ *  Raw platform changes go through an AssetEventDebouncer; a flusher thread classifies the
+ *  settled changes and sends them together once their paths are quiet for the debounce window.
+ *  The platform callback only records the change, it does not touch the filesystem. */
 export struct FileAssetWatcher : public AssetWatcher {
    private:
-    std::unique_ptr<efsw::FileWatcher> m_watcher;
+    struct Shared;
+    std::shared_ptr<Shared> m_shared;
+    std::jthread m_flusher;
     std::unique_ptr<efsw::FileWatchListener> m_listener;
+    // declared last so it is destroyed first, stopping the callbacks before the listener goes.
+    std::unique_ptr<efsw::FileWatcher> m_watcher;
 
    public:
-    FileAssetWatcher(std::filesystem::path root, utils::Sender<AssetSourceEvent> event_sender);
+    FileAssetWatcher(std::filesystem::path root,
+                     utils::Sender<AssetSourceEvent> event_sender,
+                     std::chrono::milliseconds debounce = DEFAULT_WATCHER_DEBOUNCE);
 };
 }  // namespace epix::assets
\ No newline at end of file
@@ -45,6 +45,9 @@ struct ProcessorGatedReader : public AssetReader {
     std::expected<std::unique_ptr<std::istream>, AssetReaderError> read_meta(
         const std::filesystem::path& path) const override;
 
+    /** @brief Forward a byte view of the inner reader, holding the transaction lock while it is alive. */
+    std::optional<AssetBytes> read_bytes_view(const std::filesystem::path& path) const override;
+
     std::expected<utils::input_iterable<std::filesystem::path>, AssetReaderError> read_directory(
         const std::filesystem::path& path) const override;
 
@@ -21,7 +21,30 @@ struct HttpError {
 export using AssetReaderError =
     std::variant<reader_errors::NotFound, reader_errors::IoError, reader_errors::HttpError, std::exception_ptr>;
 
-// TODO: use coroutines async operation for readers, and return a future/awaitable instead of blocking the thread
+/** @brief Refcounted read-only view over the bytes of an asset, e.g. a memory-mapped file.
+ *  The bytes stay valid as long as any copy of this view is alive. */
+export struct AssetBytes {
+   private:
+    std::shared_ptr<const void> m_owner;
+    std::span<const std::byte> m_bytes;
+
+   public:
+    AssetBytes() = default;
+    /** @brief Construct a view over `bytes`, kept alive by `owner`. */
+    AssetBytes(std::shared_ptr<const void> owner, std::span<const std::byte> bytes)
+        : m_owner(std::move(owner)), m_bytes(bytes) {}
+
+    /** @brief Get the viewed bytes. */
+    std::span<const std::byte> bytes() const { return m_bytes; }
+    /** @brief Get the object keeping the bytes alive. */
+    const std::shared_ptr<const void>& owner() const { return m_owner; }
+    const std::byte* data() const { return m_bytes.data(); }
+    std::size_t size() const { return m_bytes.size(); }
+    bool empty() const { return m_bytes.empty(); }
+};
+
+/** @brief Completion callback of `AssetReader::read_bytes_async`. */
+export using AssetBytesCallback = std::function<void(std::expected<AssetBytes, AssetReaderError>)>;
 
 export struct AssetReader {
     /** @brief Get a stream to read an asset */
@@ -39,6 +62,20 @@ export struct AssetReader {
     virtual std::optional<std::filesystem::file_time_type> last_modified(const std::filesystem::path& path) const {
         return std::nullopt;
     }
+    /** @brief Get a zero-copy view of an asset's bytes, or nullopt if unsupported by this reader.
+     *  Loaders are then handed the bytes directly instead of a stream. Errors are not reported here,
+     *  callers fall back to `read()` which reports them. */
+    virtual std::optional<AssetBytes> read_bytes_view(const std::filesystem::path& path) const {
+        return std::nullopt;
+    }
+    /** @brief Read all bytes of an asset, blocking. Uses `read_bytes_view` if supported, otherwise
+     *  copies the stream returned by `read`. */
+    std::expected<AssetBytes, AssetReaderError> read_bytes(const std::filesystem::path& path) const;
+    /** @brief Read all bytes of an asset without blocking the caller.
+     *  `on_complete` is invoked exactly once, on an unspecified thread, and must not block: hand
+     *  CPU work such as decoding to another pool. The reader must outlive the read. The default
+     *  runs `read_bytes` on the IOTaskPool. */
+    virtual void read_bytes_async(const std::filesystem::path& path, AssetBytesCallback on_complete) const;
     /** @brief Read metadata bytes of an asset */
     std::expected<std::vector<std::byte>, AssetReaderError> read_meta_bytes(const std::filesystem::path& path) const;
     virtual ~AssetReader() = default;
@@ -74,6 +111,11 @@ export struct AssetWriter {
                                                       std::span<const std::byte> bytes) const;
     std::expected<void, AssetWriterError> write_meta_bytes(const std::filesystem::path& path,
                                                            std::span<const std::byte> bytes) const;
+    /** @brief Write the content of the file `file` on disk as the asset at `path`.
+     *  The default copies the bytes through `write`. Writers on disk may link the file instead,
+     *  `file` must not be modified afterwards then. */
+    virtual std::expected<void, AssetWriterError> write_from_file(const std::filesystem::path& path,
+                                                                  const std::filesystem::path& file) const;
     virtual ~AssetWriter() = default;
 };
 
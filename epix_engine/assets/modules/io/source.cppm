@@ -6,6 +6,7 @@ import epix.utils;
 import :path;
 import :io.reader;
 import :io.file.asset;
+import :io.archive;
 import :io.file.watcher;
 
 namespace epix::assets {
@@ -43,9 +44,14 @@ export struct AssetSource {
         utils::function_ref<std::unique_ptr<AssetReader>(AssetSourceId, const AssetReader&)> factory);
 
     static std::function<std::unique_ptr<AssetReader>()> get_default_reader(std::filesystem::path path);
+    /** @brief Reader factory serving a packed archive written by `write_asset_archive`.
+     *  Use it as the (processed) reader of a source to ship assets as a single file. */
+    static std::function<std::unique_ptr<AssetReader>()> get_archive_reader(std::filesystem::path archive);
     static std::function<std::unique_ptr<AssetWriter>()> get_default_writer(std::filesystem::path path);
+    /** @brief Watcher factory for a directory. Changes to a path are delivered once the path has been
+     *  quiet for `debounce`. */
     static std::function<std::unique_ptr<AssetWatcher>(utils::Sender<AssetSourceEvent>)> get_default_watcher(
-        std::filesystem::path path);
+        std::filesystem::path path, std::chrono::milliseconds debounce = DEFAULT_WATCHER_DEBOUNCE);
 };
 
 export struct AssetSourceBuilder {
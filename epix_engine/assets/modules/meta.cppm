@@ -26,7 +26,7 @@ import :path;
 namespace epix::assets {
 
 /** @brief Version string for the meta format. */
-export inline constexpr std::string_view META_FORMAT_VERSION = "2.0";
+export inline constexpr std::string_view META_FORMAT_VERSION = "3.0";
 
 /** @brief Controls when and how asset metadata files are checked.
  *  Matches bevy_asset's AssetMetaCheck. */
@@ -52,7 +52,7 @@ export enum class UnapprovedPathMode {
 };
 
 /** @brief Hash type used by the asset processing pipeline.
- *  Matches bevy_asset's AssetHash = [u8; 32] (BLAKE3 hash). */
+ *  Matches bevy_asset's AssetHash = [u8; 32], a BLAKE3 hash since META_FORMAT_VERSION 3.0. */
 export using AssetHash = std::array<uint8_t, 32>;
 
 /** @brief Information about a processed asset's dependency on another asset. */
@@ -378,19 +378,27 @@ export inline std::expected<std::optional<ProcessedInfo>, std::errc> deserialize
 
 // ---------------------------------------------------------------------------
 // Asset hashing utilities
-// Matches bevy_asset's get_asset_hash / get_full_asset_hash.
-// Uses a simple streaming 32-byte hash (4 x 64-bit lanes, FNV-inspired) since
-// BLAKE3 is not available as a standalone dependency.  The format is internal
-// to epix_engine and does not need to interoperate with bevy's binary format.
+// Matches bevy_asset's get_asset_hash / get_full_asset_hash: BLAKE3 over the meta bytes followed
+// by the asset bytes. Earlier meta formats used a different hash, so hashes recorded by them
+// never match and those assets are processed again.
 // ---------------------------------------------------------------------------
 
 /** @brief Compute a 32-byte asset hash from meta bytes + asset stream contents.
  *  NOTE: changing the hashing algorithm requires a META_FORMAT_VERSION bump.
  *  Matches bevy_asset's get_asset_hash (synchronous version). */
-AssetHash get_asset_hash(std::span<const std::byte> meta_bytes, std::istream& reader);
+export AssetHash get_asset_hash(std::span<const std::byte> meta_bytes, std::istream& reader);
+/** @brief Compute the same hash as the stream overload over bytes already in memory, without copying.
+ *  Hashes on the calling thread, so it is safe to call from task pool threads. */
+export AssetHash get_asset_hash(std::span<const std::byte> meta_bytes, std::span<const std::byte> asset_bytes);
+/** @brief Same hash as above, with inputs of more than a few MiB split across up to `threads` threads,
+ *  the calling one included. The extra threads are short-lived and not taken from a task pool; if one
+ *  cannot be started, its subtree is hashed on the calling thread instead. */
+export AssetHash get_asset_hash(std::span<const std::byte> meta_bytes,
+                                std::span<const std::byte> asset_bytes,
+                                unsigned threads);
 
 /** @brief Compute the full_hash by chaining an asset hash with all dependency full_hashes.
  *  Matches bevy_asset's get_full_asset_hash. */
-AssetHash get_full_asset_hash(AssetHash asset_hash, const std::vector<AssetHash>& dependency_hashes);
+export AssetHash get_full_asset_hash(AssetHash asset_hash, const std::vector<AssetHash>& dependency_hashes);
 
 }  // namespace epix::assets
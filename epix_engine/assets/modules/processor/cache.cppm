@@ -0,0 +1,67 @@
+module;
+
+export module epix.assets:processor.cache;
+
+import std;
+
+import :meta;
+import :io.disk_cache;
+
+namespace epix::assets {
+
+/** @brief Default size limit of a ProcessedAssetCache, 4 GiB. */
+export inline constexpr std::uint64_t DEFAULT_PROCESSED_CACHE_SIZE = std::uint64_t{4} << 30;
+
+/** @brief A content-addressed store of processed assets, shared by every processed tree on a machine.
+ *
+ *  Entries are keyed by the hash of the source asset and its meta together with the processor type
+ *  and version, see `key`, so a clean checkout or a branch switch finds the outputs processed by
+ *  another tree. The processed info of an entry records the full hashes of the dependencies it was
+ *  processed with; the processor only serves an entry whose dependencies still match.
+ *
+ *  Each entry is two files in a DiskCacheStore under `root`, `<key>.asset` and `<key>.meta`; the meta
+ *  file marks the entry complete and carries its use time. Cached asset files are linked into processed
+ *  trees where possible and must never be written in place. Thread-safe. */
+export struct ProcessedAssetCache {
+    /** @brief A cached processed asset. */
+    struct Entry {
+        /** @brief The processed asset file in the cache, to be linked or copied. */
+        std::filesystem::path asset;
+        /** @brief The processed meta bytes, including the ProcessedInfo it was processed with. */
+        std::vector<std::byte> meta;
+    };
+    using Stats = DiskCacheStats;
+
+   private:
+    DiskCacheStore m_store;
+    std::uint64_t m_max_bytes;
+    /** @brief Set when an entry was stored since the last collection. */
+    std::atomic<bool> m_grown = true;
+
+   public:
+    /** @param max_bytes Size `collect_garbage` trims the cache to. */
+    explicit ProcessedAssetCache(std::filesystem::path root, std::uint64_t max_bytes = DEFAULT_PROCESSED_CACHE_SIZE);
+
+    /** @brief Key of the output of `processor` at `version` for an input hash, as computed by
+     *  get_asset_hash over the source meta and asset bytes. */
+    static AssetHash key(const AssetHash& input_hash, std::string_view processor, std::uint32_t version);
+
+    /** @brief Look up an entry, marking it used for garbage collection. */
+    std::optional<Entry> find(const AssetHash& key);
+    /** @brief Store a processed asset and its processed meta bytes, replacing an existing entry.
+     *  @return False if the entry could not be written; the cache is left unchanged then. */
+    bool store(const AssetHash& key, std::span<const std::byte> asset, std::span<const std::byte> meta);
+    /** @brief Remove the least recently used entries until the cache fits `max_bytes`, and any
+     *  leftover of interrupted stores.
+     *  @return The number of bytes removed. */
+    std::uint64_t collect_garbage();
+    /** @brief Check if entries were stored since the last `collect_garbage`. */
+    bool needs_collection() const { return m_grown.load(std::memory_order_relaxed); }
+    /** @brief Total size of the files in the cache. Walks the cache directory. */
+    std::uint64_t size_bytes() const { return m_store.size_bytes(); }
+
+    Stats stats() const { return m_store.stats(); }
+    const std::filesystem::path& root() const { return m_store.root(); }
+    std::uint64_t max_bytes() const { return m_max_bytes; }
+};
+}  // namespace epix::assets
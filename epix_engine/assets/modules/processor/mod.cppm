@@ -13,10 +13,13 @@ import :path;
 import :meta;
 import :io.reader;
 import :io.source;
+import :io.archive;
 import :server.loader;
 import :server;
+import :server.diagnostics;
 import :processor.process;
 import :processor.log;
+import :processor.cache;
 
 namespace epix::assets {
 
@@ -66,6 +69,8 @@ struct ProcessorAssetInfo {
     std::shared_ptr<std::shared_mutex> file_transaction_lock = std::make_shared<std::shared_mutex>();
     utils::BroadcastSender<ProcessStatus> status_sender;
     utils::BroadcastReceiver<ProcessStatus> status_receiver;
+    /** @brief Wall time of the last processing attempt, including reads, waits on dependencies and writes. */
+    std::optional<std::chrono::nanoseconds> process_time;
 
     ProcessorAssetInfo();
 
@@ -106,6 +111,46 @@ struct ProcessorAssetInfos {
     void clear_dependencies(const AssetPath& asset_path, const ProcessedInfo& removed_info);
 };
 
+// ---- ProcessingScheduler ----
+
+/** @brief Queue of processing tasks, ordered along the process dependencies recorded by the last run
+ *  and bounded in how many run at once.
+ *
+ *  A task whose recorded dependencies are still queued or running waits for them, every other task
+ *  runs in arrival order. Dependencies a processor discovers for the first time are covered by
+ *  `steal`: a thread about to wait for a queued asset runs it itself instead of holding its slot. */
+export struct ProcessingScheduler {
+    using Task = std::pair<AssetSourceId, std::filesystem::path>;
+
+   private:
+    struct Entry {
+        Task task;
+        std::size_t blocking = 0;
+        bool running         = false;
+        bool rerun           = false;
+    };
+    mutable std::mutex m_mutex;
+    std::unordered_map<AssetPath, Entry> m_entries;
+    std::unordered_map<AssetPath, std::vector<AssetPath>> m_dependents;
+    std::deque<AssetPath> m_ready;
+    std::size_t m_running = 0;
+
+   public:
+    /** @brief Queue a task. A task already queued is not queued twice, a running one runs again after.
+     *  @param dependencies Paths the asset depended on when it was last processed. */
+    void push(Task task, std::span<const AssetPath> dependencies);
+    /** @brief Take the next ready task, if fewer than `limit` popped tasks are running. */
+    std::optional<Task> pop(std::size_t limit);
+    /** @brief Take a queued task to run it on the calling thread, which is about to wait for it.
+     *  @return nullopt if the asset is not queued or already running. */
+    std::optional<Task> steal(const AssetPath& path);
+    /** @brief Mark a task finished and release the tasks waiting for it.
+     *  @param popped Whether the task came from `pop`, rather than from `steal`. */
+    void finish(const AssetPath& path, bool popped);
+    /** @brief Check if no task is queued or running. */
+    bool empty() const;
+};
+
 // ---- ProcessingState ----
 
 /** @brief The current state of processing, including the overall state and the state of all assets.
@@ -120,6 +165,8 @@ struct ProcessingState {
     utils::BroadcastReceiver<bool> m_finished_receiver;
 
     mutable utils::RwLock<ProcessorAssetInfos> m_asset_infos;
+    /// Runs a queued asset on a thread about to wait for it. Set by the task executor while it runs.
+    utils::Mutex<std::function<void(const AssetPath&)>> m_run_queued{std::function<void(const AssetPath&)>{}};
 
     friend struct AssetProcessor;
     friend struct AssetProcessorData;
@@ -148,6 +195,14 @@ struct ProcessingState {
 
 // ---- AssetProcessorData ----
 
+/** @brief Concurrency limits of the asset processor. */
+export struct ProcessingLimits {
+    /** @brief Assets in flight at once, from reading the source to writing the processed asset. */
+    std::size_t tasks = std::max<std::size_t>(4, 2 * std::thread::hardware_concurrency());
+    /** @brief Assets inside `Process::process` at once, the CPU-bound step. Waiting for a dependency does not count. */
+    std::size_t cpu_tasks = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+};
+
 /** @brief Error when updating the transaction log factory after the processor has started.
  *  Matches bevy_asset's SetTransactionLogFactoryError. */
 export namespace set_transaction_log_factory_errors {
@@ -170,6 +225,11 @@ export struct AssetProcessorData {
         bool shutdown_requested = false;
     };
     utils::Mutex<TaskSenderState> task_sender;
+    utils::Mutex<ProcessingLimits> limits{ProcessingLimits{}};
+    utils::Mutex<std::shared_ptr<ProcessedAssetCache>> cache{std::shared_ptr<ProcessedAssetCache>{}};
+    mutable std::mutex cpu_slot_mutex;
+    mutable std::condition_variable cpu_slot_cv;
+    mutable std::size_t cpu_slots_used = 0;
 
     AssetProcessorData(std::shared_ptr<AssetSources> sources, std::shared_ptr<ProcessingState> processing_state);
     AssetProcessorData(std::shared_ptr<AssetSources> sources,
@@ -177,9 +237,16 @@ export struct AssetProcessorData {
                        std::unique_ptr<ProcessorTransactionLogFactory> log_factory);
 
     friend struct AssetProcessor;
+    friend struct ProcessingState;
 
     void set_task_sender(utils::Sender<std::pair<AssetSourceId, std::filesystem::path>> sender) const;
     void shutdown() const;
+    /** @brief Block until fewer than `cpu_tasks` assets are being processed, then take a slot.
+     *  @return False if the thread already holds a slot, e.g. while processing a dependency inline;
+     *  nothing is taken then and nothing must be released. A thread blocked in `wait_until_processed` on an
+     *  asset processed elsewhere gives its slot back until the wait ends. */
+    bool acquire_cpu_slot() const;
+    void release_cpu_slot() const;
 
    public:
     std::expected<void, SetTransactionLogFactoryError> set_log_factory(
@@ -188,6 +255,17 @@ export struct AssetProcessorData {
     void wait_until_initialized() const;
     void wait_until_finished() const;
     ProcessorState state() const;
+    /** @brief Set the concurrency limits. Applies to tasks started afterwards. */
+    void set_processing_limits(ProcessingLimits limits) const;
+    ProcessingLimits processing_limits() const;
+    /** @brief Get how long the last processing attempt of `path` took. */
+    std::optional<std::chrono::nanoseconds> process_time(const AssetPath& path) const;
+    /** @brief Get how long the last processing attempt of every processed asset took. */
+    std::vector<ProcessedAssetTiming> process_times() const;
+    /** @brief Share processed outputs through `cache`, or stop sharing with nullptr.
+     *  Applies to tasks started afterwards. */
+    void set_processed_cache(std::shared_ptr<ProcessedAssetCache> cache) const;
+    std::shared_ptr<ProcessedAssetCache> processed_cache() const;
 };
 
 // ---- AssetProcessor ----
@@ -320,6 +398,12 @@ export struct AssetProcessor {
      *  Matches bevy_asset's AssetProcessor::get_processor. */
     std::expected<std::shared_ptr<ErasedProcessor>, GetProcessorError> get_processor(std::string_view type_name) const;
 
+    /** @brief Pack the processed assets of `source` into a single archive at `output`.
+     *  Waits for processing to finish first. Serve the result with `AssetSource::get_archive_reader`.
+     *  @return The number of packed assets. */
+    std::expected<std::size_t, AssetWriterError> write_archive(const AssetSourceId& source,
+                                                               const std::filesystem::path& output) const;
+
     // ---- Processing lifecycle (declared, defined in .cpp) ----
 
     /** @brief Start the processor. This is the main entry point, typically called as a system.
@@ -25,7 +25,9 @@ export struct ProcessContext;
 /** @brief Concept for an asset processor.
  *  Matches bevy_asset's Process trait.
  *  A processor reads input bytes, processes the value in some way,
- *  and writes processed bytes that can be loaded with Process::OutputLoader. */
+ *  and writes processed bytes that can be loaded with Process::OutputLoader.
+ *  A processor may declare `static constexpr std::uint32_t version`, bumped whenever its output
+ *  for the same input changes, so outputs cached by older versions are not reused. */
 export template <typename P>
 concept Process = requires(P& p, ProcessContext& ctx, const typename P::Settings& settings, std::ostream& writer) {
     typename P::Settings;
@@ -146,6 +148,8 @@ export struct ErasedProcessor {
     virtual std::string_view type_path() const = 0;
     /** @brief Get the short type path of this processor. */
     virtual std::string_view short_type_path() const = 0;
+    /** @brief Get the version of this processor, `P::version` or 0 if it declares none. */
+    virtual std::uint32_t version() const = 0;
     /** @brief Get the default type-erased AssetMetaDyn for this processor. */
     virtual std::unique_ptr<AssetMetaDyn> default_meta() const = 0;
     /** @brief Get default settings for this processor. */
@@ -193,6 +197,13 @@ struct ErasedProcessorImpl : P, ErasedProcessor {
 
     std::string_view type_path() const override { return epix::meta::type_id<P>{}.name(); }
     std::string_view short_type_path() const override { return epix::meta::type_id<P>{}.short_name(); }
+    std::uint32_t version() const override {
+        if constexpr (requires { std::uint32_t{P::version}; }) {
+            return P::version;
+        } else {
+            return 0;
+        }
+    }
 
     std::unique_ptr<AssetMetaDyn> default_meta() const override {
         auto meta       = std::make_unique<AssetMeta<typename P::OutputLoader::Settings, typename P::Settings>>();
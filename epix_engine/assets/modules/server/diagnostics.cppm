@@ -0,0 +1,138 @@
+module;
+
+export module epix.assets:server.diagnostics;
+
+import std;
+import epix.meta;
+
+namespace epix::assets {
+/** @brief The stages of an asset load timed by the AssetServer. */
+export enum class LoadStage : std::uint8_t {
+    Queued, /**< Waiting in the load queue for a load slot. */
+    Read,   /**< Resolving meta and loader, then reading the asset bytes. */
+    Decode, /**< Running the loader on the bytes, on the WorkerTaskPool. */
+    Insert, /**< Inserting the loaded asset into the world, on the thread running `handle_internal_events`. */
+};
+export inline constexpr std::size_t LOAD_STAGE_COUNT = 4;
+export constexpr std::string_view load_stage_name(LoadStage stage) {
+    constexpr std::array<std::string_view, LOAD_STAGE_COUNT> names{"queued", "read", "decode", "insert"};
+    return names[std::to_underlying(stage)];
+}
+
+/** @brief Histogram of durations over power-of-two microsecond buckets.
+ *  Bucket `i` counts durations under `2^i` microseconds; the last bucket counts everything longer. */
+export struct LatencyHistogram {
+    static constexpr std::size_t BUCKETS = 24;
+
+    std::array<std::uint64_t, BUCKETS> buckets{};
+    std::uint64_t count = 0;
+    std::chrono::nanoseconds total{0};
+    std::chrono::nanoseconds max{0};
+
+    void record(std::chrono::nanoseconds duration);
+    std::chrono::nanoseconds mean() const { return count == 0 ? total : total / count; }
+    /** @brief Upper bound of the bucket holding the `q` quantile, `q` in [0, 1]. The max for the last bucket. */
+    std::chrono::nanoseconds quantile(double q) const;
+};
+
+/** @brief Stage histograms of the loads of one loader or one asset type. */
+export struct LoadStageTimings {
+    /** @brief Short name of the loader or the asset type. */
+    std::string_view name;
+    std::array<LatencyHistogram, LOAD_STAGE_COUNT> stages;
+    /** @brief Asset bytes read for these loads, meta files excluded. */
+    std::uint64_t bytes_read = 0;
+
+    const LatencyHistogram& stage(LoadStage stage) const { return stages[std::to_underlying(stage)]; }
+};
+
+/** @brief How long the AssetProcessor took for one asset on its last attempt. */
+export struct ProcessedAssetTiming {
+    std::string path;
+    std::chrono::nanoseconds time;
+};
+
+/** @brief Snapshot of the AssetServer's activity, published as a resource every frame by
+ *  `publish_asset_server_diagnostics`.
+ *  The stage histograms tell slow I/O, slow decoding and slow main-thread insertion apart. Histograms
+ *  cover every load since the server was created; rates cover the last frame. */
+export struct AssetServerDiagnostics {
+    /** @brief Slowest processed assets kept in `slowest_processed_assets`. */
+    static constexpr std::size_t SLOWEST_PROCESSED = 16;
+
+    std::size_t started_load_tasks   = 0;
+    std::size_t finished_load_tasks  = 0;
+    std::size_t cancelled_load_tasks = 0;
+    /** @brief Loads past the queue that are still reading or decoding. A load leaves this count when
+     *  its decode task ends, so its asset may still wait for `handle_internal_events`. */
+    std::size_t in_flight_loads = 0;
+    /** @brief Loads waiting in the load queue for a slot. */
+    std::size_t queued_loads = 0;
+    /** @brief Assets published by running loaders and not inserted yet. */
+    std::size_t pending_published_assets = 0;
+    /** @brief Dropped strong handles whose assets the next `Assets<T>::handle_events` runs release. */
+    std::size_t pending_handle_drops = 0;
+    std::uint64_t bytes_read     = 0;
+    double bytes_read_per_second = 0;
+    /** @brief Per loader, sorted by name. */
+    std::vector<LoadStageTimings> loaders;
+    /** @brief Per asset type, sorted by name. */
+    std::vector<LoadStageTimings> asset_types;
+    /** @brief Last processing time of every asset the AssetProcessor handled. Empty without a processor. */
+    LatencyHistogram processing;
+    /** @brief The assets that took the AssetProcessor longest, slowest first. */
+    std::vector<ProcessedAssetTiming> slowest_processed_assets;
+
+    const LoadStageTimings* loader(std::string_view name) const;
+    const LoadStageTimings* asset_type(std::string_view name) const;
+};
+
+/** @brief Collects load timings for AssetServerDiagnostics, and for a Chrome trace while one is
+ *  recorded. Thread-safe. Recording takes a short lock, a few times per load. */
+struct AssetLoadRecorder {
+    using Clock = std::chrono::steady_clock;
+
+    /** @brief Trace events kept at most; later ones are dropped until the trace is taken. */
+    static constexpr std::size_t MAX_TRACE_EVENTS = 1 << 20;
+
+   private:
+    struct TraceEvent {
+        LoadStage stage;
+        std::string path;
+        std::string_view loader;
+        Clock::time_point start;
+        Clock::time_point end;
+        std::thread::id thread;
+    };
+    mutable std::mutex m_mutex;
+    std::map<std::string_view, LoadStageTimings> m_loaders;
+    std::unordered_map<epix::meta::type_index, LoadStageTimings> m_types;
+    std::atomic<std::uint64_t> m_bytes_read = 0;
+    std::atomic<std::size_t> m_in_flight    = 0;
+    std::optional<Clock::time_point> m_trace_start;
+    std::vector<TraceEvent> m_trace;
+
+    LoadStageTimings& type_timings(const epix::meta::type_index& type);
+
+   public:
+    /** @brief Record that a load of `path` spent `[start, end)` in `stage`. */
+    void record(LoadStage stage,
+                std::string_view loader,
+                const epix::meta::type_index& type,
+                std::string_view path,
+                Clock::time_point start,
+                Clock::time_point end);
+    void record_bytes(std::string_view loader, const epix::meta::type_index& type, std::uint64_t bytes);
+    void load_started() { m_in_flight.fetch_add(1, std::memory_order_relaxed); }
+    void load_finished() { m_in_flight.fetch_sub(1, std::memory_order_relaxed); }
+    std::size_t in_flight() const { return m_in_flight.load(std::memory_order_relaxed); }
+    std::uint64_t bytes_read() const { return m_bytes_read.load(std::memory_order_relaxed); }
+    /** @brief Copy the histograms into `diagnostics`. */
+    void snapshot(AssetServerDiagnostics& diagnostics) const;
+
+    /** @brief Start recording trace events, discarding any recorded so far. */
+    void start_trace();
+    /** @brief Stop recording and return the events as Chrome trace JSON, empty if no trace was started. */
+    std::string take_trace();
+};
+}  // namespace epix::assets
@@ -32,7 +32,6 @@ struct AssetInfo {
     /// Tasks waiting for this asset to finish loading. Each entry is resolved when loading completes
     /// or fails. Mirrors bevy_asset's AssetInfo::waiting_tasks (Vec<Waker>).
     std::vector<std::shared_ptr<std::promise<std::expected<void, WaitForAssetError>>>> waiting_tasks;
-    std::size_t handle_destruct_skip = 0;
     /// Reverse dependency tracking: assets that have this asset as a direct dependency.
     /// Matches bevy_asset's AssetInfo::dependants (HashSet<ErasedAssetIndex>).
     std::unordered_set<UntypedAssetId> dependants;
@@ -42,10 +41,69 @@ struct AssetInfo {
 };
 
 /** @brief Statistics reported by the asset server.
- *  Matches bevy_asset's AssetServerStats. */
+ *  Matches bevy_asset's AssetServerStats. Counters are atomic and live next to the infos lock rather
+ *  than inside it, so starting a load task does not take the infos write lock just to count it. */
 struct AssetServerStats {
-    std::size_t started_load_tasks  = 0;
-    std::size_t finished_load_tasks = 0;
+    std::atomic<std::size_t> started_load_tasks  = 0;
+    std::atomic<std::size_t> finished_load_tasks = 0;
+    /// Loads dropped or stopped early because every handle to their asset was dropped.
+    std::atomic<std::size_t> cancelled_load_tasks = 0;
+};
+
+/** @brief Generational slot map of AssetInfo, keyed by asset id.
+ *  Index ids address a per-type slot vector directly and the slot generation rejects stale
+ *  ids, so a lookup hashes the type once instead of hashing and comparing the whole id.
+ *  Handle providers recycle indices, which keeps the slot vectors dense. Uuid ids, which the
+ *  server never allocates itself, live in a side map. Like a vector, `emplace` may move the
+ *  infos of the same asset type, so do not hold an info across it. */
+struct AssetInfoSlots {
+   private:
+    struct Slot {
+        std::uint32_t generation = 0;
+        std::optional<AssetInfo> info;
+    };
+    std::unordered_map<epix::meta::type_index, std::vector<Slot>> m_slots;
+    std::unordered_map<UntypedAssetId, AssetInfo> m_uuid_infos;
+    std::size_t m_size = 0;
+
+   public:
+    /** @brief Get the info stored for `id`, or nullptr if there is none. */
+    AssetInfo* find(const UntypedAssetId& id);
+    /** @brief Get the info stored for `id`, or nullptr if there is none. */
+    const AssetInfo* find(const UntypedAssetId& id) const;
+    bool contains(const UntypedAssetId& id) const { return find(id) != nullptr; }
+    /** @brief Store `info` for `id`, replacing the info of any older generation in the slot. */
+    AssetInfo& emplace(const UntypedAssetId& id, AssetInfo info);
+    /** @brief Remove the info of `id`. Returns false if there was none. */
+    bool erase(const UntypedAssetId& id);
+    std::size_t size() const { return m_size; }
+};
+
+/** @brief Index from asset paths to their ids, one per asset type, split into shards with their own locks.
+ *  Writes happen under the infos write lock. Path queries of the AssetServer lock one shard for reading
+ *  instead of taking the infos lock, so they do not wait behind load tasks and handle drops. Almost every
+ *  path maps to a single type, so a path keeps a flat vector that is scanned instead of a hash map. */
+struct AssetPathIndex {
+   public:
+    /** @brief Ids of every asset type stored under `path`. */
+    std::vector<UntypedAssetId> ids(const AssetPath& path) const;
+    /** @brief Id of the asset of `type` stored under `path`. */
+    std::optional<UntypedAssetId> find(const AssetPath& path, epix::meta::type_index type) const;
+    /** @brief Type of the only asset stored under `path`, or nullopt if there are none or several. */
+    std::optional<epix::meta::type_index> single_type(const AssetPath& path) const;
+    void insert(const AssetPath& path, epix::meta::type_index type, const UntypedAssetId& id);
+    void erase(const AssetPath& path, epix::meta::type_index type);
+
+   private:
+    static constexpr std::size_t k_shards = 16;
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        std::unordered_map<AssetPath, std::vector<std::pair<epix::meta::type_index, UntypedAssetId>>> ids;
+    };
+    const Shard& shard(const AssetPath& path) const;
+    Shard& shard(const AssetPath& path) { return const_cast<Shard&>(std::as_const(*this).shard(path)); }
+
+    std::array<Shard, k_shards> m_shards;
 };
 
 /** @brief Error variants for GetOrCreateHandleInternalError.
@@ -74,8 +132,9 @@ enum class HandleLoadingMode {
 };
 
 struct AssetInfos {
-    std::unordered_map<AssetPath, std::unordered_map<epix::meta::type_index, UntypedAssetId>> path_to_ids;
-    std::unordered_map<UntypedAssetId, AssetInfo> infos;
+    /// Ids per path, one per asset type. Shared with AssetServerData, which reads it without this lock.
+    std::shared_ptr<AssetPathIndex> paths = std::make_shared<AssetPathIndex>();
+    AssetInfoSlots infos;
     std::unordered_map<epix::meta::type_index, std::shared_ptr<HandleProvider>> handle_providers;
 
     std::unordered_map<epix::meta::type_index, void (*)(epix::core::World&, AssetIndex)> dependency_loaded_event_sender;
@@ -84,7 +143,6 @@ struct AssetInfos {
 
     std::unordered_map<UntypedAssetId, std::variant<std::packaged_task<void()>, std::shared_future<void>>>
         pending_tasks;
-    AssetServerStats stats;
     bool watching_for_changes = false;
     /// Monotonically increasing counter; incremented each time an AssetInfo entry is created or removed.
     /// Matches bevy_asset's AssetInfos::infos_generation.
@@ -130,10 +188,16 @@ struct AssetInfos {
                                        HandleLoadingMode loading_mode,
                                        std::optional<MetaTransform> meta_transform = std::nullopt)
         -> std::expected<std::pair<UntypedHandle, bool>, GetOrCreateHandleInternalError>;
+    /** @brief The handle get_or_create_handle would return when it changes nothing: the path has a live
+     *  handle of `type` and `loading_mode` starts no load for it. Needs only the read lock, so repeated
+     *  loads of a path do not queue behind the write lock; nullopt means get_or_create_handle is needed. */
+    std::optional<UntypedHandle> get_existing_handle(const AssetPath& path,
+                                                     std::optional<epix::meta::type_index> type,
+                                                     HandleLoadingMode loading_mode) const;
     bool contains_key(const UntypedAssetId& id) const { return infos.contains(id); }
     std::optional<std::reference_wrapper<const AssetInfo>> get_info(const UntypedAssetId& id) const;
     std::optional<std::reference_wrapper<AssetInfo>> get_info_mut(const UntypedAssetId& id);
-    epix::utils::input_iterable<UntypedAssetId> get_path_ids(const AssetPath& path) const;
+    std::vector<UntypedAssetId> get_path_ids(const AssetPath& path) const { return paths->ids(path); }
     std::optional<UntypedHandle> get_handle_by_id(const UntypedAssetId& id) const;
     auto get_handles_by_path(const AssetPath& path) const {
         return get_path_ids(path) |
@@ -144,13 +208,22 @@ struct AssetInfos {
     auto get_handle_by_path_type(const AssetPath& path, epix::meta::type_index type) const
         -> std::optional<UntypedHandle>;
     bool is_path_alive(const AssetPath& path) const;
+    /** @brief Check if a strong handle to `id` is still alive, without taking a new one. */
+    bool is_handle_alive(const UntypedAssetId& id) const {
+        auto info = infos.find(id);
+        return info && !info->weak_handle.expired();
+    }
     bool should_reload(const AssetPath& path) const;
-    /** @brief Returns `true` if the asset should be removed from collection. */
+    /** @brief Returns `true` if the asset should be removed from collection: it is not managed by
+     *  the server, or no handle to it was handed out again since its last one was dropped. */
     bool process_handle_destruction(const UntypedAssetId& id);
     void process_asset_load(const UntypedAssetId& loaded_asset_id,
                             ErasedLoadedAsset loaded_asset,
                             epix::core::World& world,
                             const epix::utils::Sender<InternalAssetEvent>& event_sender);
+    /** @brief Insert a preliminary asset of a load in progress, leaving its load state as is.
+     *  @return False if the asset is not loading, then nothing is inserted. */
+    bool process_partial_asset_load(const UntypedAssetId& id, ErasedLoadedAsset partial, epix::core::World& world);
     void propagate_loaded_state(UntypedAssetId loaded_asset_id,
                                 UntypedAssetId waiting_id,
                                 const epix::utils::Sender<InternalAssetEvent>& sender);
@@ -183,15 +256,6 @@ std::pair<Handle<T>, bool> AssetInfos::get_or_create_handle(const AssetPath& pat
 }
 auto AssetInfos::get_handle_by_path_type(const AssetPath& path, epix::meta::type_index type) const
     -> std::optional<UntypedHandle> {
-    auto it = path_to_ids.find(path);
-    if (it != path_to_ids.end()) {
-        auto& type_map = it->second;
-        auto type_it   = type_map.find(type);
-        if (type_it != type_map.end()) {
-            auto id = type_it->second;
-            return get_handle_by_id(id);
-        }
-    }
-    return std::nullopt;
+    return paths->find(path, type).and_then([this](const UntypedAssetId& id) { return get_handle_by_id(id); });
 }
 }  // namespace epix::assets
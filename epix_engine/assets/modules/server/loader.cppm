@@ -133,7 +133,7 @@ struct AssetContainerImpl : AssetContainer {
     meta::type_index type() const override { return meta::type_id<T>{}; }
     void insert(const UntypedAssetId& id, core::World& world) override {
         auto&& assets                       = world.resource_mut<Assets<T>>();
-        [[maybe_unused]] auto insert_result = assets.insert(id.typed<T>(), std::move(asset));
+        [[maybe_unused]] auto insert_result = assets.insert_loaded(id.typed<T>(), std::move(asset));
     }
     void visit_dependencies(utils::function_ref<void(UntypedAssetId)> visit) const override {
         if constexpr (VisitAssetDependencies<T>) {
@@ -385,6 +385,8 @@ namespace internal_asset_event {
 struct Loaded {
     UntypedAssetId id;
     ErasedLoadedAsset asset;
+    /** @brief Short name of the loader that produced the asset, empty for assets added directly. */
+    std::string_view loader = {};
 };
 struct LoadedWithDeps {
     UntypedAssetId id;
@@ -394,9 +396,20 @@ struct Failed {
     AssetPath path;
     AssetLoadError error;
 };
+/** @brief An asset delivered by a loader that is still running, see LoadContext::publish_labeled_asset. */
+struct Published {
+    UntypedAssetId id;
+    ErasedLoadedAsset asset;
+    /** @brief A preliminary root asset, inserted without changing the load state. */
+    bool partial = false;
+    /** @brief Keeps a published labeled asset alive until it is handled. */
+    std::optional<UntypedHandle> handle;
+};
 }  // namespace internal_asset_event
-using InternalAssetEvent =
-    std::variant<internal_asset_event::Loaded, internal_asset_event::LoadedWithDeps, internal_asset_event::Failed>;
+using InternalAssetEvent = std::variant<internal_asset_event::Loaded,
+                                        internal_asset_event::LoadedWithDeps,
+                                        internal_asset_event::Failed,
+                                        internal_asset_event::Published>;
 
 /** @brief A builder for performing nested asset loads within a LoadContext.
  *  Matches bevy_asset's NestedLoader. */
@@ -412,7 +425,13 @@ export struct LoadContext {
     /// When false, NestedLoader::load() only reserves a handle without scheduling a load task.
     /// Matches bevy_asset's LoadContext::should_load_dependencies.
     bool m_should_load_dependencies = true;
+    /// Id of the asset this load delivers to the world. Set by the server for the loads it starts, the
+    /// only loads whose published assets reach the world before the load finishes.
+    std::optional<UntypedAssetId> m_streaming_id;
+    /// Labels already delivered through publish_labeled_asset, with their handles.
+    std::unordered_map<std::string, UntypedHandle> m_published_assets;
 
+    friend struct AssetServer;
     friend struct NestedLoader;
     template <typename>
     friend struct ErasedAssetLoaderImpl;
@@ -438,8 +457,14 @@ export struct LoadContext {
      *  Matches bevy_asset's LoadContext::should_load_dependencies field. */
     void set_should_load_dependencies(bool v) { m_should_load_dependencies = v; }
 
-    /** @brief Check whether a labeled asset with the given label exists. */
-    bool has_labeled_asset(const std::string& label) const { return m_labeled_assets.contains(label); }
+    /** @brief Check whether a labeled asset with the given label exists, added or published. */
+    bool has_labeled_asset(const std::string& label) const {
+        return m_labeled_assets.contains(label) || m_published_assets.contains(label);
+    }
+
+    /** @brief Check whether published assets reach the world before this load finishes.
+     *  True for loads started by the AssetServer, false for direct loads and for processing. */
+    bool is_streaming() const { return m_streaming_id.has_value(); }
 
     /** @brief Get a labeled sub-asset by label. */
     std::optional<std::reference_wrapper<const ErasedLoadedAsset>> get_labeled(const std::string& label) const {
@@ -462,6 +487,29 @@ export struct LoadContext {
     template <Asset A>
     Handle<A> add_loaded_labeled_asset(const std::string& label, LoadedAsset<A> loaded);
 
+    /** @brief Add a labeled asset and deliver it to `Assets<A>` now instead of with the root asset.
+     *
+     *  The labeled handle becomes Loaded, and a LabeledAssetPublishedEvent is sent, in the next
+     *  `handle_internal_events`, while the loader keeps running. Publishing a label again replaces
+     *  its asset, so a sub-asset can be refined progressively. Published assets stay when the load
+     *  later fails. Never blocks: while the server holds `max_published_assets` published assets it
+     *  has not handled yet, the asset is kept and arrives with the root asset, as with add_labeled_asset.
+     *  Acts as add_labeled_asset when the load is not streaming, see is_streaming.
+     *  @return A handle to the labeled asset. */
+    template <Asset A>
+    Handle<A> publish_labeled_asset(const std::string& label, A asset);
+
+    /** @brief Deliver a preliminary version of the root asset, e.g. an image holding its smallest mips.
+     *
+     *  The asset is inserted into `Assets<A>` without changing the load state; the value passed to
+     *  `finish` replaces it and makes the asset Loaded. Reloads publish over the previous asset too.
+     *  Never blocks: the asset is dropped while the server holds `max_published_assets` unhandled
+     *  published assets, since the final value replaces it anyway.
+     *  @return False if the load is not streaming, A is not the type of the root asset or the asset was
+     *  dropped. */
+    template <Asset A>
+    bool publish_partial(A asset);
+
     /** @brief Get a nested loader for loading sub-assets from within this load.
      *  Matches bevy_asset's LoadContext::loader(). */
     NestedLoader loader();
@@ -558,6 +606,16 @@ concept AssetLoader = requires(const T& t, std::istream& stream, LoadContext& co
     } -> std::same_as<std::expected<typename T::Asset, typename T::Error>>;
     { asset_loader_error_to_exception(std::declval<const typename T::Error&>()) } -> std::same_as<std::exception_ptr>;
 };
+/** @brief Concept for an asset loader that can also decode directly from an in-memory byte span.
+ *  The server prefers this overload when the reader can provide a zero-copy view (see
+ *  `AssetReader::read_bytes_view`), skipping the stream copy entirely. */
+export template <typename T>
+concept AssetBytesLoader =
+    AssetLoader<T> && requires(const T& t, std::span<const std::byte> bytes, LoadContext& context) {
+        {
+            t.load(bytes, std::declval<const typename T::Settings&>(), context)
+        } -> std::same_as<std::expected<typename T::Asset, typename T::Error>>;
+    };
 export struct ErasedAssetLoader {
     virtual ~ErasedAssetLoader()                           = default;
     virtual std::span<std::string_view> extensions() const = 0;
@@ -584,6 +642,11 @@ export struct ErasedAssetLoader {
     virtual std::expected<ErasedLoadedAsset, std::exception_ptr> load(std::istream& stream,
                                                                       const Settings& settings,
                                                                       LoadContext& context) const = 0;
+    /** @brief Load from an in-memory byte span. Loaders without a span overload read it through a
+     *  non-owning stream, so the bytes are still not copied before decoding. */
+    virtual std::expected<ErasedLoadedAsset, std::exception_ptr> load(std::span<const std::byte> bytes,
+                                                                      const Settings& settings,
+                                                                      LoadContext& context) const = 0;
 };
 template <typename T>
 struct ErasedAssetLoaderImpl : T, ErasedAssetLoader {
@@ -616,12 +679,31 @@ struct ErasedAssetLoaderImpl : T, ErasedAssetLoader {
     std::expected<ErasedLoadedAsset, std::exception_ptr> load(std::istream& stream,
                                                               const Settings& settings,
                                                               LoadContext& context) const override {
+        return load_impl(stream, settings, context);
+    }
+    std::expected<ErasedLoadedAsset, std::exception_ptr> load(std::span<const std::byte> bytes,
+                                                              const Settings& settings,
+                                                              LoadContext& context) const override {
+        if constexpr (AssetBytesLoader<T>) {
+            return load_impl(bytes, settings, context);
+        } else {
+            std::ispanstream stream(
+                std::span<const char>(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+            return load_impl(static_cast<std::istream&>(stream), settings, context);
+        }
+    }
+
+   private:
+    template <typename Input>
+    std::expected<ErasedLoadedAsset, std::exception_ptr> load_impl(Input&& input,
+                                                                   const Settings& settings,
+                                                                   LoadContext& context) const {
         try {
             auto* settings_ptr = dynamic_cast<const SettingsImpl<typename T::Settings>*>(&settings);
             if (!settings_ptr) {
                 throw std::runtime_error("Invalid settings type for loader " + std::string(loader_type().short_name()));
             }
-            auto loaded_asset = as_concrete().load(stream, settings_ptr->value, context);
+            auto loaded_asset = as_concrete().load(std::forward<Input>(input), settings_ptr->value, context);
             if (!loaded_asset) {
                 return std::unexpected(asset_loader_error_to_exception(loaded_asset.error()));
             }
@@ -9,6 +9,7 @@ import epix.meta;
 import epix.utils;
 
 import :server.info;
+import :server.diagnostics;
 import :server.loader;
 import :server.loaders;
 
@@ -23,8 +24,87 @@ export enum class AssetServerMode {
     Processed,   /**< Assets go through a processing pipeline before use. */
 };
 
+/** @brief Priority class of an asset load. Queued loads start in class order, and in request order
+ *  within a class. */
+export enum class LoadPriority : std::uint8_t {
+    Visible,    /**< Needed now, e.g. on screen. The default for loads outside of a loader. */
+    Nearby,     /**< Likely needed soon. */
+    Prefetch,   /**< Speculatively loaded ahead of need. */
+    Background, /**< Loaded only when nothing more urgent is waiting. */
+};
+
+/** @brief Loads waiting for an IO slot, ordered by priority.
+ *
+ *  The queue holds asset ids, not handles: a queued load does not keep its asset alive, and a load
+ *  whose handles are all dropped before it starts is discarded. A slot is held from the start of a
+ *  load until its bytes have been read, so the cap bounds the IO in flight, not the decoding. */
+struct LoadQueue {
+    struct Load {
+        UntypedAssetId id;
+        AssetPath path;
+        LoadPriority priority;
+        std::chrono::steady_clock::time_point queued_at;
+    };
+
+   private:
+    struct Entry {
+        AssetPath path;
+        LoadPriority priority;
+        std::uint64_t sequence;
+        std::chrono::steady_clock::time_point queued_at;
+    };
+    mutable std::mutex m_mutex;
+    std::map<std::pair<LoadPriority, std::uint64_t>, UntypedAssetId> m_order;
+    std::unordered_map<UntypedAssetId, Entry> m_entries;
+    std::uint64_t m_next_sequence = 0;
+    std::size_t m_in_flight       = 0;
+    std::size_t m_max_in_flight   = std::max<std::size_t>(16, 4 * std::thread::hardware_concurrency());
+
+   public:
+    /** @brief Queue a load. A load already queued for `id` keeps its place and takes the higher priority. */
+    void push(const UntypedAssetId& id, AssetPath path, LoadPriority priority);
+    /** @brief Take the most urgent load and a slot for it, if a slot is free. */
+    std::optional<Load> pop();
+    /** @brief Release the slot taken by `pop`. */
+    void release();
+    /** @brief Move a queued load to another priority class, behind the loads already in it.
+     *  @param only_raise Leave the load where it is if `priority` is not more urgent.
+     *  @return False if no load is queued for `id`. */
+    bool set_priority(const UntypedAssetId& id, LoadPriority priority, bool only_raise = false);
+    /** @brief Drop the queued load of `id`, if any. */
+    bool cancel(const UntypedAssetId& id);
+    void set_max_in_flight(std::size_t max);
+    std::size_t size() const;
+};
+
+/** @brief Bounds the assets published by running loaders that `handle_internal_events` has not handled
+ *  yet. Taking a slot never waits: loaders run on task pool threads, and a loader parked until the next
+ *  frame would stall anything waiting for the pool to drain before running that frame. */
+struct PublishedAssetSlots {
+   private:
+    std::mutex m_mutex;
+    std::size_t m_in_flight     = 0;
+    std::size_t m_max_in_flight = 256;
+
+   public:
+    /** @brief Take a slot if one is free.
+     *  @return False if every slot is taken. */
+    bool try_acquire();
+    /** @brief Release a slot taken by `acquire`. */
+    void release();
+    /** @brief Set the number of slots. Zero removes the limit. */
+    void set_max_in_flight(std::size_t max);
+    std::size_t in_flight();
+};
+
 struct AssetServerData {
     utils::RwLock<AssetInfos> infos;
+    /// The path index of `infos`, for path queries that do not need the infos lock.
+    std::shared_ptr<const AssetPathIndex> path_index = infos.read()->paths;
+    AssetServerStats stats;
+    AssetLoadRecorder load_recorder;
+    LoadQueue load_queue;
+    PublishedAssetSlots published_slots;
     std::shared_ptr<utils::RwLock<AssetLoaders>> loaders;
     utils::Sender<InternalAssetEvent> asset_event_sender;
     utils::Receiver<InternalAssetEvent> asset_event_receiver;
@@ -52,6 +132,7 @@ export struct AssetServer {
     std::shared_ptr<AssetServerData> data;
 
     friend struct AssetProcessor;
+    friend struct LoadContext;
 
    public:
     AssetServer()                              = default;
@@ -128,10 +209,13 @@ export struct AssetServer {
     // ---- Loading (typed) ----
 
     /** @brief Load an asset from a path. Returns a handle immediately; loading happens asynchronously.
-     *  If the asset is already loaded or loading, returns the existing handle. */
+     *  If the asset is already loaded or loading, returns the existing handle.
+     *  @param priority Priority class of the load. Unset, it is the priority of the load running the
+     *  calling loader, or Visible outside of a loader. A higher priority given for an asset that is
+     *  still queued moves it up. */
     template <typename A>
-    Handle<A> load(const AssetPath& path) const {
-        return load_with_meta_transform<A>(path, std::nullopt, false);
+    Handle<A> load(const AssetPath& path, std::optional<LoadPriority> priority = std::nullopt) const {
+        return load_with_meta_transform<A>(path, std::nullopt, false, false, priority);
     }
     /** @brief Load an asset, overriding any existing load for that path (force reload). */
     template <typename A>
@@ -145,8 +229,11 @@ export struct AssetServer {
      *  @param path     Asset path.
      *  @param settings Function that mutates the loader settings. */
     template <typename A, typename S>
-    Handle<A> load_with_settings(const AssetPath& path, std::function<void(S&)> settings) const {
-        return load_with_meta_transform<A>(path, loader_settings_meta_transform<S>(std::move(settings)), false);
+    Handle<A> load_with_settings(const AssetPath& path,
+                                 std::function<void(S&)> settings,
+                                 std::optional<LoadPriority> priority = std::nullopt) const {
+        return load_with_meta_transform<A>(path, loader_settings_meta_transform<S>(std::move(settings)), false, false,
+                                           priority);
     }
 
     /** @brief Load an asset with settings, overriding any existing load (force). */
@@ -163,7 +250,8 @@ export struct AssetServer {
     Handle<A> load_with_meta_transform(const AssetPath& path,
                                        std::optional<MetaTransform> meta_transform,
                                        bool force,
-                                       bool override_unapproved = false) const {
+                                       bool override_unapproved             = false,
+                                       std::optional<LoadPriority> priority = std::nullopt) const {
         // Enforce UnapprovedPathMode when not overriding
         if (!override_unapproved && path.is_unapproved()) {
             if (data->unapproved_path_mode == UnapprovedPathMode::Forbid) {
@@ -173,11 +261,17 @@ export struct AssetServer {
                 return Handle<A>(AssetId<A>::invalid());
             }
         }
-        auto mode                  = force ? HandleLoadingMode::Force : HandleLoadingMode::Request;
+        auto mode = force ? HandleLoadingMode::Force : HandleLoadingMode::Request;
+        if (auto existing = data->infos.read()->get_existing_handle(path, meta::type_id<A>{}, mode)) {
+            if (priority) raise_load_priority(existing->id(), *priority);
+            return existing->template typed<A>();
+        }
         auto guard                 = data->infos.write();
         auto [handle, should_load] = guard->template get_or_create_handle<A>(path, mode, std::move(meta_transform));
         if (should_load) {
-            spawn_load_task(handle.untyped(), path, *guard);
+            spawn_load_task(handle.untyped(), path, *guard, priority);
+        } else if (priority) {
+            raise_load_priority(handle.id(), *priority);
         }
         return handle;
     }
@@ -185,10 +279,39 @@ export struct AssetServer {
     // ---- Loading (untyped) ----
 
     /** @brief Load an asset by path, using the registered loader's type inferred from extension. */
-    UntypedHandle load_untyped(const AssetPath& path) const;
+    UntypedHandle load_untyped(const AssetPath& path, std::optional<LoadPriority> priority = std::nullopt) const;
 
     /** @brief Load an asset by explicit type id and path. */
-    UntypedHandle load_erased(meta::type_index type_id, const AssetPath& path) const;
+    UntypedHandle load_erased(meta::type_index type_id,
+                              const AssetPath& path,
+                              std::optional<LoadPriority> priority = std::nullopt) const;
+
+    // ---- Load Scheduling ----
+
+    /** @brief Move the queued load of an asset to another priority class.
+     *  @return False if the load is not queued: it already started, finished or was cancelled. */
+    bool set_load_priority(const UntypedAssetId& id, LoadPriority priority) const;
+    /** @brief Set how many loads may read at once. Loads beyond it wait in the priority queue. */
+    void set_max_loads_in_flight(std::size_t max) const;
+    /** @brief Get the number of loads waiting for a slot. */
+    std::size_t queued_loads() const;
+    /** @brief Set how many assets published by running loaders may wait for `handle_internal_events`.
+     *  Labeled assets published beyond it arrive with the root asset instead, and partial root assets
+     *  are dropped; the loader never waits. Zero removes the limit. */
+    void set_max_published_assets(std::size_t max) const;
+    /** @brief Get the number of published assets not handled yet. */
+    std::size_t pending_published_assets() const;
+
+    // ---- Diagnostics ----
+
+    /** @brief Get load counters, queue depths and the load stage histograms. The read rate and the
+     *  processor timings are left empty; `publish_asset_server_diagnostics` fills them in. */
+    AssetServerDiagnostics diagnostics() const;
+    /** @brief Start recording load stages for a Chrome trace, discarding any recorded so far. */
+    void start_chrome_trace() const;
+    /** @brief Stop recording and get the recorded load stages as Chrome trace JSON, to open in
+     *  chrome://tracing or Perfetto. Empty if no trace was started. */
+    std::string take_chrome_trace() const;
 
     // ---- Folder Loading ----
 
@@ -307,6 +430,10 @@ export struct AssetServer {
      *  Matches bevy_asset's AssetServer::get_or_create_path_handle. */
     template <typename A>
     Handle<A> get_or_create_path_handle(const AssetPath& path, std::optional<MetaTransform> meta_transform) const {
+        if (auto existing =
+                data->infos.read()->get_existing_handle(path, meta::type_id<A>{}, HandleLoadingMode::NotLoading)) {
+            return existing->template typed<A>();
+        }
         return data->infos.write()
             ->template get_or_create_handle<A>(path, HandleLoadingMode::NotLoading, std::move(meta_transform))
             .first;
@@ -448,25 +575,56 @@ export struct AssetServer {
     /** @brief Process handle destruction across the info table.
      *  @return true if the asset should be removed from its collection. */
     bool process_handle_destruction(const UntypedAssetId& id) const;
+    /** @brief Check that a loaded asset can be evicted from its collection and loaded again on its own,
+     *  and if so set its load state back to NotLoaded. Labeled assets and assets with living labeled
+     *  assets are refused: loading them again would replace their siblings too.
+     *  @return true if the asset may be evicted. */
+    bool evict_loaded(const UntypedAssetId& id) const;
+    /** @brief Queue the load of an evicted asset, with the settings its handle was loaded with.
+     *  Does nothing if the asset is no longer NotLoaded, e.g. because it was loaded again by path. */
+    void load_evicted(const UntypedAssetId& id) const;
 
     /** @brief Process internal asset events (called from system). */
     static void handle_internal_events(core::ParamSet<core::World&, core::Res<AssetServer>> params);
 
    private:
-    /** @brief Spawn an IO task to load an asset. Takes the handle (which carries meta_transform)
+    /** @brief Queue the load of an asset. Takes the handle (which carries meta_transform)
      *  and the infos write guard for pending_tasks tracking.
      *  Matches bevy_asset's AssetServer::spawn_load_task. */
-    void spawn_load_task(const UntypedHandle& handle, const AssetPath& path, AssetInfos& infos) const;
-    /** @brief Overload without infos guard, for reload path. */
-    void spawn_load_task(const UntypedHandle& handle, const AssetPath& path) const;
+    void spawn_load_task(const UntypedHandle& handle,
+                         const AssetPath& path,
+                         AssetInfos& infos,
+                         std::optional<LoadPriority> priority = std::nullopt) const;
+    /** @brief Overload without infos guard. Queueing the load needs no infos lock. */
+    void spawn_load_task(const UntypedHandle& handle,
+                         const AssetPath& path,
+                         std::optional<LoadPriority> priority = std::nullopt) const;
+    /** @brief Start queued loads on the IOTaskPool while slots are free. */
+    void start_queued_loads() const;
+    /** @brief Move a queued load up to `priority`, never down. */
+    void raise_load_priority(const UntypedAssetId& id, LoadPriority priority) const;
+    /** @brief Check whether every handle of a load's asset was dropped, so the load can stop. */
+    bool load_cancelled(const UntypedAssetId& id) const;
+    /** @brief Send an asset published by a running load if a published slot is free, moving it out of
+     *  `event`.
+     *  @return False if every slot is taken; `event` is left untouched then. */
+    bool try_publish_asset(internal_asset_event::Published& event) const;
     void load_folder_internal(const UntypedAssetId& id, const AssetPath& path) const;
 
     /** @brief Core loading pipeline: read meta, pick loader, load asset, send event.
-     *  Matches bevy_asset's AssetServer::load_internal. */
+     *  With an input handle, only the handle passed in is held until the read starts: the load stops
+     *  between stages once every handle to the asset is dropped.
+     *  Matches bevy_asset's AssetServer::load_internal.
+     *  @param load_slot Released once the asset bytes are read, or when the load stops before that.
+     *  @param priority Priority inherited by the loads the loader starts.
+     *  @param queued_at When the load entered the load queue, for its queue wait. */
     void load_internal(std::optional<UntypedHandle> input_handle,
                        AssetPath path,
                        bool force,
-                       std::optional<MetaTransform> meta_transform) const;
+                       std::optional<MetaTransform> meta_transform,
+                       std::shared_ptr<void> load_slot                                = nullptr,
+                       LoadPriority priority                                          = LoadPriority::Visible,
+                       std::optional<std::chrono::steady_clock::time_point> queued_at = std::nullopt) const;
 
     /** @brief Get the meta, loader, and a reader stream for an asset path.
      *  Matches bevy_asset's AssetServer::get_meta_loader_and_reader.
@@ -474,11 +632,18 @@ export struct AssetServer {
     struct MetaLoaderReader {
         std::unique_ptr<AssetMetaDyn> meta;
         std::shared_ptr<ErasedAssetLoader> loader;
+        /// The source reader the asset is read from, owned by the server's sources.
+        const AssetReader* source_reader;
+        /// Null when the reader provided a zero-copy byte view in `bytes`, or when not opened.
         std::unique_ptr<std::istream> reader;
+        std::optional<AssetBytes> bytes;
     };
+    /** @param open_reader When false, only the meta and loader are resolved and neither `reader` nor
+     *  `bytes` is set, for callers that read through `source_reader` themselves. */
     std::optional<MetaLoaderReader> get_meta_loader_and_reader(const AssetPath& asset_path,
                                                                std::optional<meta::type_index> asset_type_id,
-                                                               std::optional<AssetLoadError>& out_error) const;
+                                                               std::optional<AssetLoadError>& out_error,
+                                                               bool open_reader = true) const;
 
     /** @brief Run loader and return ErasedLoadedAsset, catching panics (exceptions).
      *  Matches bevy_asset's AssetServer::load_with_settings_loader_and_reader. */
@@ -487,6 +652,20 @@ export struct AssetServer {
         const Settings& settings,
         const ErasedAssetLoader& loader,
         std::istream& reader) const;
+    /** @brief Run loader on an in-memory byte view of the asset. */
+    std::expected<ErasedLoadedAsset, AssetLoadError> load_with_settings_loader_and_reader(
+        const AssetPath& asset_path,
+        const Settings& settings,
+        const ErasedAssetLoader& loader,
+        std::span<const std::byte> bytes) const;
+    /** @brief Run loader on whichever input `get_meta_loader_and_reader` produced. */
+    std::expected<ErasedLoadedAsset, AssetLoadError> load_with_settings_loader_and_reader(
+        const AssetPath& asset_path, const Settings& settings, const MetaLoaderReader& input) const {
+        if (input.bytes) {
+            return load_with_settings_loader_and_reader(asset_path, settings, *input.loader, input.bytes->bytes());
+        }
+        return load_with_settings_loader_and_reader(asset_path, settings, *input.loader, *input.reader);
+    }
 
     /** @brief Spawn a task that calls load_internal for each existing handle to the path.
      *  Matches bevy_asset's AssetServer::reload_internal. */
@@ -494,6 +673,11 @@ export struct AssetServer {
 
     /** @brief Send an internal asset event. */
     void send_asset_event(InternalAssetEvent event) const { data->asset_event_sender.send(std::move(event)); }
+    /** @brief Send the Loaded or Failed event ending a load task. */
+    void send_load_result(InternalAssetEvent event) const {
+        data->stats.finished_load_tasks++;
+        send_asset_event(std::move(event));
+    }
 
     /** @brief Helper to create a LoadContext. Defined here in the module interface
      *  where AssetServer is complete, working around MSVC C++20 modules bug
@@ -548,4 +732,54 @@ std::expected<LoadedAsset<A>, AssetLoadError> LoadContext::load_direct_with_read
     return std::move(*down);
 }
 
+template <Asset A>
+Handle<A> LoadContext::add_labeled_asset(const std::string& label, A asset) {
+    auto handle = m_server.template get_or_create_path_handle<A>(m_path.with_label(label), std::nullopt);
+    m_labeled_assets.insert_or_assign(label, LabeledAsset{ErasedLoadedAsset::from_asset(std::move(asset)), handle});
+    return handle;
+}
+
+template <Asset A>
+Handle<A> LoadContext::add_loaded_labeled_asset(const std::string& label, LoadedAsset<A> loaded) {
+    auto handle = m_server.template get_or_create_path_handle<A>(m_path.with_label(label), std::nullopt);
+    ErasedLoadedAsset erased{std::make_unique<AssetContainerImpl<A>>(std::move(loaded.value)),
+                             std::move(loaded.dependencies), std::move(loaded.loader_dependencies),
+                             std::move(loaded.labeled_assets)};
+    m_labeled_assets.insert_or_assign(label, LabeledAsset{std::move(erased), handle});
+    return handle;
+}
+
+template <Asset A>
+Handle<A> LoadContext::publish_labeled_asset(const std::string& label, A asset) {
+    if (!m_streaming_id) return add_labeled_asset<A>(label, std::move(asset));
+    auto handle = m_server.template get_or_create_path_handle<A>(m_path.with_label(label), std::nullopt);
+    internal_asset_event::Published event{
+        .id      = handle.id(),
+        .asset   = ErasedLoadedAsset::from_asset(std::move(asset)),
+        .partial = false,
+        .handle  = handle,
+    };
+    if (!m_server.try_publish_asset(event)) {
+        // the world is behind, so the asset waits for the root asset rather than the loader waiting.
+        m_published_assets.erase(label);
+        m_labeled_assets.insert_or_assign(label, LabeledAsset{std::move(event.asset), handle});
+        return handle;
+    }
+    // a label added before is published now rather than delivered again with the root asset.
+    m_labeled_assets.erase(label);
+    m_published_assets.insert_or_assign(label, handle);
+    return handle;
+}
+
+template <Asset A>
+bool LoadContext::publish_partial(A asset) {
+    if (!m_streaming_id || m_streaming_id->type != meta::type_id<A>{}) return false;
+    internal_asset_event::Published event{
+        .id      = *m_streaming_id,
+        .asset   = ErasedLoadedAsset::from_asset(std::move(asset)),
+        .partial = true,
+    };
+    return m_server.try_publish_asset(event);
+}
+
 }  // namespace epix::assets
\ No newline at end of file
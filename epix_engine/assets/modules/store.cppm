@@ -9,6 +9,7 @@ import std;
 import :concepts;
 
 import :handle;
+import :path;
 import epix.utils;
 using epix::utils::visitor;
 
@@ -17,11 +18,38 @@ namespace epix::assets {
 export struct AssetServer;
 
 bool asset_server_process_handle_destruction(const AssetServer& server, const UntypedAssetId& id);
+bool asset_server_evict_loaded(const AssetServer& server, const UntypedAssetId& id);
+void asset_server_load_evicted(const AssetServer& server, const UntypedAssetId& id);
+
+/** @brief Asset types that report the bytes they hold, heap allocations included. */
+export template <typename T>
+concept AssetMemorySize = requires(const T& t) {
+    { t.memory_size() } -> std::convertible_to<std::size_t>;
+};
+
+/** @brief Bytes an asset holds: `memory_size()` if the type reports it, `sizeof(T)` otherwise. */
+export template <typename T>
+std::size_t asset_memory_size(const T& asset) {
+    if constexpr (AssetMemorySize<T>) {
+        return static_cast<std::size_t>(asset.memory_size());
+    } else {
+        return sizeof(T);
+    }
+}
 
 template <typename T>
 struct Entry {
     std::optional<T> asset   = std::nullopt;
     std::uint32_t generation = 0;
+    /** @brief Bytes the asset held when it was last measured. */
+    std::size_t bytes = 0;
+    /** @brief Frame of the last access. Shared readers write it through an atomic_ref. */
+    alignas(std::atomic_ref<std::uint64_t>::required_alignment) mutable std::uint64_t last_access = 0;
+    /** @brief The asset is as the AssetServer loaded it, so it can be dropped and loaded again. */
+    bool evictable = false;
+    /** @brief The asset was evicted. An access sets `reload_requested` through an atomic_ref. */
+    bool evicted                  = false;
+    mutable bool reload_requested = false;
 };
 
 /** @brief Error: the requested slot index exceeds storage bounds. */
@@ -57,6 +85,32 @@ struct AssetStorage {
     // index is not released or recycled.
     std::vector<std::optional<Entry<T>>> m_storage;
     std::uint32_t m_size;
+    std::size_t m_resident_bytes = 0;
+    // access clock, advanced once per frame by Assets<T>::manage_memory.
+    std::uint64_t m_frame = 1;
+    // slots handed out mutably since the last measurement, their size may have changed.
+    std::vector<std::uint32_t> m_mutated;
+    bool m_all_mutated = false;
+
+    void touch(const Entry<T>& entry) const {
+        // shared readers race on the stamp, it is only compared against frames so relaxed is enough.
+        std::atomic_ref last_access(entry.last_access);
+        if (last_access.load(std::memory_order_relaxed) != m_frame) {
+            last_access.store(m_frame, std::memory_order_relaxed);
+        }
+    }
+    void mark_mutated(std::uint32_t slot, Entry<T>& entry) {
+        // a modified asset no longer matches its source, evicting it would lose the change.
+        entry.evictable = false;
+        if (!m_all_mutated) m_mutated.push_back(slot);
+    }
+    void drop_asset(Entry<T>& entry) {
+        m_resident_bytes -= entry.bytes;
+        entry.bytes     = 0;
+        entry.evictable = false;
+        entry.asset.reset();
+        m_size--;
+    }
 
    public:
     AssetStorage() : m_size(0) {}
@@ -69,6 +123,7 @@ struct AssetStorage {
     bool empty() const { return m_size == 0; }
 
     void resize_slots(std::uint32_t new_size) { m_storage.resize(new_size); }
+    std::uint32_t slot_count() const { return static_cast<std::uint32_t>(m_storage.size()); }
 
     std::expected<Entry<T>*, AssetError> get_entry(const AssetIndex& index) {
         if (index.index() >= m_storage.size()) {
@@ -120,8 +175,16 @@ struct AssetStorage {
             return std::unexpected(
                 GenMismatch{index.index(), m_storage[index.index()]->generation, index.generation()});
         }
-        bool res = m_storage[index.index()]->asset.has_value();
-        m_storage[index.index()]->asset.emplace(std::forward<Args>(args)...);
+        auto& entry = *m_storage[index.index()];
+        bool res    = entry.asset.has_value();
+        m_resident_bytes -= entry.bytes;
+        entry.asset.emplace(std::forward<Args>(args)...);
+        entry.bytes            = asset_memory_size(*entry.asset);
+        entry.evictable        = false;
+        entry.evicted          = false;
+        entry.reload_requested = false;
+        entry.last_access      = m_frame;
+        m_resident_bytes += entry.bytes;
         m_size++;
         return res;
     }
@@ -154,8 +217,7 @@ struct AssetStorage {
         return get_entry(index).and_then([this, &index](Entry<T>* entry) -> std::expected<T, AssetError> {
             if (entry->asset.has_value()) {
                 T asset = std::move(entry->asset.value());
-                entry->asset.reset();
-                m_size--;
+                drop_asset(*entry);
                 return std::move(asset);
             } else {
                 return std::unexpected(AssetNotPresent(index));
@@ -175,8 +237,7 @@ struct AssetStorage {
     std::expected<void, AssetError> remove(const AssetIndex& index) {
         return get_entry(index).and_then([this, &index](Entry<T>* entry) -> std::expected<void, AssetError> {
             if (entry->asset.has_value()) {
-                entry->asset.reset();
-                m_size--;
+                drop_asset(*entry);
                 return {};
             } else {
                 return std::unexpected(AssetNotPresent(index));
@@ -197,9 +258,9 @@ struct AssetStorage {
     std::expected<void, AssetError> remove_dereferenced(const AssetIndex& index) {
         return get_entry(index).and_then([this, &index](Entry<T>* entry) -> std::expected<void, AssetError> {
             entry->generation++;
+            entry->evicted = false;
             if (entry->asset.has_value()) {
-                entry->asset.reset();
-                m_size--;
+                drop_asset(*entry);
                 return {};
             } else {
                 return std::unexpected(AssetNotPresent(index));
@@ -209,8 +270,10 @@ struct AssetStorage {
 
     std::expected<std::reference_wrapper<T>, AssetError> try_get_mut(const AssetIndex& index) {
         return get_entry(index).and_then(
-            [&index](Entry<T>* entry) -> std::expected<std::reference_wrapper<T>, AssetError> {
+            [this, &index](Entry<T>* entry) -> std::expected<std::reference_wrapper<T>, AssetError> {
                 if (entry->asset.has_value()) {
+                    touch(*entry);
+                    mark_mutated(index.index(), *entry);
                     return std::ref(entry->asset.value());
                 } else {
                     return std::unexpected(AssetNotPresent(index));
@@ -220,10 +283,12 @@ struct AssetStorage {
 
     std::expected<std::reference_wrapper<const T>, AssetError> try_get(const AssetIndex& index) const {
         return get_entry(index).and_then(
-            [&index](const Entry<T>* entry) -> std::expected<std::reference_wrapper<const T>, AssetError> {
+            [this, &index](const Entry<T>* entry) -> std::expected<std::reference_wrapper<const T>, AssetError> {
                 if (entry->asset.has_value()) {
+                    touch(*entry);
                     return std::cref(entry->asset.value());
                 } else {
+                    if (entry->evicted) std::atomic_ref(entry->reload_requested).store(true, std::memory_order_relaxed);
                     return std::unexpected(AssetNotPresent(index));
                 }
             });
@@ -250,13 +315,84 @@ struct AssetStorage {
     /** @brief Call fn(uint32_t slot_index, uint32_t generation, T& asset) for each valid entry (mutable). */
     template <typename F>
     void for_each_mut(F&& fn) {
+        m_all_mutated = true;
+        m_mutated.clear();
         for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(m_storage.size()); i++) {
             auto& slot = m_storage[i];
             if (slot && slot->asset.has_value()) {
+                slot->evictable = false;
                 fn(i, slot->generation, slot->asset.value());
             }
         }
     }
+
+    /** @brief Bytes held by the stored assets, as last measured. */
+    std::size_t resident_bytes() const { return m_resident_bytes; }
+    /** @brief Current frame of the access clock. */
+    std::uint64_t frame() const { return m_frame; }
+    /** @brief Advance the access clock, assets read from now on count as used in the new frame. */
+    void advance_frame() { m_frame++; }
+
+    /** @brief Mark a stored asset as loaded from its source, which allows evicting it. */
+    void mark_loaded(const AssetIndex& index) {
+        if (auto entry = get_entry(index); entry && (*entry)->asset.has_value()) (*entry)->evictable = true;
+    }
+
+    /** @brief Measure again the assets handed out mutably since the last call. */
+    void measure_mutated() {
+        auto measure = [this](Entry<T>& entry) {
+            if (!entry.asset) return;
+            m_resident_bytes -= entry.bytes;
+            entry.bytes = asset_memory_size(*entry.asset);
+            m_resident_bytes += entry.bytes;
+        };
+        if (m_all_mutated) {
+            for (auto& slot : m_storage) {
+                if (slot) measure(*slot);
+            }
+        } else {
+            std::ranges::sort(m_mutated);
+            m_mutated.erase(std::ranges::unique(m_mutated).begin(), m_mutated.end());
+            for (auto slot : m_mutated) {
+                if (slot < m_storage.size() && m_storage[slot]) measure(*m_storage[slot]);
+            }
+        }
+        m_mutated.clear();
+        m_all_mutated = false;
+    }
+
+    /** @brief Get the evictable assets not used in the current frame, least recently used first. */
+    std::vector<AssetIndex> eviction_candidates() const {
+        std::vector<std::pair<std::uint64_t, AssetIndex>> candidates;
+        for (std::uint32_t i = 0; i < static_cast<std::uint32_t>(m_storage.size()); i++) {
+            auto& slot = m_storage[i];
+            if (!slot || !slot->asset || !slot->evictable) continue;
+            auto last_access = std::atomic_ref(slot->last_access).load(std::memory_order_relaxed);
+            if (last_access < m_frame) candidates.emplace_back(last_access, AssetIndex(i, slot->generation));
+        }
+        std::ranges::stable_sort(candidates, {}, &std::pair<std::uint64_t, AssetIndex>::first);
+        return candidates | std::views::values | std::ranges::to<std::vector>();
+    }
+
+    /** @brief Drop an evictable asset, keeping its slot so an access can ask for it again.
+     *  @return The bytes released, nullopt if the asset is not evictable. */
+    std::optional<std::size_t> evict(const AssetIndex& index) {
+        auto entry = get_entry(index);
+        if (!entry || !(*entry)->asset || !(*entry)->evictable) return std::nullopt;
+        auto bytes = (*entry)->bytes;
+        drop_asset(**entry);
+        (*entry)->evicted          = true;
+        (*entry)->reload_requested = false;
+        return bytes;
+    }
+
+    /** @brief Check an evicted asset.
+     *  @return Whether it was accessed since it was evicted, nullopt once it is no longer evicted. */
+    std::optional<bool> evicted_access(const AssetIndex& index) const {
+        auto entry = get_entry(index);
+        if (!entry || !(*entry)->evicted) return std::nullopt;
+        return std::atomic_ref((*entry)->reload_requested).load(std::memory_order_relaxed);
+    }
 };
 
 /** @brief Lifecycle event for an asset of type T.
@@ -350,17 +486,89 @@ export struct UntypedAssetLoadFailedEvent {
     std::variant<std::string, std::exception_ptr> error;
 };
 
+/** @brief Event fired when a running loader delivers an asset early, see LoadContext::publish_labeled_asset. */
+export struct LabeledAssetPublishedEvent {
+    /** @brief The id of the published asset. */
+    UntypedAssetId id;
+    /** @brief The path of the published asset, with its label unless `partial` is set. */
+    AssetPath path;
+    /** @brief Whether a preliminary root asset was published, see LoadContext::publish_partial. */
+    bool partial = false;
+};
+
+/** @brief Memory held by each registered asset type, reported every frame by `Assets<T>::manage_memory`.
+ *  The per-type systems run in parallel, so reports go through an internal lock. */
+export struct AssetMemoryUsage {
+    /** @brief Memory of one asset type. */
+    struct TypeUsage {
+        /** @brief Short name of the asset type. */
+        std::string_view type_name;
+        /** @brief Bytes held by the stored assets, see asset_memory_size. */
+        std::size_t resident_bytes = 0;
+        /** @brief Memory budget of the type, if any. */
+        std::optional<std::size_t> budget;
+        /** @brief Assets evicted and not loaded again yet. */
+        std::size_t evicted = 0;
+        /** @brief Assets evicted since the collection was created. */
+        std::size_t evictions = 0;
+    };
+
+    /** @brief Record the usage of an asset type, replacing its previous report. */
+    void report(meta::type_index type, TypeUsage usage) const {
+        std::lock_guard lock(m_mutex);
+        m_usage.insert_or_assign(type, usage);
+    }
+    /** @brief Get the last report of an asset type. */
+    std::optional<TypeUsage> get(meta::type_index type) const {
+        std::lock_guard lock(m_mutex);
+        if (auto it = m_usage.find(type); it != m_usage.end()) return it->second;
+        return std::nullopt;
+    }
+    template <typename T>
+    std::optional<TypeUsage> get() const {
+        return get(meta::type_id<T>{});
+    }
+    /** @brief Get the last report of every asset type, largest first. */
+    std::vector<TypeUsage> types() const {
+        std::vector<TypeUsage> usages;
+        {
+            std::lock_guard lock(m_mutex);
+            usages = m_usage | std::views::values | std::ranges::to<std::vector>();
+        }
+        std::ranges::sort(usages, std::ranges::greater{}, &TypeUsage::resident_bytes);
+        return usages;
+    }
+    /** @brief Sum of the resident bytes of every asset type. */
+    std::size_t total_resident_bytes() const {
+        std::lock_guard lock(m_mutex);
+        std::size_t total = 0;
+        for (auto& [_, usage] : m_usage) total += usage.resident_bytes;
+        return total;
+    }
+
+   private:
+    mutable std::mutex m_mutex;
+    mutable std::unordered_map<meta::type_index, TypeUsage> m_usage;
+};
+
 /** @brief Collection that stores and manages assets of type T.
+ *
+ *  Assets loaded by the AssetServer can be kept within a memory budget: the least recently
+ *  accessed of them are evicted under pressure, keeping their handles and slots, and an access
+ *  to an evicted asset has the server load it again. Accesses are stamped per frame, so assets
+ *  read in the current frame are never evicted.
  *  @tparam T The asset type (must satisfy Asset). */
 export template <Asset T>
 struct Assets {
    private:
     AssetStorage<T> m_assets;
-    std::vector<std::uint32_t> m_references;
     std::shared_ptr<HandleProvider> m_handle_provider;
     std::unordered_map<uuids::uuid, T> m_mapped_assets;
     std::unordered_map<uuids::uuid, std::uint32_t> m_mapped_assets_ref;
     std::vector<AssetEvent<T>> m_cached_events;
+    std::optional<std::size_t> m_memory_budget;
+    std::vector<AssetIndex> m_evicted;
+    std::size_t m_evictions = 0;
 
     /**
      * @brief Insert an asset at the given index.
@@ -372,14 +580,7 @@ struct Assets {
     template <typename... Args>
         requires std::constructible_from<T, Args...>
     std::expected<bool, AssetError> insert_index(const AssetIndex& index, Args&&... args) {
-        std::uint32_t storage_size = static_cast<std::uint32_t>(m_references.size());
-        while (auto&& opt = m_handle_provider->index_allocator.reserved_receiver().try_receive()) {
-            storage_size = std::max(storage_size, opt->index() + 1);
-        }
-        if (storage_size > m_references.size()) {
-            m_assets.resize_slots(storage_size);
-            m_references.resize(storage_size, 0);
-        }
+        grow_slots();
         return m_assets.insert(index, std::forward<Args>(args)...)
             .or_else([this](AssetError&& err) -> std::expected<bool, AssetError> {
                 log_asset_error(err, meta::type_id<Assets<T>>::short_name(), "insert_index");
@@ -408,18 +609,17 @@ struct Assets {
         return false;
     }
 
-    bool release_index(const AssetIndex& index) {
-        if (index.index() < m_references.size()) {
-            m_references[index.index()]--;
-            if (m_references[index.index()] == 0) {
-                m_cached_events.emplace_back(AssetEvent<T>::unused(AssetId<T>(index)));
-                m_assets.remove_dereferenced(index).transform(
-                    [&]() { m_cached_events.emplace_back(AssetEvent<T>::removed(AssetId<T>(index))); });
-                m_handle_provider->index_allocator.release(index);
-                return true;
-            }
-        }
-        return false;
+    /** @brief Storage slots follow the indices handed out by the allocator, reserved on any thread. */
+    void grow_slots() {
+        auto slots = m_handle_provider->index_allocator.slot_count();
+        if (slots > m_assets.slot_count()) m_assets.resize_slots(slots);
+    }
+    /** @brief Release an index whose handles are all gone, recycling it. */
+    void release_index(const AssetIndex& index) {
+        m_cached_events.emplace_back(AssetEvent<T>::unused(AssetId<T>(index)));
+        m_assets.remove_dereferenced(index).transform(
+            [&]() { m_cached_events.emplace_back(AssetEvent<T>::removed(AssetId<T>(index))); });
+        m_handle_provider->index_allocator.release(index);
     }
     bool release_uuid(const uuids::uuid& id) {
         if (m_mapped_assets_ref.contains(id)) {
@@ -435,11 +635,6 @@ struct Assets {
         }
         return false;
     }
-    bool release(const AssetId<T>& id) {
-        return std::visit(visitor{[this](const AssetIndex& index) { return release_index(index); },
-                                  [this](const uuids::uuid& id) { return release_uuid(id); }},
-                          id);
-    }
 
    public:
     /** @brief Construct a new Assets collection with its own HandleProvider. */
@@ -466,9 +661,8 @@ struct Assets {
     template <typename... Args>
         requires std::constructible_from<T, Args...>
     Handle<T> emplace(Args&&... args) {
-        Handle<T> handle                                        = m_handle_provider->reserve().typed<T>();
-        auto res                                                = insert(handle, std::forward<Args>(args)...);
-        m_references[std::get<AssetIndex>(handle.id()).index()] = 1;
+        Handle<T> handle = m_handle_provider->reserve().typed<T>();
+        auto res         = insert(handle, std::forward<Args>(args)...);
         return handle;
     }
 
@@ -500,6 +694,20 @@ struct Assets {
             });
     }
 
+    /**
+     * @brief Insert an asset loaded by the AssetServer.
+     *
+     * Unlike `insert`, the asset may be evicted under the memory budget until it is accessed
+     * mutably, since the server can load it again.
+     */
+    template <typename... Args>
+        requires std::constructible_from<T, Args...>
+    std::expected<bool, AssetError> insert_loaded(const AssetId<T>& id, Args&&... args) {
+        auto res = insert(id, std::forward<Args>(args)...);
+        if (auto index = std::get_if<AssetIndex>(&id); res && index) m_assets.mark_loaded(*index);
+        return res;
+    }
+
     /**
      * @brief Check if there is an asset at the given index.
      *
@@ -524,9 +732,8 @@ struct Assets {
      */
     std::expected<Handle<T>, AssetError> get_strong_handle(const AssetId<T>& id) {
         return try_get(id).and_then([this, &id](const T& asset) -> std::expected<Handle<T>, AssetError> {
-            std::visit(visitor{[this](const AssetIndex& index) { m_references[index.index()]++; },
-                               [this](const uuids::uuid& id) { m_mapped_assets_ref.at(id)++; }},
-                       id);
+            // handles to indices count themselves in their slot.
+            if (auto* uuid = std::get_if<uuids::uuid>(&id)) m_mapped_assets_ref.at(*uuid)++;
             return m_handle_provider->get_handle(id, false, std::nullopt);
         });
     }
@@ -653,17 +860,7 @@ struct Assets {
      */
     Handle<T> reserve_handle() {
         Handle<T> handle = m_handle_provider->reserve().template typed<T>();
-        // Ensure storage is large enough
-        auto index                 = std::get<AssetIndex>(handle.id());
-        std::uint32_t storage_size = static_cast<std::uint32_t>(m_references.size());
-        while (auto&& opt = m_handle_provider->index_allocator.reserved_receiver().try_receive()) {
-            storage_size = std::max(storage_size, opt->index() + 1);
-        }
-        if (storage_size > m_references.size()) {
-            m_assets.resize_slots(storage_size);
-            m_references.resize(storage_size, 0);
-        }
-        m_references[index.index()] = 1;
+        grow_slots();
         return handle;
     }
 
@@ -781,20 +978,73 @@ struct Assets {
         }
     }
 
-    /** @brief Process pending handle destruction events manually. */
+    /** @brief Set the memory budget of this collection in bytes, nullopt for no budget. */
+    void set_memory_budget(std::optional<std::size_t> bytes) { m_memory_budget = bytes; }
+    /** @brief Get the memory budget of this collection. */
+    std::optional<std::size_t> memory_budget() const { return m_memory_budget; }
+    /** @brief Bytes held by the assets in this collection, see asset_memory_size. Sizes are measured
+     *  on insert, assets accessed mutably are measured again by `manage_memory_manual`. */
+    std::size_t resident_bytes() const {
+        std::size_t bytes = m_assets.resident_bytes();
+        for (auto& [_, asset] : m_mapped_assets) bytes += asset_memory_size(asset);
+        return bytes;
+    }
+    /** @brief Check if an asset was evicted and not loaded again yet. */
+    bool is_evicted(const AssetId<T>& id) const {
+        auto index = std::get_if<AssetIndex>(&id);
+        return index && m_assets.evicted_access(*index).has_value();
+    }
+    /** @brief Number of evicted assets waiting for an access. */
+    std::size_t evicted_len() const { return m_evicted.size(); }
+
+    /**
+     * @brief Reload evicted assets accessed since the last call, then evict the least recently
+     * used loaded assets while the collection is over its memory budget.
+     *
+     * Evicting an asset sends a Removed event, loading it again sends Added. Ends the frame of
+     * the access clock.
+     */
+    void manage_memory_manual(const AssetServer& asset_server) {
+        m_assets.measure_mutated();
+        std::erase_if(m_evicted, [&](const AssetIndex& index) {
+            auto accessed = m_assets.evicted_access(index);
+            if (!accessed) return true;
+            if (!*accessed) return false;
+            asset_server_load_evicted(asset_server, AssetId<T>(index));
+            return true;
+        });
+        if (auto resident = resident_bytes(); m_memory_budget && resident > *m_memory_budget) {
+            for (auto& index : m_assets.eviction_candidates()) {
+                if (resident <= *m_memory_budget) break;
+                // only assets the server can load again on their own are evicted.
+                if (!asset_server_evict_loaded(asset_server, AssetId<T>(index))) continue;
+                auto bytes = m_assets.evict(index);
+                if (!bytes) continue;
+                resident -= *bytes;
+                m_evicted.push_back(index);
+                m_evictions++;
+                m_cached_events.emplace_back(AssetEvent<T>::removed(AssetId<T>(index)));
+            }
+        }
+        m_assets.advance_frame();
+    }
+
+    /** @brief Release the assets whose strong handles were all dropped since the last call.
+     *  Sweeps the slots marked by dropped handles rather than draining one event per drop. The
+     *  server, if given, gets to keep an asset whose handle it handed out again in the meantime. */
     void handle_events_manual(const AssetServer* asset_server = nullptr) {
         spdlog::trace("[{}] Handling events", meta::type_id<T>::short_name());
-        while (auto&& opt = m_handle_provider->index_allocator.reserved_receiver().try_receive()) {
-            m_assets.resize_slots(opt->index() + 1);
+        grow_slots();
+        for (auto& index : m_handle_provider->index_allocator.take_unreferenced()) {
+            if (asset_server && !asset_server_process_handle_destruction(*asset_server, AssetId<T>(index))) continue;
+            release_index(index);
         }
-        while (auto&& opt = m_handle_provider->event_receiver.try_receive()) {
-            auto id = (*opt).id.template typed<T>();
-            if ((*opt).asset_server_managed && asset_server) {
-                if (!asset_server_process_handle_destruction(*asset_server, id)) {
-                    continue;
-                }
+        for (auto& [uuid, server_managed] : m_handle_provider->take_dropped_uuids()) {
+            if (server_managed && asset_server &&
+                !asset_server_process_handle_destruction(*asset_server, AssetId<T>(uuid))) {
+                continue;
             }
-            release(id);
+            release_uuid(uuid);
         }
         spdlog::trace("[{}] Finished handling events", meta::type_id<T>::short_name());
     }
@@ -806,6 +1056,20 @@ struct Assets {
         assets->handle_events_manual(asset_server.ptr());
     }
 
+    /** @brief System that keeps the collection within its memory budget and reports its usage. */
+    static void manage_memory(core::ResMut<Assets<T>> assets,
+                              core::Res<AssetServer> asset_server,
+                              core::Res<AssetMemoryUsage> usage) {
+        assets->manage_memory_manual(*asset_server);
+        usage->report(meta::type_id<T>{}, AssetMemoryUsage::TypeUsage{
+                                              .type_name      = meta::type_id<T>::short_name(),
+                                              .resident_bytes = assets->resident_bytes(),
+                                              .budget         = assets->m_memory_budget,
+                                              .evicted        = assets->m_evicted.size(),
+                                              .evictions      = assets->m_evictions,
+                                          });
+    }
+
     /** @brief System that flushes cached asset events to the event writer. */
     static void asset_events(core::ResMut<Assets<T>> assets, core::EventWriter<AssetEvent<T>> writer) {
         for (auto&& event : assets->m_cached_events) {
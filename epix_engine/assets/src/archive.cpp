@@ -0,0 +1,273 @@
+module;
+
+#include <spdlog/spdlog.h>
+
+module epix.assets;
+
+import std;
+import epix.utils;
+
+namespace epix::assets {
+// the header and index are read in place from the mapping.
+static_assert(std::endian::native == std::endian::little, "asset archives are little-endian");
+
+std::uint64_t archive_path_hash(std::string_view path) {
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+    for (char c : path) {
+        hash ^= static_cast<std::uint8_t>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::string archive_path(const std::filesystem::path& path) {
+    auto normal = path.lexically_normal().generic_string();
+    if (normal == ".") return {};
+    if (normal.starts_with("./")) normal.erase(0, 2);
+    if (normal.ends_with('/')) normal.pop_back();
+    return normal;
+}
+
+namespace {
+/** @brief Read-only stream over a view, keeping the view's owner alive. */
+struct BytesStreamBuf : std::streambuf {
+    AssetBytes bytes;
+
+    explicit BytesStreamBuf(AssetBytes view) : bytes(std::move(view)) {
+        auto begin = const_cast<char*>(reinterpret_cast<const char*>(bytes.data()));
+        setg(begin, begin, begin + bytes.size());
+    }
+
+   protected:
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in)) return pos_type(off_type(-1));
+        off_type base = dir == std::ios_base::beg   ? 0
+                        : dir == std::ios_base::cur ? gptr() - eback()
+                                                    : egptr() - eback();
+        return seekpos(pos_type(base + off), which);
+    }
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        if (!(which & std::ios_base::in) || pos < 0 || pos > egptr() - eback()) return pos_type(off_type(-1));
+        setg(eback(), eback() + static_cast<off_type>(pos), egptr());
+        return pos;
+    }
+};
+
+struct BytesStream : std::istream {
+    BytesStreamBuf buffer;
+
+    explicit BytesStream(AssetBytes view) : std::istream(nullptr), buffer(std::move(view)) { rdbuf(&buffer); }
+};
+
+std::unique_ptr<std::istream> open_stream(AssetBytes view) { return std::make_unique<BytesStream>(std::move(view)); }
+
+std::unexpected<AssetWriterError> write_failed() {
+    return std::unexpected(AssetWriterError(writer_errors::IoError{std::make_error_code(std::errc::io_error)}));
+}
+
+void collect_asset_paths(const AssetReader& reader,
+                         const std::filesystem::path& path,
+                         std::vector<std::filesystem::path>& paths) {
+    if (auto is_dir = reader.is_directory(path); is_dir && *is_dir) {
+        auto children = reader.read_directory(path);
+        if (!children) return;
+        for (auto child : *children) collect_asset_paths(reader, child, paths);
+    } else if (path.extension() != ".meta") {
+        paths.push_back(path);
+    }
+}
+
+std::uint64_t align_up(std::uint64_t offset, std::uint64_t alignment) {
+    return (offset + alignment - 1) / alignment * alignment;
+}
+}  // namespace
+
+std::expected<std::size_t, AssetWriterError> write_asset_archive(const AssetReader& reader,
+                                                                 const std::filesystem::path& output) {
+    std::vector<std::filesystem::path> paths;
+    collect_asset_paths(reader, "", paths);
+
+    auto temp_path = std::filesystem::path(output).concat(".tmp");
+    std::ofstream file(temp_path, std::ios::binary | std::ios::trunc);
+    if (!file) return write_failed();
+
+    std::uint64_t offset = 0;
+    auto write_at        = [&](std::uint64_t at, std::span<const std::byte> bytes) {
+        static constexpr std::array<char, ARCHIVE_ALIGNMENT> padding{};
+        file.write(padding.data(), static_cast<std::streamsize>(at - offset));
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        offset = at + bytes.size();
+    };
+
+    // header last, once the offsets are known.
+    ArchiveHeader header{};
+    write_at(0, std::as_bytes(std::span(&header, 1)));
+
+    // blobs are streamed one at a time, only the index entries are kept.
+    std::vector<ArchiveEntry> entries;
+    std::string names;
+    entries.reserve(paths.size());
+    for (auto& path : paths) {
+        auto bytes = reader.read_bytes(path);
+        if (!bytes) {
+            spdlog::warn("[assets] Skipping '{}' while packing the archive: cannot read it.", path.string());
+            continue;
+        }
+        auto meta = reader.read_meta_bytes(path).value_or(std::vector<std::byte>{});
+        auto name = archive_path(path);
+
+        ArchiveEntry entry{};
+        entry.path_hash   = archive_path_hash(name);
+        entry.name_offset = static_cast<std::uint32_t>(names.size());
+        entry.name_size   = static_cast<std::uint32_t>(name.size());
+        entry.compression = ArchiveCompression::None;
+        if (auto info = deserialize_processed_info(meta); info && *info) {
+            entry.hash = (*info)->hash;
+        } else {
+            auto chars = std::span(reinterpret_cast<const char*>(bytes->data()), bytes->size());
+            std::ispanstream stream(chars, std::ios::binary);
+            entry.hash = get_asset_hash(meta, stream);
+        }
+        names += name;
+
+        entry.data_offset = align_up(offset, ARCHIVE_ALIGNMENT);
+        entry.data_size   = bytes->size();
+        write_at(entry.data_offset, bytes->bytes());
+        entry.meta_offset = align_up(offset, ARCHIVE_ALIGNMENT);
+        entry.meta_size   = static_cast<std::uint32_t>(meta.size());
+        write_at(entry.meta_offset, meta);
+        entries.push_back(entry);
+    }
+
+    std::ranges::sort(entries, [&](const ArchiveEntry& a, const ArchiveEntry& b) {
+        if (a.path_hash != b.path_hash) return a.path_hash < b.path_hash;
+        return std::string_view(names).substr(a.name_offset, a.name_size) <
+               std::string_view(names).substr(b.name_offset, b.name_size);
+    });
+
+    header.magic        = ARCHIVE_MAGIC;
+    header.version      = ARCHIVE_VERSION;
+    header.entry_count  = entries.size();
+    header.names_offset = offset;
+    header.names_size   = names.size();
+    write_at(offset, std::as_bytes(std::span(names)));
+    header.index_offset = align_up(offset, alignof(ArchiveEntry));
+    write_at(header.index_offset, std::as_bytes(std::span(entries)));
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (!file) return write_failed();
+
+    std::error_code ec;
+    std::filesystem::rename(temp_path, output, ec);
+    if (ec) return std::unexpected(AssetWriterError(writer_errors::IoError{ec}));
+    return entries.size();
+}
+
+ArchiveAssetReader::ArchiveAssetReader(const std::filesystem::path& archive) {
+    // assets are read in any order, read-ahead over the whole archive would only waste memory.
+    auto mapped = map_file(archive, false);
+    if (!mapped) {
+        spdlog::error("[assets] Cannot map asset archive '{}'.", archive.string());
+        return;
+    }
+    auto bytes   = mapped->bytes();
+    auto invalid = [&]() -> std::optional<std::string_view> {
+        if (bytes.size() < sizeof(ArchiveHeader)) return "truncated header";
+        ArchiveHeader header;
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.magic != ARCHIVE_MAGIC) return "bad magic";
+        if (header.version != ARCHIVE_VERSION) return "unsupported version";
+        if (header.index_offset % alignof(ArchiveEntry) != 0 || header.index_offset > bytes.size() ||
+            header.entry_count > (bytes.size() - header.index_offset) / sizeof(ArchiveEntry))
+            return "index out of bounds";
+        if (header.names_offset > bytes.size() || header.names_size > bytes.size() - header.names_offset)
+            return "name table out of bounds";
+
+        // the mapping is page aligned, so the aligned index can be used in place.
+        auto entries   = std::span(reinterpret_cast<const ArchiveEntry*>(bytes.data() + header.index_offset),
+                                   static_cast<std::size_t>(header.entry_count));
+        auto in_bounds = [&](std::uint64_t offset, std::uint64_t size) {
+            return offset <= bytes.size() && size <= bytes.size() - offset;
+        };
+        for (auto& entry : entries) {
+            if (std::uint64_t(entry.name_offset) + entry.name_size > header.names_size ||
+                !in_bounds(entry.data_offset, entry.data_size) || !in_bounds(entry.meta_offset, entry.meta_size))
+                return "entry out of bounds";
+            if (entry.compression != ArchiveCompression::None) return "unsupported compression";
+        }
+        m_names =
+            std::string_view(reinterpret_cast<const char*>(bytes.data() + header.names_offset), header.names_size);
+        m_entries = entries;
+        return std::nullopt;
+    }();
+    if (invalid) {
+        spdlog::error("[assets] Invalid asset archive '{}': {}.", archive.string(), *invalid);
+        m_names   = {};
+        m_entries = {};
+        return;
+    }
+    m_archive = std::move(*mapped);
+}
+
+const ArchiveEntry* ArchiveAssetReader::find(const std::filesystem::path& path) const {
+    auto key  = archive_path(path);
+    auto hash = archive_path_hash(key);
+    for (auto it = std::ranges::lower_bound(m_entries, hash, {}, &ArchiveEntry::path_hash);
+         it != m_entries.end() && it->path_hash == hash; ++it) {
+        if (name(*it) == key) return &*it;
+    }
+    return nullptr;
+}
+
+std::optional<AssetHash> ArchiveAssetReader::asset_hash(const std::filesystem::path& path) const {
+    if (auto entry = find(path)) return entry->hash;
+    return std::nullopt;
+}
+
+std::optional<AssetBytes> ArchiveAssetReader::read_bytes_view(const std::filesystem::path& path) const {
+    if (auto entry = find(path)) return slice(entry->data_offset, entry->data_size);
+    return std::nullopt;
+}
+
+std::expected<std::unique_ptr<std::istream>, AssetReaderError> ArchiveAssetReader::read(
+    const std::filesystem::path& path) const {
+    if (auto entry = find(path)) return open_stream(slice(entry->data_offset, entry->data_size));
+    return std::unexpected(AssetReaderError(reader_errors::NotFound{path}));
+}
+
+std::expected<std::unique_ptr<std::istream>, AssetReaderError> ArchiveAssetReader::read_meta(
+    const std::filesystem::path& path) const {
+    // packed assets without a meta file have an empty meta blob.
+    if (auto entry = find(path); entry && entry->meta_size > 0) {
+        return open_stream(slice(entry->meta_offset, entry->meta_size));
+    }
+    return std::unexpected(AssetReaderError(reader_errors::NotFound{get_meta_path(path)}));
+}
+
+std::expected<utils::input_iterable<std::filesystem::path>, AssetReaderError> ArchiveAssetReader::read_directory(
+    const std::filesystem::path& path) const {
+    auto dir = archive_path(path);
+    if (!is_directory(path).value_or(false)) return std::unexpected(AssetReaderError(reader_errors::NotFound{path}));
+    auto prefix = dir.empty() ? dir : dir + '/';
+    std::set<std::string_view> children;
+    for (auto& entry : m_entries) {
+        auto entry_name = name(entry);
+        if (!entry_name.starts_with(prefix)) continue;
+        // a deeper entry lists the subdirectory it is in.
+        auto slash = entry_name.find('/', prefix.size());
+        children.insert(slash == std::string_view::npos ? entry_name : entry_name.substr(0, slash));
+    }
+    return utils::input_iterable<std::filesystem::path>(children | std::views::transform([](std::string_view child) {
+                                                            return std::filesystem::path(child);
+                                                        }) |
+                                                        std::ranges::to<std::vector>());
+}
+
+std::expected<bool, AssetReaderError> ArchiveAssetReader::is_directory(const std::filesystem::path& path) const {
+    auto dir = archive_path(path);
+    if (dir.empty()) return true;
+    dir += '/';
+    return std::ranges::any_of(m_entries, [&](const ArchiveEntry& entry) { return name(entry).starts_with(dir); });
+}
+}  // namespace epix::assets
@@ -0,0 +1,158 @@
+module;
+
+module epix.assets;
+
+import std;
+import epix.utils;
+
+namespace epix::assets {
+FileStatus disk_file_status(const std::filesystem::path& path) {
+    std::error_code ec;
+    auto status = std::filesystem::status(path, ec);
+    if (ec || !std::filesystem::exists(status)) return {};
+    return FileStatus{.exists = true, .is_directory = std::filesystem::is_directory(status)};
+}
+
+void AssetEventDebouncer::remove_origin(const std::filesystem::path& origin, Clock::time_point now) {
+    if (auto it = m_pending.find(origin); it != m_pending.end() && it->second.kind == Settled::Kind::Added) {
+        it->second.kind        = Settled::Kind::Modified;
+        it->second.last_change = now;
+        return;
+    }
+    m_pending.insert_or_assign(origin, Pending{Settled::Kind::Removed, std::nullopt, now});
+}
+
+void AssetEventDebouncer::push(const RawFileChange& change, Clock::time_point now) {
+    using Kind = Settled::Kind;
+    auto it    = m_pending.find(change.path);
+    switch (change.kind) {
+        case RawFileChange::Kind::Added:
+        case RawFileChange::Kind::Modified: {
+            if (it == m_pending.end()) {
+                auto kind = change.kind == RawFileChange::Kind::Added ? Kind::Added : Kind::Modified;
+                m_pending.emplace(change.path, Pending{kind, std::nullopt, now});
+                break;
+            }
+            // added stays added; a removed path written again, or a renamed one, is modified.
+            if (it->second.kind != Kind::Added) it->second.kind = Kind::Modified;
+            it->second.last_change = now;
+            break;
+        }
+        case RawFileChange::Kind::Removed: {
+            if (it == m_pending.end()) {
+                m_pending.emplace(change.path, Pending{Kind::Removed, std::nullopt, now});
+                break;
+            }
+            auto pending = std::move(it->second);
+            m_pending.erase(it);
+            if (pending.renamed_from) {
+                // renamed then removed: only the original path is gone.
+                remove_origin(*pending.renamed_from, now);
+            } else if (pending.kind != Kind::Added) {
+                m_pending.emplace(change.path, Pending{Kind::Removed, std::nullopt, now});
+            }
+            break;
+        }
+        case RawFileChange::Kind::Moved: {
+            Pending moved{Kind::Renamed, change.old_path, now};
+            if (auto source = m_pending.find(change.old_path); source != m_pending.end()) {
+                if (source->second.kind == Kind::Removed ||
+                    (source->second.kind == Kind::Added && !source->second.renamed_from)) {
+                    // a new file renamed into place, as editors save.
+                    moved = Pending{Kind::Added, std::nullopt, now};
+                } else {
+                    moved = Pending{source->second.kind, source->second.renamed_from.value_or(change.old_path), now};
+                }
+                m_pending.erase(source);
+            }
+            if (moved.renamed_from == change.path) {
+                moved = Pending{Kind::Modified, std::nullopt, now};
+            }
+            if (auto dest = m_pending.find(change.path); dest != m_pending.end()) {
+                auto replaced = std::move(dest->second);
+                m_pending.erase(dest);
+                if (moved.kind == Kind::Added && replaced.kind != Kind::Added) moved.kind = Kind::Modified;
+                if (replaced.renamed_from && replaced.renamed_from != moved.renamed_from) {
+                    remove_origin(*replaced.renamed_from, now);
+                }
+            }
+            m_pending.insert_or_assign(change.path, std::move(moved));
+            break;
+        }
+    }
+}
+
+std::vector<AssetEventDebouncer::Settled> AssetEventDebouncer::take_settled(Clock::time_point now) {
+    std::vector<Settled> settled;
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (now - it->second.last_change < m_window) {
+            ++it;
+            continue;
+        }
+        settled.push_back(Settled{it->second.kind, it->first, std::move(it->second.renamed_from)});
+        it = m_pending.erase(it);
+    }
+    return settled;
+}
+
+std::optional<AssetEventDebouncer::Clock::time_point> AssetEventDebouncer::next_deadline() const {
+    std::optional<Clock::time_point> deadline;
+    for (auto& [_, pending] : m_pending) {
+        if (!deadline || pending.last_change + m_window < *deadline) deadline = pending.last_change + m_window;
+    }
+    return deadline;
+}
+
+std::vector<AssetSourceEvent> AssetEventDebouncer::to_events(
+    std::span<const Settled> settled, utils::function_ref<FileStatus(const std::filesystem::path&)> status) {
+    using namespace source_events;
+    std::vector<AssetSourceEvent> events;
+    events.reserve(settled.size());
+    auto removed = [&](const std::filesystem::path& path) {
+        if (path.extension() == ".meta") {
+            events.emplace_back(RemovedMeta{path});
+        } else {
+            events.emplace_back(RemovedAsset{path});
+        }
+    };
+    for (auto& change : settled) {
+        if (change.kind == Settled::Kind::Removed) {
+            removed(change.path);
+            continue;
+        }
+        auto file    = status(change.path);
+        bool is_meta = change.path.extension() == ".meta";
+        if (!file.exists) {
+            if (change.renamed_from) removed(*change.renamed_from);
+            continue;
+        }
+        if (change.renamed_from) {
+            if (file.is_directory) {
+                events.emplace_back(RenamedDirectory{*change.renamed_from, change.path});
+            } else if (is_meta) {
+                events.emplace_back(RenamedMeta{*change.renamed_from, change.path});
+            } else {
+                events.emplace_back(RenamedAsset{*change.renamed_from, change.path});
+            }
+            if (change.kind == Settled::Kind::Renamed || file.is_directory) continue;
+        }
+        if (change.kind == Settled::Kind::Added) {
+            if (file.is_directory) {
+                events.emplace_back(AddedDirectory{change.path});
+            } else if (is_meta) {
+                events.emplace_back(AddedMeta{change.path});
+            } else {
+                events.emplace_back(AddedAsset{change.path});
+            }
+        } else if (!file.is_directory) {
+            // modifications of directories carry no information.
+            if (is_meta) {
+                events.emplace_back(ModifiedMeta{change.path});
+            } else {
+                events.emplace_back(ModifiedAsset{change.path});
+            }
+        }
+    }
+    return events;
+}
+}  // namespace epix::assets
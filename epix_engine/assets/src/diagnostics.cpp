@@ -0,0 +1,145 @@
+module;
+
+module epix.assets;
+
+import std;
+
+namespace epix::assets {
+namespace {
+void append_json_string(std::string& out, std::string_view value) {
+    out.push_back('"');
+    for (char c : value) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    std::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned char>(c));
+                } else {
+                    out.push_back(c);
+                }
+        }
+    }
+    out.push_back('"');
+}
+double to_micros(std::chrono::steady_clock::duration duration) {
+    return std::chrono::duration<double, std::micro>(duration).count();
+}
+}  // namespace
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration) {
+    auto micros = static_cast<std::uint64_t>(std::max<std::int64_t>(
+        0, std::chrono::duration_cast<std::chrono::microseconds>(duration).count()));
+    // durations under 2^i microseconds, so bit_width(micros) is the bucket.
+    auto bucket = std::min<std::size_t>(std::bit_width(micros), BUCKETS - 1);
+    buckets[bucket]++;
+    count++;
+    total += duration;
+    max = std::max(max, duration);
+}
+
+std::chrono::nanoseconds LatencyHistogram::quantile(double q) const {
+    if (count == 0) return std::chrono::nanoseconds{0};
+    auto rank          = static_cast<std::uint64_t>(std::ceil(std::clamp(q, 0.0, 1.0) * static_cast<double>(count)));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < BUCKETS - 1; i++) {
+        seen += buckets[i];
+        if (seen >= std::max<std::uint64_t>(rank, 1)) {
+            return std::min<std::chrono::nanoseconds>(std::chrono::microseconds(std::uint64_t{1} << i), max);
+        }
+    }
+    return max;
+}
+
+const LoadStageTimings* AssetServerDiagnostics::loader(std::string_view name) const {
+    auto it = std::ranges::find(loaders, name, &LoadStageTimings::name);
+    return it == loaders.end() ? nullptr : &*it;
+}
+const LoadStageTimings* AssetServerDiagnostics::asset_type(std::string_view name) const {
+    auto it = std::ranges::find(asset_types, name, &LoadStageTimings::name);
+    return it == asset_types.end() ? nullptr : &*it;
+}
+
+LoadStageTimings& AssetLoadRecorder::type_timings(const epix::meta::type_index& type) {
+    auto [it, inserted] = m_types.try_emplace(type);
+    if (inserted) it->second.name = type.short_name();
+    return it->second;
+}
+
+void AssetLoadRecorder::record(LoadStage stage,
+                               std::string_view loader,
+                               const epix::meta::type_index& type,
+                               std::string_view path,
+                               Clock::time_point start,
+                               Clock::time_point end) {
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start);
+    auto index    = std::to_underlying(stage);
+    std::lock_guard lock(m_mutex);
+    auto& by_loader = m_loaders[loader];
+    by_loader.name  = loader;
+    by_loader.stages[index].record(duration);
+    type_timings(type).stages[index].record(duration);
+    if (m_trace_start && m_trace.size() < MAX_TRACE_EVENTS) {
+        m_trace.push_back(TraceEvent{stage, std::string(path), loader, start, end, std::this_thread::get_id()});
+    }
+}
+
+void AssetLoadRecorder::record_bytes(std::string_view loader,
+                                     const epix::meta::type_index& type,
+                                     std::uint64_t bytes) {
+    m_bytes_read.fetch_add(bytes, std::memory_order_relaxed);
+    std::lock_guard lock(m_mutex);
+    auto& by_loader = m_loaders[loader];
+    by_loader.name  = loader;
+    by_loader.bytes_read += bytes;
+    type_timings(type).bytes_read += bytes;
+}
+
+void AssetLoadRecorder::snapshot(AssetServerDiagnostics& diagnostics) const {
+    std::lock_guard lock(m_mutex);
+    diagnostics.loaders     = m_loaders | std::views::values | std::ranges::to<std::vector>();
+    diagnostics.asset_types = m_types | std::views::values | std::ranges::to<std::vector>();
+    std::ranges::sort(diagnostics.asset_types, {}, &LoadStageTimings::name);
+}
+
+void AssetLoadRecorder::start_trace() {
+    std::lock_guard lock(m_mutex);
+    m_trace.clear();
+    m_trace_start = Clock::now();
+}
+
+std::string AssetLoadRecorder::take_trace() {
+    std::vector<TraceEvent> events;
+    Clock::time_point trace_start;
+    {
+        std::lock_guard lock(m_mutex);
+        if (!m_trace_start) return {};
+        trace_start = *std::exchange(m_trace_start, std::nullopt);
+        events      = std::exchange(m_trace, {});
+    }
+    // trace viewers want small thread ids; number threads in order of appearance.
+    std::unordered_map<std::thread::id, std::size_t> threads;
+    std::string json = R"({"displayTimeUnit":"ms","traceEvents":[)";
+    for (auto& event : events) {
+        auto tid = threads.try_emplace(event.thread, threads.size() + 1).first->second;
+        if (&event != events.data()) json.push_back(',');
+        json += R"({"name":)";
+        append_json_string(json, event.path);
+        std::format_to(std::back_inserter(json), R"(,"cat":"assets.{}","ph":"X","ts":{:.3f},"dur":{:.3f},)",
+                       load_stage_name(event.stage), to_micros(event.start - trace_start),
+                       to_micros(event.end - event.start));
+        std::format_to(std::back_inserter(json), R"("pid":1,"tid":{},"args":{{"loader":)", tid);
+        append_json_string(json, event.loader);
+        json += "}}";
+    }
+    json += "]}";
+    return json;
+}
+}  // namespace epix::assets
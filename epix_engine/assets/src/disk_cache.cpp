@@ -0,0 +1,160 @@
+module;
+
+module epix.assets;
+
+import std;
+
+namespace epix::assets {
+namespace {
+constexpr std::string_view TEMP_EXTENSION = ".tmp";
+/** @brief Temporary files older than this are leftovers of interrupted stores. */
+constexpr auto STALE_TEMP_AGE = std::chrono::hours(1);
+
+bool write_file(const std::filesystem::path& path, std::span<const std::span<const std::byte>> parts) {
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    for (auto part : parts) {
+        stream.write(reinterpret_cast<const char*>(part.data()), static_cast<std::streamsize>(part.size()));
+    }
+    stream.close();
+    return !stream.fail();
+}
+
+/** @brief A temporary name next to `path`, unique across threads and processes sharing the cache. */
+std::filesystem::path temp_path(const std::filesystem::path& path) {
+    static const std::uint64_t process_tag    = std::random_device{}();
+    static std::atomic<std::uint64_t> counter = 0;
+    auto name = std::format("{}.{:x}.{:x}{}", path.filename().string(), process_tag,
+                            counter.fetch_add(1, std::memory_order_relaxed), TEMP_EXTENSION);
+    return path.parent_path() / name;
+}
+}  // namespace
+
+DiskCacheStore::DiskCacheStore(std::filesystem::path root, std::string marker_extension)
+    : m_root(std::move(root)), m_marker_extension(std::move(marker_extension)) {
+    std::error_code ec;
+    std::filesystem::create_directories(m_root, ec);
+}
+
+std::filesystem::path DiskCacheStore::entry_name(const AssetHash& key, std::string_view extension) {
+    std::string hex;
+    hex.reserve(key.size() * 2);
+    for (auto byte : key) std::format_to(std::back_inserter(hex), "{:02x}", byte);
+    // fan out over 256 directories so no directory holds every entry.
+    return (std::filesystem::path(hex.substr(0, 2)) / hex).concat(extension);
+}
+
+bool DiskCacheStore::store(const AssetHash& key, std::initializer_list<File> files) {
+    std::error_code ec;
+    std::filesystem::create_directories(entry_path(key, {}).parent_path(), ec);
+    for (auto& file : files) {
+        auto path = entry_path(key, file.extension);
+        auto temp = temp_path(path);
+        if (!write_file(temp, file.parts)) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        std::filesystem::rename(temp, path, ec);
+        if (ec) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+    }
+    m_stores.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void DiskCacheStore::touch(const AssetHash& key) const {
+    std::error_code ec;
+    std::filesystem::last_write_time(entry_path(key, m_marker_extension),
+                                     std::filesystem::file_time_type::clock::now(), ec);
+}
+
+std::uint64_t DiskCacheStore::collect_garbage(std::uint64_t max_bytes) {
+    struct Candidate {
+        std::filesystem::file_time_type used;
+        std::uint64_t bytes = 0;
+        std::vector<std::filesystem::path> files;
+        bool complete = false;
+    };
+    std::map<std::filesystem::path, Candidate> entries;
+    std::uint64_t total   = 0;
+    std::uint64_t removed = 0;
+    auto now              = std::filesystem::file_time_type::clock::now();
+    std::error_code ec;
+
+    for (auto it = std::filesystem::recursive_directory_iterator(m_root, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        std::error_code file_ec;
+        if (!it->is_regular_file(file_ec)) continue;
+        auto& path = it->path();
+        auto size  = it->file_size(file_ec);
+        auto time  = it->last_write_time(file_ec);
+        if (file_ec) continue;
+        if (path.extension() == TEMP_EXTENSION) {
+            if (now - time > STALE_TEMP_AGE && std::filesystem::remove(path, file_ec)) removed += size;
+            continue;
+        }
+        auto& candidate = entries[std::filesystem::path(path).replace_extension()];
+        candidate.bytes += size;
+        if (path.extension() == m_marker_extension) {
+            candidate.used     = time;
+            candidate.complete = true;
+            // the marker is removed first, so a concurrent lookup misses instead of finding half an entry.
+            candidate.files.insert(candidate.files.begin(), path);
+        } else {
+            candidate.files.push_back(path);
+        }
+        total += size;
+    }
+
+    auto remove_entry = [&](const Candidate& candidate) {
+        for (auto& file : candidate.files) std::filesystem::remove(file, ec);
+        removed += candidate.bytes;
+        total -= candidate.bytes;
+    };
+    std::vector<Candidate> by_use;
+    by_use.reserve(entries.size());
+    for (auto& [base, candidate] : entries) {
+        if (!candidate.complete) {
+            // files of a store interrupted before its marker was renamed in.
+            remove_entry(candidate);
+            continue;
+        }
+        by_use.push_back(std::move(candidate));
+    }
+    std::ranges::sort(by_use, {}, &Candidate::used);
+    for (auto& candidate : by_use) {
+        if (total <= max_bytes) break;
+        remove_entry(candidate);
+        m_evicted.fetch_add(1, std::memory_order_relaxed);
+    }
+    return removed;
+}
+
+std::uint64_t DiskCacheStore::size_bytes() const {
+    std::uint64_t total = 0;
+    std::error_code ec;
+    for (auto it = std::filesystem::recursive_directory_iterator(m_root, ec);
+         !ec && it != std::filesystem::recursive_directory_iterator(); it.increment(ec)) {
+        std::error_code file_ec;
+        if (it->is_regular_file(file_ec)) total += it->file_size(file_ec);
+    }
+    return total;
+}
+
+void DiskCacheStore::clear() {
+    std::error_code ec;
+    for (auto& entry : std::filesystem::directory_iterator(m_root, ec)) {
+        std::filesystem::remove_all(entry.path(), ec);
+    }
+}
+
+DiskCacheStats DiskCacheStore::stats() const {
+    return DiskCacheStats{
+        .hits    = m_hits.load(std::memory_order_relaxed),
+        .misses  = m_misses.load(std::memory_order_relaxed),
+        .stores  = m_stores.load(std::memory_order_relaxed),
+        .evicted = m_evicted.load(std::memory_order_relaxed),
+    };
+}
+}  // namespace epix::assets
@@ -1,4 +1,20 @@
 ﻿module;
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 module epix.assets;
 
 import std;
@@ -28,6 +44,85 @@ std::expected<std::unique_ptr<std::istream>, AssetReaderError> FileAssetReader::
     }
 }
 
+#if defined(_WIN32)
+namespace {
+/** @brief Read-only mapping of a whole file, unmapped on destruction. */
+struct FileMapping {
+    const std::byte* data = nullptr;
+    std::size_t size      = 0;
+    HANDLE file           = INVALID_HANDLE_VALUE;
+    HANDLE mapping        = nullptr;
+
+    FileMapping()                              = default;
+    FileMapping(const FileMapping&)            = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+    ~FileMapping() {
+        if (data) UnmapViewOfFile(data);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+    }
+
+    static std::shared_ptr<FileMapping> open(const std::filesystem::path& path, bool sequential) {
+        auto result = std::make_shared<FileMapping>();
+        result->file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_EXISTING,
+                                   FILE_ATTRIBUTE_NORMAL | (sequential ? FILE_FLAG_SEQUENTIAL_SCAN : 0), nullptr);
+        if (result->file == INVALID_HANDLE_VALUE) return nullptr;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(result->file, &size)) return nullptr;
+        result->size = static_cast<std::size_t>(size.QuadPart);
+        // mapping an empty file fails, an empty view needs no mapping.
+        if (result->size == 0) return result;
+        result->mapping = CreateFileMappingW(result->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!result->mapping) return nullptr;
+        result->data = static_cast<const std::byte*>(MapViewOfFile(result->mapping, FILE_MAP_READ, 0, 0, 0));
+        if (!result->data) return nullptr;
+        return result;
+    }
+};
+}  // namespace
+
+std::optional<AssetBytes> map_file(const std::filesystem::path& path, bool sequential) {
+    auto mapping = FileMapping::open(path, sequential);
+    if (!mapping) return std::nullopt;
+    auto bytes = std::span<const std::byte>(mapping->data, mapping->size);
+    return AssetBytes(std::move(mapping), bytes);
+}
+#else
+std::optional<AssetBytes> map_file_descriptor(int fd, std::size_t size, bool sequential) {
+    // mapping an empty file fails, an empty view needs no mapping.
+    if (size == 0) return AssetBytes();
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) return std::nullopt;
+    // loaders decode front to back, let the kernel read ahead aggressively.
+    if (sequential) ::madvise(data, size, MADV_SEQUENTIAL);
+    auto owner = std::shared_ptr<const void>(data, [size](const void* p) { ::munmap(const_cast<void*>(p), size); });
+    return AssetBytes(std::move(owner), {static_cast<const std::byte*>(data), size});
+}
+
+std::optional<AssetBytes> map_file(const std::filesystem::path& path, bool sequential) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return std::nullopt;
+    struct stat st;
+    std::optional<AssetBytes> result;
+    if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        result = map_file_descriptor(fd, static_cast<std::size_t>(st.st_size), sequential);
+    }
+    // the mapping keeps its own reference to the file.
+    ::close(fd);
+    return result;
+}
+#endif
+
+std::optional<AssetBytes> FileAssetReader::read_bytes_view(const std::filesystem::path& path) const {
+    return map_file(m_root / path);
+}
+
+void FileAssetReader::read_bytes_async(const std::filesystem::path& path, AssetBytesCallback on_complete) const {
+    if (uring_read_file(m_root / path, on_complete)) return;
+    AssetReader::read_bytes_async(path, std::move(on_complete));
+}
+
 std::expected<utils::input_iterable<std::filesystem::path>, AssetReaderError> FileAssetReader::read_directory(
     const std::filesystem::path& path) const {
     try {
@@ -67,6 +162,9 @@ std::expected<std::unique_ptr<std::ostream>, AssetWriterError> FileAssetWriter::
     try {
         auto full_path = m_root / path;
         std::filesystem::create_directories(full_path.parent_path());
+        // unlink first: the old file may be a hard link shared with another tree.
+        std::error_code ec;
+        std::filesystem::remove(full_path, ec);
         auto stream = std::make_unique<std::ofstream>(full_path, std::ios::binary);
         if (!stream->is_open()) {
             return std::unexpected(
@@ -80,6 +178,23 @@ std::expected<std::unique_ptr<std::ostream>, AssetWriterError> FileAssetWriter::
     }
 }
 
+std::expected<void, AssetWriterError> FileAssetWriter::write_from_file(const std::filesystem::path& path,
+                                                                       const std::filesystem::path& file) const {
+    try {
+        auto full_path = m_root / path;
+        std::filesystem::create_directories(full_path.parent_path());
+        std::filesystem::remove(full_path);
+        std::error_code ec;
+        std::filesystem::create_hard_link(file, full_path, ec);
+        if (ec) std::filesystem::copy_file(file, full_path, std::filesystem::copy_options::overwrite_existing);
+        return {};
+    } catch (const std::system_error& e) {
+        return std::unexpected(AssetWriterError(writer_errors::IoError{e.code()}));
+    } catch (...) {
+        return std::unexpected(AssetWriterError(std::current_exception()));
+    }
+}
+
 std::expected<void, AssetWriterError> FileAssetWriter::remove(const std::filesystem::path& path) const {
     try {
         auto full_path = m_root / path;
@@ -0,0 +1,333 @@
+module;
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define EPIX_ASSETS_IO_URING 1
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+module epix.assets;
+
+import std;
+
+namespace epix::assets {
+
+#if defined(EPIX_ASSETS_IO_URING)
+namespace {
+/** @brief Process-wide io_uring queue reading whole files.
+ *
+ *  Each read is a small state machine of open, statx, read and close operations, all submitted
+ *  to one ring and completed on a dedicated thread. Callbacks run on that thread. */
+struct UringFileQueue {
+   public:
+    /** @brief Get the shared queue, or nullptr if io_uring is unavailable (old kernel, seccomp). */
+    static UringFileQueue* instance() {
+        static std::unique_ptr<UringFileQueue> queue = [] {
+            auto result = std::unique_ptr<UringFileQueue>(new UringFileQueue());
+            if (!result->start()) result.reset();
+            return result;
+        }();
+        return queue.get();
+    }
+
+    UringFileQueue(const UringFileQueue&)            = delete;
+    UringFileQueue& operator=(const UringFileQueue&) = delete;
+    ~UringFileQueue() {
+        if (m_thread.joinable()) {
+            {
+                std::lock_guard lock(m_mutex);
+                push_sqe([](io_uring_sqe& sqe) { sqe.opcode = IORING_OP_NOP; }, kStopToken);
+            }
+            m_thread.join();
+        }
+        if (m_sqes) ::munmap(m_sqes, m_sqes_size);
+        if (m_cq_ptr && m_cq_ptr != m_sq_ptr) ::munmap(m_cq_ptr, m_cq_size);
+        if (m_sq_ptr) ::munmap(m_sq_ptr, m_sq_size);
+        if (m_ring_fd >= 0) ::close(m_ring_fd);
+    }
+
+    /** @brief Read the whole file at `path`, calling `on_complete` once on the completion thread. */
+    void read(const std::filesystem::path& path, AssetBytesCallback on_complete) {
+        auto request         = std::make_unique<Request>();
+        request->path        = path;
+        request->on_complete = std::move(on_complete);
+        std::lock_guard lock(m_mutex);
+        if (m_in_flight >= kMaxInFlight) {
+            m_waiting.push_back(std::move(request));
+            return;
+        }
+        m_in_flight++;
+        submit_open(request.release());
+    }
+
+   private:
+    static constexpr unsigned kQueueDepth     = 256;
+    static constexpr unsigned kMaxInFlight    = kQueueDepth;
+    static constexpr std::uint64_t kStopToken = 0;
+    /// Files at least this large are memory-mapped instead of read into a buffer.
+    static constexpr std::size_t kMapThreshold = 1 << 20;
+
+    enum class Stage { Open, Stat, Read, Close };
+    struct Request {
+        std::filesystem::path path;
+        AssetBytesCallback on_complete;
+        Stage stage = Stage::Open;
+        int fd      = -1;
+        struct statx stat {};
+        std::shared_ptr<std::byte[]> buffer;
+        std::size_t size   = 0;
+        std::size_t offset = 0;
+        std::expected<AssetBytes, AssetReaderError> result;
+    };
+
+    UringFileQueue() = default;
+
+    bool start() {
+        io_uring_params params{};
+        params.flags      = IORING_SETUP_CQSIZE;
+        params.cq_entries = kQueueDepth * 2;
+        m_ring_fd         = static_cast<int>(::syscall(__NR_io_uring_setup, kQueueDepth, &params));
+        if (m_ring_fd < 0) return false;
+        if (!supports_ops()) return false;
+
+        m_sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+        if (single_mmap) m_sq_size = m_cq_size = std::max(m_sq_size, m_cq_size);
+        m_sq_ptr = ::mmap(nullptr, m_sq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd,
+                          IORING_OFF_SQ_RING);
+        if (m_sq_ptr == MAP_FAILED) {
+            m_sq_ptr = nullptr;
+            return false;
+        }
+        m_cq_ptr = single_mmap ? m_sq_ptr
+                               : ::mmap(nullptr, m_cq_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                                        m_ring_fd, IORING_OFF_CQ_RING);
+        if (m_cq_ptr == MAP_FAILED) {
+            m_cq_ptr = nullptr;
+            return false;
+        }
+        m_sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes  = ::mmap(nullptr, m_sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_ring_fd,
+                             IORING_OFF_SQES);
+        if (sqes == MAP_FAILED) return false;
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq   = static_cast<std::byte*>(m_sq_ptr);
+        m_sq_tail  = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sq_mask  = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        auto* cq   = static_cast<std::byte*>(m_cq_ptr);
+        m_cq_head  = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cq_tail  = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cq_mask  = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes     = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+
+        m_thread = std::thread([this] { run(); });
+        return true;
+    }
+
+    bool supports_ops() const {
+        constexpr unsigned op_count = 256;
+        std::vector<std::byte> storage(sizeof(io_uring_probe) + op_count * sizeof(io_uring_probe_op));
+        auto* probe = reinterpret_cast<io_uring_probe*>(storage.data());
+        if (::syscall(__NR_io_uring_register, m_ring_fd, IORING_REGISTER_PROBE, probe, op_count) < 0) return false;
+        return std::ranges::all_of(std::array{IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE},
+                                   [&](auto op) {
+                                       return op <= probe->last_op && (probe->ops[op].flags & IO_URING_OP_SUPPORTED);
+                                   });
+    }
+
+    /** @brief Fill the next submission entry and submit it. Caller holds `m_mutex`. */
+    template <typename F>
+    void push_sqe(F&& fill, std::uint64_t user_data) {
+        unsigned tail       = *m_sq_tail;
+        unsigned index      = tail & m_sq_mask;
+        io_uring_sqe& sqe   = m_sqes[index];
+        std::memset(&sqe, 0, sizeof(sqe));
+        fill(sqe);
+        sqe.user_data       = user_data;
+        m_sq_array[index]   = index;
+        std::atomic_ref(*m_sq_tail).store(tail + 1, std::memory_order_release);
+        // without SQPOLL the kernel consumes the entry here, so the ring never fills up.
+        while (::syscall(__NR_io_uring_enter, m_ring_fd, 1, 0, 0, nullptr, 0) < 0 && errno == EINTR) {
+        }
+    }
+
+    void submit_open(Request* request) {
+        request->stage = Stage::Open;
+        push_sqe(
+            [&](io_uring_sqe& sqe) {
+                sqe.opcode     = IORING_OP_OPENAT;
+                sqe.fd         = AT_FDCWD;
+                sqe.addr       = reinterpret_cast<std::uint64_t>(request->path.c_str());
+                sqe.open_flags = O_RDONLY | O_CLOEXEC;
+            },
+            reinterpret_cast<std::uint64_t>(request));
+    }
+    void submit_stat(Request* request) {
+        request->stage = Stage::Stat;
+        push_sqe(
+            [&](io_uring_sqe& sqe) {
+                sqe.opcode      = IORING_OP_STATX;
+                sqe.fd          = request->fd;
+                sqe.addr        = reinterpret_cast<std::uint64_t>("");
+                sqe.len         = STATX_TYPE | STATX_SIZE;
+                sqe.statx_flags = AT_EMPTY_PATH;
+                sqe.off         = reinterpret_cast<std::uint64_t>(&request->stat);
+            },
+            reinterpret_cast<std::uint64_t>(request));
+    }
+    void submit_read(Request* request) {
+        request->stage = Stage::Read;
+        push_sqe(
+            [&](io_uring_sqe& sqe) {
+                sqe.opcode = IORING_OP_READ;
+                sqe.fd     = request->fd;
+                sqe.addr   = reinterpret_cast<std::uint64_t>(request->buffer.get() + request->offset);
+                sqe.len    = static_cast<unsigned>(std::min<std::size_t>(request->size - request->offset, 1u << 30));
+                sqe.off    = request->offset;
+            },
+            reinterpret_cast<std::uint64_t>(request));
+    }
+    void submit_close(Request* request) {
+        request->stage = Stage::Close;
+        push_sqe(
+            [&](io_uring_sqe& sqe) {
+                sqe.opcode = IORING_OP_CLOSE;
+                sqe.fd     = request->fd;
+            },
+            reinterpret_cast<std::uint64_t>(request));
+    }
+
+    static AssetReaderError error_from(int res, const std::filesystem::path& path) {
+        if (res == -ENOENT || res == -ENOTDIR) return reader_errors::NotFound{path};
+        return reader_errors::IoError{std::error_code(-res, std::system_category())};
+    }
+
+    /** @brief Advance `request` after an operation finished with `res`.
+     *  @return True if the request is done and its callback should run. Caller holds `m_mutex`. */
+    bool advance(Request* request, int res) {
+        switch (request->stage) {
+            case Stage::Open:
+                if (res < 0) {
+                    request->result = std::unexpected(error_from(res, request->path));
+                    return true;
+                }
+                request->fd = res;
+                submit_stat(request);
+                return false;
+            case Stage::Stat:
+                if (res < 0) {
+                    request->result = std::unexpected(error_from(res, request->path));
+                } else if (!S_ISREG(request->stat.stx_mode)) {
+                    request->result = std::unexpected(AssetReaderError(reader_errors::NotFound{request->path}));
+                } else {
+                    request->size = static_cast<std::size_t>(request->stat.stx_size);
+                    std::optional<AssetBytes> mapped;
+                    // large files skip the copy, pages are faulted in by the loader instead.
+                    if (request->size >= kMapThreshold) mapped = map_file_descriptor(request->fd, request->size, true);
+                    if (request->size == 0) {
+                        request->result = AssetBytes();
+                    } else if (mapped) {
+                        request->result = std::move(*mapped);
+                    } else {
+                        request->buffer = std::make_shared_for_overwrite<std::byte[]>(request->size);
+                        submit_read(request);
+                        return false;
+                    }
+                }
+                submit_close(request);
+                return false;
+            case Stage::Read:
+                if (res == -EINTR || res == -EAGAIN) {
+                    submit_read(request);
+                    return false;
+                }
+                if (res < 0) {
+                    request->result = std::unexpected(error_from(res, request->path));
+                } else {
+                    request->offset += static_cast<std::size_t>(res);
+                    // a zero read means the file shrank since statx, keep what was read.
+                    if (res > 0 && request->offset < request->size) {
+                        submit_read(request);
+                        return false;
+                    }
+                    request->result = AssetBytes(request->buffer, {request->buffer.get(), request->offset});
+                }
+                submit_close(request);
+                return false;
+            case Stage::Close:
+                return true;
+        }
+        return true;
+    }
+
+    void run() {
+        while (true) {
+            unsigned head = *m_cq_head;
+            unsigned tail = std::atomic_ref(*m_cq_tail).load(std::memory_order_acquire);
+            if (head == tail) {
+                ::syscall(__NR_io_uring_enter, m_ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+                continue;
+            }
+            for (; head != tail; head++) {
+                io_uring_cqe cqe = m_cqes[head & m_cq_mask];
+                std::atomic_ref(*m_cq_head).store(head + 1, std::memory_order_release);
+                if (cqe.user_data == kStopToken) return;
+                auto* request = reinterpret_cast<Request*>(cqe.user_data);
+                std::unique_ptr<Request> finished;
+                {
+                    std::lock_guard lock(m_mutex);
+                    if (!advance(request, cqe.res)) continue;
+                    finished.reset(request);
+                    if (m_waiting.empty()) {
+                        m_in_flight--;
+                    } else {
+                        submit_open(m_waiting.front().release());
+                        m_waiting.pop_front();
+                    }
+                }
+                finished->on_complete(std::move(finished->result));
+            }
+        }
+    }
+
+    int m_ring_fd = -1;
+    void* m_sq_ptr = nullptr;
+    void* m_cq_ptr = nullptr;
+    std::size_t m_sq_size = 0;
+    std::size_t m_cq_size = 0;
+    std::size_t m_sqes_size = 0;
+    io_uring_sqe* m_sqes = nullptr;
+    unsigned* m_sq_tail = nullptr;
+    unsigned* m_sq_array = nullptr;
+    unsigned m_sq_mask = 0;
+    unsigned* m_cq_head = nullptr;
+    unsigned* m_cq_tail = nullptr;
+    unsigned m_cq_mask = 0;
+    io_uring_cqe* m_cqes = nullptr;
+
+    std::mutex m_mutex;
+    unsigned m_in_flight = 0;
+    std::deque<std::unique_ptr<Request>> m_waiting;
+    std::thread m_thread;
+};
+}  // namespace
+
+bool uring_read_file(const std::filesystem::path& path, AssetBytesCallback& on_complete) {
+    auto* queue = UringFileQueue::instance();
+    if (!queue) return false;
+    queue->read(path, std::move(on_complete));
+    return true;
+}
+#else
+bool uring_read_file(const std::filesystem::path&, AssetBytesCallback&) { return false; }
+#endif
+
+}  // namespace epix::assets
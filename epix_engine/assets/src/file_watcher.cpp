@@ -9,72 +9,93 @@ import epix.utils;
 
 namespace epix::assets {
 
-FileAssetWatcher::FileAssetWatcher(std::filesystem::path root, utils::Sender<AssetSourceEvent> event_sender) {
-    m_watcher = std::make_unique<efsw::FileWatcher>();
+struct FileAssetWatcher::Shared {
+    std::filesystem::path root;
+    std::filesystem::path absolute_root;
+    utils::Sender<AssetSourceEvent> sender;
+    std::mutex mutex;
+    std::condition_variable_any changed;
+    AssetEventDebouncer debouncer;
+
+    Shared(std::filesystem::path root, utils::Sender<AssetSourceEvent> sender, std::chrono::milliseconds debounce)
+        : root(root.lexically_normal()), sender(std::move(sender)), debouncer(debounce) {
+        std::error_code ec;
+        absolute_root = std::filesystem::absolute(this->root, ec).lexically_normal();
+    }
+
+    /** @brief Path relative to the watched root, as the asset server addresses it. */
+    std::filesystem::path relative(const std::filesystem::path& path) const {
+        for (auto& base : {absolute_root, root}) {
+            auto rel = path.lexically_relative(base);
+            if (!rel.empty() && *rel.begin() != "..") return rel;
+        }
+        return path;
+    }
+};
+
+FileAssetWatcher::FileAssetWatcher(std::filesystem::path root,
+                                   utils::Sender<AssetSourceEvent> event_sender,
+                                   std::chrono::milliseconds debounce) {
+    m_shared = std::make_shared<Shared>(root, std::move(event_sender), debounce);
+
     struct Listener : public efsw::FileWatchListener {
-        utils::Sender<AssetSourceEvent> sender;
-        Listener(utils::Sender<AssetSourceEvent> sender) : sender(std::move(sender)) {}
+        std::shared_ptr<Shared> shared;
+        Listener(std::shared_ptr<Shared> shared) : shared(std::move(shared)) {}
         void handleFileAction(efsw::WatchID watchid,
                               const std::string& dir,
                               const std::string& filename,
                               efsw::Action action,
                               std::string oldFilename) override {
             std::filesystem::path dir_path(dir);
-            auto full_path = dir_path / filename;
-            std::optional<std::filesystem::path> old_full_path;
-            if (!oldFilename.empty()) {
-                old_full_path = dir_path / oldFilename;
-            }
-            bool is_meta      = full_path.extension() == ".meta";
-            bool is_directory = std::filesystem::is_directory(full_path);
-            bool exists       = std::filesystem::exists(full_path);
+            RawFileChange change{.path = shared->relative((dir_path / filename).lexically_normal())};
             switch (action) {
                 case efsw::Action::Add:
-                    if (!exists) {
-                        break;
-                    } else if (is_directory) {
-                        sender.send(AssetSourceEvent(source_events::AddedDirectory{full_path}));
-                    } else if (is_meta) {
-                        sender.send(AssetSourceEvent(source_events::AddedMeta{full_path}));
-                    } else {
-                        sender.send(AssetSourceEvent(source_events::AddedAsset{full_path}));
-                    }
+                    change.kind = RawFileChange::Kind::Added;
                     break;
                 case efsw::Action::Modified:
-                    if (!exists) {
-                        break;
-                    } else if (is_directory) {
-                        // we shouldn't have modified events for directories, but just in case
-                    } else if (is_meta) {
-                        sender.send(AssetSourceEvent(source_events::ModifiedMeta{full_path}));
-                    } else {
-                        sender.send(AssetSourceEvent(source_events::ModifiedAsset{full_path}));
-                    }
+                    change.kind = RawFileChange::Kind::Modified;
                     break;
                 case efsw::Action::Delete:
-                    if (is_directory) {
-                        sender.send(AssetSourceEvent(source_events::RemovedDirectory{full_path}));
-                    } else if (is_meta) {
-                        sender.send(AssetSourceEvent(source_events::RemovedMeta{full_path}));
-                    } else {
-                        sender.send(AssetSourceEvent(source_events::RemovedAsset{full_path}));
-                    }
+                    change.kind = RawFileChange::Kind::Removed;
                     break;
                 case efsw::Action::Moved:
-                    if (old_full_path) {
-                        if (is_directory) {
-                            sender.send(AssetSourceEvent(source_events::RenamedDirectory{*old_full_path, full_path}));
-                        } else if (is_meta) {
-                            sender.send(AssetSourceEvent(source_events::RenamedMeta{*old_full_path, full_path}));
-                        } else {
-                            sender.send(AssetSourceEvent(source_events::RenamedAsset{*old_full_path, full_path}));
-                        }
-                    }
+                    if (oldFilename.empty()) return;
+                    change.kind     = RawFileChange::Kind::Moved;
+                    change.old_path = shared->relative((dir_path / oldFilename).lexically_normal());
                     break;
+                default:
+                    return;
             }
+            {
+                std::lock_guard lock(shared->mutex);
+                shared->debouncer.push(change, AssetEventDebouncer::Clock::now());
+            }
+            shared->changed.notify_one();
         }
     };
-    m_listener = std::make_unique<Listener>(std::move(event_sender));
+
+    m_flusher = std::jthread([shared = m_shared](std::stop_token stop) {
+        std::unique_lock lock(shared->mutex);
+        while (!stop.stop_requested()) {
+            if (auto deadline = shared->debouncer.next_deadline()) {
+                shared->changed.wait_until(lock, stop, *deadline, [] { return false; });
+            } else {
+                shared->changed.wait(lock, stop, [&] { return shared->debouncer.pending() > 0; });
+            }
+            auto settled = shared->debouncer.take_settled(AssetEventDebouncer::Clock::now());
+            if (settled.empty()) continue;
+            // classify and send without the lock, the platform callback must not wait on a stat.
+            lock.unlock();
+            auto events = AssetEventDebouncer::to_events(settled, [&](const std::filesystem::path& path) {
+                return disk_file_status(shared->absolute_root / path);
+            });
+            for (auto& event : events) shared->sender.send(std::move(event));
+            lock.lock();
+        }
+    });
+
+    m_listener = std::make_unique<Listener>(m_shared);
+    m_watcher  = std::make_unique<efsw::FileWatcher>();
     m_watcher->addWatch(root.string(), m_listener.get(), true);
     m_watcher->watch();
 }
@@ -11,35 +11,55 @@ using namespace epix::assets;
 using namespace epix::core;
 
 StrongHandle::StrongHandle(const UntypedAssetId& id,
-                           const Sender<DestructionEvent>& event_sender,
+                           std::shared_ptr<const HandleProvider> provider,
                            bool asset_server_managed,
                            const std::optional<AssetPath>& path,
                            std::optional<MetaTransform> meta_transform)
     : id(id),
-      event_sender(event_sender),
+      provider(std::move(provider)),
       path(path),
       asset_server_managed(asset_server_managed),
-      meta_transform(std::move(meta_transform)) {}
+      meta_transform(std::move(meta_transform)) {
+    if (auto* index = std::get_if<AssetIndex>(&this->id.id)) {
+        this->provider->index_allocator.acquire_handle(index->index());
+    }
+}
 
 StrongHandle::~StrongHandle() {
     spdlog::trace("[assets] StrongHandle destroyed: {}.", id);
-    event_sender.send(DestructionEvent{id, asset_server_managed});
+    provider->handle_dropped(*this);
+}
+
+HandleProvider::HandleProvider(const meta::type_index& type) : type(type) {}
+
+void HandleProvider::handle_dropped(const StrongHandle& handle) const {
+    std::visit(utils::visitor{[this](const AssetIndex& index) { index_allocator.release_handle(index.index()); },
+                              [&](const uuids::uuid& uuid) {
+                                  std::lock_guard lock(m_dropped_uuids_mutex);
+                                  m_dropped_uuids.emplace_back(uuid, handle.asset_server_managed);
+                              }},
+               handle.id.id);
+}
+std::vector<std::pair<uuids::uuid, bool>> HandleProvider::take_dropped_uuids() const {
+    std::lock_guard lock(m_dropped_uuids_mutex);
+    return std::exchange(m_dropped_uuids, {});
 }
 
-HandleProvider::HandleProvider(const meta::type_index& type) : type(type) {
-    std::tie(event_sender, event_receiver) = make_channel<DestructionEvent>();
+std::size_t HandleProvider::pending_drops() const {
+    std::lock_guard lock(m_dropped_uuids_mutex);
+    return index_allocator.unreferenced_count() + m_dropped_uuids.size();
 }
 
 UntypedHandle HandleProvider::reserve() const {
     auto index = index_allocator.reserve();
     spdlog::trace("[assets] HandleProvider::reserve: index={}/gen={}.", index.index(), index.generation());
-    return std::make_shared<StrongHandle>(UntypedAssetId(type, index), event_sender, false, std::nullopt);
+    return std::make_shared<StrongHandle>(UntypedAssetId(type, index), shared_from_this(), false, std::nullopt);
 }
 std::shared_ptr<StrongHandle> HandleProvider::get_handle(const InternalAssetId& id,
                                                          bool asset_server_managed,
                                                          const std::optional<AssetPath>& path,
                                                          std::optional<MetaTransform> meta_transform) const {
-    return std::make_shared<StrongHandle>(id.untyped(type), event_sender, asset_server_managed, path,
+    return std::make_shared<StrongHandle>(id.untyped(type), shared_from_this(), asset_server_managed, path,
                                           std::move(meta_transform));
 }
 std::shared_ptr<StrongHandle> HandleProvider::reserve(bool asset_server_managed,
@@ -6,26 +6,109 @@ module epix.assets;
 
 namespace epix::assets {
 
-AssetIndexAllocator::AssetIndexAllocator() {
-    std::tie(m_free_indices_sender, m_free_indices_receiver) = core::make_channel<AssetIndex>();
-    std::tie(m_reserved_sender, m_reserved)                  = core::make_channel<AssetIndex>();
+AssetIndexAllocator::~AssetIndexAllocator() {
+    for (auto& segment : m_segments) delete segment.load(std::memory_order_relaxed);
 }
+std::uint32_t AssetIndexAllocator::segment_of(std::uint32_t index) {
+    if (index < FIRST_SEGMENT) return 0;
+    return static_cast<std::uint32_t>(std::bit_width(index)) - FIRST_SEGMENT_BITS;
+}
+std::uint32_t AssetIndexAllocator::segment_start(std::uint32_t segment) {
+    return segment == 0 ? 0 : FIRST_SEGMENT << (segment - 1);
+}
+std::uint32_t AssetIndexAllocator::segment_size(std::uint32_t segment) {
+    return segment == 0 ? FIRST_SEGMENT : FIRST_SEGMENT << (segment - 1);
+}
+AssetIndexAllocator::Slot& AssetIndexAllocator::slot(std::uint32_t index) const {
+    auto segment = segment_of(index);
+    return m_segments[segment].load(std::memory_order_acquire)->slots[index - segment_start(segment)];
+}
+std::atomic<std::uint64_t>& AssetIndexAllocator::unreferenced_word(std::uint32_t index) const {
+    auto segment = segment_of(index);
+    return m_segments[segment].load(std::memory_order_acquire)->unreferenced[(index - segment_start(segment)) / 64];
+}
+void AssetIndexAllocator::ensure_segment(std::uint32_t index) const {
+    auto& segment = m_segments[segment_of(index)];
+    if (segment.load(std::memory_order_acquire)) return;
+    std::lock_guard lock(m_grow_mutex);
+    if (segment.load(std::memory_order_relaxed)) return;
+    auto size = segment_size(segment_of(index));
+    auto* created = new Segment{std::make_unique<Slot[]>(size),
+                                std::make_unique<std::atomic<std::uint64_t>[]>(size / 64)};
+    segment.store(created, std::memory_order_release);
+}
+
 AssetIndex AssetIndexAllocator::reserve() const {
-    if (auto index = m_free_indices_receiver.try_receive()) {
-        spdlog::trace("[assets] AssetIndexAllocator::reserve: recycled index={}/gen={}.", index->index(),
-                      index->generation() + 1u);
-        m_reserved_sender.send(AssetIndex(index->index(), index->generation() + 1u));
-        return AssetIndex(index->index(), index->generation() + 1);
-    } else {
-        uint32_t i = m_next.fetch_add(1, std::memory_order_relaxed);
-        spdlog::trace("[assets] AssetIndexAllocator::reserve: new index={}/gen=0.", i);
-        m_reserved_sender.send(AssetIndex(i, 0));
-        return AssetIndex(i, 0);
+    auto head = m_free_head.load(std::memory_order_acquire);
+    while (auto free = static_cast<std::uint32_t>(head)) {
+        auto next = slot(free - 1).next_free.load(std::memory_order_relaxed);
+        // the pop counter changes on every pop, so a head popped and pushed again in between fails here.
+        auto popped = ((head >> 32) + 1) << 32 | next;
+        if (m_free_head.compare_exchange_weak(head, popped, std::memory_order_acquire, std::memory_order_acquire)) {
+            auto generation = slot(free - 1).generation.fetch_add(1, std::memory_order_relaxed) + 1;
+            spdlog::trace("[assets] AssetIndexAllocator::reserve: recycled index={}/gen={}.", free - 1, generation);
+            return AssetIndex(free - 1, generation);
+        }
     }
+    std::uint32_t i = m_next.fetch_add(1, std::memory_order_acq_rel);
+    ensure_segment(i);
+    spdlog::trace("[assets] AssetIndexAllocator::reserve: new index={}/gen=0.", i);
+    return AssetIndex(i, 0);
 }
-core::Receiver<AssetIndex> AssetIndexAllocator::reserved_receiver() const { return m_reserved; }
 void AssetIndexAllocator::release(const AssetIndex& index) const {
     spdlog::trace("[assets] AssetIndexAllocator::release: index={}/gen={}.", index.index(), index.generation());
-    m_free_indices_sender.send(index);
+    auto& released = slot(index.index());
+    // a mark left by a handle resurrected and dropped again before the release must not outlive it.
+    unreferenced_word(index.index()).fetch_and(~(std::uint64_t{1} << (index.index() % 64)), std::memory_order_relaxed);
+    auto head = m_free_head.load(std::memory_order_relaxed);
+    std::uint64_t pushed;
+    do {
+        released.next_free.store(static_cast<std::uint32_t>(head), std::memory_order_relaxed);
+        pushed = (head & ~std::uint64_t{0xffffffff}) | (index.index() + 1);
+    } while (!m_free_head.compare_exchange_weak(head, pushed, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void AssetIndexAllocator::acquire_handle(std::uint32_t index) const {
+    slot(index).handles.fetch_add(1, std::memory_order_relaxed);
+}
+void AssetIndexAllocator::release_handle(std::uint32_t index) const {
+    if (slot(index).handles.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        unreferenced_word(index).fetch_or(std::uint64_t{1} << (index % 64), std::memory_order_release);
+    }
+}
+std::uint32_t AssetIndexAllocator::handle_count(std::uint32_t index) const {
+    if (index >= slot_count() || !m_segments[segment_of(index)].load(std::memory_order_acquire)) return 0;
+    return slot(index).handles.load(std::memory_order_acquire);
+}
+std::size_t AssetIndexAllocator::unreferenced_count() const {
+    std::size_t count = 0;
+    for (std::uint32_t s = 0; s < SEGMENT_COUNT; s++) {
+        auto* segment = m_segments[s].load(std::memory_order_acquire);
+        if (!segment) continue;
+        for (std::uint32_t word = 0; word < segment_size(s) / 64; word++) {
+            count += std::popcount(segment->unreferenced[word].load(std::memory_order_relaxed));
+        }
+    }
+    return count;
+}
+std::vector<AssetIndex> AssetIndexAllocator::take_unreferenced() const {
+    std::vector<AssetIndex> unreferenced;
+    for (std::uint32_t s = 0; s < SEGMENT_COUNT; s++) {
+        auto* segment = m_segments[s].load(std::memory_order_acquire);
+        // segments may be created out of order by concurrent reserves.
+        if (!segment) continue;
+        for (std::uint32_t word = 0; word < segment_size(s) / 64; word++) {
+            auto bits = segment->unreferenced[word].exchange(0, std::memory_order_acq_rel);
+            for (; bits; bits &= bits - 1) {
+                auto offset = word * 64 + static_cast<std::uint32_t>(std::countr_zero(bits));
+                auto& entry = segment->slots[offset];
+                // a handle created since the count dropped keeps the index alive.
+                if (entry.handles.load(std::memory_order_acquire) != 0) continue;
+                unreferenced.push_back(
+                    AssetIndex(segment_start(s) + offset, entry.generation.load(std::memory_order_relaxed)));
+            }
+        }
+    }
+    return unreferenced;
 }
 }  // namespace epix::assets
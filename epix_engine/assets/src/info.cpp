@@ -9,6 +9,93 @@ import epix.meta;
 import epix.utils;
 import epix.core;
 namespace epix::assets {
+const AssetPathIndex::Shard& AssetPathIndex::shard(const AssetPath& path) const {
+    // the maps inside a shard use the low bits of the same hash, pick the shard from the high bits.
+    auto hash = static_cast<std::uint64_t>(std::hash<AssetPath>()(path)) * 0x9e3779b97f4a7c15ull;
+    return m_shards[hash >> (64 - std::countr_zero(k_shards))];
+}
+std::vector<UntypedAssetId> AssetPathIndex::ids(const AssetPath& path) const {
+    auto& shard = this->shard(path);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.ids.find(path);
+    if (it == shard.ids.end()) return {};
+    return it->second | std::views::values | std::ranges::to<std::vector>();
+}
+std::optional<UntypedAssetId> AssetPathIndex::find(const AssetPath& path, epix::meta::type_index type) const {
+    auto& shard = this->shard(path);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.ids.find(path);
+    if (it == shard.ids.end()) return std::nullopt;
+    auto id_it = std::ranges::find(it->second, type, [](const auto& entry) { return entry.first; });
+    if (id_it == it->second.end()) return std::nullopt;
+    return id_it->second;
+}
+std::optional<epix::meta::type_index> AssetPathIndex::single_type(const AssetPath& path) const {
+    auto& shard = this->shard(path);
+    std::shared_lock lock(shard.mutex);
+    auto it = shard.ids.find(path);
+    if (it == shard.ids.end() || it->second.size() != 1) return std::nullopt;
+    return it->second.front().first;
+}
+void AssetPathIndex::insert(const AssetPath& path, epix::meta::type_index type, const UntypedAssetId& id) {
+    auto& shard = this->shard(path);
+    std::unique_lock lock(shard.mutex);
+    auto& ids = shard.ids[path];
+    if (auto it = std::ranges::find(ids, type, [](const auto& entry) { return entry.first; }); it != ids.end()) {
+        it->second = id;
+    } else {
+        ids.emplace_back(type, id);
+    }
+}
+void AssetPathIndex::erase(const AssetPath& path, epix::meta::type_index type) {
+    auto& shard = this->shard(path);
+    std::unique_lock lock(shard.mutex);
+    auto it = shard.ids.find(path);
+    if (it == shard.ids.end()) return;
+    std::erase_if(it->second, [&](const auto& entry) { return entry.first == type; });
+    if (it->second.empty()) shard.ids.erase(it);
+}
+
+AssetInfo* AssetInfoSlots::find(const UntypedAssetId& id) {
+    if (auto index = std::get_if<AssetIndex>(&id.id)) {
+        auto it = m_slots.find(id.type);
+        if (it == m_slots.end() || index->index() >= it->second.size()) return nullptr;
+        auto& slot = it->second[index->index()];
+        return slot.info && slot.generation == index->generation() ? &*slot.info : nullptr;
+    }
+    auto it = m_uuid_infos.find(id);
+    return it != m_uuid_infos.end() ? &it->second : nullptr;
+}
+const AssetInfo* AssetInfoSlots::find(const UntypedAssetId& id) const {
+    return const_cast<AssetInfoSlots&>(*this).find(id);
+}
+AssetInfo& AssetInfoSlots::emplace(const UntypedAssetId& id, AssetInfo info) {
+    if (auto index = std::get_if<AssetIndex>(&id.id)) {
+        auto& slots = m_slots[id.type];
+        if (index->index() >= slots.size()) slots.resize(index->index() + 1);
+        auto& slot = slots[index->index()];
+        if (!slot.info) m_size++;
+        slot.generation = index->generation();
+        return slot.info.emplace(std::move(info));
+    }
+    auto [it, inserted] = m_uuid_infos.insert_or_assign(id, std::move(info));
+    if (inserted) m_size++;
+    return it->second;
+}
+bool AssetInfoSlots::erase(const UntypedAssetId& id) {
+    if (auto index = std::get_if<AssetIndex>(&id.id)) {
+        auto it = m_slots.find(id.type);
+        if (it == m_slots.end() || index->index() >= it->second.size()) return false;
+        auto& slot = it->second[index->index()];
+        if (!slot.info || slot.generation != index->generation()) return false;
+        slot.info.reset();
+        m_size--;
+        return true;
+    }
+    if (!m_uuid_infos.erase(id)) return false;
+    m_size--;
+    return true;
+}
 void AssetInfos::propagate_loaded_state(UntypedAssetId loaded_asset_id,
                                         UntypedAssetId waiting_id,
                                         const epix::utils::Sender<InternalAssetEvent>& sender) {
@@ -96,6 +183,18 @@ void AssetInfos::process_asset_fail(const UntypedAssetId& failed_id, const Asset
         propagate_failed_state(failed_id, waiting_id, error_ptr);
     }
 }
+bool AssetInfos::process_partial_asset_load(const UntypedAssetId& id,
+                                            ErasedLoadedAsset partial,
+                                            epix::core::World& world) {
+    auto info = get_info(id);
+    if (!info) return false;
+    // the final asset may have arrived first when a reload overtook this load.
+    auto* state = std::get_if<LoadStateOK>(&info->get().state);
+    if (!state || *state != LoadStateOK::Loading) return false;
+    partial.value->insert(id, world);
+    return true;
+}
+
 void AssetInfos::process_asset_load(const UntypedAssetId& loaded_asset_id,
                                     ErasedLoadedAsset loaded_asset,
                                     epix::core::World& world,
@@ -265,14 +364,7 @@ void AssetInfos::process_asset_load(const UntypedAssetId& loaded_asset_id,
     }
 }
 bool AssetInfos::is_path_alive(const AssetPath& path) const {
-    if (auto it = path_to_ids.find(path); it != path_to_ids.end()) {
-        for (const auto& [type, id] : it->second) {
-            if (auto info = get_info(id); info && !info->get().weak_handle.expired()) {
-                return true;
-            }
-        }
-    }
-    return false;
+    return std::ranges::any_of(paths->ids(path), [&](const UntypedAssetId& id) { return is_handle_alive(id); });
 }
 bool AssetInfos::should_reload(const AssetPath& path) const {
     if (is_path_alive(path)) {
@@ -308,12 +400,10 @@ void AssetInfos::remove_dependents_and_labels(const AssetInfo& info,
 }
 bool AssetInfos::process_handle_destruction(const UntypedAssetId& id) {
     auto info_res = get_info_mut(id);
-    if (!info_res) return false;  // asset already removed or is not managed by AssetServer
+    if (!info_res) return true;  // not managed by the AssetServer
 
-    if (auto& info = info_res->get(); info.handle_destruct_skip > 0) {
-        info.handle_destruct_skip--;
-        return false;
-    }
+    // the server handed out a new handle since the last one was dropped.
+    if (!info_res->get().weak_handle.expired()) return false;
 
     pending_tasks.erase(id);
 
@@ -328,36 +418,17 @@ bool AssetInfos::process_handle_destruction(const UntypedAssetId& id) {
         remove_dependents_and_labels(info, loader_dependents, path, living_labeled_assets);
     }
 
-    if (auto it = path_to_ids.find(path); it != path_to_ids.end()) {
-        auto& type_map = it->second;
-        type_map.erase(type_index);
-        if (type_map.empty()) {
-            path_to_ids.erase(it);
-        }
-    }
+    paths->erase(path, type_index);
     return true;
 }
 std::optional<std::reference_wrapper<const AssetInfo>> AssetInfos::get_info(const UntypedAssetId& id) const {
-    auto it = infos.find(id);
-    if (it != infos.end()) {
-        return std::cref(it->second);
-    }
+    if (auto info = infos.find(id)) return std::cref(*info);
     return std::nullopt;
 }
 std::optional<std::reference_wrapper<AssetInfo>> AssetInfos::get_info_mut(const UntypedAssetId& id) {
-    auto it = infos.find(id);
-    if (it != infos.end()) {
-        return std::ref(it->second);
-    }
+    if (auto info = infos.find(id)) return std::ref(*info);
     return std::nullopt;
 }
-epix::utils::input_iterable<UntypedAssetId> AssetInfos::get_path_ids(const AssetPath& path) const {
-    auto it = path_to_ids.find(path);
-    if (it != path_to_ids.end()) {
-        return std::views::values(it->second);
-    }
-    return epix::utils::input_iterable<UntypedAssetId>{};
-}
 std::optional<UntypedHandle> AssetInfos::get_handle_by_id(const UntypedAssetId& id) const {
     return get_info(id).and_then([](const AssetInfo& info) -> std::optional<UntypedHandle> {
         if (auto handle = info.weak_handle.lock()) return UntypedHandle(handle);
@@ -413,22 +484,15 @@ auto AssetInfos::get_or_create_handle_internal(const AssetPath& path,
                                                HandleLoadingMode loading_mode,
                                                std::optional<MetaTransform> meta_transform)
     -> std::expected<std::pair<UntypedHandle, bool>, GetOrCreateHandleInternalError> {
-    auto& handles = path_to_ids[path];
-
-    type = type.or_else([&]() -> std::optional<epix::meta::type_index> {
-        if (handles.size() == 1) {
-            return handles.begin()->first;
-        }
-        return std::nullopt;
-    });
+    type = type.or_else([&]() { return paths->single_type(path); });
     if (!type)
         return std::unexpected(
             GetOrCreateHandleInternalError{get_or_create_handle_internal_errors::HandleMissingButTypeIdNotSpecified{}});
     auto type_index = *type;
 
-    if (auto handle_it = handles.find(type_index); handle_it != handles.end()) {
-        auto& id         = handle_it->second;
-        auto& info       = infos.at(id);
+    if (auto existing = paths->find(path, type_index)) {
+        auto id          = *existing;
+        auto& info       = *infos.find(id);
         bool should_load = false;
         if (loading_mode == HandleLoadingMode::Force ||
             (loading_mode == HandleLoadingMode::Request &&
@@ -449,8 +513,15 @@ auto AssetInfos::get_or_create_handle_internal(const AssetPath& path,
             // AssetInfo exists but handle released. This means Assets::handle_events haven't been run to remove the
             // asset.
 
-            // We can just create a new strong handle for that.
-            info.handle_destruct_skip++;
+            // We can just create a new strong handle for that; it counts in the slot again, so the
+            // sweep of dropped handles skips it.
+            // a load started for the released handle stops once it sees the handle gone, so a
+            // requested load is started again rather than left waiting on it.
+            if (loading_mode == HandleLoadingMode::Request && !should_load &&
+                std::holds_alternative<LoadStateOK>(info.state) &&
+                std::get<LoadStateOK>(info.state) == LoadStateOK::Loading) {
+                should_load = true;
+            }
             auto provider_it = handle_providers.find(type_index);
             if (provider_it == handle_providers.end())
                 return std::unexpected(GetOrCreateHandleInternalError{
@@ -466,11 +537,29 @@ auto AssetInfos::get_or_create_handle_internal(const AssetPath& path,
                                                   type_index, path, std::move(meta_transform), should_load);
         if (!handle_res) return std::unexpected(handle_res.error());
         auto handle = std::move(handle_res.value());
-        handles.emplace(type_index, handle.id());
+        paths->insert(path, type_index, handle.id());
         infos_generation++;
         return std::make_pair(UntypedHandle(handle), should_load);
     }
 }
+std::optional<UntypedHandle> AssetInfos::get_existing_handle(const AssetPath& path,
+                                                             std::optional<epix::meta::type_index> type,
+                                                             HandleLoadingMode loading_mode) const {
+    if (loading_mode == HandleLoadingMode::Force) return std::nullopt;
+    type = type.or_else([&]() { return paths->single_type(path); });
+    if (!type) return std::nullopt;
+    auto id = paths->find(path, *type);
+    if (!id) return std::nullopt;
+    auto* info = infos.find(*id);
+    if (!info) return std::nullopt;
+    // a requested load starts again for an asset never loaded or failed, which changes its state.
+    if (loading_mode == HandleLoadingMode::Request) {
+        auto* state = std::get_if<LoadStateOK>(&info->state);
+        if (!state || *state == LoadStateOK::NotLoaded) return std::nullopt;
+    }
+    if (auto handle = info->weak_handle.lock()) return UntypedHandle(handle);
+    return std::nullopt;
+}
 UntypedHandle AssetInfos::create_loading_handle_untyped(epix::meta::type_index type_id) {
     // Use an empty (pathless) AssetPath with Force mode so a fresh handle is always created.
     // Matches bevy_asset's AssetInfos::create_loading_handle_untyped.
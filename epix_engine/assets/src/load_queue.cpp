@@ -0,0 +1,93 @@
+module;
+
+module epix.assets;
+
+import std;
+import epix.utils;
+
+namespace epix::assets {
+void LoadQueue::push(const UntypedAssetId& id, AssetPath path, LoadPriority priority) {
+    std::lock_guard lock(m_mutex);
+    if (auto it = m_entries.find(id); it != m_entries.end()) {
+        if (priority < it->second.priority) {
+            m_order.erase({it->second.priority, it->second.sequence});
+            it->second.priority = priority;
+            m_order.emplace(std::pair{priority, it->second.sequence}, id);
+        }
+        return;
+    }
+    auto sequence = m_next_sequence++;
+    m_entries.emplace(id, Entry{std::move(path), priority, sequence, std::chrono::steady_clock::now()});
+    m_order.emplace(std::pair{priority, sequence}, id);
+}
+
+std::optional<LoadQueue::Load> LoadQueue::pop() {
+    std::lock_guard lock(m_mutex);
+    if (m_order.empty() || m_in_flight >= m_max_in_flight) return std::nullopt;
+    auto order = m_order.begin();
+    auto id    = order->second;
+    m_order.erase(order);
+    auto entry = m_entries.extract(id);
+    m_in_flight++;
+    return Load{id, std::move(entry.mapped().path), entry.mapped().priority, entry.mapped().queued_at};
+}
+
+void LoadQueue::release() {
+    std::lock_guard lock(m_mutex);
+    m_in_flight--;
+}
+
+bool LoadQueue::set_priority(const UntypedAssetId& id, LoadPriority priority, bool only_raise) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) return false;
+    auto& entry = it->second;
+    if (entry.priority == priority || (only_raise && priority > entry.priority)) return true;
+    m_order.erase({entry.priority, entry.sequence});
+    entry.priority = priority;
+    entry.sequence = m_next_sequence++;
+    m_order.emplace(std::pair{priority, entry.sequence}, id);
+    return true;
+}
+
+bool LoadQueue::cancel(const UntypedAssetId& id) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_entries.find(id);
+    if (it == m_entries.end()) return false;
+    m_order.erase({it->second.priority, it->second.sequence});
+    m_entries.erase(it);
+    return true;
+}
+
+void LoadQueue::set_max_in_flight(std::size_t max) {
+    std::lock_guard lock(m_mutex);
+    m_max_in_flight = max;
+}
+
+std::size_t LoadQueue::size() const {
+    std::lock_guard lock(m_mutex);
+    return m_entries.size();
+}
+
+bool PublishedAssetSlots::try_acquire() {
+    std::lock_guard lock(m_mutex);
+    if (m_max_in_flight != 0 && m_in_flight >= m_max_in_flight) return false;
+    m_in_flight++;
+    return true;
+}
+
+void PublishedAssetSlots::release() {
+    std::lock_guard lock(m_mutex);
+    m_in_flight--;
+}
+
+void PublishedAssetSlots::set_max_in_flight(std::size_t max) {
+    std::lock_guard lock(m_mutex);
+    m_max_in_flight = max;
+}
+
+std::size_t PublishedAssetSlots::in_flight() {
+    std::lock_guard lock(m_mutex);
+    return m_in_flight;
+}
+}  // namespace epix::assets
@@ -1,5 +1,9 @@
 ﻿module;
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define EPIX_ASSETS_HASH_SSE2
+#endif
 #include <spdlog/spdlog.h>
 #include <zpp_bits.h>
 
@@ -11,23 +15,361 @@ namespace epix::assets {
 
 // ---------------------------------------------------------------------------
 // AssetHasher (internal — not exported)
+// BLAKE3 in hash mode, 32-byte output. Full chunks are compressed four at a time, one per SIMD
+// lane, and large inputs may be split into subtrees hashed on separate threads. The tree shape is
+// fixed by the chunk counters, so the result does not depend on how the input is split across
+// updates.
 // ---------------------------------------------------------------------------
 
+namespace {
+namespace blake3 {
+constexpr std::size_t BLOCK_LEN = 64;
+constexpr std::size_t CHUNK_LEN = 1024;
+constexpr std::size_t LANES     = 4;
+// a subtree of at least this many chunks per half is worth a thread of its own (4 MiB).
+constexpr std::size_t PARALLEL_MIN_CHUNKS = 4096;
+
+constexpr std::uint32_t CHUNK_START = 1 << 0;
+constexpr std::uint32_t CHUNK_END   = 1 << 1;
+constexpr std::uint32_t PARENT      = 1 << 2;
+constexpr std::uint32_t ROOT        = 1 << 3;
+
+using Words = std::array<std::uint32_t, 8>;
+
+constexpr Words IV = {0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A,
+                      0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19};
+
+// message word order of each round: the BLAKE3 permutation applied round after round.
+constexpr auto MSG_SCHEDULE = [] {
+    constexpr std::array<std::uint8_t, 16> permutation = {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8};
+    std::array<std::array<std::uint8_t, 16>, 7> schedule{};
+    for (std::uint8_t i = 0; i < 16; i++) schedule[0][i] = i;
+    for (std::size_t r = 1; r < 7; r++) {
+        for (std::size_t i = 0; i < 16; i++) schedule[r][i] = schedule[r - 1][permutation[i]];
+    }
+    return schedule;
+}();
+
+std::uint32_t load_le32(const std::uint8_t* p) {
+    return std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8 | std::uint32_t(p[2]) << 16 | std::uint32_t(p[3]) << 24;
+}
+
+/** @brief Four 32-bit lanes, one chunk per lane. */
+#ifdef EPIX_ASSETS_HASH_SSE2
+struct Vec {
+    __m128i v;
+
+    static Vec splat(std::uint32_t x) { return {_mm_set1_epi32(static_cast<int>(x))}; }
+    static Vec set(std::uint32_t x0, std::uint32_t x1, std::uint32_t x2, std::uint32_t x3) {
+        return {_mm_setr_epi32(static_cast<int>(x0), static_cast<int>(x1), static_cast<int>(x2), static_cast<int>(x3))};
+    }
+    static Vec load(const std::uint8_t* p) { return {_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))}; }
+    void store(std::uint32_t* out) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(out), v); }
+    friend Vec operator+(Vec a, Vec b) { return {_mm_add_epi32(a.v, b.v)}; }
+    friend Vec operator^(Vec a, Vec b) { return {_mm_xor_si128(a.v, b.v)}; }
+    template <int N>
+    friend Vec rotr(Vec a) {
+        return {_mm_or_si128(_mm_srli_epi32(a.v, N), _mm_slli_epi32(a.v, 32 - N))};
+    }
+    /** @brief Transpose four vectors as the rows of a 4x4 matrix. */
+    static void transpose(Vec& a, Vec& b, Vec& c, Vec& d) {
+        auto ab_lo = _mm_unpacklo_epi32(a.v, b.v), ab_hi = _mm_unpackhi_epi32(a.v, b.v);
+        auto cd_lo = _mm_unpacklo_epi32(c.v, d.v), cd_hi = _mm_unpackhi_epi32(c.v, d.v);
+        a.v = _mm_unpacklo_epi64(ab_lo, cd_lo);
+        b.v = _mm_unpackhi_epi64(ab_lo, cd_lo);
+        c.v = _mm_unpacklo_epi64(ab_hi, cd_hi);
+        d.v = _mm_unpackhi_epi64(ab_hi, cd_hi);
+    }
+};
+#else
+// portable lanes, left to the compiler's vectorizer.
+struct Vec {
+    std::array<std::uint32_t, 4> v;
+
+    static Vec splat(std::uint32_t x) { return {{x, x, x, x}}; }
+    static Vec set(std::uint32_t x0, std::uint32_t x1, std::uint32_t x2, std::uint32_t x3) {
+        return {{x0, x1, x2, x3}};
+    }
+    static Vec load(const std::uint8_t* p) {
+        return {{load_le32(p), load_le32(p + 4), load_le32(p + 8), load_le32(p + 12)}};
+    }
+    void store(std::uint32_t* out) const { std::ranges::copy(v, out); }
+    friend Vec operator+(Vec a, Vec b) {
+        for (std::size_t i = 0; i < 4; i++) a.v[i] += b.v[i];
+        return a;
+    }
+    friend Vec operator^(Vec a, Vec b) {
+        for (std::size_t i = 0; i < 4; i++) a.v[i] ^= b.v[i];
+        return a;
+    }
+    template <int N>
+    friend Vec rotr(Vec a) {
+        for (auto& x : a.v) x = std::rotr(x, N);
+        return a;
+    }
+    static void transpose(Vec& a, Vec& b, Vec& c, Vec& d) {
+        std::array<Vec*, 4> rows = {&a, &b, &c, &d};
+        for (std::size_t i = 0; i < 4; i++) {
+            for (std::size_t j = i + 1; j < 4; j++) std::swap(rows[i]->v[j], rows[j]->v[i]);
+        }
+    }
+};
+#endif
+
+template <int N>
+std::uint32_t rotr(std::uint32_t x) {
+    return std::rotr(x, N);
+}
+
+/** @brief The G mixing function over state words `a`, `b`, `c`, `d`, for one state or four. */
+template <typename T>
+void g(T (&v)[16], std::size_t a, std::size_t b, std::size_t c, std::size_t d, T x, T y) {
+    v[a] = v[a] + v[b] + x;
+    v[d] = rotr<16>(v[d] ^ v[a]);
+    v[c] = v[c] + v[d];
+    v[b] = rotr<12>(v[b] ^ v[c]);
+    v[a] = v[a] + v[b] + y;
+    v[d] = rotr<8>(v[d] ^ v[a]);
+    v[c] = v[c] + v[d];
+    v[b] = rotr<7>(v[b] ^ v[c]);
+}
+
+template <typename T>
+void rounds(T (&v)[16], const T (&m)[16]) {
+    for (auto& s : MSG_SCHEDULE) {
+        // columns, then diagonals.
+        g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+        g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+        g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+        g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+        g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+        g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+        g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+        g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+    }
+}
+
+/** @brief Compress one block, returning the full 16-word state (the first 8 words are the new CV). */
+std::array<std::uint32_t, 16> compress(
+    const Words& cv, const std::uint8_t* block, std::uint32_t block_len, std::uint64_t counter, std::uint32_t flags) {
+    std::uint32_t m[16];
+    for (std::size_t i = 0; i < 16; i++) m[i] = load_le32(block + 4 * i);
+    std::uint32_t v[16] = {cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+                           IV[0], IV[1], IV[2], IV[3], std::uint32_t(counter), std::uint32_t(counter >> 32),
+                           block_len, flags};
+    rounds(v, m);
+    std::array<std::uint32_t, 16> out;
+    for (std::size_t i = 0; i < 8; i++) {
+        out[i]     = v[i] ^ v[i + 8];
+        out[i + 8] = v[i + 8] ^ cv[i];
+    }
+    return out;
+}
+
+/** @brief A node not yet compressed: the chunk's last block or a parent block. */
+struct Output {
+    Words cv;
+    std::array<std::uint8_t, BLOCK_LEN> block;
+    std::uint32_t block_len;
+    std::uint64_t counter;
+    std::uint32_t flags;
+
+    Words chaining_value() const {
+        auto out = compress(cv, block.data(), block_len, counter, flags);
+        Words result;
+        std::copy_n(out.begin(), 8, result.begin());
+        return result;
+    }
+    AssetHash root_hash() const {
+        auto out = compress(cv, block.data(), block_len, 0, flags | ROOT);
+        AssetHash result;
+        for (std::size_t i = 0; i < 32; i++) result[i] = std::uint8_t(out[i / 4] >> (8 * (i % 4)));
+        return result;
+    }
+};
+
+Output parent_output(const Words& left, const Words& right) {
+    Output output{IV, {}, BLOCK_LEN, 0, PARENT};
+    for (std::size_t i = 0; i < 8; i++) {
+        for (std::size_t b = 0; b < 4; b++) {
+            output.block[4 * i + b]      = std::uint8_t(left[i] >> (8 * b));
+            output.block[32 + 4 * i + b] = std::uint8_t(right[i] >> (8 * b));
+        }
+    }
+    return output;
+}
+
+Words parent_cv(const Words& left, const Words& right) { return parent_output(left, right).chaining_value(); }
+
+struct ChunkState {
+    Words cv                 = IV;
+    std::uint64_t counter    = 0;
+    std::array<std::uint8_t, BLOCK_LEN> buf{};
+    std::uint32_t buf_len    = 0;
+    std::uint32_t blocks_compressed = 0;
+
+    std::size_t len() const { return BLOCK_LEN * blocks_compressed + buf_len; }
+    std::uint32_t start_flag() const { return blocks_compressed == 0 ? CHUNK_START : 0; }
+
+    void compress_block(const std::uint8_t* block) {
+        auto out = compress(cv, block, BLOCK_LEN, counter, start_flag());
+        std::copy_n(out.begin(), 8, cv.begin());
+        blocks_compressed++;
+    }
+    void update(const std::uint8_t* input, std::size_t len) {
+        // the last block is kept back, only the output knows whether it ends the chunk.
+        while (len > 0) {
+            if (buf_len == BLOCK_LEN) {
+                compress_block(buf.data());
+                buf_len = 0;
+                buf.fill(0);
+            }
+            if (buf_len == 0 && len > BLOCK_LEN) {
+                compress_block(input);
+                input += BLOCK_LEN;
+                len -= BLOCK_LEN;
+                continue;
+            }
+            auto take = std::min<std::size_t>(BLOCK_LEN - buf_len, len);
+            std::memcpy(buf.data() + buf_len, input, take);
+            buf_len += static_cast<std::uint32_t>(take);
+            input += take;
+            len -= take;
+        }
+    }
+    Output output() const { return Output{cv, buf, buf_len, counter, start_flag() | CHUNK_END}; }
+};
+
+/** @brief Chaining values of `LANES` consecutive full chunks, compressed in lockstep. */
+void hash_chunks_wide(const std::uint8_t* input, std::uint64_t counter, Words* out) {
+    Vec cv[8];
+    for (std::size_t w = 0; w < 8; w++) cv[w] = Vec::splat(IV[w]);
+    auto counter_lo = Vec::set(std::uint32_t(counter), std::uint32_t(counter + 1), std::uint32_t(counter + 2),
+                               std::uint32_t(counter + 3));
+    auto counter_hi = Vec::set(std::uint32_t(counter >> 32), std::uint32_t((counter + 1) >> 32),
+                               std::uint32_t((counter + 2) >> 32), std::uint32_t((counter + 3) >> 32));
+    for (std::size_t block = 0; block < CHUNK_LEN / BLOCK_LEN; block++) {
+        // load 4 words of each chunk per row, then transpose so lane l holds chunk l.
+        Vec m[16];
+        auto blocks = input + block * BLOCK_LEN;
+        for (std::size_t q = 0; q < 16; q += 4) {
+            for (std::size_t l = 0; l < LANES; l++) m[q + l] = Vec::load(blocks + l * CHUNK_LEN + 4 * q);
+            Vec::transpose(m[q], m[q + 1], m[q + 2], m[q + 3]);
+        }
+        auto flags = (block == 0 ? CHUNK_START : 0) | (block == CHUNK_LEN / BLOCK_LEN - 1 ? CHUNK_END : 0);
+        Vec v[16]  = {cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+                      Vec::splat(IV[0]), Vec::splat(IV[1]), Vec::splat(IV[2]), Vec::splat(IV[3]),
+                      counter_lo, counter_hi, Vec::splat(BLOCK_LEN), Vec::splat(flags)};
+        rounds(v, m);
+        for (std::size_t w = 0; w < 8; w++) cv[w] = v[w] ^ v[w + 8];
+    }
+    Vec::transpose(cv[0], cv[1], cv[2], cv[3]);
+    Vec::transpose(cv[4], cv[5], cv[6], cv[7]);
+    for (std::size_t l = 0; l < LANES; l++) {
+        cv[l].store(out[l].data());
+        cv[4 + l].store(out[l].data() + 4);
+    }
+}
+
+/** @brief Chaining value of a complete subtree of `chunks` full chunks, a power of two.
+ *  @param threads How many threads this subtree may use, including the calling one. */
+Words subtree_cv(const std::uint8_t* input, std::size_t chunks, std::uint64_t counter, unsigned threads) {
+    if (chunks == 1) {
+        ChunkState chunk{.counter = counter};
+        chunk.update(input, CHUNK_LEN);
+        return chunk.output().chaining_value();
+    }
+    if (chunks <= LANES) {
+        std::array<Words, LANES> cvs;
+        if (chunks == LANES) {
+            hash_chunks_wide(input, counter, cvs.data());
+        } else {
+            for (std::size_t i = 0; i < chunks; i++) cvs[i] = subtree_cv(input + i * CHUNK_LEN, 1, counter + i, 1);
+        }
+        for (std::size_t n = chunks; n > 1; n /= 2) {
+            for (std::size_t i = 0; i < n / 2; i++) cvs[i] = parent_cv(cvs[2 * i], cvs[2 * i + 1]);
+        }
+        return cvs[0];
+    }
+    auto half = chunks / 2;
+    auto right_input = input + half * CHUNK_LEN;
+    if (threads > 1 && half >= PARALLEL_MIN_CHUNKS) {
+        std::future<Words> left;
+        try {
+            left = std::async(std::launch::async, subtree_cv, input, half, counter, threads / 2);
+        } catch (const std::system_error&) {
+            // no thread to spare, hash both halves here.
+            return parent_cv(subtree_cv(input, half, counter, threads - threads / 2),
+                             subtree_cv(right_input, half, counter + half, threads - threads / 2));
+        }
+        auto right = subtree_cv(right_input, half, counter + half, threads - threads / 2);
+        return parent_cv(left.get(), right);
+    }
+    return parent_cv(subtree_cv(input, half, counter, 1), subtree_cv(right_input, half, counter + half, 1));
+}
+}  // namespace blake3
+}  // namespace
+
 struct AssetHasher {
-    uint64_t s[4] = {
-        0xcbf29ce484222325ULL,  // FNV-1a 64-bit offset basis
-        0x9e3779b97f4a7c15ULL,  // golden ratio x 2^64
-        0x6c62272e07bb0142ULL,  // random constant
-        0x14020a57acced8b7ULL,  // random constant
-    };
+    blake3::ChunkState chunk;
+    // one CV per set bit of the chunk count, 54 levels cover 2^64 bytes.
+    std::array<blake3::Words, 54> cv_stack;
+    std::size_t cv_stack_len = 0;
+    /** @brief Threads a single large update may use, the calling one included. */
+    unsigned threads = 1;
+
+    AssetHasher() = default;
+    explicit AssetHasher(unsigned threads) : threads(std::max(threads, 1u)) {}
+
+    // merge completed subtrees, keeping the last CV unmerged: it may still be the root's child.
+    void merge_cv_stack(std::uint64_t total_chunks) {
+        auto post_merge_len = static_cast<std::size_t>(std::popcount(total_chunks));
+        while (cv_stack_len > post_merge_len) {
+            cv_stack[cv_stack_len - 2] = blake3::parent_cv(cv_stack[cv_stack_len - 2], cv_stack[cv_stack_len - 1]);
+            cv_stack_len--;
+        }
+    }
+    void push_cv(const blake3::Words& cv, std::uint64_t chunk_counter) {
+        merge_cv_stack(chunk_counter);
+        cv_stack[cv_stack_len++] = cv;
+    }
 
     void update(const uint8_t* data, std::size_t len) noexcept {
-        for (std::size_t i = 0; i < len; ++i) {
-            const uint64_t b = data[i];
-            s[0]             = (s[0] ^ b) * 0x00000100000001B3ULL;
-            s[1]             = (s[1] + b) * 0x9e3779b97f4a7415ULL;
-            s[2] ^= (s[0] >> 17) | (s[0] << 47);
-            s[3] ^= (s[1] >> 23) | (s[1] << 41);
+        using blake3::CHUNK_LEN;
+        if (chunk.len() > 0) {
+            auto take = std::min(CHUNK_LEN - chunk.len(), len);
+            chunk.update(data, take);
+            data += take;
+            len -= take;
+            if (len == 0) return;
+            auto counter = chunk.counter;
+            push_cv(chunk.output().chaining_value(), counter);
+            chunk = blake3::ChunkState{.counter = counter + 1};
+        }
+        // whole subtrees are hashed straight from the input, as large as the chunk counter's
+        // alignment allows. The final chunk stays in `chunk`, it may be the root.
+        while (len > CHUNK_LEN) {
+            auto subtree_chunks = std::bit_floor(len / CHUNK_LEN);
+            while (chunk.counter % subtree_chunks != 0) subtree_chunks /= 2;
+            if (subtree_chunks * CHUNK_LEN == len) subtree_chunks = std::max<std::size_t>(subtree_chunks / 2, 1);
+            auto counter = chunk.counter;
+            if (subtree_chunks == 1) {
+                push_cv(blake3::subtree_cv(data, 1, counter, 1), counter);
+            } else {
+                // pushed as two halves so the subtree root can still become the hash root.
+                auto half  = subtree_chunks / 2;
+                auto left  = blake3::subtree_cv(data, half, counter, threads / 2 + threads % 2);
+                auto right = blake3::subtree_cv(data + half * CHUNK_LEN, half, counter + half, threads / 2);
+                push_cv(left, counter);
+                push_cv(right, counter + half);
+            }
+            chunk.counter += subtree_chunks;
+            data += subtree_chunks * CHUNK_LEN;
+            len -= subtree_chunks * CHUNK_LEN;
+        }
+        if (len > 0) {
+            chunk.update(data, len);
+            merge_cv_stack(chunk.counter);
         }
     }
 
@@ -36,16 +378,13 @@ struct AssetHasher {
     }
 
     AssetHash finish() noexcept {
-        for (auto& x : s) {
-            x ^= x >> 33;
-            x *= 0xff51afd7ed558ccdULL;
-            x ^= x >> 33;
-            x *= 0xc4ceb9fe1a85ec53ULL;
-            x ^= x >> 33;
+        auto output    = chunk.output();
+        auto remaining = cv_stack_len;
+        while (remaining > 0) {
+            remaining--;
+            output = blake3::parent_output(cv_stack[remaining], output.chaining_value());
         }
-        AssetHash result;
-        std::memcpy(result.data(), s, 32);
-        return result;
+        return output.root_hash();
     }
 };
 
@@ -85,8 +424,10 @@ std::expected<std::optional<ProcessedInfo>, std::errc> deserialize_processed_inf
 AssetHash get_asset_hash(std::span<const std::byte> meta_bytes, std::istream& reader) {
     AssetHasher hasher;
     hasher.update(meta_bytes);
-    char buf[8192];
-    while (reader.read(buf, sizeof(buf)) || reader.gcount() > 0) {
+    // a multiple of the 4-chunk SIMD width, so full chunks are hashed four at a time.
+    std::vector<char> storage(64 * 1024);
+    auto buf = storage.data();
+    while (reader.read(buf, static_cast<std::streamsize>(storage.size())) || reader.gcount() > 0) {
         hasher.update(std::span<const std::byte>(reinterpret_cast<const std::byte*>(buf),
                                                  static_cast<std::size_t>(reader.gcount())));
         if (reader.eof()) break;
@@ -94,6 +435,22 @@ AssetHash get_asset_hash(std::span<const std::byte> meta_bytes, std::istream& re
     return hasher.finish();
 }
 
+AssetHash get_asset_hash(std::span<const std::byte> meta_bytes, std::span<const std::byte> asset_bytes) {
+    AssetHasher hasher;
+    hasher.update(meta_bytes);
+    hasher.update(asset_bytes);
+    return hasher.finish();
+}
+
+AssetHash get_asset_hash(std::span<const std::byte> meta_bytes,
+                         std::span<const std::byte> asset_bytes,
+                         unsigned threads) {
+    AssetHasher hasher(threads);
+    hasher.update(meta_bytes);
+    hasher.update(asset_bytes);
+    return hasher.finish();
+}
+
 AssetHash get_full_asset_hash(AssetHash asset_hash, const std::vector<AssetHash>& dependency_hashes) {
     AssetHasher hasher;
     hasher.update(std::span<const std::byte>(reinterpret_cast<const std::byte*>(asset_hash.data()), asset_hash.size()));
@@ -63,6 +63,10 @@ void AssetPlugin::build(App& app) {
             if (use_asset_processor && processed.has_value()) {
                 auto processor = AssetProcessor(builders, watch,
                                                 std::make_unique<FileTransactionLogFactory>(processed.value() / "log"));
+                if (processed_cache_path) {
+                    processor.get_data()->set_processed_cache(
+                        std::make_shared<ProcessedAssetCache>(*processed_cache_path, processed_cache_size));
+                }
 
                 world.emplace_resource<AssetServer>(
                     processor.sources(), processor.get_server().get_loaders(), AssetServerMode::Processed,
@@ -98,13 +102,50 @@ void AssetPlugin::build(App& app) {
     app_register_asset<LoadedUntypedAsset>(app);
 
     app.add_events<UntypedAssetLoadFailedEvent>();
+    app.add_events<LabeledAssetPublishedEvent>();
+    world.init_resource<AssetServerDiagnostics>();
 
-    app.add_systems(Last, into(AssetServer::handle_internal_events));
+    app.add_systems(Last, into(AssetServer::handle_internal_events, publish_asset_server_diagnostics).chain());
     app.configure_sets(sets(AssetSystems::HandleEvents, AssetSystems::WriteEvents).chain());
 }
 
 void AssetPlugin::finish(App& app) { (void)app; }
 
+void epix::assets::publish_asset_server_diagnostics(ResMut<AssetServerDiagnostics> diagnostics,
+                                                    Res<AssetServer> server,
+                                                    std::optional<Res<AssetProcessor>> processor,
+                                                    Local<std::optional<AssetDiagnosticsSample>> last_sample) {
+    auto now      = std::chrono::steady_clock::now();
+    auto snapshot = server->diagnostics();
+    if (*last_sample) {
+        std::chrono::duration<double> elapsed = now - (*last_sample)->time;
+        if (elapsed.count() > 0) {
+            snapshot.bytes_read_per_second =
+                static_cast<double>(snapshot.bytes_read - (*last_sample)->bytes_read) / elapsed.count();
+        }
+    }
+
+    // walking every processed asset is skipped while the processor idles.
+    std::optional<ProcessorState> processor_state;
+    if (processor) processor_state = (*processor)->get_data()->state();
+    bool refresh = processor_state && (*processor_state != ProcessorState::Finished ||
+                                       !*last_sample || (*last_sample)->processor_state != processor_state);
+    if (refresh) {
+        auto times = (*processor)->get_data()->process_times();
+        for (auto& timing : times) snapshot.processing.record(timing.time);
+        auto slowest = std::min(times.size(), AssetServerDiagnostics::SLOWEST_PROCESSED);
+        std::ranges::partial_sort(times, times.begin() + slowest, std::ranges::greater{}, &ProcessedAssetTiming::time);
+        times.resize(slowest);
+        snapshot.slowest_processed_assets = std::move(times);
+    } else {
+        snapshot.processing               = std::move(diagnostics->processing);
+        snapshot.slowest_processed_assets = std::move(diagnostics->slowest_processed_assets);
+    }
+
+    *last_sample = AssetDiagnosticsSample{now, snapshot.bytes_read, processor_state};
+    *diagnostics = std::move(snapshot);
+}
+
 AssetPlugin& AssetPlugin::register_asset_source(AssetSourceId id, AssetSourceBuilder source) {
     m_source_builders.emplace_back(std::move(id), std::move(source));
     return *this;
@@ -0,0 +1,52 @@
+module;
+
+module epix.assets;
+
+import std;
+
+namespace epix::assets {
+namespace {
+constexpr std::string_view ASSET_EXTENSION = ".asset";
+constexpr std::string_view META_EXTENSION  = ".meta";
+}  // namespace
+
+ProcessedAssetCache::ProcessedAssetCache(std::filesystem::path root, std::uint64_t max_bytes)
+    : m_store(std::move(root), std::string(META_EXTENSION)), m_max_bytes(max_bytes) {}
+
+AssetHash ProcessedAssetCache::key(const AssetHash& input_hash, std::string_view processor, std::uint32_t version) {
+    auto tag = std::format("{}\n{}\n{}", META_FORMAT_VERSION, processor, version);
+    return get_asset_hash(std::as_bytes(std::span(tag)), std::as_bytes(std::span(input_hash)));
+}
+
+std::optional<ProcessedAssetCache::Entry> ProcessedAssetCache::find(const AssetHash& key) {
+    auto asset_path = m_store.entry_path(key, ASSET_EXTENSION);
+    std::ifstream stream(m_store.entry_path(key, META_EXTENSION), std::ios::binary);
+    std::error_code ec;
+    if (!stream || !std::filesystem::is_regular_file(asset_path, ec)) {
+        m_store.record_miss();
+        return std::nullopt;
+    }
+    Entry entry{.asset = std::move(asset_path)};
+    entry.meta = std::views::istream<char>(stream >> std::noskipws) |
+                 std::views::transform([](char c) { return static_cast<std::byte>(c); }) |
+                 std::ranges::to<std::vector<std::byte>>();
+    // the meta file carries the use time, the asset file may be linked into processed trees.
+    m_store.touch(key);
+    m_store.record_hit();
+    return entry;
+}
+
+bool ProcessedAssetCache::store(const AssetHash& key,
+                                std::span<const std::byte> asset,
+                                std::span<const std::byte> meta) {
+    // the meta file goes last: an entry without it is not found and is collected later.
+    if (!m_store.store(key, {{ASSET_EXTENSION, {asset}}, {META_EXTENSION, {meta}}})) return false;
+    m_grown.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+std::uint64_t ProcessedAssetCache::collect_garbage() {
+    m_grown.store(false, std::memory_order_relaxed);
+    return m_store.collect_garbage(m_max_bytes);
+}
+}  // namespace epix::assets
@@ -302,6 +302,20 @@ std::shared_ptr<ErasedProcessor> AssetProcessor::get_default_processor(std::stri
     return proc_it->second;
 }
 
+std::expected<std::size_t, AssetWriterError> AssetProcessor::write_archive(const AssetSourceId& source_id,
+                                                                         const std::filesystem::path& output) const {
+    auto failed = [](std::errc code) {
+        return std::unexpected(AssetWriterError(writer_errors::IoError{std::make_error_code(code)}));
+    };
+    data->wait_until_finished();
+    auto source = get_source(source_id);
+    if (!source) return failed(std::errc::no_such_device);
+    // read past the processor gate, processing is finished anyway.
+    auto reader = source->get().ungated_processed_reader().or_else([&] { return source->get().processed_reader(); });
+    if (!reader) return failed(std::errc::not_supported);
+    return write_asset_archive(reader->get(), output);
+}
+
 std::expected<std::shared_ptr<ErasedProcessor>, GetProcessorError> AssetProcessor::get_processor(
     std::string_view type_name) const {
     auto guard = data->processors.read();
@@ -409,8 +423,13 @@ void AssetProcessor::process_asset(
     }
     auto& source     = source_opt->get();
     auto asset_path  = AssetPath(source.id(), path);
+    auto start       = std::chrono::steady_clock::now();
     auto result      = process_asset_internal(source, asset_path);
+    auto elapsed     = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
     auto infos_guard = data->processing_state->m_asset_infos.write();
+    infos_guard->get_or_insert(asset_path).process_time = elapsed;
+    spdlog::debug("[assets.processor] Processed {} in {:.3f} ms", asset_path.string(),
+                  std::chrono::duration<double, std::milli>(elapsed).count());
     infos_guard->finish_processing(asset_path, result, reprocess_sender);
 }
 
@@ -473,10 +492,7 @@ std::expected<ProcessResult, ProcessError> AssetProcessor::process_asset_interna
         // Hash = (.meta bytes if present) + asset bytes — used only for in-memory skip-check.
         std::vector<std::byte> meta_bytes_for_hash = meta_raw ? std::move(*meta_raw) : std::vector<std::byte>{};
         AssetHash new_hash                         = {};
-        {
-            auto hash_reader = reader.read(path);
-            if (hash_reader) new_hash = get_asset_hash(meta_bytes_for_hash, **hash_reader);
-        }
+        if (auto bytes = reader.read_bytes(path)) new_hash = get_asset_hash(meta_bytes_for_hash, bytes->bytes());
 
         // Skip if unchanged (in-memory; nothing is written to the processed output).
         {
@@ -561,13 +577,11 @@ std::expected<ProcessResult, ProcessError> AssetProcessor::process_asset_interna
         }
     }
 
-    // 2b. Compute new_hash = hash(meta_bytes + asset_bytes)
-    AssetHash new_hash = {};
-    {
-        auto hash_reader = reader.read(path);
-        if (!hash_reader) return std::unexpected(reader_err(hash_reader.error()));
-        new_hash = get_asset_hash(meta_bytes_for_hash, **hash_reader);
-    }
+    // 2b. Read the source once (mapped where the reader supports it), and compute
+    //     new_hash = hash(meta_bytes + asset_bytes) over the same bytes the processor reads.
+    auto source_bytes = reader.read_bytes(path);
+    if (!source_bytes) return std::unexpected(reader_err(source_bytes.error()));
+    AssetHash new_hash = get_asset_hash(meta_bytes_for_hash, source_bytes->bytes());
 
     // 3. Skip-unchanged check (hash-based fallback when mtime unavailable)
     {
@@ -589,6 +603,34 @@ std::expected<ProcessResult, ProcessError> AssetProcessor::process_asset_interna
         }
     }
 
+    // 3b. Look the output up in the processed cache. An entry was processed from the same bytes by the
+    //     same processor, it is only valid if the dependencies it was processed with are unchanged.
+    auto cache     = data->processed_cache();
+    auto cache_key = ProcessedAssetCache::key(new_hash, processor->type_path(), processor->version());
+    std::optional<ProcessedAssetCache::Entry> cached;
+    std::unique_ptr<AssetMetaDyn> cached_meta;
+    if (cache) {
+        auto dependencies_match = [&](const ProcessedInfo& info) {
+            for (const auto& dep : info.process_dependencies) {
+                auto dep_path = AssetPath(dep.path);
+                if (data->wait_until_processed(dep_path) != ProcessStatus::Processed) return false;
+                auto infos_guard     = data->processing_state->m_asset_infos.read();
+                const auto* dep_info = infos_guard->get(dep_path);
+                if (!dep_info || !dep_info->processed_info || dep_info->processed_info->full_hash != dep.full_hash) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (auto entry = cache->find(cache_key)) {
+            auto meta = processor->deserialize_meta(entry->meta);
+            if (meta && (*meta)->processed_info() && dependencies_match(*(*meta)->processed_info())) {
+                cached      = std::move(entry);
+                cached_meta = std::move(*meta);
+            }
+        }
+    }
+
     // 4. Acquire transaction lock and log
     auto _transaction_lock = [&]() -> std::shared_ptr<std::shared_mutex> {
         auto infos_guard = data->processing_state->m_asset_infos.write();
@@ -599,21 +641,49 @@ std::expected<ProcessResult, ProcessError> AssetProcessor::process_asset_interna
 
     log_begin_processing(asset_path);
 
-    // 5. Open streams for the actual process
-    auto source_stream = reader.read(path);
-    if (!source_stream) return std::unexpected(reader_err(source_stream.error()));
+    if (cached) {
+        // the cached info only differs in the source timestamp of this tree.
+        auto& cached_info           = *cached_meta->processed_info_mut();
+        cached_info.source_mtime_ns = current_mtime_ns;
+        auto linked                 = processed_writer.write_from_file(path, cached->asset);
+        if (!linked) return std::unexpected(writer_err(linked.error()));
+        auto meta_write = processed_writer.write_meta_bytes(path, cached_meta->serialize_bytes());
+        if (!meta_write) return std::unexpected(writer_err(meta_write.error()));
+        log_end_processing(asset_path);
+        return ProcessResult{ProcessResultKind::Processed, cached_info};
+    }
 
-    auto dest_stream = processed_writer.write(path);
-    if (!dest_stream) return std::unexpected(writer_err(dest_stream.error()));
+    // 5. Open streams for the actual process. With a cache the output is buffered, it is written
+    //    both to the processed tree and to the cache.
+    std::ispanstream source_stream(
+        std::span(reinterpret_cast<const char*>(source_bytes->data()), source_bytes->size()), std::ios::binary);
+
+    std::unique_ptr<std::ostream> dest_stream;
+    std::ostringstream buffered_output(std::ios::binary);
+    if (!cache) {
+        auto stream = processed_writer.write(path);
+        if (!stream) return std::unexpected(writer_err(stream.error()));
+        dest_stream = std::move(*stream);
+    }
+    std::ostream& output = dest_stream ? *dest_stream : buffered_output;
 
     // 6. Process
     ProcessedInfo new_processed_info;
     new_processed_info.hash            = new_hash;
     new_processed_info.full_hash       = new_hash;
     new_processed_info.source_mtime_ns = current_mtime_ns;
-    ProcessContext context(*this, asset_path, **source_stream, new_processed_info);
-
-    auto process_result = processor->process(context, *settings_to_use, **dest_stream);
+    ProcessContext context(*this, asset_path, source_stream, new_processed_info);
+
+    auto process_result = [&] {
+        struct CpuSlot {
+            const AssetProcessorData& data;
+            bool held;
+            ~CpuSlot() {
+                if (held) data.release_cpu_slot();
+            }
+        } slot{*data, data->acquire_cpu_slot()};
+        return processor->process(context, *settings_to_use, output);
+    }();
     if (!process_result) {
         return std::unexpected(std::move(process_result.error()));
     }
@@ -632,6 +702,16 @@ std::expected<ProcessResult, ProcessError> AssetProcessor::process_asset_interna
     // 8. Embed ProcessedInfo in the processed meta and write meta file
     processed_meta->processed_info_mut() = new_processed_info;
     auto processed_meta_bytes            = processed_meta->serialize_bytes();
+    if (cache) {
+        auto processed_bytes = std::move(buffered_output).str();
+        auto asset_bytes     = std::as_bytes(std::span(processed_bytes));
+        auto asset_write     = processed_writer.write_bytes(path, asset_bytes);
+        if (!asset_write) return std::unexpected(writer_err(asset_write.error()));
+        if (!cache->store(cache_key, asset_bytes, processed_meta_bytes)) {
+            spdlog::debug("Could not store {} in the processed cache at {}", asset_path.string(),
+                          cache->root().string());
+        }
+    }
     if (!processed_meta_bytes.empty()) {
         auto meta_write = processed_writer.write_meta_bytes(path, processed_meta_bytes);
         if (!meta_write) return std::unexpected(writer_err(meta_write.error()));
@@ -858,10 +938,21 @@ void AssetProcessor::execute_processing_tasks(
     // from file-watcher senders later); if it returns a value we'll re-inject it below.
     using Task = std::pair<AssetSourceId, std::filesystem::path>;
 
+    // trim the processed cache in the background once the outputs of this run are stored.
+    auto set_finished = [this] {
+        data->processing_state->set_state(ProcessorState::Finished);
+        if (auto cache = data->processed_cache(); cache && cache->needs_collection()) {
+            utils::IOTaskPool::instance().detach_task([cache] { cache->collect_garbage(); });
+        }
+    };
+
     struct StartTaskEvent {
         Task task;
     };
-    struct FinishedTaskEvent {};
+    struct FinishedTaskEvent {
+        AssetPath path;
+        bool popped;
+    };
     struct InputClosedEvent {};
     using ProcessingTaskEvent = std::variant<StartTaskEvent, FinishedTaskEvent, InputClosedEvent>;
 
@@ -874,7 +965,7 @@ void AssetProcessor::execute_processing_tasks(
         if (!first) {
             if (first.error() == utils::ReceiveError::Empty) {
                 // No tasks are queued right now; go to Finished immediately.
-                data->processing_state->set_state(ProcessorState::Finished);
+                set_finished();
             }
             // If Closed, the InputClosedEvent from the forwarding thread handles it.
         } else {
@@ -898,13 +989,51 @@ void AssetProcessor::execute_processing_tasks(
         }
     });
 
-    int pending_tasks = 0;
+    // Tasks are queued in dependency order and started up to the task limit. A thread about to
+    // wait for a queued asset processes it inline through the steal hook. The hook holds the
+    // processor weakly, like the source change listeners, so it does not keep it alive.
+    auto scheduler        = std::make_shared<ProcessingScheduler>();
+    auto weak_data        = std::weak_ptr<AssetProcessorData>(data);
+    auto weak_server_data = std::weak_ptr<AssetServerData>(server.data);
+    *data->processing_state->m_run_queued.lock() = [scheduler, weak_data, weak_server_data, weak_sender,
+                                                    event_sender](const AssetPath& path) {
+        auto locked_data        = weak_data.lock();
+        auto locked_server_data = weak_server_data.lock();
+        auto upgraded           = weak_sender.upgrade();
+        if (!locked_data || !locked_server_data || !upgraded) return;
+        auto task = scheduler->steal(path);
+        if (!task) return;
+        AssetServer tmp_server;
+        tmp_server.data = locked_server_data;
+        AssetProcessor(std::move(tmp_server), locked_data).process_asset(task->first, task->second, *upgraded);
+        event_sender.send(FinishedTaskEvent{path, false});
+    };
+
+    auto start_ready_tasks = [&] {
+        auto limit = data->processing_limits().tasks;
+        while (auto task = scheduler->pop(limit)) {
+            auto upgraded = weak_sender.upgrade();
+            if (!upgraded) {
+                scheduler->finish(AssetPath(task->first, task->second), true);
+                continue;
+            }
+            auto p  = *this;
+            auto s  = std::move(*upgraded);
+            auto es = event_sender;
+            auto t  = std::move(*task);
+            utils::IOTaskPool::instance().detach_task([p, s, es, t]() mutable {
+                auto& [source_id, path] = t;
+                p.process_asset(source_id, path, std::move(s));
+                es.send(FinishedTaskEvent{AssetPath(source_id, path), true});
+            });
+        }
+    };
+
     bool input_closed = false;
 
     // Unified event loop, equivalent to Bevy's `select_biased!` over new_task_receiver and
-    // task_finished_receiver.  We prefer StartTaskEvent (start tasks) over FinishedTaskEvent so
-    // we don't prematurely mark as Finished before all queued tasks are dispatched.
-    while (!input_closed || pending_tasks > 0) {
+    // task_finished_receiver.
+    while (!input_closed || !scheduler->empty()) {
         auto event = event_receiver.receive();
         if (!event) {
             break;
@@ -912,38 +1041,41 @@ void AssetProcessor::execute_processing_tasks(
 
         std::visit(utils::visitor{
                        [&](StartTaskEvent& e) {
-                           auto upgraded = weak_sender.upgrade();
-                           if (!upgraded) {
+                           if (!weak_sender.upgrade()) {
                                return;
                            }
-                           pending_tasks++;
-                           auto p  = *this;
-                           auto s  = std::move(*upgraded);
-                           auto es = event_sender;
-                           auto t  = std::move(e.task);
-                           utils::IOTaskPool::instance().detach_task([p, s, es, t]() mutable {
-                               auto& [source_id, path] = t;
-                               p.process_asset(source_id, path, std::move(s));
-                               es.send(FinishedTaskEvent{});
-                           });
+                           // dependencies recorded by the last run, restored from the processed metas.
+                           std::vector<AssetPath> dependencies;
+                           {
+                               auto infos_guard = data->processing_state->m_asset_infos.read();
+                               auto* info       = infos_guard->get(AssetPath(e.task.first, e.task.second));
+                               if (info && info->processed_info) {
+                                   for (const auto& dep : info->processed_info->process_dependencies) {
+                                       dependencies.emplace_back(dep.path);
+                                   }
+                               }
+                           }
+                           scheduler->push(std::move(e.task), dependencies);
                            data->processing_state->set_state(ProcessorState::Processing);
                        },
-                       [&](FinishedTaskEvent&) {
-                           pending_tasks--;
-                           if (pending_tasks == 0) {
-                               data->processing_state->set_state(ProcessorState::Finished);
+                       [&](FinishedTaskEvent& e) {
+                           scheduler->finish(e.path, e.popped);
+                           if (scheduler->empty()) {
+                               set_finished();
                            }
                        },
                        [&](InputClosedEvent&) {
                            input_closed = true;
-                           // If there are no in-flight tasks left, processing is done now.
-                           if (pending_tasks == 0) {
-                               data->processing_state->set_state(ProcessorState::Finished);
+                           // If there are no queued or running tasks left, processing is done now.
+                           if (scheduler->empty()) {
+                               set_finished();
                            }
                        },
                    },
                    *event);
+        start_ready_tasks();
     }
+    *data->processing_state->m_run_queued.lock() = nullptr;
 }
 
 // ---- File system helpers ----
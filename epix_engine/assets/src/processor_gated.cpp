@@ -38,6 +38,25 @@ std::expected<std::unique_ptr<std::istream>, AssetReaderError> ProcessorGatedRea
     return std::make_unique<TransactionLockedStream>(std::move(*read_result), std::move(mutex), std::move(lock));
 }
 
+std::optional<AssetBytes> ProcessorGatedReader::read_bytes_view(const std::filesystem::path& path) const {
+    auto asset_path = AssetPath(m_source, path);
+    // on failure fall back to read(), which reports the gate's error.
+    if (m_processing_state->wait_until_processed(asset_path) != ProcessStatus::Processed) return std::nullopt;
+    auto lock_result = m_processing_state->get_transaction_lock(asset_path);
+    if (!lock_result) return std::nullopt;
+    auto mutex = lock_result.value();
+    auto lock  = std::shared_lock(*mutex);
+    auto view  = m_reader->read_bytes_view(path);
+    if (!view) return std::nullopt;
+    struct LockedBytes {
+        std::shared_ptr<const void> inner;
+        std::shared_ptr<std::shared_mutex> mutex;
+        std::shared_lock<std::shared_mutex> lock;
+    };
+    auto bytes = view->bytes();
+    return AssetBytes(std::make_shared<LockedBytes>(view->owner(), std::move(mutex), std::move(lock)), bytes);
+}
+
 std::expected<utils::input_iterable<std::filesystem::path>, AssetReaderError> ProcessorGatedReader::read_directory(
     const std::filesystem::path& path) const {
     m_processing_state->wait_until_finished();
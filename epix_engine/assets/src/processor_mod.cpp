@@ -205,6 +205,58 @@ AssetProcessorData::AssetProcessorData(std::shared_ptr<AssetSources> sources,
       sources(std::move(sources)),
       task_sender(AssetProcessorData::TaskSenderState{}) {}
 
+namespace {
+// the processor whose CPU slot the calling thread holds, if any.
+thread_local const AssetProcessorData* cpu_slot_owner = nullptr;
+}
+
+bool AssetProcessorData::acquire_cpu_slot() const {
+    if (cpu_slot_owner) return false;
+    auto limit = std::max<std::size_t>(1, limits.lock()->cpu_tasks);
+    std::unique_lock lock(cpu_slot_mutex);
+    cpu_slot_cv.wait(lock, [&] { return cpu_slots_used < limit; });
+    cpu_slots_used++;
+    cpu_slot_owner = this;
+    return true;
+}
+
+void AssetProcessorData::release_cpu_slot() const {
+    {
+        std::lock_guard lock(cpu_slot_mutex);
+        cpu_slots_used--;
+    }
+    cpu_slot_owner = nullptr;
+    cpu_slot_cv.notify_one();
+}
+
+void AssetProcessorData::set_processing_limits(ProcessingLimits new_limits) const {
+    *limits.lock() = new_limits;
+    cpu_slot_cv.notify_all();
+}
+
+ProcessingLimits AssetProcessorData::processing_limits() const { return *limits.lock(); }
+
+void AssetProcessorData::set_processed_cache(std::shared_ptr<ProcessedAssetCache> new_cache) const {
+    *cache.lock() = std::move(new_cache);
+}
+
+std::shared_ptr<ProcessedAssetCache> AssetProcessorData::processed_cache() const { return *cache.lock(); }
+
+std::optional<std::chrono::nanoseconds> AssetProcessorData::process_time(const AssetPath& path) const {
+    auto guard = processing_state->m_asset_infos.read();
+    if (auto* info = guard->get(path)) return info->process_time;
+    return std::nullopt;
+}
+
+std::vector<ProcessedAssetTiming> AssetProcessorData::process_times() const {
+    auto guard = processing_state->m_asset_infos.read();
+    std::vector<ProcessedAssetTiming> times;
+    for (auto& [path, info] : guard->infos) {
+        if (info.process_time) times.push_back(ProcessedAssetTiming{path.string(), *info.process_time});
+    }
+    return times;
+}
+
 void AssetProcessorData::set_task_sender(utils::Sender<std::pair<AssetSourceId, std::filesystem::path>> sender) const {
     auto guarded    = task_sender.lock();
     guarded->sender = std::move(sender);
@@ -246,6 +298,73 @@ void AssetProcessorData::wait_until_finished() const { processing_state->wait_un
 
 ProcessorState AssetProcessorData::state() const { return processing_state->get_state(); }
 
+// ---- ProcessingScheduler ----
+
+void ProcessingScheduler::push(Task task, std::span<const AssetPath> dependencies) {
+    std::lock_guard lock(m_mutex);
+    AssetPath path(task.first, task.second);
+    if (auto it = m_entries.find(path); it != m_entries.end()) {
+        if (it->second.running) it->second.rerun = true;
+        return;
+    }
+    auto& entry = m_entries.emplace(path, Entry{std::move(task)}).first->second;
+    for (auto& dependency : dependencies) {
+        if (dependency == path || !m_entries.contains(dependency)) continue;
+        entry.blocking++;
+        m_dependents[dependency].push_back(path);
+    }
+    if (entry.blocking == 0) m_ready.push_back(std::move(path));
+}
+
+std::optional<ProcessingScheduler::Task> ProcessingScheduler::pop(std::size_t limit) {
+    std::lock_guard lock(m_mutex);
+    while (m_running < limit && !m_ready.empty()) {
+        auto path = std::move(m_ready.front());
+        m_ready.pop_front();
+        // stolen tasks stay in the ready list, and a stolen task pushed again may be waiting on new
+        // dependencies; skip such stale listings here.
+        auto it = m_entries.find(path);
+        if (it == m_entries.end() || it->second.running || it->second.blocking != 0) continue;
+        it->second.running = true;
+        m_running++;
+        return it->second.task;
+    }
+    return std::nullopt;
+}
+
+std::optional<ProcessingScheduler::Task> ProcessingScheduler::steal(const AssetPath& path) {
+    std::lock_guard lock(m_mutex);
+    auto it = m_entries.find(path);
+    if (it == m_entries.end() || it->second.running) return std::nullopt;
+    it->second.running = true;
+    return it->second.task;
+}
+
+void ProcessingScheduler::finish(const AssetPath& path, bool popped) {
+    std::lock_guard lock(m_mutex);
+    if (popped) m_running--;
+    if (auto it = m_entries.find(path); it != m_entries.end()) {
+        if (it->second.rerun) {
+            it->second = Entry{std::move(it->second.task)};
+            m_ready.push_back(path);
+        } else {
+            m_entries.erase(it);
+        }
+    }
+    auto dependents = m_dependents.extract(path);
+    if (dependents.empty()) return;
+    for (auto& dependent : dependents.mapped()) {
+        auto it = m_entries.find(dependent);
+        if (it == m_entries.end() || it->second.blocking == 0) continue;
+        if (--it->second.blocking == 0 && !it->second.running) m_ready.push_back(dependent);
+    }
+}
+
+bool ProcessingScheduler::empty() const {
+    std::lock_guard lock(m_mutex);
+    return m_entries.empty();
+}
+
 // ---- ProcessingState ----
 
 ProcessingState::ProcessingState() {
@@ -303,6 +422,24 @@ ProcessStatus ProcessingState::wait_until_processed(const AssetPath& path) const
         }
     }
     if (pending_receiver) {
+        // a queued asset is processed right here rather than waited for, so a waiting task never
+        // holds its processing slot while the asset it needs sits behind it in the queue.
+        if (auto run_queued = *m_run_queued.lock()) {
+            run_queued(path);
+            auto guard = m_asset_infos.read();
+            if (auto* info = guard->get(path); info && info->status) return *info->status;
+        }
+        // the asset is being processed elsewhere. Its processor may still need a CPU slot, so the
+        // slot of the waiting thread is given back for the wait.
+        struct YieldedCpuSlot {
+            const AssetProcessorData* owner = cpu_slot_owner;
+            YieldedCpuSlot() {
+                if (owner) owner->release_cpu_slot();
+            }
+            ~YieldedCpuSlot() {
+                if (owner) owner->acquire_cpu_slot();
+            }
+        } yielded;
         auto status = pending_receiver->receive();
         if (status) return *status;
     }
@@ -2,9 +2,34 @@
 module epix.assets;
 
 import std;
+import epix.utils;
 
 namespace epix::assets {
 
+std::expected<AssetBytes, AssetReaderError> AssetReader::read_bytes(const std::filesystem::path& path) const {
+    if (auto view = read_bytes_view(path)) return std::move(*view);
+    return read(path).and_then(
+        [](std::unique_ptr<std::istream>&& stream) -> std::expected<AssetBytes, AssetReaderError> {
+            try {
+                auto bytes = std::make_shared<std::vector<std::byte>>(
+                    std::ranges::subrange(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>()) |
+                    std::views::transform([](char c) { return static_cast<std::byte>(c); }) |
+                    std::ranges::to<std::vector<std::byte>>());
+                auto view = std::span<const std::byte>(*bytes);
+                return AssetBytes(std::move(bytes), view);
+            } catch (const std::ios_base::failure& e) {
+                return std::unexpected(AssetReaderError(reader_errors::IoError{e.code()}));
+            } catch (...) {
+                return std::unexpected(AssetReaderError(std::current_exception()));
+            }
+        });
+}
+
+void AssetReader::read_bytes_async(const std::filesystem::path& path, AssetBytesCallback on_complete) const {
+    utils::IOTaskPool::instance().detach_task(
+        [this, path, on_complete = std::move(on_complete)]() { on_complete(read_bytes(path)); });
+}
+
 std::expected<std::vector<std::byte>, AssetReaderError> AssetReader::read_meta_bytes(
     const std::filesystem::path& path) const {
     return read_meta(path).and_then(
@@ -61,4 +86,27 @@ std::expected<void, AssetWriterError> AssetWriter::write_meta_bytes(const std::f
         });
 }
 
+std::expected<void, AssetWriterError> AssetWriter::write_from_file(const std::filesystem::path& path,
+                                                                   const std::filesystem::path& file) const {
+    std::ifstream input(file, std::ios::binary);
+    if (!input) {
+        return std::unexpected(AssetWriterError(writer_errors::IoError{std::make_error_code(std::errc::io_error)}));
+    }
+    return write(path).and_then(
+        [&input](std::unique_ptr<std::ostream>&& stream) -> std::expected<void, AssetWriterError> {
+            try {
+                *stream << input.rdbuf();
+                if (!*stream) {
+                    return std::unexpected(AssetWriterError(writer_errors::IoError{
+                        std::error_code(static_cast<int>(stream->rdstate()), std::iostream_category())}));
+                }
+                return {};
+            } catch (const std::ios_base::failure& e) {
+                return std::unexpected(AssetWriterError(writer_errors::IoError{e.code()}));
+            } catch (...) {
+                return std::unexpected(AssetWriterError(std::current_exception()));
+            }
+        });
+}
+
 }  // namespace epix::assets
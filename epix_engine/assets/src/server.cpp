@@ -8,6 +8,18 @@ import std;
 
 using namespace epix::assets;
 
+namespace {
+// priority of the load whose loader runs on this thread, inherited by the loads it starts.
+thread_local std::optional<LoadPriority> t_loading_priority;
+
+/** @brief Runs `on_release` when the last copy is destroyed: a load's slot in the LoadQueue, or its
+ *  count of loads in flight. */
+struct LoadSlot {
+    std::function<void()> on_release;
+    ~LoadSlot() { on_release(); }
+};
+}  // namespace
+
 AssetServer::AssetServer(std::shared_ptr<AssetSources> sources, AssetServerMode mode, bool watching_for_changes)
     : data(std::make_shared<AssetServerData>()) {
     data->sources                                                  = std::move(sources);
@@ -58,6 +70,39 @@ bool ::epix::assets::asset_server_process_handle_destruction(const AssetServer&
     return server.process_handle_destruction(id);
 }
 
+bool ::epix::assets::asset_server_evict_loaded(const AssetServer& server, const UntypedAssetId& id) {
+    return server.evict_loaded(id);
+}
+
+void ::epix::assets::asset_server_load_evicted(const AssetServer& server, const UntypedAssetId& id) {
+    server.load_evicted(id);
+}
+
+bool AssetServer::evict_loaded(const UntypedAssetId& id) const {
+    auto guard = data->infos.write();
+    auto info  = guard->get_info_mut(id);
+    if (!info || !info->get().path || info->get().path->label) return false;
+    if (auto it = guard->living_labeled_assets.find(*info->get().path);
+        it != guard->living_labeled_assets.end() && !it->second.empty()) {
+        return false;
+    }
+    info->get().state = LoadStateOK::NotLoaded;
+    return true;
+}
+
+void AssetServer::load_evicted(const UntypedAssetId& id) const {
+    auto guard = data->infos.write();
+    auto info  = guard->get_info_mut(id);
+    if (!info || !info->get().path) return;
+    auto& state = info->get().state;
+    if (!std::holds_alternative<LoadStateOK>(state) || std::get<LoadStateOK>(state) != LoadStateOK::NotLoaded) return;
+    auto handle = guard->get_handle_by_id(id);
+    if (!handle) return;
+    state     = LoadStateOK::Loading;
+    auto path = *info->get().path;
+    spawn_load_task(*handle, path, *guard);
+}
+
 void AssetServer::set_processor_check(std::function<bool(std::string_view)> check) const {
     data->has_processor_for_ext = std::move(check);
 }
@@ -117,7 +162,7 @@ static void load_folder_recursive(const AssetSourceId& source,
 }
 
 void AssetServer::load_folder_internal(const UntypedAssetId& id, const AssetPath& path) const {
-    data->infos.write()->stats.started_load_tasks++;
+    data->stats.started_load_tasks++;
 
     auto server     = *this;
     auto asset_id   = id;
@@ -155,6 +200,7 @@ void AssetServer::handle_internal_events(core::ParamSet<core::World&, core::Res<
     auto receiver          = server->data->asset_event_receiver;
 
     std::vector<UntypedAssetLoadFailedEvent> untyped_failures;
+    std::vector<LabeledAssetPublishedEvent> published;
     std::unordered_set<AssetPath> paths_to_reload;
     bool watching_for_changes = false;
 
@@ -164,8 +210,14 @@ void AssetServer::handle_internal_events(core::ParamSet<core::World&, core::Res<
         while (auto event = receiver.try_receive()) {
             std::visit(utils::visitor{
                            [&](internal_asset_event::Loaded& loaded) {
+                               auto start = AssetLoadRecorder::Clock::now();
                                guard->process_asset_load(loaded.id, std::move(loaded.asset), world,
                                                          server->data->asset_event_sender);
+                               if (loaded.loader.empty()) return;
+                               auto info = guard->get_info(loaded.id);
+                               auto path = info && info->get().path ? info->get().path->string() : std::string();
+                               server->data->load_recorder.record(LoadStage::Insert, loaded.loader, loaded.id.type,
+                                                                  path, start, AssetLoadRecorder::Clock::now());
                            },
                            [&](internal_asset_event::LoadedWithDeps& loaded_with_deps) {
                                // Dispatch typed LoadedWithDependencies event
@@ -200,10 +252,33 @@ void AssetServer::handle_internal_events(core::ParamSet<core::World&, core::Res<
 
                                log_asset_load_error(failed.error, failed.path);
                            },
+                           [&](internal_asset_event::Published& publish) {
+                               server->data->published_slots.release();
+                               auto info = guard->get_info(publish.id);
+                               if (!info || !info->get().path) return;
+                               auto path = *info->get().path;
+                               if (publish.partial) {
+                                   auto& asset = publish.asset;
+                                   if (!guard->process_partial_asset_load(publish.id, std::move(asset), world)) return;
+                               } else {
+                                   guard->process_asset_load(publish.id, std::move(publish.asset), world,
+                                                             server->data->asset_event_sender);
+                               }
+                               published.push_back(
+                                   LabeledAssetPublishedEvent{publish.id, std::move(path), publish.partial});
+                           },
                        },
                        *event);
         }
 
+        if (!published.empty()) {
+            if (auto events_opt = world.get_resource_mut<core::Events<LabeledAssetPublishedEvent>>()) {
+                for (auto& event : published) {
+                    events_opt->get().push(std::move(event));
+                }
+            }
+        }
+
         if (!untyped_failures.empty()) {
             auto events_opt = world.get_resource_mut<core::Events<UntypedAssetLoadFailedEvent>>();
             if (events_opt) {
@@ -216,14 +291,12 @@ void AssetServer::handle_internal_events(core::ParamSet<core::World&, core::Res<
         // Hot-reload: process watcher events
         watching_for_changes = guard->watching_for_changes;
         if (watching_for_changes) {
+            // a batch of changes in one folder reloads the folder once.
+            std::unordered_set<AssetPath> folders_to_reload;
             auto reload_parent_folders = [&](const std::filesystem::path& path, const AssetSourceId& source) {
                 auto current = path.parent_path();
                 while (!current.empty() && current != path) {
-                    auto parent_asset_path = AssetPath(source, current);
-                    for (auto handle : guard->get_handles_by_path(parent_asset_path)) {
-                        spdlog::info("Reloading folder {} because content has changed", parent_asset_path.string());
-                        server->load_folder_internal(handle.id(), parent_asset_path);
-                    }
+                    folders_to_reload.insert(AssetPath(source, current));
                     auto next = current.parent_path();
                     if (next == current) break;
                     current = next;
@@ -253,6 +326,11 @@ void AssetServer::handle_internal_events(core::ParamSet<core::World&, core::Res<
                                },
                                [&](const source_events::ModifiedAsset& e) { reload_path(e.path, source); },
                                [&](const source_events::ModifiedMeta& e) { reload_path(e.path, source); },
+                               [&](const source_events::RenamedAsset& e) {
+                                   reload_parent_folders(e.old_path, source);
+                                   reload_parent_folders(e.new_path, source);
+                                   reload_path(e.new_path, source);
+                               },
                                [&](const source_events::RenamedDirectory& e) {
                                    reload_parent_folders(e.old_path, source);
                                    reload_parent_folders(e.new_path, source);
@@ -285,6 +363,13 @@ void AssetServer::handle_internal_events(core::ParamSet<core::World&, core::Res<
                     }
                 }
             }
+
+            for (auto& folder : folders_to_reload) {
+                for (auto handle : guard->get_handles_by_path(folder)) {
+                    spdlog::info("Reloading folder {} because content has changed", folder.string());
+                    server->load_folder_internal(handle.id(), folder);
+                }
+            }
         }
     }  // guard dropped here
 
@@ -299,14 +384,15 @@ void AssetServer::handle_internal_events(core::ParamSet<core::World&, core::Res<
 // Matches bevy_asset's AssetServer::load_with_settings_loader_and_reader.
 // Calls the loader, wrapping any thrown exception into an AssetLoadError.
 // ---------------------------------------------------------------------------
-std::expected<ErasedLoadedAsset, AssetLoadError> AssetServer::load_with_settings_loader_and_reader(
-    const AssetPath& asset_path,
-    const Settings& settings,
-    const ErasedAssetLoader& loader,
-    std::istream& reader) const {
+namespace {
+template <typename Input>
+std::expected<ErasedLoadedAsset, AssetLoadError> run_loader(LoadContext context,
+                                                           const AssetPath& asset_path,
+                                                           const Settings& settings,
+                                                           const ErasedAssetLoader& loader,
+                                                           Input&& input) {
     try {
-        auto context     = AssetServer::make_load_context(*this, asset_path);
-        auto load_result = loader.load(reader, settings, context);
+        auto load_result = loader.load(std::forward<Input>(input), settings, context);
         if (!load_result) {
             return std::unexpected(AssetLoadError{
                 load_error::AssetLoaderException{load_result.error(), asset_path, loader.loader_type().short_name()}});
@@ -317,6 +403,23 @@ std::expected<ErasedLoadedAsset, AssetLoadError> AssetServer::load_with_settings
             load_error::AssetLoaderException{std::current_exception(), asset_path, loader.loader_type().short_name()}});
     }
 }
+}  // namespace
+
+std::expected<ErasedLoadedAsset, AssetLoadError> AssetServer::load_with_settings_loader_and_reader(
+    const AssetPath& asset_path,
+    const Settings& settings,
+    const ErasedAssetLoader& loader,
+    std::istream& reader) const {
+    return run_loader(AssetServer::make_load_context(*this, asset_path), asset_path, settings, loader, reader);
+}
+
+std::expected<ErasedLoadedAsset, AssetLoadError> AssetServer::load_with_settings_loader_and_reader(
+    const AssetPath& asset_path,
+    const Settings& settings,
+    const ErasedAssetLoader& loader,
+    std::span<const std::byte> bytes) const {
+    return run_loader(AssetServer::make_load_context(*this, asset_path), asset_path, settings, loader, bytes);
+}
 
 // ---------------------------------------------------------------------------
 // get_meta_loader_and_reader
@@ -331,7 +434,8 @@ std::expected<ErasedLoadedAsset, AssetLoadError> AssetServer::load_with_settings
 std::optional<AssetServer::MetaLoaderReader> AssetServer::get_meta_loader_and_reader(
     const AssetPath& asset_path,
     std::optional<meta::type_index> asset_type_id,
-    std::optional<AssetLoadError>& out_error) const {
+    std::optional<AssetLoadError>& out_error,
+    bool open_reader) const {
     // 1. Resolve the source
     auto source_opt = get_source(asset_path.source);
     if (!source_opt) {
@@ -454,14 +558,20 @@ std::optional<AssetServer::MetaLoaderReader> AssetServer::get_meta_loader_and_re
             break;
     }
 
-    // 6. Open the asset file for reading
+    // 6. Open the asset file for reading, zero-copy if the reader can map it
+    if (!open_reader) {
+        return MetaLoaderReader{std::move(*meta), std::move(loader), reader_ptr, nullptr, std::nullopt};
+    }
+    if (auto bytes = reader_ptr->read_bytes_view(asset_path.path)) {
+        return MetaLoaderReader{std::move(*meta), std::move(loader), reader_ptr, nullptr, std::move(bytes)};
+    }
     auto read_result = reader_ptr->read(asset_path.path);
     if (!read_result) {
         out_error = AssetLoadError{load_error::AssetReaderError{read_result.error()}};
         return std::nullopt;
     }
 
-    return MetaLoaderReader{std::move(*meta), std::move(loader), std::move(*read_result)};
+    return MetaLoaderReader{std::move(*meta), std::move(loader), reader_ptr, std::move(*read_result), std::nullopt};
 }
 
 // ---------------------------------------------------------------------------
@@ -472,25 +582,30 @@ std::optional<AssetServer::MetaLoaderReader> AssetServer::get_meta_loader_and_re
 void AssetServer::load_internal(std::optional<UntypedHandle> input_handle,
                                 AssetPath path,
                                 bool force,
-                                std::optional<MetaTransform> meta_transform) const {
+                                std::optional<MetaTransform> meta_transform,
+                                std::shared_ptr<void> load_slot,
+                                LoadPriority priority,
+                                std::optional<std::chrono::steady_clock::time_point> queued_at) const {
+    auto entered = AssetLoadRecorder::Clock::now();
     // Determine asset_type_id hint from input handle (if typed)
     std::optional<meta::type_index> input_type_id;
     if (input_handle) input_type_id = input_handle->type();
 
     // --- Get meta, loader and reader ---------------------------------
     std::optional<AssetLoadError> get_error;
-    auto mlr = get_meta_loader_and_reader(path, input_type_id, get_error);
+    auto mlr = get_meta_loader_and_reader(path, input_type_id, get_error, false);
     if (!mlr) {
         // If we had an input handle, propagate failure so the handle's state is updated
         if (input_handle) {
-            send_asset_event(InternalAssetEvent{internal_asset_event::Failed{
+            send_load_result(InternalAssetEvent{internal_asset_event::Failed{
                 input_handle->id(), path,
                 get_error.value_or(
                     AssetLoadError{load_error::MissingAssetLoader{std::nullopt, input_type_id, path, {}}})}});
         }
         return;
     }
-    auto& [meta, loader, reader] = *mlr;
+    auto& meta   = mlr->meta;
+    auto& loader = mlr->loader;
 
     // Apply the meta_transform carried by the handle (settings override)
     // Priority: meta_transform argument > handle's built-in meta_transform
@@ -524,11 +639,18 @@ void AssetServer::load_internal(std::optional<UntypedHandle> input_handle,
         return;
     }
 
+    auto loader_name = loader->loader_type().short_name();
+    if (queued_at) {
+        data->load_recorder.record(LoadStage::Queued, loader_name, asset_id->type, path.string(), *queued_at, entered);
+    }
+    data->load_recorder.load_started();
+    auto in_flight = std::make_shared<LoadSlot>([server = *this] { server.data->load_recorder.load_finished(); });
+
     // --- Verify type matches loader ----------------------------------
     if (asset_id->type != loader->asset_type()) {
         auto err = AssetLoadError{load_error::RequestHandleMismatch{path, asset_id->type, loader->asset_type(),
                                                                     loader->loader_type().short_name()}};
-        send_asset_event(InternalAssetEvent{internal_asset_event::Failed{*asset_id, path, err}});
+        send_load_result(InternalAssetEvent{internal_asset_event::Failed{*asset_id, path, err}});
         return;
     }
 
@@ -538,38 +660,104 @@ void AssetServer::load_internal(std::optional<UntypedHandle> input_handle,
         auto err = AssetLoadError{load_error::AssetLoaderException{
             std::make_exception_ptr(std::runtime_error("Asset meta has no loader settings")), path,
             loader->loader_type().short_name()}};
-        send_asset_event(InternalAssetEvent{internal_asset_event::Failed{*asset_id, path, err}});
+        send_load_result(InternalAssetEvent{internal_asset_event::Failed{*asset_id, path, err}});
         return;
     }
 
-    auto load_result = load_with_settings_loader_and_reader(path, *settings_ptr, *loader, *reader);
-    if (load_result) {
-        send_asset_event(InternalAssetEvent{internal_asset_event::Loaded{*asset_id, std::move(*load_result)}});
-    } else {
-        // Detailed error is logged later in handle_internal_events when the Failed event is processed.
-        send_asset_event(InternalAssetEvent{internal_asset_event::Failed{*asset_id, path, load_result.error()}});
-    }
+    // The bytes are read without parking this thread, and decoding runs on the WorkerTaskPool once they
+    // arrive, so many reads stay in flight. A handle passed in is not held past this point: the load
+    // stops between stages once all handles to the asset are dropped. A handle created here has no
+    // other owner, so it is held to keep the asset alive.
+    bool on_read_cancellable = input_handle.has_value();
+    auto on_read = [server = *this, path, id = *asset_id, meta = std::shared_ptr<AssetMetaDyn>(std::move(meta)), loader,
+                    keep_alive = fetched_handle, cancellable = on_read_cancellable, load_slot, priority, entered,
+                    loader_name, in_flight](std::expected<AssetBytes, AssetReaderError> bytes) mutable {
+        load_slot.reset();
+        if (cancellable && server.load_cancelled(id)) return;
+        if (!bytes) {
+            server.send_load_result(InternalAssetEvent{internal_asset_event::Failed{
+                id, path, AssetLoadError{load_error::AssetReaderError{std::move(bytes.error())}}}});
+            return;
+        }
+        auto& recorder = server.data->load_recorder;
+        recorder.record(LoadStage::Read, loader_name, id.type, path.string(), entered, AssetLoadRecorder::Clock::now());
+        recorder.record_bytes(loader_name, id.type, bytes->bytes().size());
+        utils::WorkerTaskPool::instance().detach_task([server, path, id, meta, loader, keep_alive, cancellable,
+                                                       priority, loader_name, in_flight, bytes = std::move(*bytes)]() {
+            if (cancellable && server.load_cancelled(id)) return;
+            // loads started by the loader inherit this load's priority.
+            t_loading_priority = priority;
+            // the result goes to the world, so assets the loader publishes may go there before it.
+            auto context           = AssetServer::make_load_context(server, path);
+            context.m_streaming_id = id;
+            auto decode_start      = AssetLoadRecorder::Clock::now();
+            auto load_result = run_loader(std::move(context), path, *meta->loader_settings(), *loader, bytes.bytes());
+            t_loading_priority.reset();
+            server.data->load_recorder.record(LoadStage::Decode, loader_name, id.type, path.string(), decode_start,
+                                              AssetLoadRecorder::Clock::now());
+            if (load_result) {
+                server.send_load_result(
+                    InternalAssetEvent{internal_asset_event::Loaded{id, std::move(*load_result), loader_name}});
+            } else {
+                // Detailed error is logged later in handle_internal_events when the Failed event is processed.
+                server.send_load_result(
+                    InternalAssetEvent{internal_asset_event::Failed{id, path, load_result.error()}});
+            }
+        });
+    };
+    input_handle.reset();
+    if (on_read_cancellable && load_cancelled(*asset_id)) return;
+    mlr->source_reader->read_bytes_async(path.path, std::move(on_read));
 }
 
 // ---------------------------------------------------------------------------
-// spawn_load_task — now a thin wrapper that calls load_internal.
+// spawn_load_task — queues the load; start_queued_loads runs load_internal for it.
 // Matches bevy_asset's AssetServer::spawn_load_task.
 // ---------------------------------------------------------------------------
-void AssetServer::spawn_load_task(const UntypedHandle& handle, const AssetPath& path, AssetInfos& infos) const {
-    infos.stats.started_load_tasks++;
+void AssetServer::spawn_load_task(const UntypedHandle& handle,
+                                  const AssetPath& path,
+                                  AssetInfos&,
+                                  std::optional<LoadPriority> priority) const {
+    spawn_load_task(handle, path, priority);
+}
 
-    auto server       = *this;
-    auto owned_handle = handle;
-    auto asset_path   = path;
+void AssetServer::spawn_load_task(const UntypedHandle& handle,
+                                  const AssetPath& path,
+                                  std::optional<LoadPriority> priority) const {
+    data->stats.started_load_tasks++;
+    data->load_queue.push(handle.id(), path, priority.value_or(t_loading_priority.value_or(LoadPriority::Visible)));
+    start_queued_loads();
+}
 
-    utils::IOTaskPool::instance().detach_task([server, owned_handle, asset_path]() mutable {
-        server.load_internal(std::move(owned_handle), std::move(asset_path), false, std::nullopt);
-    });
+void AssetServer::start_queued_loads() const {
+    while (auto load = data->load_queue.pop()) {
+        utils::IOTaskPool::instance().detach_task([server = *this, load = std::move(*load)]() mutable {
+            auto slot = std::make_shared<LoadSlot>([server] {
+                server.data->load_queue.release();
+                server.start_queued_loads();
+            });
+            // queued loads hold no handle, so a dropped asset is noticed here at the latest.
+            auto handle = server.data->infos.read()->get_handle_by_id(load.id);
+            if (!handle) {
+                server.data->stats.cancelled_load_tasks++;
+                return;
+            }
+            server.load_internal(std::move(*handle), std::move(load.path), false, std::nullopt, std::move(slot),
+                                 load.priority, load.queued_at);
+        });
+    }
 }
 
-void AssetServer::spawn_load_task(const UntypedHandle& handle, const AssetPath& path) const {
-    auto guard = data->infos.write();
-    spawn_load_task(handle, path, *guard);
+bool AssetServer::load_cancelled(const UntypedAssetId& id) const {
+    if (data->infos.read()->is_handle_alive(id)) return false;
+    data->stats.cancelled_load_tasks++;
+    return true;
+}
+
+bool AssetServer::try_publish_asset(internal_asset_event::Published& event) const {
+    if (!data->published_slots.try_acquire()) return false;
+    send_asset_event(InternalAssetEvent{std::move(event)});
+    return true;
 }
 
 // ---------------------------------------------------------------------------
@@ -587,16 +775,16 @@ std::expected<ErasedLoadedAsset, AssetLoadError> AssetServer::load_direct_untype
     auto settings = mlr->meta->loader_settings();
     if (!settings) {
         auto def = mlr->loader->default_settings();
-        return load_with_settings_loader_and_reader(path, *def, *mlr->loader, *mlr->reader);
+        return load_with_settings_loader_and_reader(path, *def, *mlr);
     }
-    return load_with_settings_loader_and_reader(path, *settings, *mlr->loader, *mlr->reader);
+    return load_with_settings_loader_and_reader(path, *settings, *mlr);
 }
 
 std::expected<ErasedLoadedAsset, AssetLoadError> AssetServer::load_direct_with_reader_untyped(
     const AssetPath& path, std::istream& reader) const {
     // Use type-id-only lookup to get the right loader
     std::optional<AssetLoadError> err;
-    auto mlr = get_meta_loader_and_reader(path, std::nullopt, err);
+    auto mlr = get_meta_loader_and_reader(path, std::nullopt, err, false);
     if (!mlr) {
         // Fall back: just try extension-based lookup, use the provided reader directly
         auto maybe = [&]() -> std::optional<MaybeAssetLoader> {
@@ -655,13 +843,9 @@ void AssetServer::reload_internal(const AssetPath& path, bool log) const {
     // Synchronously mark existing handles as Loading so callers observe the transition immediately.
     {
         auto guard = data->infos.write();
-        if (auto pit = guard->path_to_ids.find(asset_path); pit != guard->path_to_ids.end()) {
-            for (auto& [type, id] : pit->second) {
-                if (auto iit = guard->infos.find(id); iit != guard->infos.end()) {
-                    if (!iit->second.weak_handle.expired()) {
-                        iit->second.state = LoadStateOK::Loading;
-                    }
-                }
+        for (auto id : guard->get_path_ids(asset_path)) {
+            if (auto info = guard->get_info_mut(id); info && !info->get().weak_handle.expired()) {
+                info->get().state = LoadStateOK::Loading;
             }
         }
     }
@@ -674,7 +858,7 @@ void AssetServer::reload_internal(const AssetPath& path, bool log) const {
         {
             auto guard = server.data->infos.write();
             for (auto h : guard->get_handles_by_path(asset_path)) {
-                guard->stats.started_load_tasks++;
+                server.data->stats.started_load_tasks++;
                 handles.push_back(h);
             }
         }
@@ -688,7 +872,7 @@ void AssetServer::reload_internal(const AssetPath& path, bool log) const {
         if (!reloaded) {
             bool should = server.data->infos.read()->should_reload(asset_path);
             if (should) {
-                server.data->infos.write()->stats.started_load_tasks++;
+                server.data->stats.started_load_tasks++;
                 server.load_internal(std::nullopt, asset_path, true, std::nullopt);
                 reloaded = true;
             }
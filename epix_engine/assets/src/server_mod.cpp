@@ -6,7 +6,7 @@ import std;
 
 using namespace epix::assets;
 
-UntypedHandle AssetServer::load_untyped(const AssetPath& path) const {
+UntypedHandle AssetServer::load_untyped(const AssetPath& path, std::optional<LoadPriority> priority) const {
     std::optional<meta::type_index> loader_type;
     {
         auto loaders_guard = data->loaders->read();
@@ -16,23 +16,77 @@ UntypedHandle AssetServer::load_untyped(const AssetPath& path) const {
             if (loader) loader_type = loader->asset_type();
         }
     }
+    if (auto existing = data->infos.read()->get_existing_handle(path, loader_type, HandleLoadingMode::Request)) {
+        if (priority) raise_load_priority(existing->id(), *priority);
+        return *existing;
+    }
     auto guard                 = data->infos.write();
     auto [handle, should_load] = guard->get_or_create_handle_untyped(path, loader_type, HandleLoadingMode::Request);
     if (should_load) {
-        spawn_load_task(handle, path, *guard);
+        spawn_load_task(handle, path, *guard, priority);
+    } else if (priority) {
+        raise_load_priority(handle.id(), *priority);
     }
     return handle;
 }
 
-UntypedHandle AssetServer::load_erased(meta::type_index type_id, const AssetPath& path) const {
+UntypedHandle AssetServer::load_erased(meta::type_index type_id,
+                                       const AssetPath& path,
+                                       std::optional<LoadPriority> priority) const {
+    if (auto existing = data->infos.read()->get_existing_handle(path, type_id, HandleLoadingMode::Request)) {
+        if (priority) raise_load_priority(existing->id(), *priority);
+        return *existing;
+    }
     auto guard                 = data->infos.write();
     auto [handle, should_load] = guard->get_or_create_handle_untyped(path, type_id, HandleLoadingMode::Request);
     if (should_load) {
-        spawn_load_task(handle, path, *guard);
+        spawn_load_task(handle, path, *guard, priority);
+    } else if (priority) {
+        raise_load_priority(handle.id(), *priority);
     }
     return handle;
 }
 
+bool AssetServer::set_load_priority(const UntypedAssetId& id, LoadPriority priority) const {
+    return data->load_queue.set_priority(id, priority);
+}
+
+void AssetServer::set_max_loads_in_flight(std::size_t max) const {
+    data->load_queue.set_max_in_flight(max);
+    start_queued_loads();
+}
+
+std::size_t AssetServer::queued_loads() const { return data->load_queue.size(); }
+
+void AssetServer::set_max_published_assets(std::size_t max) const { data->published_slots.set_max_in_flight(max); }
+
+std::size_t AssetServer::pending_published_assets() const { return data->published_slots.in_flight(); }
+
+AssetServerDiagnostics AssetServer::diagnostics() const {
+    AssetServerDiagnostics diagnostics{
+        .started_load_tasks       = data->stats.started_load_tasks,
+        .finished_load_tasks      = data->stats.finished_load_tasks,
+        .cancelled_load_tasks     = data->stats.cancelled_load_tasks,
+        .in_flight_loads          = data->load_recorder.in_flight(),
+        .queued_loads             = data->load_queue.size(),
+        .pending_published_assets = data->published_slots.in_flight(),
+        .bytes_read               = data->load_recorder.bytes_read(),
+    };
+    for (auto& [_, provider] : data->infos.read()->handle_providers) {
+        diagnostics.pending_handle_drops += provider->pending_drops();
+    }
+    data->load_recorder.snapshot(diagnostics);
+    return diagnostics;
+}
+
+void AssetServer::start_chrome_trace() const { data->load_recorder.start_trace(); }
+
+std::string AssetServer::take_chrome_trace() const { return data->load_recorder.take_trace(); }
+
+void AssetServer::raise_load_priority(const UntypedAssetId& id, LoadPriority priority) const {
+    data->load_queue.set_priority(id, priority, true);
+}
+
 Handle<LoadedFolder> AssetServer::load_folder(const AssetPath& path) const {
     auto guard                 = data->infos.write();
     auto [handle, should_load] = guard->template get_or_create_handle<LoadedFolder>(path, HandleLoadingMode::Request);
@@ -97,6 +151,9 @@ std::expected<void, WaitForAssetError> AssetServer::wait_for_asset_id(const Unty
 UntypedHandle AssetServer::get_or_create_path_handle_erased(const AssetPath& path,
                                                             meta::type_index type_id,
                                                             std::optional<MetaTransform> meta_transform) const {
+    if (auto existing = data->infos.read()->get_existing_handle(path, type_id, HandleLoadingMode::NotLoading)) {
+        return *existing;
+    }
     return data->infos.write()
         ->get_or_create_handle_untyped(path, type_id, HandleLoadingMode::NotLoading, std::move(meta_transform))
         .first;
@@ -164,8 +221,8 @@ bool AssetServer::is_loaded_with_dependencies(const UntypedAssetId& id) const {
 }
 
 std::optional<UntypedHandle> AssetServer::get_handle_untyped(const AssetPath& path) const {
+    auto ids   = data->path_index->ids(path);
     auto guard = data->infos.read();
-    auto ids   = guard->get_path_ids(path);
     for (auto id : ids) {
         auto handle = guard->get_handle_by_id(id);
         if (handle) return handle;
@@ -175,8 +232,8 @@ std::optional<UntypedHandle> AssetServer::get_handle_untyped(const AssetPath& pa
 
 std::vector<UntypedHandle> AssetServer::get_handles_untyped(const AssetPath& path) const {
     std::vector<UntypedHandle> result;
+    auto ids   = data->path_index->ids(path);
     auto guard = data->infos.read();
-    auto ids   = guard->get_path_ids(path);
     for (auto id : ids) {
         auto handle = guard->get_handle_by_id(id);
         if (handle) result.push_back(*handle);
@@ -203,19 +260,13 @@ std::optional<AssetPath> AssetServer::get_path(const UntypedAssetId& id) const {
 }
 
 std::optional<UntypedAssetId> AssetServer::get_path_id(const AssetPath& path) const {
-    auto guard = data->infos.read();
-    auto ids   = guard->get_path_ids(path);
-    for (auto id : ids) return id;
-    return std::nullopt;
+    auto ids = data->path_index->ids(path);
+    if (ids.empty()) return std::nullopt;
+    return ids.front();
 }
 
 std::vector<UntypedAssetId> AssetServer::get_path_ids(const AssetPath& path) const {
-    auto guard = data->infos.read();
-    std::vector<UntypedAssetId> result;
-    for (auto id : guard->get_path_ids(path)) {
-        result.push_back(id);
-    }
-    return result;
+    return data->path_index->ids(path);
 }
 
 bool AssetServer::is_managed(const UntypedAssetId& id) const {
@@ -261,8 +312,10 @@ std::shared_ptr<ErasedAssetLoader> AssetServer::get_asset_loader_with_asset_type
 }
 
 bool AssetServer::process_handle_destruction(const UntypedAssetId& id) const {
-    auto guard = data->infos.write();
-    return guard->process_handle_destruction(id);
+    bool removed = data->infos.write()->process_handle_destruction(id);
+    // a load still queued for the released asset would only be discarded when it starts.
+    if (removed && data->load_queue.cancel(id)) data->stats.cancelled_load_tasks++;
+    return removed;
 }
 
 UntypedHandle NestedLoader::load_untyped(const AssetPath& path) {
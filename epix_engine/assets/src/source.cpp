@@ -52,15 +52,21 @@ std::function<std::unique_ptr<AssetReader>()> AssetSource::get_default_reader(st
         [path = std::move(path)]() -> std::unique_ptr<AssetReader> { return std::make_unique<FileAssetReader>(path); };
 }
 
+std::function<std::unique_ptr<AssetReader>()> AssetSource::get_archive_reader(std::filesystem::path archive) {
+    return [archive = std::move(archive)]() -> std::unique_ptr<AssetReader> {
+        return std::make_unique<ArchiveAssetReader>(archive);
+    };
+}
+
 std::function<std::unique_ptr<AssetWriter>()> AssetSource::get_default_writer(std::filesystem::path path) {
     return
         [path = std::move(path)]() -> std::unique_ptr<AssetWriter> { return std::make_unique<FileAssetWriter>(path); };
 }
 
 std::function<std::unique_ptr<AssetWatcher>(utils::Sender<AssetSourceEvent>)> AssetSource::get_default_watcher(
-    std::filesystem::path path) {
-    return [path = std::move(path)](utils::Sender<AssetSourceEvent> sender) -> std::unique_ptr<AssetWatcher> {
-        return std::make_unique<FileAssetWatcher>(path, std::move(sender));
+    std::filesystem::path path, std::chrono::milliseconds debounce) {
+    return [path = std::move(path), debounce](utils::Sender<AssetSourceEvent> sender) -> std::unique_ptr<AssetWatcher> {
+        return std::make_unique<FileAssetWatcher>(path, std::move(sender), debounce);
     };
 }
 
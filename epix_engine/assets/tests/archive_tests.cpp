@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.assets;
+
+#include "temp_dir.hpp"
+
+using namespace epix::assets;
+
+namespace {
+/** @brief A TempDir holding the loose assets under `assets/`, next to the archive packed from them. */
+struct ArchiveDir : TempDir {
+    ArchiveDir() { std::filesystem::create_directories(path / "assets"); }
+    void write(const std::filesystem::path& rel, std::string_view content) const {
+        TempDir::write("assets" / rel, content);
+    }
+    std::filesystem::path pack() const {
+        auto reader  = AssetSource::get_default_reader(path / "assets")();
+        auto archive = path / "assets.epak";
+        EXPECT_TRUE(write_asset_archive(*reader, archive).has_value());
+        return archive;
+    }
+};
+
+std::string to_string(std::span<const std::byte> bytes) {
+    return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+std::string read_all(std::istream& stream) { return std::string(std::istreambuf_iterator<char>(stream), {}); }
+}  // namespace
+
+TEST(ArchiveAssetReader, ReadsPackedAssetsAndMeta) {
+    ArchiveDir dir;
+    dir.write("a.txt", "alpha");
+    dir.write("a.txt.meta", "alpha meta");
+    dir.write("textures/b.txt", "beta");
+    dir.write("textures/deep/c.txt", "");
+
+    auto reader  = AssetSource::get_default_reader(dir.path / "assets")();
+    auto archive = dir.path / "assets.epak";
+    auto packed  = write_asset_archive(*reader, archive);
+    ASSERT_TRUE(packed.has_value());
+    EXPECT_EQ(*packed, 3);
+
+    ArchiveAssetReader archive_reader(archive);
+    ASSERT_TRUE(archive_reader.is_open());
+    EXPECT_EQ(archive_reader.size(), 3);
+
+    auto view = archive_reader.read_bytes_view("textures/b.txt");
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(to_string(view->bytes()), "beta");
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(view->data()) % ARCHIVE_ALIGNMENT, 0);
+
+    auto stream = archive_reader.read("a.txt");
+    ASSERT_TRUE(stream.has_value());
+    EXPECT_EQ(read_all(**stream), "alpha");
+    auto meta = archive_reader.read_meta("a.txt");
+    ASSERT_TRUE(meta.has_value());
+    EXPECT_EQ(read_all(**meta), "alpha meta");
+    EXPECT_FALSE(archive_reader.read_meta("textures/b.txt").has_value());
+
+    auto empty = archive_reader.read_bytes("textures/deep/c.txt");
+    ASSERT_TRUE(empty.has_value());
+    EXPECT_TRUE(empty->empty());
+
+    EXPECT_TRUE(archive_reader.asset_hash("a.txt").has_value());
+    EXPECT_NE(archive_reader.asset_hash("a.txt"), archive_reader.asset_hash("textures/b.txt"));
+}
+
+TEST(ArchiveAssetReader, MissingAssetIsNotFound) {
+    ArchiveDir dir;
+    dir.write("a.txt", "alpha");
+    ArchiveAssetReader reader(dir.pack());
+
+    EXPECT_FALSE(reader.read_bytes_view("b.txt").has_value());
+    auto stream = reader.read("b.txt");
+    ASSERT_FALSE(stream.has_value());
+    EXPECT_TRUE(std::holds_alternative<reader_errors::NotFound>(stream.error()));
+}
+
+TEST(ArchiveAssetReader, ListsDirectories) {
+    ArchiveDir dir;
+    dir.write("a.txt", "alpha");
+    dir.write("textures/b.txt", "beta");
+    dir.write("textures/deep/c.txt", "gamma");
+    ArchiveAssetReader reader(dir.pack());
+
+    EXPECT_TRUE(reader.is_directory("").value());
+    EXPECT_TRUE(reader.is_directory("textures").value());
+    EXPECT_FALSE(reader.is_directory("a.txt").value());
+
+    auto children = reader.read_directory("textures");
+    ASSERT_TRUE(children.has_value());
+    std::vector<std::filesystem::path> listed;
+    for (auto child : *children) listed.push_back(child);
+    std::vector<std::filesystem::path> expected = {"textures/b.txt", "textures/deep"};
+    EXPECT_EQ(listed, expected);
+
+    EXPECT_FALSE(reader.read_directory("missing").has_value());
+}
+
+TEST(ArchiveAssetReader, ViewOutlivesReader) {
+    ArchiveDir dir;
+    dir.write("a.txt", "alpha");
+    auto reader = std::make_unique<ArchiveAssetReader>(dir.pack());
+    auto view   = reader->read_bytes_view("a.txt");
+    reader.reset();
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(to_string(view->bytes()), "alpha");
+}
+
+TEST(ArchiveAssetReader, RejectsMalformedArchive) {
+    ArchiveDir dir;
+    auto path = dir.path / "bad.epak";
+    std::ofstream(path, std::ios::binary) << "not an archive, but long enough to hold a header";
+    ArchiveAssetReader reader(path);
+    EXPECT_FALSE(reader.is_open());
+    EXPECT_FALSE(reader.read("a.txt").has_value());
+    EXPECT_FALSE(ArchiveAssetReader(dir.path / "missing.epak").is_open());
+}
@@ -748,8 +748,11 @@ PluginTestEnv make_plugin_env_for_mode(AssetServerMode mode,
     return {std::move(app), dir};
 }
 
-/// Wait for all IOTaskPool tasks and then run the Last schedule to process internal events.
+/// Wait for the load tasks on the IOTaskPool and the decodes on the WorkerTaskPool, then run the
+/// Last schedule to process internal events.
 void flush_load_tasks(App& app) {
+    epix::utils::IOTaskPool::instance().wait();
+    epix::utils::WorkerTaskPool::instance().wait();
     epix::utils::IOTaskPool::instance().wait();
     app.run_schedule(Last);
 }
@@ -778,6 +781,26 @@ TEST(HotReload, InitialLoad_ReachesAssetsStorage) {
     EXPECT_TRUE(server.is_loaded(handle.id()));
 }
 
+TEST(HotReload, LoadOfLoadedPath_ReturnsSameHandleWithoutNewTask) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    auto& server    = app.resource<AssetServer>();
+
+    auto handle = server.load<std::string>(AssetPath("hello.txt"));
+    flush_load_tasks(app);
+    ASSERT_TRUE(server.is_loaded(handle.id()));
+
+    // served from the live handle under the read lock.
+    auto typed       = server.load<std::string>(AssetPath("hello.txt"));
+    auto untyped     = server.load_untyped(AssetPath("hello.txt"));
+    auto path_handle = server.get_or_create_path_handle<std::string>(AssetPath("hello.txt"), std::nullopt);
+    flush_load_tasks(app);
+
+    EXPECT_EQ(typed.id(), handle.id());
+    EXPECT_EQ(untyped.id(), UntypedAssetId(handle.id()));
+    EXPECT_EQ(path_handle.id(), handle.id());
+    EXPECT_EQ(server.diagnostics().started_load_tasks, 1u);
+}
+
 TEST(HotReload, Reload_UpdatesStoredAssetContent) {
     auto [app, dir] = make_plugin_env(/*watching=*/false);
     auto& server    = app.resource<AssetServer>();
@@ -2006,3 +2029,591 @@ TEST(DeserializeMetaIntegration, DifferentQualities_LoadSamePathWithMetaTransfor
     EXPECT_EQ(SettingsCapturingLoader::last_quality.load(), 77)
         << "MetaTransform override should win over .meta file settings";
 }
+
+// -------------------------------------------------------------------------------------
+// LoadQueue — prioritized, cancellable loads
+// -------------------------------------------------------------------------------------
+
+TEST(LoadQueue, QueuedLoad_StartsWhenSlotFrees) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    auto& server    = app.resource<AssetServer>();
+    server.set_max_loads_in_flight(0);
+
+    auto handle = server.load<std::string>(AssetPath("hello.txt"), LoadPriority::Background);
+    EXPECT_EQ(server.queued_loads(), 1);
+    EXPECT_TRUE(server.set_load_priority(handle.id(), LoadPriority::Visible));
+    flush_load_tasks(app);
+    EXPECT_FALSE(server.is_loaded(handle.id()));
+
+    server.set_max_loads_in_flight(1);
+    flush_load_tasks(app);
+    EXPECT_TRUE(server.is_loaded(handle.id()));
+    EXPECT_EQ(server.queued_loads(), 0);
+    EXPECT_FALSE(server.set_load_priority(handle.id(), LoadPriority::Prefetch));
+}
+
+namespace {
+
+/// Records the order of asset reads and holds them until the gate opens, so the order loads are
+/// dispatched in can be observed while a slot is taken.
+struct ReadGate {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open = false;
+    std::vector<std::string> reads;
+
+    void wait_for_reads(std::size_t count) {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [&] { return reads.size() >= count; });
+    }
+    void release() {
+        std::lock_guard lock(mutex);
+        open = true;
+        cv.notify_all();
+    }
+};
+
+struct GatedMemoryReader : MemoryAssetReader {
+    std::shared_ptr<ReadGate> gate;
+
+    GatedMemoryReader(memory::Directory dir, std::shared_ptr<ReadGate> gate)
+        : MemoryAssetReader(std::move(dir)), gate(std::move(gate)) {}
+
+    std::expected<std::unique_ptr<std::istream>, AssetReaderError> read(
+        const std::filesystem::path& path) const override {
+        if (path.extension() != ".meta") {
+            std::unique_lock lock(gate->mutex);
+            gate->reads.push_back(path.generic_string());
+            gate->cv.notify_all();
+            gate->cv.wait(lock, [&] { return gate->open; });
+        }
+        return MemoryAssetReader::read(path);
+    }
+};
+
+App make_gated_app(const memory::Directory& dir, std::shared_ptr<ReadGate> gate) {
+    App app = App::create();
+    AssetPlugin plugin;
+    plugin.watch_for_changes_override = false;
+    plugin.register_asset_source(AssetSourceId{},
+                                 AssetSourceBuilder::create([dir, gate]() -> std::unique_ptr<AssetReader> {
+                                     return std::make_unique<GatedMemoryReader>(dir, gate);
+                                 }));
+    plugin.build(app);
+    app_register_asset<std::string>(app);
+    app_register_loader<TestTextLoader>(app);
+    return app;
+}
+
+}  // namespace
+
+TEST(LoadQueue, HigherPriority_LoadsFirst) {
+    auto dir = make_memory_dir_with_text();
+    ASSERT_TRUE(dir.insert_file("near.txt", memory::Value::from_shared(make_bytes("near"))).has_value());
+    auto gate    = std::make_shared<ReadGate>();
+    App app      = make_gated_app(dir, gate);
+    auto& server = app.resource<AssetServer>();
+    server.set_max_loads_in_flight(0);
+
+    auto background = server.load<std::string>(AssetPath("hello.txt"), LoadPriority::Background);
+    auto nearby     = server.load<std::string>(AssetPath("near.txt"), LoadPriority::Nearby);
+    EXPECT_EQ(server.queued_loads(), 2);
+
+    // one slot: the nearby load takes it, the background load waits until its read is done.
+    server.set_max_loads_in_flight(1);
+    gate->wait_for_reads(1);
+    EXPECT_EQ(server.queued_loads(), 1);
+    EXPECT_TRUE(server.set_load_priority(background.id(), LoadPriority::Background));
+
+    gate->release();
+    flush_load_tasks(app);
+    EXPECT_EQ(gate->reads, (std::vector<std::string>{"near.txt", "hello.txt"}));
+    EXPECT_TRUE(server.is_loaded(nearby.id()));
+    EXPECT_TRUE(server.is_loaded(background.id()));
+}
+
+TEST(LoadQueue, LoadingAgain_RaisesQueuedPriority) {
+    auto dir = make_memory_dir_with_text();
+    ASSERT_TRUE(dir.insert_file("near.txt", memory::Value::from_shared(make_bytes("near"))).has_value());
+    auto gate    = std::make_shared<ReadGate>();
+    App app      = make_gated_app(dir, gate);
+    auto& server = app.resource<AssetServer>();
+    server.set_max_loads_in_flight(0);
+
+    auto nearby   = server.load<std::string>(AssetPath("near.txt"), LoadPriority::Nearby);
+    auto prefetch = server.load<std::string>(AssetPath("hello.txt"), LoadPriority::Prefetch);
+    auto visible  = server.load<std::string>(AssetPath("hello.txt"), LoadPriority::Visible);
+    EXPECT_EQ(prefetch.id(), visible.id());
+    EXPECT_EQ(server.queued_loads(), 2);
+
+    server.set_max_loads_in_flight(1);
+    gate->wait_for_reads(1);
+    EXPECT_FALSE(server.set_load_priority(visible.id(), LoadPriority::Visible));
+    EXPECT_TRUE(server.set_load_priority(nearby.id(), LoadPriority::Nearby));
+
+    gate->release();
+    flush_load_tasks(app);
+    EXPECT_EQ(gate->reads, (std::vector<std::string>{"hello.txt", "near.txt"}));
+    EXPECT_TRUE(server.is_loaded(visible.id()));
+}
+
+TEST(LoadQueue, DroppedHandle_CancelsQueuedLoad) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    auto& server    = app.resource<AssetServer>();
+    server.set_max_loads_in_flight(0);
+
+    auto id = [&]() {
+        auto handle = server.load<std::string>(AssetPath("hello.txt"), LoadPriority::Prefetch);
+        EXPECT_EQ(server.queued_loads(), 1);
+        return handle.id();
+    }();
+    // handle is dropped here
+    app.resource_mut<Assets<std::string>>().handle_events_manual(&server);
+    EXPECT_EQ(server.queued_loads(), 0);
+    EXPECT_FALSE(server.set_load_priority(id, LoadPriority::Visible));
+
+    server.set_max_loads_in_flight(4);
+    flush_load_tasks(app);
+    EXPECT_FALSE(app.resource<Assets<std::string>>().get(id).has_value());
+    EXPECT_FALSE(server.get_load_state(id).has_value());
+}
+
+TEST(LoadQueue, DroppedThenLoadedAgain_LoadsAsset) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    auto& server    = app.resource<AssetServer>();
+    server.set_max_loads_in_flight(0);
+
+    { auto dropped = server.load<std::string>(AssetPath("hello.txt")); }
+    auto handle = server.load<std::string>(AssetPath("hello.txt"));
+    app.resource_mut<Assets<std::string>>().handle_events_manual(&server);
+
+    server.set_max_loads_in_flight(4);
+    flush_load_tasks(app);
+    EXPECT_TRUE(server.is_loaded(handle.id()));
+}
+
+// -------------------------------------------------------------------------------------
+// Diagnostics — load stage timings published by AssetPlugin
+// -------------------------------------------------------------------------------------
+
+TEST(Diagnostics, FinishedLoad_PublishesStageTimingsAndBytes) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    auto& server    = app.resource<AssetServer>();
+
+    auto handle = server.load<std::string>(AssetPath("hello.txt"));
+    flush_load_tasks(app);
+    ASSERT_TRUE(server.is_loaded(handle.id()));
+
+    auto& diagnostics = app.resource<AssetServerDiagnostics>();
+    EXPECT_EQ(diagnostics.started_load_tasks, 1u);
+    EXPECT_EQ(diagnostics.finished_load_tasks, 1u);
+    EXPECT_EQ(diagnostics.in_flight_loads, 0u);
+    EXPECT_EQ(diagnostics.queued_loads, 0u);
+    EXPECT_EQ(diagnostics.bytes_read, std::string_view("hello").size());
+    ASSERT_EQ(diagnostics.loaders.size(), 1u);
+    auto& timings = diagnostics.loaders.front();
+    EXPECT_EQ(timings.bytes_read, std::string_view("hello").size());
+    EXPECT_EQ(timings.stage(LoadStage::Read).count, 1u);
+    EXPECT_EQ(timings.stage(LoadStage::Decode).count, 1u);
+    EXPECT_EQ(timings.stage(LoadStage::Insert).count, 1u);
+    ASSERT_EQ(diagnostics.asset_types.size(), 1u);
+    EXPECT_EQ(diagnostics.asset_types.front().stage(LoadStage::Decode).count, 1u);
+}
+
+TEST(Diagnostics, QueuedLoad_RecordsQueueTime) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    auto& server    = app.resource<AssetServer>();
+    server.set_max_loads_in_flight(0);
+
+    auto handle = server.load<std::string>(AssetPath("hello.txt"));
+    app.run_schedule(Last);
+    EXPECT_EQ(app.resource<AssetServerDiagnostics>().queued_loads, 1u);
+
+    server.set_max_loads_in_flight(4);
+    flush_load_tasks(app);
+    ASSERT_TRUE(server.is_loaded(handle.id()));
+    auto& diagnostics = app.resource<AssetServerDiagnostics>();
+    EXPECT_EQ(diagnostics.queued_loads, 0u);
+    ASSERT_EQ(diagnostics.loaders.size(), 1u);
+    EXPECT_EQ(diagnostics.loaders.front().stage(LoadStage::Queued).count, 1u);
+}
+
+TEST(Diagnostics, ChromeTrace_ContainsLoadStages) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    auto& server    = app.resource<AssetServer>();
+    EXPECT_TRUE(server.take_chrome_trace().empty());
+
+    server.start_chrome_trace();
+    auto handle = server.load<std::string>(AssetPath("hello.txt"));
+    flush_load_tasks(app);
+    ASSERT_TRUE(server.is_loaded(handle.id()));
+
+    auto trace = server.take_chrome_trace();
+    EXPECT_TRUE(trace.starts_with(R"({"displayTimeUnit":"ms","traceEvents":[)"));
+    EXPECT_TRUE(trace.contains(R"("name":"hello.txt")"));
+    for (auto stage : {"assets.read", "assets.decode", "assets.insert"}) {
+        EXPECT_TRUE(trace.contains(stage)) << stage;
+    }
+    // taking the trace stops it.
+    EXPECT_TRUE(server.take_chrome_trace().empty());
+}
+
+// -------------------------------------------------------------------------------------
+// MemoryBudget — LRU eviction and reload on access
+// -------------------------------------------------------------------------------------
+
+TEST(MemoryBudget, OverBudget_EvictsLeastRecentlyUsedAndReloadsOnAccess) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    ASSERT_TRUE(dir.insert_file("other.txt", memory::Value::from_shared(make_bytes("other"))).has_value());
+    auto& server = app.resource<AssetServer>();
+
+    auto hello = server.load<std::string>(AssetPath("hello.txt"));
+    auto other = server.load<std::string>(AssetPath("other.txt"));
+    flush_load_tasks(app);
+
+    auto& assets = app.resource_mut<Assets<std::string>>();
+    ASSERT_TRUE(assets.get(hello.id()).has_value());
+    ASSERT_TRUE(assets.get(other.id()).has_value());
+    assets.set_memory_budget(sizeof(std::string));
+
+    // both were used in this frame, so nothing can be evicted yet.
+    assets.manage_memory_manual(server);
+    EXPECT_FALSE(assets.is_evicted(hello.id()));
+    EXPECT_FALSE(assets.is_evicted(other.id()));
+
+    ASSERT_TRUE(assets.get(other.id()).has_value());
+    assets.manage_memory_manual(server);
+    EXPECT_TRUE(assets.is_evicted(hello.id()));
+    EXPECT_FALSE(assets.is_evicted(other.id()));
+    EXPECT_EQ(assets.resident_bytes(), sizeof(std::string));
+    EXPECT_FALSE(server.is_loaded(hello.id()));
+    EXPECT_TRUE(server.is_loaded(other.id()));
+
+    // the access misses, and asks for the asset to be loaded again.
+    EXPECT_FALSE(assets.get(hello.id()).has_value());
+    assets.set_memory_budget(std::nullopt);
+    assets.manage_memory_manual(server);
+    flush_load_tasks(app);
+
+    auto& reloaded = app.resource<Assets<std::string>>();
+    auto value     = reloaded.get(hello.id());
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(value->get(), "hello");
+    EXPECT_FALSE(reloaded.is_evicted(hello.id()));
+    EXPECT_TRUE(server.is_loaded(hello.id()));
+}
+
+TEST(MemoryBudget, SettingsLoadedAsset_ReloadsWithItsSettings) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    ASSERT_TRUE(dir.insert_file("asset.qtxt", memory::Value::from_shared(make_bytes("data"))).has_value());
+    app_register_loader<SettingsCapturingLoader>(app);
+    auto& server = app.resource<AssetServer>();
+
+    auto handle = server.load_with_settings<std::string, SettingsCapturingLoader::Settings>(
+        AssetPath("asset.qtxt"), [](SettingsCapturingLoader::Settings& settings) { settings.quality = 42; });
+    flush_load_tasks(app);
+    ASSERT_EQ(SettingsCapturingLoader::last_quality.load(), 42);
+
+    auto& assets = app.resource_mut<Assets<std::string>>();
+    assets.set_memory_budget(0);
+    assets.manage_memory_manual(server);
+    ASSERT_TRUE(assets.is_evicted(handle.id()));
+
+    SettingsCapturingLoader::reset_stats();
+    EXPECT_FALSE(assets.get(handle.id()).has_value());
+    assets.set_memory_budget(std::nullopt);
+    assets.manage_memory_manual(server);
+    flush_load_tasks(app);
+
+    EXPECT_TRUE(app.resource<Assets<std::string>>().get(handle.id()).has_value());
+    EXPECT_EQ(SettingsCapturingLoader::last_quality.load(), 42);
+}
+
+TEST(MemoryBudget, ModifiedAndAddedAssets_AreNotEvicted) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    auto& server    = app.resource<AssetServer>();
+
+    auto loaded = server.load<std::string>(AssetPath("hello.txt"));
+    flush_load_tasks(app);
+
+    auto& assets = app.resource_mut<Assets<std::string>>();
+    auto added   = assets.add(std::string("added"));
+    ASSERT_TRUE(assets.get_mut(loaded.id()).has_value());
+    assets.set_memory_budget(0);
+
+    assets.manage_memory_manual(server);
+    assets.manage_memory_manual(server);
+    EXPECT_FALSE(assets.is_evicted(loaded.id()));
+    EXPECT_TRUE(assets.get(loaded.id()).has_value());
+    EXPECT_TRUE(assets.get(added.id()).has_value());
+}
+
+TEST(MemoryBudget, ManageMemorySystem_ReportsUsage) {
+    auto [app, dir] = make_plugin_env(/*watching=*/false);
+    auto& server    = app.resource<AssetServer>();
+
+    auto handle = server.load<std::string>(AssetPath("hello.txt"));
+    flush_load_tasks(app);
+    app.resource_mut<Assets<std::string>>().set_memory_budget(1024);
+    app.run_schedule(PostUpdate);
+
+    auto usage = app.resource<AssetMemoryUsage>().get<std::string>();
+    ASSERT_TRUE(usage.has_value());
+    EXPECT_EQ(usage->resident_bytes, sizeof(std::string));
+    EXPECT_EQ(usage->budget, 1024u);
+    EXPECT_EQ(usage->evicted, 0u);
+    EXPECT_GE(app.resource<AssetMemoryUsage>().total_resident_bytes(), sizeof(std::string));
+}
+
+namespace {
+
+/// Holds a streaming loader after it published its assets, until the test lets it finish.
+struct StreamGate {
+    static inline std::mutex mutex;
+    static inline std::condition_variable cv;
+    static inline bool open     = true;
+    static inline int published = 0;
+
+    static void close() {
+        std::lock_guard lock(mutex);
+        open      = false;
+        published = 0;
+    }
+    static void release() {
+        std::lock_guard lock(mutex);
+        open = true;
+        cv.notify_all();
+    }
+    static void on_published() {
+        std::lock_guard lock(mutex);
+        published++;
+        cv.notify_all();
+    }
+    static int published_count() {
+        std::lock_guard lock(mutex);
+        return published;
+    }
+    static void wait_open() {
+        std::unique_lock lock(mutex);
+        cv.wait(lock, [] { return open; });
+    }
+};
+
+/// Closes the gate for the rest of a test; a failing test still lets its loader finish.
+struct ClosedStreamGate {
+    ClosedStreamGate() { StreamGate::close(); }
+    ~ClosedStreamGate() { StreamGate::release(); }
+};
+
+struct LinePack {
+    std::vector<Handle<std::string>> lines;
+};
+
+/// Loads each line of a file as a labeled `line<N>` asset, published as it is read when `Stream` is set.
+template <bool Stream>
+struct LinePackLoader {
+    using Asset = LinePack;
+    struct Settings {};
+    using Error = std::exception_ptr;
+
+    static std::span<std::string_view> extensions() {
+        static auto exts = std::array{std::string_view{Stream ? "stream" : "pack"}};
+        return std::span<std::string_view>(exts.data(), exts.size());
+    }
+
+    static std::expected<LinePack, Error> load(std::istream& reader, const Settings&, LoadContext& context) {
+        LinePack pack;
+        std::string line;
+        for (int i = 0; std::getline(reader, line); i++) {
+            auto label = std::format("line{}", i);
+            if constexpr (Stream) {
+                pack.lines.push_back(context.publish_labeled_asset<std::string>(label, line));
+                StreamGate::on_published();
+            } else {
+                pack.lines.push_back(context.add_labeled_asset<std::string>(label, line));
+            }
+        }
+        StreamGate::wait_open();
+        return pack;
+    }
+};
+
+struct ProgressiveImage {
+    int mips = 0;
+};
+
+/// Publishes a one-mip image before the full one.
+struct ProgressiveImageLoader {
+    using Asset = ProgressiveImage;
+    struct Settings {};
+    using Error = std::exception_ptr;
+
+    static std::span<std::string_view> extensions() {
+        static auto exts = std::array{std::string_view{"img"}};
+        return std::span<std::string_view>(exts.data(), exts.size());
+    }
+
+    static std::expected<ProgressiveImage, Error> load(std::istream&, const Settings&, LoadContext& context) {
+        EXPECT_FALSE(context.publish_partial(std::string("wrong type")));
+        EXPECT_TRUE(context.publish_partial(ProgressiveImage{1}));
+        StreamGate::on_published();
+        StreamGate::wait_open();
+        return ProgressiveImage{4};
+    }
+};
+
+PluginTestEnv make_streaming_env() {
+    auto env = make_plugin_env(/*watching=*/false);
+    for (auto name : {"lines.pack", "lines.stream", "image.img"}) {
+        EXPECT_TRUE(env.dir.insert_file(name, memory::Value::from_shared(make_bytes("a\nb\nc"))).has_value());
+    }
+    app_register_asset<LinePack>(env.app);
+    app_register_asset<ProgressiveImage>(env.app);
+    app_register_loader<LinePackLoader<false>>(env.app);
+    app_register_loader<LinePackLoader<true>>(env.app);
+    app_register_loader<ProgressiveImageLoader>(env.app);
+    return env;
+}
+
+/// Run Last until `done` holds, without waiting for the loaders, which may still be running.
+template <typename F>
+bool run_last_until(App& app, F&& done) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        app.run_schedule(Last);
+        if (done()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+}
+
+}  // namespace
+
+TEST(StreamingLoad, AddedLabeledAssets_ArriveWithRootAsset) {
+    auto [app, dir] = make_streaming_env();
+    auto& server    = app.resource<AssetServer>();
+
+    auto pack = server.load<LinePack>(AssetPath("lines.pack"));
+    flush_load_tasks(app);
+
+    ASSERT_TRUE(server.is_loaded(pack.id()));
+    auto& packs = app.resource<Assets<LinePack>>();
+    ASSERT_TRUE(packs.get(pack.id()).has_value());
+    auto& lines = packs.get(pack.id())->get().lines;
+    ASSERT_EQ(lines.size(), 3u);
+    auto& strings = app.resource<Assets<std::string>>();
+    EXPECT_EQ(strings.get(lines[1].id())->get(), "b");
+    EXPECT_EQ(server.get_handle<std::string>(AssetPath("lines.pack").with_label("line2")), lines[2]);
+    auto& published = app.resource<Events<LabeledAssetPublishedEvent>>();
+    EXPECT_EQ(published.head(), published.tail());
+}
+
+TEST(StreamingLoad, PublishedLabeledAssets_ArriveBeforeRootFinishes) {
+    auto [app, dir] = make_streaming_env();
+    auto& server    = app.resource<AssetServer>();
+    ClosedStreamGate gate;
+
+    auto pack = server.load<LinePack>(AssetPath("lines.stream"));
+    auto line = [&](std::string_view label) {
+        return server.get_handle<std::string>(AssetPath("lines.stream").with_label(label));
+    };
+    ASSERT_TRUE(run_last_until(app, [&] {
+        auto last = line("line2");
+        return last && server.is_loaded(last->id());
+    }));
+    EXPECT_FALSE(server.is_loaded(pack.id()));
+    EXPECT_EQ(app.resource<Assets<std::string>>().get(line("line0")->id())->get(), "a");
+    auto& published = app.resource<Events<LabeledAssetPublishedEvent>>();
+    EXPECT_TRUE(any_recorded_event(published, [&](const LabeledAssetPublishedEvent& event) {
+        return event.id == UntypedAssetId(line("line2")->id()) &&
+               event.path == AssetPath("lines.stream").with_label("line2") && !event.partial;
+    }));
+
+    StreamGate::release();
+    flush_load_tasks(app);
+    ASSERT_TRUE(server.is_loaded(pack.id()));
+    auto& lines = app.resource<Assets<LinePack>>().get(pack.id())->get().lines;
+    ASSERT_EQ(lines.size(), 3u);
+    EXPECT_EQ(app.resource<Assets<std::string>>().get(lines[2].id())->get(), "c");
+    EXPECT_EQ(server.pending_published_assets(), 0u);
+}
+
+TEST(StreamingLoad, PublishBeyondLimit_ArrivesWithRootAsset) {
+    auto [app, dir] = make_streaming_env();
+    auto& server    = app.resource<AssetServer>();
+    server.set_max_published_assets(1);
+    ClosedStreamGate gate;
+
+    auto pack = server.load<LinePack>(AssetPath("lines.stream"));
+    auto line = [&](std::string_view label) {
+        return server.get_handle<std::string>(AssetPath("lines.stream").with_label(label));
+    };
+    // the loader does not wait for a frame to handle the first asset before publishing the others.
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (StreamGate::published_count() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(StreamGate::published_count(), 3);
+    EXPECT_EQ(server.pending_published_assets(), 1u);
+
+    app.run_schedule(Last);
+    EXPECT_TRUE(server.is_loaded(line("line0")->id()));
+    EXPECT_FALSE(server.is_loaded(line("line2")->id()));
+    EXPECT_EQ(server.pending_published_assets(), 0u);
+
+    // no frame runs while the pools drain, so this hangs if the loader waits for one.
+    StreamGate::release();
+    flush_load_tasks(app);
+    EXPECT_TRUE(server.is_loaded(pack.id()));
+    EXPECT_TRUE(server.is_loaded(line("line2")->id()));
+    EXPECT_EQ(app.resource<Assets<std::string>>().get(line("line2")->id())->get(), "c");
+}
+
+TEST(StreamingLoad, PartialRootAsset_IsReplacedByFinalAsset) {
+    auto [app, dir] = make_streaming_env();
+    auto& server    = app.resource<AssetServer>();
+    ClosedStreamGate gate;
+
+    auto image = server.load<ProgressiveImage>(AssetPath("image.img"));
+    ASSERT_TRUE(
+        run_last_until(app, [&] { return app.resource<Assets<ProgressiveImage>>().get(image.id()).has_value(); }));
+    EXPECT_EQ(app.resource<Assets<ProgressiveImage>>().get(image.id())->get().mips, 1);
+    EXPECT_FALSE(server.is_loaded(image.id()));
+    EXPECT_TRUE(any_recorded_event(app.resource<Events<LabeledAssetPublishedEvent>>(),
+                                   [&](const LabeledAssetPublishedEvent& event) {
+                                       return event.id == UntypedAssetId(image.id()) && event.partial;
+                                   }));
+
+    StreamGate::release();
+    flush_load_tasks(app);
+    EXPECT_TRUE(server.is_loaded(image.id()));
+    EXPECT_EQ(app.resource<Assets<ProgressiveImage>>().get(image.id())->get().mips, 4);
+}
+
+TEST(MemoryBudget, LabeledAssetsAndTheirRoot_AreNotEvicted) {
+    auto [app, dir] = make_streaming_env();
+    auto& server    = app.resource<AssetServer>();
+
+    auto pack = server.load<LinePack>(AssetPath("lines.pack"));
+    flush_load_tasks(app);
+    ASSERT_TRUE(server.is_loaded(pack.id()));
+    auto lines = app.resource<Assets<LinePack>>().get(pack.id())->get().lines;
+    ASSERT_EQ(lines.size(), 3u);
+
+    auto& packs   = app.resource_mut<Assets<LinePack>>();
+    auto& strings = app.resource_mut<Assets<std::string>>();
+    packs.set_memory_budget(0);
+    strings.set_memory_budget(0);
+    for (int frame = 0; frame < 2; frame++) {
+        packs.manage_memory_manual(server);
+        strings.manage_memory_manual(server);
+    }
+
+    // loading either again would replace the other, so both stay resident.
+    EXPECT_FALSE(packs.is_evicted(pack.id()));
+    EXPECT_TRUE(server.is_loaded(pack.id()));
+    for (auto& line : lines) {
+        EXPECT_FALSE(strings.is_evicted(line.id()));
+        EXPECT_TRUE(strings.get(line.id()).has_value());
+    }
+}
@@ -227,6 +227,56 @@ TEST(Assets, IndexRecycling_AfterHandleDestruction_ReusesIndexAndBumpsGeneration
     EXPECT_EQ(first_index->generation() + 1, second_index.generation());
 }
 
+TEST(Assets, IndexRecycling_ManySlots_AllReused) {
+    Assets<std::string> assets;
+    std::set<std::uint32_t> first_indices;
+    {
+        std::vector<Handle<std::string>> handles;
+        for (int i = 0; i < 300; i++) handles.push_back(assets.emplace(std::to_string(i)));
+        for (auto& handle : handles) first_indices.insert(std::get<AssetIndex>(handle.id()).index());
+    }
+    assets.handle_events_manual();
+    EXPECT_EQ(assets.len(), 0u);
+
+    std::vector<Handle<std::string>> handles;
+    for (int i = 0; i < 300; i++) handles.push_back(assets.emplace(std::to_string(i)));
+    for (auto& handle : handles) {
+        auto index = std::get<AssetIndex>(handle.id());
+        EXPECT_TRUE(first_indices.contains(index.index()));
+        EXPECT_EQ(index.generation(), 1u);
+    }
+}
+
+TEST(Assets, StrongHandlesDroppedOnOtherThreads_ReleasedBySweep) {
+    Assets<std::string> assets;
+    std::vector<Handle<std::string>> handles;
+    for (int i = 0; i < 64; i++) handles.push_back(assets.emplace(std::to_string(i)));
+    auto kept = handles.front();
+    {
+        std::vector<std::jthread> threads;
+        for (int t = 0; t < 4; t++) {
+            // every thread drops its own copies; the originals go with the vector below.
+            threads.emplace_back([copies = handles]() mutable { copies.clear(); });
+        }
+        handles.clear();
+    }
+    assets.handle_events_manual();
+    EXPECT_EQ(assets.len(), 1u);
+    EXPECT_TRUE(assets.contains(kept.id()));
+}
+
+TEST(Assets, UuidStrongHandleDrop_ReleasesAsset) {
+    Assets<std::string> assets;
+    auto id = uuid_handle<std::string>("00000000-0000-0000-0000-00000000a042").id();
+    ASSERT_TRUE(assets.insert(id, "mapped").has_value());
+    {
+        auto strong = assets.get_strong_handle(id);
+        ASSERT_TRUE(strong.has_value());
+    }
+    assets.handle_events_manual();
+    EXPECT_FALSE(assets.contains(id));
+}
+
 // ===========================================================================
 // Assets<T> — reserve_handle
 // ===========================================================================
@@ -365,3 +415,39 @@ TEST(Assets, RemoveUntracked) {
     EXPECT_EQ(res.value(), "bye");
     EXPECT_FALSE(assets.contains(h.id()));
 }
+
+// ===========================================================================
+// Assets<T> — memory accounting
+// ===========================================================================
+
+namespace {
+struct Blob {
+    std::vector<std::byte> bytes;
+    std::size_t memory_size() const { return sizeof(Blob) + bytes.capacity(); }
+};
+}  // namespace
+
+TEST(Assets, ResidentBytes_UsesReportedSize) {
+    static_assert(AssetMemorySize<Blob>);
+    static_assert(!AssetMemorySize<std::string>);
+    Assets<Blob> assets;
+    EXPECT_EQ(assets.resident_bytes(), 0u);
+
+    auto h1 = assets.add(Blob{std::vector<std::byte>(100)});
+    auto h2 = assets.add(Blob{std::vector<std::byte>(50)});
+    EXPECT_EQ(assets.resident_bytes(), 2 * sizeof(Blob) + 150);
+
+    ASSERT_TRUE(assets.insert(h1.id(), Blob{std::vector<std::byte>(10)}).has_value());
+    EXPECT_EQ(assets.resident_bytes(), 2 * sizeof(Blob) + 60);
+
+    ASSERT_TRUE(assets.remove(h2.id()).has_value());
+    EXPECT_EQ(assets.resident_bytes(), sizeof(Blob) + 10);
+}
+
+TEST(Assets, ResidentBytes_FallsBackToSizeof) {
+    Assets<std::string> assets;
+    auto h = assets.add(std::string("value"));
+    EXPECT_EQ(assets.resident_bytes(), sizeof(std::string));
+    EXPECT_FALSE(assets.is_evicted(h.id()));
+    EXPECT_EQ(assets.memory_budget(), std::nullopt);
+}
@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.assets;
+
+using namespace epix::assets;
+using namespace std::chrono_literals;
+
+namespace {
+using Clock = AssetEventDebouncer::Clock;
+using Kind  = RawFileChange::Kind;
+
+const Clock::time_point T0{};
+
+// every path exists as a file, except those listed as directories or missing.
+struct FakeDisk {
+    std::set<std::filesystem::path> directories;
+    std::set<std::filesystem::path> missing;
+    FileStatus operator()(const std::filesystem::path& path) const {
+        if (missing.contains(path)) return {};
+        return FileStatus{.exists = true, .is_directory = directories.contains(path)};
+    }
+};
+
+std::vector<AssetSourceEvent> settle(AssetEventDebouncer& debouncer, const FakeDisk& disk = {}) {
+    auto settled = debouncer.take_all();
+    return AssetEventDebouncer::to_events(settled, disk);
+}
+}  // namespace
+
+TEST(AssetEventDebouncer, WaitsForQuietWindow) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Modified, "a.txt"}, T0);
+    debouncer.push({Kind::Modified, "a.txt"}, T0 + 60ms);
+
+    EXPECT_EQ(debouncer.next_deadline(), T0 + 160ms);
+    EXPECT_TRUE(debouncer.take_settled(T0 + 120ms).empty());
+    EXPECT_EQ(debouncer.pending(), 1);
+
+    auto settled = debouncer.take_settled(T0 + 160ms);
+    ASSERT_EQ(settled.size(), 1);
+    EXPECT_EQ(settled[0].kind, AssetEventDebouncer::Settled::Kind::Modified);
+    EXPECT_EQ(debouncer.pending(), 0);
+    EXPECT_FALSE(debouncer.next_deadline().has_value());
+}
+
+TEST(AssetEventDebouncer, SettlesPathsIndependently) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Modified, "a.txt"}, T0);
+    debouncer.push({Kind::Modified, "b.txt"}, T0 + 80ms);
+
+    auto settled = debouncer.take_settled(T0 + 100ms);
+    ASSERT_EQ(settled.size(), 1);
+    EXPECT_EQ(settled[0].path, "a.txt");
+    EXPECT_EQ(debouncer.next_deadline(), T0 + 180ms);
+}
+
+TEST(AssetEventDebouncer, AddedThenModifiedIsAdded) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Added, "a.txt"}, T0);
+    debouncer.push({Kind::Modified, "a.txt"}, T0);
+    debouncer.push({Kind::Modified, "a.txt"}, T0);
+
+    auto events = settle(debouncer);
+    ASSERT_EQ(events.size(), 1);
+    auto* added = std::get_if<source_events::AddedAsset>(&events[0]);
+    ASSERT_NE(added, nullptr);
+    EXPECT_EQ(added->path, "a.txt");
+}
+
+TEST(AssetEventDebouncer, AddedThenRemovedIsNothing) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Added, "a.txt"}, T0);
+    debouncer.push({Kind::Modified, "a.txt"}, T0);
+    debouncer.push({Kind::Removed, "a.txt"}, T0);
+
+    EXPECT_EQ(debouncer.pending(), 0);
+    EXPECT_TRUE(settle(debouncer).empty());
+}
+
+TEST(AssetEventDebouncer, RemovedThenAddedIsModified) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Removed, "a.txt"}, T0);
+    debouncer.push({Kind::Added, "a.txt"}, T0);
+
+    auto events = settle(debouncer);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_TRUE(std::holds_alternative<source_events::ModifiedAsset>(events[0]));
+}
+
+TEST(AssetEventDebouncer, RenameChainIsOneRename) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Moved, "b.txt", "a.txt"}, T0);
+    debouncer.push({Kind::Moved, "c.txt", "b.txt"}, T0);
+
+    auto events = settle(debouncer);
+    ASSERT_EQ(events.size(), 1);
+    auto* renamed = std::get_if<source_events::RenamedAsset>(&events[0]);
+    ASSERT_NE(renamed, nullptr);
+    EXPECT_EQ(renamed->old_path, "a.txt");
+    EXPECT_EQ(renamed->new_path, "c.txt");
+}
+
+TEST(AssetEventDebouncer, RenameBackIsModified) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Moved, "b.txt", "a.txt"}, T0);
+    debouncer.push({Kind::Moved, "a.txt", "b.txt"}, T0);
+
+    auto events = settle(debouncer);
+    ASSERT_EQ(events.size(), 1);
+    EXPECT_TRUE(std::holds_alternative<source_events::ModifiedAsset>(events[0]));
+}
+
+TEST(AssetEventDebouncer, RenamedThenModifiedReportsBoth) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Moved, "b.txt", "a.txt"}, T0);
+    debouncer.push({Kind::Modified, "b.txt"}, T0);
+
+    auto events = settle(debouncer);
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_TRUE(std::holds_alternative<source_events::RenamedAsset>(events[0]));
+    EXPECT_TRUE(std::holds_alternative<source_events::ModifiedAsset>(events[1]));
+}
+
+TEST(AssetEventDebouncer, RenamedThenRemovedRemovesOrigin) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Moved, "b.txt", "a.txt"}, T0);
+    debouncer.push({Kind::Removed, "b.txt"}, T0);
+
+    auto events = settle(debouncer);
+    ASSERT_EQ(events.size(), 1);
+    auto* removed = std::get_if<source_events::RemovedAsset>(&events[0]);
+    ASSERT_NE(removed, nullptr);
+    EXPECT_EQ(removed->path, "a.txt");
+}
+
+TEST(AssetEventDebouncer, AtomicSaveIsModified) {
+    // editors write a temporary file, then rename it over the target.
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Added, "a.txt.tmp"}, T0);
+    debouncer.push({Kind::Modified, "a.txt.tmp"}, T0);
+    debouncer.push({Kind::Removed, "a.txt"}, T0);
+    debouncer.push({Kind::Moved, "a.txt", "a.txt.tmp"}, T0);
+
+    auto events = settle(debouncer);
+    ASSERT_EQ(events.size(), 1);
+    auto* modified = std::get_if<source_events::ModifiedAsset>(&events[0]);
+    ASSERT_NE(modified, nullptr);
+    EXPECT_EQ(modified->path, "a.txt");
+}
+
+TEST(AssetEventDebouncer, NewFileRenamedIntoPlaceIsAdded) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Added, "a.txt.tmp"}, T0);
+    debouncer.push({Kind::Moved, "a.txt", "a.txt.tmp"}, T0);
+
+    auto events = settle(debouncer);
+    ASSERT_EQ(events.size(), 1);
+    auto* added = std::get_if<source_events::AddedAsset>(&events[0]);
+    ASSERT_NE(added, nullptr);
+    EXPECT_EQ(added->path, "a.txt");
+}
+
+TEST(AssetEventDebouncer, ClassifiesOnSettle) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Added, "textures"}, T0);
+    debouncer.push({Kind::Modified, "textures"}, T0);
+    debouncer.push({Kind::Added, "a.txt.meta"}, T0);
+    debouncer.push({Kind::Removed, "b.txt.meta"}, T0);
+    debouncer.push({Kind::Modified, "gone.txt"}, T0);
+
+    FakeDisk disk;
+    disk.directories.insert("textures");
+    disk.missing.insert("gone.txt");
+    auto events = settle(debouncer, disk);
+    ASSERT_EQ(events.size(), 3);
+    EXPECT_TRUE(std::holds_alternative<source_events::AddedMeta>(events[0]));
+    EXPECT_TRUE(std::holds_alternative<source_events::RemovedMeta>(events[1]));
+    EXPECT_TRUE(std::holds_alternative<source_events::AddedDirectory>(events[2]));
+}
+
+TEST(AssetEventDebouncer, RenamedDirectory) {
+    AssetEventDebouncer debouncer(100ms);
+    debouncer.push({Kind::Moved, "new", "old"}, T0);
+
+    FakeDisk disk;
+    disk.directories.insert("new");
+    auto events = settle(debouncer, disk);
+    ASSERT_EQ(events.size(), 1);
+    auto* renamed = std::get_if<source_events::RenamedDirectory>(&events[0]);
+    ASSERT_NE(renamed, nullptr);
+    EXPECT_EQ(renamed->old_path, "old");
+    EXPECT_EQ(renamed->new_path, "new");
+}
@@ -0,0 +1,56 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.assets;
+
+using namespace epix::assets;
+
+TEST(LatencyHistogram, EmptyHistogram) {
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.count, 0u);
+    EXPECT_EQ(histogram.mean(), std::chrono::nanoseconds{0});
+    EXPECT_EQ(histogram.quantile(0.5), std::chrono::nanoseconds{0});
+}
+
+TEST(LatencyHistogram, RecordsIntoPowerOfTwoBuckets) {
+    LatencyHistogram histogram;
+    histogram.record(std::chrono::nanoseconds(500));
+    histogram.record(std::chrono::microseconds(3));
+    histogram.record(std::chrono::microseconds(1000));
+
+    EXPECT_EQ(histogram.count, 3u);
+    EXPECT_EQ(histogram.buckets[0], 1u);
+    EXPECT_EQ(histogram.buckets[2], 1u);
+    EXPECT_EQ(histogram.buckets[10], 1u);
+    EXPECT_EQ(histogram.max, std::chrono::microseconds(1000));
+    EXPECT_EQ(histogram.mean(), (std::chrono::nanoseconds(500) + std::chrono::microseconds(1003)) / 3);
+}
+
+TEST(LatencyHistogram, LongDurationsLandInLastBucket) {
+    LatencyHistogram histogram;
+    histogram.record(std::chrono::hours(1));
+    EXPECT_EQ(histogram.buckets[LatencyHistogram::BUCKETS - 1], 1u);
+    EXPECT_EQ(histogram.quantile(1.0), std::chrono::hours(1));
+}
+
+TEST(LatencyHistogram, QuantileIsBucketUpperBound) {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 9; i++) histogram.record(std::chrono::microseconds(3));
+    histogram.record(std::chrono::microseconds(900));
+
+    EXPECT_EQ(histogram.quantile(0.5), std::chrono::microseconds(4));
+    EXPECT_EQ(histogram.quantile(0.9), std::chrono::microseconds(4));
+    // capped by the max instead of the 1024 µs bucket bound.
+    EXPECT_EQ(histogram.quantile(0.99), std::chrono::microseconds(900));
+}
+
+TEST(AssetServerDiagnostics, LookupByName) {
+    AssetServerDiagnostics diagnostics;
+    diagnostics.loaders.push_back(LoadStageTimings{.name = "TextLoader"});
+    diagnostics.loaders.back().bytes_read = 5;
+
+    ASSERT_NE(diagnostics.loader("TextLoader"), nullptr);
+    EXPECT_EQ(diagnostics.loader("TextLoader")->bytes_read, 5u);
+    EXPECT_EQ(diagnostics.loader("ImageLoader"), nullptr);
+    EXPECT_EQ(diagnostics.asset_type("TextLoader"), nullptr);
+}
@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.assets;
+
+#include "temp_dir.hpp"
+
+using namespace epix::assets;
+
+namespace {
+std::string to_string(std::span<const std::byte> bytes) {
+    return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+}  // namespace
+
+TEST(FileAssetReader, ReadBytesView_MapsFileContent) {
+    TempDir dir;
+    dir.write("data.bin", "mapped content");
+    auto reader = AssetSource::get_default_reader(dir.path)();
+
+    auto view = reader->read_bytes_view("data.bin");
+    ASSERT_TRUE(view.has_value());
+    EXPECT_EQ(to_string(view->bytes()), "mapped content");
+
+    // the view keeps the mapping alive on its own.
+    reader.reset();
+    auto copy = *view;
+    view.reset();
+    EXPECT_EQ(to_string(copy.bytes()), "mapped content");
+}
+
+TEST(FileAssetReader, ReadBytesView_EmptyFile) {
+    TempDir dir;
+    dir.write("empty.bin", "");
+    auto reader = AssetSource::get_default_reader(dir.path)();
+
+    auto view = reader->read_bytes_view("empty.bin");
+    ASSERT_TRUE(view.has_value());
+    EXPECT_TRUE(view->empty());
+}
+
+TEST(FileAssetReader, ReadBytesView_MissingFallsBack) {
+    TempDir dir;
+    auto reader = AssetSource::get_default_reader(dir.path)();
+
+    EXPECT_FALSE(reader->read_bytes_view("missing.bin").has_value());
+    // read() still reports the error.
+    auto stream = reader->read("missing.bin");
+    ASSERT_FALSE(stream.has_value());
+    EXPECT_TRUE(std::holds_alternative<reader_errors::NotFound>(stream.error()));
+}
+
+TEST(AssetReader, ReadBytesView_DefaultUnsupported) {
+    MemoryAssetReader reader(memory::Directory::create({}));
+    EXPECT_FALSE(reader.read_bytes_view("anything").has_value());
+}
+
+namespace {
+std::expected<AssetBytes, AssetReaderError> read_async(const AssetReader& reader, const std::filesystem::path& path) {
+    std::promise<std::expected<AssetBytes, AssetReaderError>> promise;
+    auto future = promise.get_future();
+    auto shared = std::make_shared<decltype(promise)>(std::move(promise));
+    reader.read_bytes_async(path, [shared](std::expected<AssetBytes, AssetReaderError> result) {
+        shared->set_value(std::move(result));
+    });
+    EXPECT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    return future.get();
+}
+}  // namespace
+
+TEST(FileAssetReader, ReadBytesAsync_ManyFiles) {
+    TempDir dir;
+    constexpr int count = 600;
+    for (int i = 0; i < count; i++) dir.write(std::format("{}.txt", i), std::format("file {}", i));
+    auto reader = AssetSource::get_default_reader(dir.path)();
+
+    // reads still in flight after a timeout must not touch this frame.
+    struct Results {
+        std::mutex mutex;
+        std::condition_variable cv;
+        int done = 0, matched = 0;
+    };
+    auto results = std::make_shared<Results>();
+    for (int i = 0; i < count; i++) {
+        auto on_complete = [results, i](std::expected<AssetBytes, AssetReaderError> result) {
+            std::lock_guard lock(results->mutex);
+            if (result && to_string(result->bytes()) == std::format("file {}", i)) results->matched++;
+            results->done++;
+            results->cv.notify_all();
+        };
+        reader->read_bytes_async(std::format("{}.txt", i), on_complete);
+    }
+    std::unique_lock lock(results->mutex);
+    EXPECT_TRUE(results->cv.wait_for(lock, std::chrono::seconds(10), [&] { return results->done == count; }));
+    EXPECT_EQ(results->matched, count);
+}
+
+TEST(FileAssetReader, ReadBytesAsync_Missing) {
+    TempDir dir;
+    auto reader = AssetSource::get_default_reader(dir.path)();
+    auto result = read_async(*reader, "missing.bin");
+    ASSERT_FALSE(result.has_value());
+    EXPECT_TRUE(std::holds_alternative<reader_errors::NotFound>(result.error()));
+}
+
+TEST(AssetReader, ReadBytesAsync_DefaultCopiesStream) {
+    auto dir    = memory::Directory::create({});
+    auto text   = std::as_bytes(std::span(std::string_view("in memory")));
+    dir.insert_file("a.txt",
+                    memory::Value::from_shared(std::make_shared<std::vector<std::byte>>(text.begin(), text.end())));
+    MemoryAssetReader reader(dir);
+    auto result = read_async(reader, "a.txt");
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(to_string(result->bytes()), "in memory");
+}
@@ -775,7 +775,60 @@ TEST(DeserializeProcessedInfo, EmptyBytes_Fails) {
 }
 
 // ===========================================================================
-// AssetHasher / get_asset_hash / get_full_asset_hash — internal hashing helpers
-// These are pub(crate) equivalents; tested indirectly through the processor
-// pipeline in processor_embedded_tests. No direct unit tests here.
+// get_asset_hash / get_full_asset_hash — BLAKE3 reference vectors
 // ===========================================================================
+
+namespace {
+std::string to_hex(const AssetHash& hash) {
+    std::string hex;
+    for (auto byte : hash) hex += std::format("{:02x}", byte);
+    return hex;
+}
+// the input pattern of the official BLAKE3 test vectors.
+std::vector<std::byte> test_input(std::size_t len) {
+    std::vector<std::byte> bytes(len);
+    for (std::size_t i = 0; i < len; i++) bytes[i] = std::byte(i % 251);
+    return bytes;
+}
+}  // namespace
+
+TEST(AssetHash, MatchesBlake3Vectors) {
+    auto abc = std::as_bytes(std::span(std::string_view("abc")));
+    EXPECT_EQ(to_hex(get_asset_hash({}, std::span<const std::byte>{})),
+              "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262");
+    EXPECT_EQ(to_hex(get_asset_hash({}, abc)), "6437b3ac38465133ffb63b75273a8db548c558465d79db03fd359c6cd5bd9d85");
+    EXPECT_EQ(to_hex(get_asset_hash({}, test_input(1025))),
+              "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444");
+    EXPECT_EQ(to_hex(get_asset_hash({}, test_input(102400))),
+              "bc3e3d41a1146b069abffad3c0d44860cf664390afce4d9661f7902e7943e085");
+}
+
+TEST(AssetHash, MetaBytesPrefixTheAsset) {
+    auto meta = std::as_bytes(std::span(std::string_view("meta")));
+    EXPECT_EQ(to_hex(get_asset_hash(meta, test_input(5000))),
+              "8e667de46ba8669d8a230b2a202d30a757051a72adbd13da70bbbc26b858487b");
+}
+
+TEST(AssetHash, StreamMatchesSpan) {
+    auto meta = std::as_bytes(std::span(std::string_view("meta")));
+    for (std::size_t len : std::array<std::size_t, 6>{0, 1, 1024, 4097, 200000, (9 << 20) + 3}) {
+        auto bytes = test_input(len);
+        std::ispanstream stream(std::span(reinterpret_cast<const char*>(bytes.data()), bytes.size()));
+        EXPECT_EQ(get_asset_hash(meta, stream), get_asset_hash(meta, bytes)) << "len " << len;
+    }
+}
+
+TEST(AssetHash, ThreadedMatchesSingleThreaded) {
+    auto meta = std::as_bytes(std::span(std::string_view("meta")));
+    // large enough for the subtrees to be split across threads.
+    auto bytes = test_input((17 << 20) + 5);
+    auto hash  = get_asset_hash(meta, bytes);
+    for (unsigned threads : {1u, 2u, 3u, 4u, 7u}) EXPECT_EQ(get_asset_hash(meta, bytes, threads), hash) << threads;
+}
+
+TEST(AssetHash, FullHashDependsOnDependencies) {
+    auto hash = get_asset_hash({}, test_input(10));
+    auto dep  = get_asset_hash({}, test_input(20));
+    EXPECT_NE(get_full_asset_hash(hash, {}), get_full_asset_hash(hash, {dep}));
+    EXPECT_EQ(get_full_asset_hash(hash, {dep}), get_full_asset_hash(hash, {dep}));
+}
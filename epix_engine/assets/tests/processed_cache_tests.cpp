@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.assets;
+
+#include "temp_dir.hpp"
+
+using namespace epix::assets;
+
+namespace {
+std::span<const std::byte> bytes_of(std::string_view s) { return std::as_bytes(std::span(s)); }
+std::string read_file(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(stream), {});
+}
+AssetHash input_hash(std::string_view content) { return get_asset_hash({}, bytes_of(content)); }
+}  // namespace
+
+TEST(ProcessedAssetCache, KeyDependsOnProcessorAndVersion) {
+    auto input = input_hash("source");
+    auto key   = ProcessedAssetCache::key(input, "ns::Compress", 1);
+    EXPECT_EQ(key, ProcessedAssetCache::key(input, "ns::Compress", 1));
+    EXPECT_NE(key, ProcessedAssetCache::key(input, "ns::Compress", 2));
+    EXPECT_NE(key, ProcessedAssetCache::key(input, "ns::Other", 1));
+    EXPECT_NE(key, ProcessedAssetCache::key(input_hash("changed"), "ns::Compress", 1));
+}
+
+TEST(ProcessedAssetCache, StoreAndFind) {
+    TempDir dir;
+    ProcessedAssetCache cache(dir.path / "cache");
+    auto key = ProcessedAssetCache::key(input_hash("source"), "ns::Compress", 1);
+
+    EXPECT_FALSE(cache.find(key).has_value());
+    ASSERT_TRUE(cache.store(key, bytes_of("processed"), bytes_of("meta")));
+
+    auto entry = cache.find(key);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(read_file(entry->asset), "processed");
+    EXPECT_TRUE(std::ranges::equal(entry->meta, bytes_of("meta")));
+
+    auto stats = cache.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 1u);
+    EXPECT_EQ(stats.stores, 1u);
+}
+
+TEST(ProcessedAssetCache, SharedBetweenInstances) {
+    TempDir dir;
+    auto key = ProcessedAssetCache::key(input_hash("source"), "ns::Compress", 1);
+    ASSERT_TRUE(ProcessedAssetCache(dir.path / "cache").store(key, bytes_of("processed"), bytes_of("meta")));
+
+    ProcessedAssetCache other(dir.path / "cache");
+    auto entry = other.find(key);
+    ASSERT_TRUE(entry.has_value());
+    EXPECT_EQ(read_file(entry->asset), "processed");
+}
+
+TEST(ProcessedAssetCache, EntryWithoutMetaIsMissingAndCollected) {
+    TempDir dir;
+    ProcessedAssetCache cache(dir.path / "cache");
+    auto key = ProcessedAssetCache::key(input_hash("source"), "ns::Compress", 1);
+    ASSERT_TRUE(cache.store(key, bytes_of("processed"), bytes_of("meta")));
+    auto entry = cache.find(key);
+    ASSERT_TRUE(entry.has_value());
+    std::filesystem::remove(std::filesystem::path(entry->asset).replace_extension(".meta"));
+
+    EXPECT_FALSE(cache.find(key).has_value());
+    EXPECT_EQ(cache.collect_garbage(), std::string_view("processed").size());
+    EXPECT_EQ(cache.size_bytes(), 0u);
+}
+
+TEST(ProcessedAssetCache, CollectsLeastRecentlyUsed) {
+    TempDir dir;
+    // room for two entries of 10 + 4 bytes.
+    ProcessedAssetCache cache(dir.path / "cache", 28);
+    std::vector<AssetHash> keys;
+    for (auto name : {"a", "b", "c"}) {
+        keys.push_back(ProcessedAssetCache::key(input_hash(name), "ns::Compress", 1));
+        ASSERT_TRUE(cache.store(keys.back(), bytes_of("0123456789"), bytes_of("meta")));
+    }
+    // make `a` the most recently used: meta times are what the collection orders by.
+    auto now = std::filesystem::file_time_type::clock::now();
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        auto entry = cache.find(keys[i]);
+        ASSERT_TRUE(entry.has_value());
+        auto meta = std::filesystem::path(entry->asset).replace_extension(".meta");
+        std::filesystem::last_write_time(meta, now - std::chrono::hours(i == 0 ? 0 : 10 - i));
+    }
+    EXPECT_TRUE(cache.needs_collection());
+
+    EXPECT_EQ(cache.collect_garbage(), 14u);
+    EXPECT_FALSE(cache.needs_collection());
+    EXPECT_EQ(cache.size_bytes(), 28u);
+    EXPECT_EQ(cache.stats().evicted, 1u);
+    EXPECT_TRUE(cache.find(keys[0]).has_value());
+    EXPECT_FALSE(cache.find(keys[1]).has_value());
+    EXPECT_TRUE(cache.find(keys[2]).has_value());
+}
+
+TEST(FileAssetWriter, WriteFromFileDoesNotShareLaterWrites) {
+    TempDir dir;
+    ProcessedAssetCache cache(dir.path / "cache");
+    auto key = ProcessedAssetCache::key(input_hash("source"), "ns::Compress", 1);
+    ASSERT_TRUE(cache.store(key, bytes_of("processed"), bytes_of("meta")));
+    auto entry = cache.find(key);
+    ASSERT_TRUE(entry.has_value());
+
+    FileAssetWriter writer(dir.path / "processed");
+    ASSERT_TRUE(writer.write_from_file("a.bin", entry->asset).has_value());
+    EXPECT_EQ(read_file(dir.path / "processed" / "a.bin"), "processed");
+
+    // rewriting the processed asset must leave the cached file alone, even if it was linked.
+    ASSERT_TRUE(writer.write_bytes("a.bin", bytes_of("rewritten")).has_value());
+    EXPECT_EQ(read_file(dir.path / "processed" / "a.bin"), "rewritten");
+    EXPECT_EQ(read_file(entry->asset), "processed");
+}
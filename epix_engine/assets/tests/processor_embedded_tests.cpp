@@ -109,6 +109,12 @@ struct TestIdentityProcessor {
     }
 };
 
+// ---- Identity processor declaring a version ----
+
+struct TestVersionedProcessor : TestIdentityProcessor {
+    static constexpr std::uint32_t version = 3;
+};
+
 // ---- Helper: create an AssetProcessor with in-memory sources ----
 
 AssetProcessor create_empty_asset_processor() {
@@ -545,3 +551,171 @@ TEST(ValidateLogError, EntryErrors) {
     ASSERT_TRUE(std::holds_alternative<validate_log_errors::EntryErrors>(err));
     EXPECT_EQ(std::get<validate_log_errors::EntryErrors>(err).errors.size(), 1u);
 }
+
+TEST(AssetProcessor, ProcessingLimits_SetAndGet) {
+    auto processor = create_empty_asset_processor();
+    auto defaults  = processor.get_data()->processing_limits();
+    EXPECT_GE(defaults.tasks, defaults.cpu_tasks);
+    EXPECT_GE(defaults.cpu_tasks, 1u);
+
+    processor.get_data()->set_processing_limits(ProcessingLimits{.tasks = 3, .cpu_tasks = 1});
+    auto limits = processor.get_data()->processing_limits();
+    EXPECT_EQ(limits.tasks, 3u);
+    EXPECT_EQ(limits.cpu_tasks, 1u);
+    EXPECT_FALSE(processor.get_data()->process_time(AssetPath("never/processed.txt")).has_value());
+}
+
+namespace {
+ProcessingScheduler::Task scheduler_task(std::string_view path) { return {AssetSourceId{}, path}; }
+AssetPath scheduler_path(std::string_view path) { return AssetPath(AssetSourceId{}, path); }
+std::optional<AssetPath> pop_path(ProcessingScheduler& scheduler, std::size_t limit = 8) {
+    return scheduler.pop(limit).transform([](const auto& task) { return AssetPath(task.first, task.second); });
+}
+}  // namespace
+
+TEST(ProcessingScheduler, DependentWaitsForQueuedDependency) {
+    ProcessingScheduler scheduler;
+    scheduler.push(scheduler_task("b.txt"), {});
+    std::array dependencies{scheduler_path("b.txt"), scheduler_path("not_queued.txt")};
+    scheduler.push(scheduler_task("a.txt"), dependencies);
+
+    EXPECT_EQ(pop_path(scheduler), scheduler_path("b.txt"));
+    // a.txt waits for b.txt; dependencies that are not queued do not block.
+    EXPECT_EQ(pop_path(scheduler), std::nullopt);
+    scheduler.finish(scheduler_path("b.txt"), true);
+    EXPECT_EQ(pop_path(scheduler), scheduler_path("a.txt"));
+    scheduler.finish(scheduler_path("a.txt"), true);
+    EXPECT_TRUE(scheduler.empty());
+}
+
+TEST(ProcessingScheduler, PopStopsAtLimit) {
+    ProcessingScheduler scheduler;
+    for (auto path : {"x.txt", "y.txt", "z.txt"}) scheduler.push(scheduler_task(path), {});
+
+    EXPECT_EQ(pop_path(scheduler, 2), scheduler_path("x.txt"));
+    EXPECT_EQ(pop_path(scheduler, 2), scheduler_path("y.txt"));
+    EXPECT_EQ(pop_path(scheduler, 2), std::nullopt);
+    scheduler.finish(scheduler_path("x.txt"), true);
+    EXPECT_EQ(pop_path(scheduler, 2), scheduler_path("z.txt"));
+}
+
+TEST(ProcessingScheduler, StealRunsQueuedTaskOutsideLimit) {
+    ProcessingScheduler scheduler;
+    scheduler.push(scheduler_task("b.txt"), {});
+    std::array dependencies{scheduler_path("b.txt")};
+    scheduler.push(scheduler_task("a.txt"), dependencies);
+    scheduler.push(scheduler_task("c.txt"), {});
+
+    auto stolen = scheduler.steal(scheduler_path("b.txt"));
+    ASSERT_TRUE(stolen.has_value());
+    EXPECT_EQ(stolen->second, std::filesystem::path("b.txt"));
+    EXPECT_FALSE(scheduler.steal(scheduler_path("b.txt")).has_value());
+    // the stolen task holds no slot, and is not popped a second time.
+    EXPECT_EQ(pop_path(scheduler, 1), scheduler_path("c.txt"));
+    EXPECT_EQ(pop_path(scheduler, 2), std::nullopt);
+
+    scheduler.finish(scheduler_path("b.txt"), false);
+    EXPECT_EQ(pop_path(scheduler, 2), scheduler_path("a.txt"));
+}
+
+TEST(ProcessingScheduler, StaleListingOfStolenTaskWaitsForNewDependencies) {
+    ProcessingScheduler scheduler;
+    scheduler.push(scheduler_task("b.txt"), {});
+    ASSERT_TRUE(scheduler.steal(scheduler_path("b.txt")).has_value());
+    scheduler.finish(scheduler_path("b.txt"), false);
+
+    // b.txt comes back blocked on c.txt while its old ready listing is still queued.
+    scheduler.push(scheduler_task("c.txt"), {});
+    std::array dependencies{scheduler_path("c.txt")};
+    scheduler.push(scheduler_task("b.txt"), dependencies);
+    EXPECT_EQ(pop_path(scheduler), scheduler_path("c.txt"));
+    EXPECT_EQ(pop_path(scheduler), std::nullopt);
+    scheduler.finish(scheduler_path("c.txt"), true);
+    EXPECT_EQ(pop_path(scheduler), scheduler_path("b.txt"));
+}
+
+TEST(AssetProcessor, ProcessorVersion) {
+    auto processor = create_empty_asset_processor();
+    processor.register_processor(TestIdentityProcessor{});
+    processor.register_processor(TestVersionedProcessor{});
+    auto unversioned = processor.get_processor(meta::type_id<TestIdentityProcessor>{}.name());
+    auto versioned   = processor.get_processor(meta::type_id<TestVersionedProcessor>{}.name());
+    ASSERT_TRUE(unversioned.has_value());
+    ASSERT_TRUE(versioned.has_value());
+    EXPECT_EQ((*unversioned)->version(), 0u);
+    EXPECT_EQ((*versioned)->version(), 3u);
+}
+
+TEST(AssetProcessor, ProcessedCache_SetAndGet) {
+    auto processor = create_empty_asset_processor();
+    EXPECT_EQ(processor.get_data()->processed_cache(), nullptr);
+    auto cache = std::make_shared<ProcessedAssetCache>(std::filesystem::temp_directory_path() / "epix_cache_set_get");
+    processor.get_data()->set_processed_cache(cache);
+    EXPECT_EQ(processor.get_data()->processed_cache(), cache);
+    processor.get_data()->set_processed_cache(nullptr);
+    EXPECT_EQ(processor.get_data()->processed_cache(), nullptr);
+    std::filesystem::remove_all(cache->root());
+}
+
+namespace {
+/** @brief Processes a file naming another asset by loading that asset directly and writing out its content. */
+struct LoadDirectProcessor {
+    struct Settings {};
+    using OutputLoader = TestTextLoader;
+
+    std::expected<OutputLoader::Settings, std::exception_ptr> process(ProcessContext& ctx,
+                                                                      const Settings&,
+                                                                      std::ostream& writer) const {
+        std::stringstream dependency_path;
+        dependency_path << ctx.asset_reader().rdbuf();
+        LoadContext load_context(ctx.asset_server(), ctx.path());
+        auto dependency = load_context.load_direct<std::string>(AssetPath(dependency_path.str()));
+        if (!dependency) return std::unexpected(std::make_exception_ptr(std::runtime_error("load_direct failed")));
+        writer << dependency->get();
+        return OutputLoader::Settings{};
+    }
+};
+
+AssetSourceBuilder make_processed_memory_source_builder(const memory::Directory& source_dir,
+                                                        const memory::Directory& processed_dir) {
+    return AssetSourceBuilder::create([source_dir]() -> std::unique_ptr<AssetReader> {
+               return std::make_unique<MemoryAssetReader>(source_dir);
+           })
+        .with_processed_reader([processed_dir]() -> std::unique_ptr<AssetReader> {
+            return std::make_unique<MemoryAssetReader>(processed_dir);
+        })
+        .with_processed_writer([processed_dir]() -> std::unique_ptr<AssetWriter> {
+            return std::make_unique<MemoryAssetWriter>(processed_dir);
+        });
+}
+}  // namespace
+
+TEST(AssetProcessor, LoadDirectOfRunningDependencyWithSingleCpuTask) {
+    auto source = memory::Directory::create({});
+    ASSERT_TRUE(source.insert_file("a.chain", make_val("b.txt")).has_value());
+    ASSERT_TRUE(source.insert_file("b.txt", make_val("hello")).has_value());
+    auto processed = memory::Directory::create({});
+
+    auto app = epix::core::App::create();
+    AssetPlugin plugin;
+    plugin.mode = AssetServerMode::Processed;
+    plugin.register_asset_source(AssetSourceId{}, make_processed_memory_source_builder(source, processed));
+    plugin.build(app);
+    app_register_asset<std::string>(app);
+    app_register_loader<TestTextLoader>(app);
+    app_register_asset_processor(app, LoadDirectProcessor{});
+    app_set_default_asset_processor<LoadDirectProcessor>(app, "chain");
+    app_register_asset_processor(app, TestIdentityProcessor{});
+    app_set_default_asset_processor<TestIdentityProcessor>(app, "txt");
+
+    // both assets start at once; a.chain may take the only CPU slot while b.txt, already running, waits for it.
+    auto& processor = app.resource<AssetProcessor>();
+    processor.get_data()->set_processing_limits(ProcessingLimits{.tasks = 2, .cpu_tasks = 1});
+    app.run_schedule(epix::core::Startup);
+
+    processor.get_data()->wait_until_initialized();
+    EXPECT_EQ(processor.get_data()->wait_until_processed(AssetPath("a.chain")), ProcessStatus::Processed);
+    EXPECT_EQ(processor.get_data()->wait_until_processed(AssetPath("b.txt")), ProcessStatus::Processed);
+    processor.get_data()->wait_until_finished();
+    EXPECT_EQ(read_dir_file(processed, "a.chain"), "hello");
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+import std;
+
+/** @brief A fresh directory under the system temp directory, removed with its content on destruction.
+ *  Shared by the tests of file-backed readers and caches. */
+struct TempDir {
+    std::filesystem::path path;
+
+    TempDir() {
+        static const std::uint64_t process_tag    = std::random_device{}();
+        static std::atomic<std::uint64_t> counter = 0;
+        path = std::filesystem::temp_directory_path() /
+               std::format("epix_test_{:x}_{}", process_tag, counter.fetch_add(1, std::memory_order_relaxed));
+        std::filesystem::create_directories(path);
+    }
+    TempDir(const TempDir&)            = delete;
+    TempDir& operator=(const TempDir&) = delete;
+    ~TempDir() {
+        std::error_code ec;
+        std::filesystem::remove_all(path, ec);
+    }
+
+    /** @brief Write a file at `rel` under the directory, creating its parent directories. */
+    void write(const std::filesystem::path& rel, std::string_view content) const {
+        std::filesystem::create_directories((path / rel).parent_path());
+        std::ofstream(path / rel, std::ios::binary).write(content.data(), content.size());
+    }
+};
@@ -35,34 +35,47 @@ struct ExtractedWorld {
 };
 template <typename T>
 struct SystemParam<Extract<T>> : SystemParam<T> {
-    using Base  = SystemParam<T>;
-    using State = typename Base::State;
-    using Item  = Extract<typename Base::Item>;
+    using Base = SystemParam<T>;
+    /** @brief Base state plus the extracted world's tick at this param's previous run, so change detection inside
+     *  Extract<T> reports changes since the last extraction rather than since the last tick check. */
+    struct State {
+        typename Base::State base;
+        Tick last_run;
+    };
+    using Item = Extract<typename Base::Item>;
 
-    static State init_state(World& world) { return Base::init_state(world.resource_mut<ExtractedWorld>().world); }
+    static State init_state(World& world) {
+        return State{.base = Base::init_state(world.resource_mut<ExtractedWorld>().world), .last_run = Tick(0)};
+    }
     static void init_access(const State& state, SystemMeta& meta, FilteredAccessSet& access, const World& world) {
         // This is a workaround to initialize access for ensuring no conflicts. But the access should be separated for
         // each world. Affects some performance but for readonly extract it is zero-cost.
-        Base::init_access(state, meta, access, world.resource<ExtractedWorld>().world);
+        Base::init_access(state.base, meta, access, world.resource<ExtractedWorld>().world);
         SystemMeta temp;
         FilteredAccessSet temp_access;
-        Base::init_access(state, temp, temp_access, world.resource<ExtractedWorld>().world);
+        Base::init_access(state.base, temp, temp_access, world.resource<ExtractedWorld>().world);
         if (temp.is_deferred())
             throw std::runtime_error(
                 std::format("Extract<T> with deferred param T=[{}] is not allowed.", meta::type_id<T>::short_name()));
     }
+    static void new_archetype(State& state, const Archetype& archetype, SystemMeta& meta) {
+        Base::new_archetype(state.base, archetype, meta);
+    }
     static void apply(State& state, const SystemMeta& meta, World& world) {}
     static void queue(State& state, const SystemMeta& meta, DeferredWorld deferred_world) {}
     static std::expected<void, ValidateParamError> validate_param(State& state, const SystemMeta& meta, World& world) {
-        return Base::validate_param(state, meta, world.resource_mut<ExtractedWorld>().world);
+        return Base::validate_param(state.base, meta, world.resource_mut<ExtractedWorld>().world);
     }
     static Item get_param(State& state, const SystemMeta& meta, World& world, Tick tick) {
-        // return Item(Base::get_param(state, meta, world.resource_mut<ExtractedWorld>().world, tick));
         SystemMeta temp;
         temp.flags            = meta.flags;
         auto& extracted_world = world.resource_mut<ExtractedWorld>().world.get();
-        temp.last_run         = extracted_world.last_change_tick();
-        return Item(Base::get_param(state, temp, extracted_world, extracted_world.change_tick()));
+        // Advance the extracted world's tick like a system run would, so writes made there after this extraction
+        // are strictly newer than `this_run` and are picked up by the next one.
+        Tick this_run  = extracted_world.increment_change_tick();
+        temp.last_run  = state.last_run;
+        state.last_run = this_run;
+        return Item(Base::get_param(state.base, temp, extracted_world, this_run));
     }
 };
 static_assert(system_param<Extract<ResMut<int>>>);
@@ -9,6 +9,8 @@ import epix.traits;
 
 import :label;
 import :labels;
+import :type_registry;
+import :query;
 
 export import :app.decl;
 export import :app.state;
@@ -83,6 +85,52 @@ struct ScheduleOrder {
    private:
     std::list<ScheduleLabel> labels;
 };
+/** @brief World-level access declared by a schedule, or by a sub-app's extraction, so that
+ *  `App::update()` can run it alongside other schedules when concurrent updates are enabled.
+ *
+ *  Types are resolved lazily through the world's TypeRegistry. The declaration is a contract:
+ *  it must cover everything the schedule touches, including schedule-level conditions. */
+struct ScheduleAccess {
+   public:
+    /** @brief Declare read access to components. */
+    template <typename... Ts>
+    ScheduleAccess& read() {
+        (_component_reads.push_back(&resolve_type<Ts>), ...);
+        return *this;
+    }
+    /** @brief Declare write access to components. */
+    template <typename... Ts>
+    ScheduleAccess& write() {
+        (_component_writes.push_back(&resolve_type<Ts>), ...);
+        return *this;
+    }
+    /** @brief Declare read access to resources. */
+    template <typename... Ts>
+    ScheduleAccess& read_resource() {
+        (_resource_reads.push_back(&resolve_type<Ts>), ...);
+        return *this;
+    }
+    /** @brief Declare write access to resources. */
+    template <typename... Ts>
+    ScheduleAccess& write_resource() {
+        (_resource_writes.push_back(&resolve_type<Ts>), ...);
+        return *this;
+    }
+    /** @brief Build the access set using the given type registry. */
+    FilteredAccessSet resolve(const TypeRegistry& registry) const;
+
+   private:
+    using Resolver = TypeId (*)(const TypeRegistry&);
+    template <typename T>
+    static TypeId resolve_type(const TypeRegistry& registry) {
+        return registry.type_id<T>();
+    }
+
+    std::vector<Resolver> _component_reads;
+    std::vector<Resolver> _component_writes;
+    std::vector<Resolver> _resource_reads;
+    std::vector<Resolver> _resource_writes;
+};
 /** @brief Abstract base class for app runner implementations.
  *  Subclass and override step() and exit() to control the main loop. */
 struct AppRunner {
@@ -396,9 +444,32 @@ struct App {
                 (spdlog::warn("Failed to run schedule, schedule not found. Skip."), true)),
                ...);
     }
-    /** @brief Update the app by running schedules in schedule-order (synchronous). */
+    /** @brief Update the app by running schedules in schedule-order.
+     *  Synchronous unless concurrent updates are enabled, see enable_concurrent_updates(). */
     void update();
 
+    // === Concurrent Updates ===
+
+    /** @brief Allow update() to run consecutive schedules of the schedule order at the same time
+     *  when their declared access does not conflict. Schedules without a declared access, with
+     *  a loop condition, or with a deferred mode other than ApplyEnd/Ignore always run alone.
+     *  Deferred commands of concurrently run schedules are applied in schedule order once all
+     *  of them finished. */
+    App& enable_concurrent_updates(bool enable = true) {
+        _concurrent_updates = enable;
+        return *this;
+    }
+    /** @brief Check if concurrent updates are enabled. */
+    bool concurrent_updates() const { return _concurrent_updates; }
+    /** @brief Declare the world access of a schedule. Replaces an earlier declaration. */
+    App& declare_schedule_access(const ScheduleLabel& label, ScheduleAccess access);
+    /** @brief Let update() drive a sub-app: it is extracted at the start of the update, with
+     *  `extract_access` declaring what its extraction reads from this app's world, and then
+     *  updated on another thread while this app's schedules run. The update is joined before
+     *  update() returns. Only has an effect when concurrent updates are enabled.
+     *  Sub-apps driven by a runner, such as the render sub-app, must not be registered here. */
+    App& add_concurrent_sub_app(const AppLabel& label, ScheduleAccess extract_access = {});
+
     // === Sub-app Extraction ===
 
     /** @brief Take ownership of a sub-app, removing it from this app. Returns nullptr if not found. */
@@ -466,6 +537,12 @@ struct App {
     std::move_only_function<void(App&, World&)> extract_fn;
     std::unique_ptr<AppRunner> runner;
 
+    bool _concurrent_updates = false;
+    std::unordered_map<ScheduleLabel, ScheduleAccess> _schedule_access;
+    std::vector<std::pair<AppLabel, ScheduleAccess>> _concurrent_sub_apps;
+
+    void update_concurrent(const ScheduleOrder& order);
+
     explicit App(
         DefaultCreateTag tag,
         const AppLabel& label                                 = AppLabel::from_type<App>(),
@@ -1,54 +1,165 @@
 module;
 
+#include <spdlog/spdlog.h>
+
 export module epix.core:hierarchy;
 
 import std;
 
 import :entities;
-import :world.decl;
+import :world;
 import :component;
 
 namespace epix::core {
-/** @brief Component that marks an entity as a child of another entity.
- *  When inserted, automatically updates the parent's Children component.
- *  When removed, the child is detached from the parent's children set. */
-export struct Parent {
+/** @brief Base for the source side of a relationship: a component on an entity that
+ *  points at exactly one target entity.
+ *
+ *  Hooks keep the target's `Target` component, a contiguous list of all entities
+ *  pointing at it, up to date. Answering "which entities target X" is then a single
+ *  component lookup on X instead of a query scan. Change the target by inserting a
+ *  new component, the replaced one is detached from its old target first.
+ *
+ *  @tparam Self The deriving source component (CRTP).
+ *  @tparam Target The component kept on the target entity, deriving from
+ *  `RelationshipTarget<Target, Self>`. */
+export template <typename Self, typename Target>
+struct Relationship {
    public:
-    /** @brief Construct a Parent linking to the given parent entity. */
-    Parent(Entity parent_entity) : _entity(parent_entity) {}
+    using relationship_target = Target;
 
-    /** @brief Get the parent entity. */
-    Entity entity() const { return _entity; }
+    /** @brief Construct a relationship pointing at `target`. */
+    Relationship(Entity target) : _target(target) {}
 
-    /** @brief Hook called when a Parent component is removed from an entity. */
-    static void on_remove(World& world, HookContext ctx);
-    /** @brief Hook called when a Parent component is inserted on an entity. */
-    static void on_insert(World& world, HookContext ctx);
+    /** @brief Get the target entity. */
+    Entity target() const { return _target; }
 
-   private:
-    friend struct Children;
+    /** @brief Hook registering the source on its target. */
+    static void on_insert(World& world, HookContext ctx);
+    /** @brief Hook unregistering the source from its target. */
+    static void on_remove(World& world, HookContext ctx);
 
-    Entity _entity;
+   protected:
+    Entity _target;
 };
-/** @brief Component that stores the set of child entities.
- *  Automatically maintained by Parent insert/remove hooks.
- *  When this entity is despawned, all children are recursively despawned. */
-export struct Children {
+
+/** @brief Base for the target side of a relationship: the reverse index of all source
+ *  entities whose `Source` component points at this entity, in insertion order.
+ *
+ *  Maintained by the hooks of `Relationship`, never modify it directly. When the
+ *  component is removed, the `Source` component is removed from every source. With
+ *  `LinkedDespawn`, despawning the target despawns all sources transitively, gathered
+ *  into one batch first so deep or wide trees do not recurse or reshuffle lists.
+ *
+ *  @tparam Self The deriving target component (CRTP).
+ *  @tparam Source The source component, deriving from `Relationship<Source, Self>`. */
+export template <typename Self, typename Source, bool LinkedDespawn = false>
+struct RelationshipTarget {
    public:
-    Children() = default;
+    using relationship                   = Source;
+    static constexpr bool linked_despawn = LinkedDespawn;
 
-    /** @brief Get a const reference to the set of child entities. */
-    auto& entities() const { return _entities; }
+    /** @brief Entities whose `Source` points at this entity. */
+    std::span<const Entity> entities() const { return _sources; }
+    /** @brief Number of source entities. */
+    std::size_t size() const { return _sources.size(); }
+    /** @brief Check if no entity points at this entity. */
+    bool empty() const { return _sources.empty(); }
+    /** @brief Check if `entity` points at this entity. Linear in the number of sources. */
+    bool contains(Entity entity) const { return std::ranges::contains(_sources, entity); }
 
-    /** @brief Hook called when a Children component is removed. */
+    /** @brief Hook detaching all sources when this component is removed. */
     static void on_remove(World& world, HookContext ctx);
-    /** @brief Hook called when the entity owning Children is despawned.
-     *  Recursively despawns all child entities. */
-    static void on_despawn(World& world, HookContext ctx);
+    /** @brief Hook despawning all sources, transitively, when the entity is despawned. */
+    static void on_despawn(World& world, HookContext ctx)
+        requires LinkedDespawn;
 
    private:
-    friend struct Parent;
+    template <typename, typename>
+    friend struct Relationship;
+
+    /** @brief Take the source list of `entity`, leaving it empty. */
+    static std::vector<Entity> take_sources(World& world, Entity entity) {
+        return world.get_entity_mut(entity)
+            .and_then([](EntityWorldMut&& target) { return target.get_mut<Self>(); })
+            .transform([](Mut<Self> target) {
+                return std::exchange(static_cast<RelationshipTarget&>(target.get_mut())._sources, {});
+            })
+            .value_or(std::vector<Entity>{});
+    }
 
-    std::unordered_set<Entity> _entities;
+    std::vector<Entity> _sources;
+};
+
+template <typename Self, typename Target>
+void Relationship<Self, Target>::on_insert(World& world, HookContext ctx) {
+    Entity target_entity = world.entity_mut(ctx.entity).get<Self>().value().get().target();
+    auto target          = world.get_entity_mut(target_entity);
+    if (!target) {
+        spdlog::warn("[hierarchy] Relationship target {} of entity {} does not exist.", target_entity.index,
+                     ctx.entity.index);
+        return;
+    }
+    target->insert_if_new(Target{});
+    static_cast<RelationshipTarget<Target, Self, Target::linked_despawn>&>(target->get_mut<Target>().value().get_mut())
+        ._sources.push_back(ctx.entity);
+}
+
+template <typename Self, typename Target>
+void Relationship<Self, Target>::on_remove(World& world, HookContext ctx) {
+    Entity target_entity = world.entity_mut(ctx.entity).get<Self>().value().get().target();
+    world.get_entity_mut(target_entity)
+        .and_then([](EntityWorldMut&& target) { return target.get_mut<Target>(); })
+        .transform([&](Mut<Target> target) {
+            auto& sources =
+                static_cast<RelationshipTarget<Target, Self, Target::linked_despawn>&>(target.get_mut())._sources;
+            // linear, but a source list that is being torn down is already empty.
+            if (auto it = std::ranges::find(sources, ctx.entity); it != sources.end()) sources.erase(it);
+            return true;
+        });
+}
+
+template <typename Self, typename Source, bool LinkedDespawn>
+void RelationshipTarget<Self, Source, LinkedDespawn>::on_remove(World& world, HookContext ctx) {
+    // sources find an empty list when they unregister, so no list is rewritten per removal.
+    for (auto source : take_sources(world, ctx.entity)) {
+        world.get_entity_mut(source).transform([](EntityWorldMut&& entity) {
+            entity.remove<Source>();
+            return true;
+        });
+    }
+}
+
+template <typename Self, typename Source, bool LinkedDespawn>
+void RelationshipTarget<Self, Source, LinkedDespawn>::on_despawn(World& world, HookContext ctx)
+    requires LinkedDespawn
+{
+    std::vector<Entity> pending = take_sources(world, ctx.entity);
+    for (std::size_t i = 0; i < pending.size(); i++) {
+        pending.append_range(take_sources(world, pending[i]));
+    }
+    for (auto entity : pending) {
+        world.get_entity_mut(entity).transform([](EntityWorldMut&& source) {
+            source.despawn();
+            return true;
+        });
+    }
+}
+
+export struct Children;
+
+/** @brief Component that marks an entity as a child of another entity.
+ *  When inserted, the parent's Children component is updated automatically.
+ *  When removed, the child is detached from the parent's children. */
+export struct Parent : Relationship<Parent, Children> {
+   public:
+    /** @brief Construct a Parent linking to the given parent entity. */
+    Parent(Entity parent_entity) : Relationship(parent_entity) {}
+
+    /** @brief Get the parent entity. */
+    Entity entity() const { return _target; }
 };
-}  // namespace core
\ No newline at end of file
+/** @brief Component that stores the child entities, in insertion order.
+ *  Automatically maintained by the Parent hooks.
+ *  When this entity is despawned, all descendants are despawned as well. */
+export struct Children : RelationshipTarget<Children, Parent, true> {};
+}  // namespace epix::core
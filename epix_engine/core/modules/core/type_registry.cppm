@@ -17,6 +17,21 @@ enum class StorageType : std::uint8_t {
 export template <typename T>
 struct sparse_component : std::false_type {};
 
+/** @brief Field list for `split_component`, each member pointer becomes its own table column.
+ *  @tparam Members Pointers to every data member of the component, e.g. `&T::a, &T::b`. */
+export template <auto... Members>
+struct split_fields : std::true_type {
+    template <template <auto...> typename F>
+    using apply = F<Members...>;
+};
+/** @brief Trait to store a component type as one table column per field (SoA) instead of a single column
+ *  of whole structs. Specialize deriving from `split_fields<...>` listing every data member; fields not
+ *  listed are dropped on insertion. For aggregates, a list shorter than the members that can be counted
+ *  fails to compile. The type is then a bundle of `Field<&T::member>` components.
+ *  @tparam T The component type. */
+export template <typename T>
+struct split_component : std::false_type {};
+
 template <typename T>
 consteval StorageType storage_for() {
     if constexpr (sparse_component<T>::value) {
@@ -33,4 +33,6 @@ Tick world_last_change_tick(const World& world);
 void world_flush_entities(World& world);
 void world_flush_commands(World& world);
 void world_flush(World& world);
+/** @brief Insert a Parent component pointing at `parent` on `child`, defined with the hierarchy. */
+void world_insert_parent(World& world, Entity child, Entity parent);
 }  // namespace core
\ No newline at end of file
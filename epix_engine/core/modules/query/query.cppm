@@ -10,6 +10,7 @@ export import :query.state;
 export import :query.fetch;
 export import :query.filter;
 export import :query.iter;
+export import :query.split;
 
 namespace epix::core {
 /** @brief High-level query handle providing iteration, single-entity lookup, and existence checks.
@@ -0,0 +1,192 @@
+module;
+
+#include <cassert>
+
+export module epix.core:query.split;
+
+import std;
+
+import :type_registry;
+import :component;
+import :ticks;
+import :bundle;
+import :query.decl;
+import :query.fetch;
+
+namespace epix::core {
+template <auto Member>
+struct member_pointer_traits;
+template <typename C, typename M, M C::* P>
+struct member_pointer_traits<P> {
+    using class_type = C;
+    using value_type = M;
+};
+
+/** @brief Component holding one field of a `split_component`. Each field is its own table column, so
+ *  querying `const Field<&T::member>&` streams only that field through the cache.
+ *  @tparam Member Pointer to the data member. */
+export template <auto Member>
+struct Field {
+    using class_type               = typename member_pointer_traits<Member>::class_type;
+    using value_type               = typename member_pointer_traits<Member>::value_type;
+    static constexpr auto member   = Member;
+    value_type value;
+};
+
+/** @brief Concept for component types stored as per-field columns. */
+export template <typename T>
+concept split = split_component<T>::value;
+
+/** @brief Converts to any member type, only used unevaluated to count aggregate members. */
+struct any_member {
+    template <typename U>
+    operator U() const;
+};
+/** @brief Lower bound of the data members of aggregate `T`. Each member is initialized from its own braces,
+ *  so array and aggregate members count once; the count stops early at members `any_member` cannot
+ *  initialize unambiguously, such as types with several converting constructors. */
+template <typename T, typename... Args>
+consteval std::size_t aggregate_member_count() {
+    if constexpr (requires { T{{Args{}}..., {any_member{}}}; }) {
+        return aggregate_member_count<T, Args..., any_member>();
+    } else {
+        return sizeof...(Args);
+    }
+}
+
+template <auto... Members>
+struct SplitBundle {
+    using T = typename member_pointer_traits<std::get<0>(std::tuple{Members...})>::class_type;
+    static_assert(!std::is_aggregate_v<T> || aggregate_member_count<T>() <= sizeof...(Members),
+                  "split_fields must list every data member of the component, unlisted members are not stored.");
+
+    static std::size_t write(T& bundle, std::span<void*> pointers) {
+        assert(pointers.size() >= sizeof...(Members));
+        std::size_t index = 0;
+        (
+            [&] {
+                if (void* ptr = pointers[index++]) new (ptr) Field<Members>{std::move(bundle.*Members)};
+            }(),
+            ...);
+        return sizeof...(Members);
+    }
+    static auto type_ids(const TypeRegistry& registry) {
+        return std::vector<TypeId>{registry.type_id<Field<Members>>()...};
+    }
+    static void register_components(const TypeRegistry& registry, Components& components) {
+        (components.register_info<Field<Members>>(), ...);
+    }
+};
+template <typename T>
+    requires split<T>
+struct Bundle<T> : split_component<T>::template apply<SplitBundle> {};
+
+template <auto... Members>
+using split_read_fields = std::tuple<const Field<Members>&...>;
+template <auto... Members>
+using split_write_fields = std::tuple<Mut<Field<Members>>...>;
+
+/** @brief Read-only proxy over the field columns of a split component for one entity. */
+export template <split T>
+struct SplitRef {
+    using Fields = typename split_component<T>::template apply<split_read_fields>;
+
+    explicit SplitRef(Fields fields) : _fields(std::move(fields)) {}
+
+    /** @brief Get one field by member pointer, e.g. `get<&T::translation>()`. */
+    template <auto Member>
+    const auto& get() const {
+        return std::get<const Field<Member>&>(_fields).value;
+    }
+    /** @brief Gather all fields into a whole value. */
+    T load() const {
+        return std::apply(
+            [](const auto&... fields) {
+                T value{};
+                ((value.*(std::decay_t<decltype(fields)>::member) = fields.value), ...);
+                return value;
+            },
+            _fields);
+    }
+
+   private:
+    Fields _fields;
+};
+
+/** @brief Mutable proxy over the field columns of a split component for one entity.
+ *  Only fields accessed through `get_mut()` or `store()` are marked modified. */
+export template <split T>
+struct SplitMut {
+    using Fields = typename split_component<T>::template apply<split_write_fields>;
+
+    explicit SplitMut(Fields fields) : _fields(std::move(fields)) {}
+
+    /** @brief Get one field by member pointer. */
+    template <auto Member>
+    const auto& get() const {
+        return std::get<Mut<Field<Member>>>(_fields).get().value;
+    }
+    /** @brief Get one field by member pointer for writing, marking only that column modified. */
+    template <auto Member>
+    auto& get_mut() {
+        return std::get<Mut<Field<Member>>>(_fields).get_mut().value;
+    }
+    /** @brief Check if any field was modified since the system last ran. */
+    bool is_modified() const {
+        return std::apply([](const auto&... fields) { return (fields.is_modified() || ...); }, _fields);
+    }
+    /** @brief Gather all fields into a whole value. */
+    T load() const {
+        return std::apply(
+            [](const auto&... fields) {
+                T value{};
+                ((value.*(std::decay_t<decltype(fields.get())>::member) = fields.get().value), ...);
+                return value;
+            },
+            _fields);
+    }
+    /** @brief Scatter a whole value into the field columns. */
+    void store(const T& value) {
+        std::apply(
+            [&](auto&... fields) {
+                ((fields.get_mut().value = value.*(std::decay_t<decltype(fields.get())>::member)), ...);
+            },
+            _fields);
+    }
+
+   private:
+    Fields _fields;
+};
+
+/** @brief Query data fetching a split component as a `SplitRef<T>` proxy. Matches entities that have
+ *  every field column. */
+export template <split T>
+struct Split {};
+/** @brief Query data fetching a split component as a `SplitMut<T>` proxy. */
+export template <split T>
+struct SplitWrite {};
+
+template <split T>
+struct WorldQuery<Split<T>> : WorldQuery<typename SplitRef<T>::Fields> {};
+template <split T>
+struct QueryData<Split<T>> {
+    using Item                            = SplitRef<T>;
+    using ReadOnly                        = Split<T>;
+    static inline constexpr bool readonly = true;
+    static Item fetch(typename WorldQuery<Split<T>>::Fetch& fetch, Entity entity, TableRow row) {
+        return Item(QueryData<typename SplitRef<T>::Fields>::fetch(fetch, entity, row));
+    }
+};
+
+template <split T>
+struct WorldQuery<SplitWrite<T>> : WorldQuery<typename SplitMut<T>::Fields> {};
+template <split T>
+struct QueryData<SplitWrite<T>> {
+    using Item                            = SplitMut<T>;
+    using ReadOnly                        = Split<T>;
+    static inline constexpr bool readonly = false;
+    static Item fetch(typename WorldQuery<SplitWrite<T>>::Fetch& fetch, Entity entity, TableRow row) {
+        return Item(QueryData<typename SplitMut<T>::Fields>::fetch(fetch, entity, row));
+    }
+};
+}  // namespace epix::core
@@ -277,6 +277,9 @@ export struct ScheduleExecutor {
     virtual ~ScheduleExecutor()                                                                 = default;
     virtual void execute(ScheduleSystems& schedule, World& world, const ExecutorConfig& config) = 0;
     virtual meta::type_index type() const                                                       = 0;
+    /** @brief Whether the executor only runs the schedule's own systems, so `Schedule::access()` covers all
+     *  it touches. Executors that drive other schedules or write resources themselves return false. */
+    virtual bool runs_own_systems_only() const { return true; }
 };
 /** @brief A named collection of systems with dependency ordering and parallel execution support.
  *  Systems are organized into sets with before/after/in_set relationships. */
@@ -399,6 +402,12 @@ export struct Schedule {
     /** @brief Initialize all systems in this schedule by calling their initialize() methods.
      *  @param force If true, re-initializes already-initialized systems. */
     void initialize_systems(World& world, bool force = false);
+    /** @brief Combined access of every initialized system, condition and pre/post system in this schedule.
+     *  Schedule-level conditions are opaque functions and are not included. */
+    FilteredAccessSet access() const;
+    /** @brief Whether `access()` covers everything executing this schedule touches, false for executors that
+     *  do work of their own. */
+    bool access_is_complete() const { return !executor || executor->runs_own_systems_only(); }
     /** @brief Clamp stale change ticks on all systems. */
     void check_change_tick(Tick tick);
     /** @brief Execute the schedule using the default configuration. */
@@ -12,7 +12,6 @@ import :ticks;
 import :world.decl;
 import :bundle.spec;
 import :storage;
-import :hierarchy;
 
 namespace epix::core {
 /**
@@ -267,7 +266,8 @@ export struct EntityWorldMut : public EntityRefMut {
             }
             return spawn_bundle(make_bundle<std::decay_t<Args>...>(std::forward_as_tuple(std::forward<Args>(args))...));
         }();
-        mut.insert(Parent{entity_});
+        world_insert_parent(*world_, mut.id(), entity_);
+        mut.update_location();
         update_location();
         return mut;
     }
@@ -193,15 +193,212 @@ void App::update() {
         [&](Tick tick) { _world.resource_scope([&](Schedules& schedules) { schedules.check_change_tick(tick); }); });
     auto order_opt = _world.take_resource<ScheduleOrder>();
     if (order_opt) {
-        for (const auto& label : order_opt->iter()) {
-            if (!run_schedule(label)) {
-                spdlog::error("Failed to run schedule '{}', schedule not found.", label.to_string());
+        if (_concurrent_updates) {
+            update_concurrent(*order_opt);
+        } else {
+            for (const auto& label : order_opt->iter()) {
+                if (!run_schedule(label)) {
+                    spdlog::error("Failed to run schedule '{}', schedule not found.", label.to_string());
+                }
             }
         }
         _world.insert_resource(std::move(*order_opt));
     }
 }
 
+FilteredAccessSet ScheduleAccess::resolve(const TypeRegistry& registry) const {
+    FilteredAccessSet access;
+    for (auto resolver : _component_reads) {
+        FilteredAccess fa = FilteredAccess::matches_everything();
+        fa.access_mut().add_component_read(resolver(registry));
+        access.add(std::move(fa));
+    }
+    for (auto resolver : _component_writes) {
+        FilteredAccess fa = FilteredAccess::matches_everything();
+        fa.access_mut().add_component_write(resolver(registry));
+        access.add(std::move(fa));
+    }
+    for (auto resolver : _resource_reads) access.add_unfiltered_resource_read(resolver(registry));
+    for (auto resolver : _resource_writes) access.add_unfiltered_resource_write(resolver(registry));
+    return access;
+}
+
+App& App::declare_schedule_access(const ScheduleLabel& label, ScheduleAccess access) {
+    _schedule_access.insert_or_assign(label, std::move(access));
+    return *this;
+}
+
+App& App::add_concurrent_sub_app(const AppLabel& label, ScheduleAccess extract_access) {
+    auto it = std::ranges::find(_concurrent_sub_apps, label, [](auto&& pair) -> const AppLabel& { return pair.first; });
+    if (it != _concurrent_sub_apps.end()) {
+        it->second = std::move(extract_access);
+    } else {
+        _concurrent_sub_apps.emplace_back(label, std::move(extract_access));
+    }
+    return *this;
+}
+
+namespace {
+/** @brief One unit of a concurrent update: a schedule of the order or the extraction of a sub-app. */
+struct UpdateTask {
+    std::variant<ScheduleLabel, AppLabel> target;
+    /** @brief Declared access, or nullopt if the task must run alone. */
+    std::optional<FilteredAccessSet> access;
+};
+/** @brief Whether a schedule can run next to others: its deferred commands must be able to wait
+ *  until the whole group finished, it must not loop on an opaque condition, and its executor must
+ *  not do work its access does not show, such as FixedMain's driving the fixed sub-schedules. */
+bool can_run_concurrently(const Schedule& schedule) {
+    const auto& config = schedule.default_schedule_config();
+    auto deferred      = config.executor_config.deferred;
+    return schedule.access_is_complete() && !config.loop_condition &&
+           (deferred == DeferredApply::ApplyEnd || deferred == DeferredApply::Ignore);
+}
+}  // namespace
+
+void App::update_concurrent(const ScheduleOrder& order) {
+    const TypeRegistry& registry = _world.type_registry();
+    Schedules& schedules         = _world.resource_or_init<Schedules>();
+    // executors create the pool lazily, create it up front so concurrent schedules never race on it.
+    _world.resource_or_emplace<ScheduleThreadPool>();
+
+    std::vector<UpdateTask> tasks;
+    for (auto&& [label, access] : _concurrent_sub_apps) {
+        if (_sub_apps.contains(label)) tasks.push_back({label, access.resolve(registry)});
+    }
+    for (auto&& label : order.iter()) {
+        std::optional<FilteredAccessSet> access;
+        if (auto declared = _schedule_access.find(label); declared != _schedule_access.end()) {
+            auto schedule = schedules.get_schedule(label);
+            if (schedule && can_run_concurrently(schedule->get())) {
+                access = declared->second.resolve(registry);
+            }
+        }
+        tasks.push_back({label, std::move(access)});
+    }
+
+    struct RunningSubApp {
+        AppLabel label;
+        std::unique_ptr<App> app;
+        std::future<void> update;
+    };
+    std::vector<RunningSubApp> running_sub_apps;
+    auto start_sub_app = [&](const AppLabel& label, std::unique_ptr<App> app) {
+        App* ptr = app.get();
+        running_sub_apps.emplace_back(label, std::move(app),
+                                      std::async(std::launch::async, [ptr]() { ptr->update(); }));
+    };
+
+    // A task joins the current group when it is compatible with every task already in it,
+    // otherwise it depends on the whole group and starts the next one.
+    std::vector<std::size_t> group;
+    auto run_group = [&]() {
+        if (group.empty()) return;
+        struct Member {
+            std::size_t task;
+            std::optional<Schedule> schedule;
+            std::unique_ptr<App> sub_app;
+            bool apply_end = false;
+        };
+        std::vector<Member> members;
+        for (auto index : group) {
+            auto& task = tasks[index];
+            if (auto* label = std::get_if<ScheduleLabel>(&task.target)) {
+                auto schedule = schedules.remove_schedule(*label);
+                if (!schedule) {
+                    spdlog::error("Failed to run schedule '{}', schedule not found.", label->to_string());
+                    continue;
+                }
+                // system initialization touches the world structurally, keep it on this thread.
+                schedule->initialize_systems(_world);
+                members.push_back({.task = index, .schedule = std::move(schedule)});
+            } else {
+                auto& label = std::get<AppLabel>(task.target);
+                auto sub_app = take_sub_app(label);
+                // a schedule of an earlier group may have removed it.
+                if (!sub_app) {
+                    spdlog::error("Failed to extract sub-app '{}', sub-app not found.", label.to_string());
+                    continue;
+                }
+                members.push_back({.task = index, .sub_app = std::move(sub_app)});
+            }
+        }
+
+        // Declarations are trusted for opaque parts only, system access must agree with them.
+        bool concurrent = members.size() > 1;
+        std::vector<FilteredAccessSet> effective(concurrent ? members.size() : 0);
+        for (auto&& [member, access] : std::views::zip(members, effective)) {
+            access = *tasks[member.task].access;
+            if (member.schedule) access.extend(member.schedule->access());
+        }
+        for (std::size_t i = 0; concurrent && i < members.size(); i++) {
+            for (std::size_t j = i + 1; j < members.size(); j++) {
+                if (effective[i].is_compatible(effective[j])) continue;
+                spdlog::warn(
+                    "[app] Systems of a concurrently updated schedule in '{}' access data outside its declared access, "
+                    "running the group sequentially.",
+                    _label.to_string());
+                concurrent = false;
+                break;
+            }
+        }
+
+        std::vector<std::future<void>> jobs;
+        jobs.reserve(members.size());
+        for (auto&& [index, member] : std::views::enumerate(members)) {
+            auto policy = (concurrent && index > 0) ? std::launch::async : std::launch::deferred;
+            if (member.schedule) {
+                ScheduleConfig config = member.schedule->default_schedule_config();
+                if (concurrent && config.executor_config.deferred == DeferredApply::ApplyEnd) {
+                    config.executor_config.deferred = DeferredApply::Ignore;
+                    member.apply_end                = true;
+                }
+                spdlog::trace("[app] Executing schedule '{}'.", member.schedule->label().to_string());
+                jobs.push_back(std::async(policy, [this, &member, config = std::move(config)]() {
+                    member.schedule->execute(_world, config);
+                }));
+            } else {
+                jobs.push_back(std::async(policy, [this, &member]() { member.sub_app->extract(*this); }));
+            }
+            // deferred jobs run in order on this thread, after the async ones were launched.
+            if (!concurrent) jobs.back().wait();
+        }
+        for (auto&& job : jobs) job.wait();
+
+        for (auto&& member : members) {
+            if (member.schedule) {
+                if (member.apply_end) member.schedule->apply_deferred(_world);
+                auto label = member.schedule->label();
+                if (schedules.get_schedule(label)) {
+                    spdlog::warn(
+                        "Schedule '{}' was re-added while existing one running, old one will be "
+                        "overwritten!",
+                        label.to_string());
+                }
+                schedules.add_schedule(std::move(*member.schedule));
+            } else {
+                start_sub_app(std::get<AppLabel>(tasks[member.task].target), std::move(member.sub_app));
+            }
+        }
+        group.clear();
+        for (auto&& job : jobs) job.get();
+    };
+
+    for (auto&& [index, task] : std::views::enumerate(tasks)) {
+        bool joins = task.access && std::ranges::all_of(group, [&](std::size_t other) {
+                         return tasks[other].access && tasks[other].access->is_compatible(*task.access);
+                     });
+        if (!joins) run_group();
+        group.push_back(index);
+        if (!task.access) run_group();
+    }
+    run_group();
+
+    for (auto&& running : running_sub_apps) running.update.wait();
+    for (auto&& running : running_sub_apps) insert_sub_app(running.label, std::move(running.app));
+    for (auto&& running : running_sub_apps) running.update.get();
+}
+
 std::unique_ptr<App> App::take_sub_app(const AppLabel& label) {
     auto it = _sub_apps.find(label);
     if (it != _sub_apps.end()) {
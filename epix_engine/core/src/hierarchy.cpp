@@ -1,74 +1,12 @@
-module;
-
-#include <spdlog/spdlog.h>
-
 module epix.core;
 
 import std;
 
 import :hierarchy;
 import :world;
-import :world.entity_ref;
 
 namespace epix::core {
-void Parent::on_remove(World& world, HookContext ctx) {
-    spdlog::trace("[hierarchy] Parent::on_remove for entity {}.", ctx.entity.index);
-    auto&& this_entity = world.entity_mut(ctx.entity);
-    this_entity.get<Parent>().transform([&](const Parent& parent) {
-        return world.entity_mut(parent._entity)
-            .get_mut<Children>()
-            .transform([&](Children& children) {
-                children._entities.erase(ctx.entity);
-                return true;
-            })
-            .value_or(false);
-    });
+void world_insert_parent(World& world, Entity child, Entity parent) {
+    world.entity_mut(child).insert(Parent{parent});
 }
-
-void Parent::on_insert(World& world, HookContext ctx) {
-    spdlog::trace("[hierarchy] Parent::on_insert for entity {}.", ctx.entity.index);
-    auto&& this_entity = world.entity_mut(ctx.entity);
-    this_entity.get<Parent>().transform([&](const Parent& parent) {
-        return world.entity_mut(parent._entity)
-            .get_mut<Children>()
-            .or_else([&]() {
-                auto entity = world.entity_mut(parent._entity);
-                entity.insert_if_new(Children{});
-                return entity.get_mut<Children>();
-            })
-            .transform([&](Children& children) {
-                children._entities.insert(ctx.entity);
-                return true;
-            })
-            .value_or(false);
-    });
-}
-
-void Children::on_remove(World& world, HookContext ctx) {
-    spdlog::trace("[hierarchy] Children::on_remove for entity {}.", ctx.entity.index);
-    auto&& this_entity = world.entity_mut(ctx.entity);
-    // copy children set cause removing it inside transform or and_then might invalidate the reference
-    std::optional children_to_remove =
-        this_entity.get<Children>().transform([&](const Children& children) { return children._entities; });
-    children_to_remove.transform([&](std::unordered_set<Entity>& children) {
-        for (auto child_entity : children) {
-            world.entity_mut(child_entity).remove<Parent>();
-        }
-        return true;
-    });
-}
-
-void Children::on_despawn(World& world, HookContext ctx) {
-    spdlog::trace("[hierarchy] Children::on_despawn for entity {} (despawning children).", ctx.entity.index);
-    auto&& this_entity = world.entity_mut(ctx.entity);
-    std::optional children_to_remove =
-        this_entity.get<Children>().transform([&](const Children& children) { return children._entities; });
-    children_to_remove.transform([&](std::unordered_set<Entity>& children) {
-        for (auto child_entity : children) {
-            world.entity_mut(child_entity).despawn();
-        }
-        return true;
-    });
-}
-
 }  // namespace epix::core
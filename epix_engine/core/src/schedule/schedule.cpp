@@ -286,6 +286,20 @@ void Schedule::initialize_systems(World& world, bool force) {
     }
 }
 
+FilteredAccessSet Schedule::access() const {
+    FilteredAccessSet access;
+    for (auto&& [label, node] : _data.nodes) {
+        if (node->system && node->system->initialized()) access.extend(node->system_access);
+        for (auto&& condition_access : node->condition_access) access.extend(condition_access);
+    }
+    for (auto* systems : {&m_pre_systems, &m_post_systems}) {
+        for (auto&& ps : *systems) {
+            if (ps.initialized) access.extend(ps.access);
+        }
+    }
+    return access;
+}
+
 void Schedule::check_change_tick(Tick change_tick) {
     // check change tick for all systems
     for (auto& [label, node] : _data.nodes) {
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.core;
+import epix.meta;
+
+using namespace epix::core;
+
+namespace {
+struct Left {
+    int value = 0;
+};
+struct Right {
+    int value = 0;
+};
+struct Marker {};
+struct LeftScheduleT {
+} LeftSchedule;
+struct RightScheduleT {
+} RightSchedule;
+struct ConcurrentSubApp {};
+struct SubAppScheduleT {
+} SubAppSchedule;
+
+/** @brief Rendezvous between two systems, true if both arrived before the timeout. */
+struct Rendezvous {
+    std::mutex mutex;
+    std::condition_variable cv;
+    int arrived = 0;
+
+    bool arrive() {
+        std::unique_lock lock(mutex);
+        arrived++;
+        cv.notify_all();
+        return cv.wait_for(lock, std::chrono::seconds(2), [this] { return arrived >= 2; });
+    }
+};
+
+App make_app() {
+    App app;
+    app.add_schedule(Schedule(LeftSchedule)).add_schedule(Schedule(RightSchedule));
+    app.schedule_order().insert_end(LeftSchedule);
+    app.schedule_order().insert_end(RightSchedule);
+    app.world_mut().init_resource<Left>();
+    app.world_mut().init_resource<Right>();
+    return app;
+}
+}  // namespace
+
+TEST(core, concurrent_update_runs_disjoint_schedules_together) {
+    static Rendezvous rendezvous;
+    static std::atomic<int> met = 0;
+    App app                     = make_app();
+    app.add_systems(LeftSchedule, into([](ResMut<Left> left, Commands commands) {
+                        if (rendezvous.arrive()) met++;
+                        left->value++;
+                        commands.spawn(Marker{});
+                    }))
+        .add_systems(RightSchedule, into([](ResMut<Right> right) {
+                         if (rendezvous.arrive()) met++;
+                         right->value++;
+                     }))
+        .declare_schedule_access(LeftSchedule, ScheduleAccess().write_resource<Left>())
+        .declare_schedule_access(RightSchedule, ScheduleAccess().write_resource<Right>())
+        .enable_concurrent_updates();
+
+    app.update();
+
+    EXPECT_EQ(met.load(), 2);
+    EXPECT_EQ(app.resource<Left>().value, 1);
+    EXPECT_EQ(app.resource<Right>().value, 1);
+    // commands of a concurrently run schedule are applied once the group finished.
+    std::size_t markers = 0;
+    for (auto&& entity : app.world_mut().query_filtered<Entity, With<Marker>>().iter(app.world_mut())) markers++;
+    EXPECT_EQ(markers, 1);
+}
+
+TEST(core, concurrent_update_keeps_conflicting_schedules_in_order) {
+    static std::vector<int> order;
+    order.clear();
+    App app = make_app();
+    app.add_systems(LeftSchedule, into([](ResMut<Left> left) { order.push_back(0); }))
+        .add_systems(RightSchedule, into([](ResMut<Left> left) { order.push_back(1); }))
+        .declare_schedule_access(LeftSchedule, ScheduleAccess().write_resource<Left>())
+        // declared as disjoint, but its systems write Left: the group falls back to sequential.
+        .declare_schedule_access(RightSchedule, ScheduleAccess().write_resource<Right>())
+        .enable_concurrent_updates();
+
+    app.update();
+    app.update();
+
+    std::vector<int> expected = {0, 1, 0, 1};
+    EXPECT_EQ(order, expected);
+}
+
+TEST(core, concurrent_update_drives_sub_app) {
+    App app = make_app();
+    App& sub_app = app.sub_app_or_insert(AppLabel::from_type<ConcurrentSubApp>());
+    sub_app.add_schedule(Schedule(SubAppSchedule));
+    sub_app.schedule_order().insert_end(SubAppSchedule);
+    sub_app.world_mut().init_resource<Left>();
+    sub_app.add_systems(SubAppSchedule, into([](ResMut<Left> left) { left->value++; }));
+    sub_app.set_extract_fn([](App& sub, World& main) {
+        sub.world_mut().resource_mut<Right>().value = main.resource<Right>().value;
+    });
+    sub_app.world_mut().init_resource<Right>();
+    app.world_mut().resource_mut<Right>().value = 7;
+    app.add_concurrent_sub_app(AppLabel::from_type<ConcurrentSubApp>(), ScheduleAccess().read_resource<Right>())
+        .enable_concurrent_updates();
+
+    app.update();
+    app.update();
+
+    auto& updated = app.sub_app(AppLabel::from_type<ConcurrentSubApp>());
+    EXPECT_EQ(updated.resource<Left>().value, 2);
+    EXPECT_EQ(updated.resource<Right>().value, 7);
+}
+
+namespace {
+std::atomic<bool> right_started = false;
+std::atomic<bool> right_started_during_left = false;
+
+/** @brief Executor doing work of its own, like FixedMain's, that the schedule's access does not show. */
+struct OpaqueExecutor : ScheduleExecutor {
+    void execute(ScheduleSystems&, World& world, const ExecutorConfig&) override {
+        world.resource_mut<Left>().value++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        right_started_during_left = right_started.load();
+    }
+    epix::meta::type_index type() const override { return epix::meta::type_id<OpaqueExecutor>(); }
+    bool runs_own_systems_only() const override { return false; }
+};
+}  // namespace
+
+TEST(core, concurrent_update_runs_schedules_with_opaque_executors_alone) {
+    App app;
+    app.add_schedule(Schedule(LeftSchedule).with_executor(std::make_unique<OpaqueExecutor>()))
+        .add_schedule(Schedule(RightSchedule));
+    app.schedule_order().insert_end(LeftSchedule);
+    app.schedule_order().insert_end(RightSchedule);
+    app.world_mut().init_resource<Left>();
+    app.world_mut().init_resource<Right>();
+    app.add_systems(RightSchedule, into([](ResMut<Right> right) {
+                        right_started = true;
+                        right->value++;
+                    }))
+        .declare_schedule_access(LeftSchedule, ScheduleAccess().write_resource<Left>())
+        .declare_schedule_access(RightSchedule, ScheduleAccess().write_resource<Right>())
+        .enable_concurrent_updates();
+
+    app.update();
+
+    EXPECT_FALSE(right_started_during_left.load());
+    EXPECT_EQ(app.resource<Left>().value, 1);
+    EXPECT_EQ(app.resource<Right>().value, 1);
+}
@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.core;
+
+using namespace epix::core;
+
+namespace {
+struct Counter {
+    int value = 0;
+};
+struct ExtractTestSubApp {};
+struct ExtractTestScheduleT {
+} ExtractTestSchedule;
+
+struct ExtractObservations {
+    std::vector<bool> modified;
+};
+}  // namespace
+
+TEST(core, extract_change_detection_since_last_extraction) {
+    App app         = App::create();
+    App& sub_app    = app.sub_app_or_insert(AppLabel::from_type<ExtractTestSubApp>());
+    auto main_world = std::ref(app.world_mut());
+    sub_app.add_schedule(Schedule(ExtractTestSchedule))
+        .set_extract_fn([](App& sub, World&) { sub.run_schedule(ExtractTestSchedule); });
+    sub_app.world_mut().init_resource<ExtractObservations>();
+    sub_app.add_systems(ExtractTestSchedule,
+                        into([](Extract<Query<Item<Ref<Counter>>>> counters, ResMut<ExtractObservations> observed) {
+                            for (auto&& [counter] : counters.iter()) {
+                                observed->modified.push_back(counter.is_modified());
+                            }
+                        }));
+
+    auto entity = main_world.get().spawn(Counter{}).id();
+
+    sub_app.extract(app);  // newly added -> modified
+    sub_app.extract(app);  // untouched -> not modified
+    main_world.get().entity_mut(entity).get_mut<Counter>().value().get_mut().value = 1;
+    sub_app.extract(app);  // written after the last extraction -> modified
+    sub_app.extract(app);
+
+    std::vector<bool> expected = {true, false, true, false};
+    EXPECT_EQ(sub_app.world().resource<ExtractObservations>().modified, expected);
+}
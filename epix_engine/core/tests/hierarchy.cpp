@@ -24,7 +24,7 @@ TEST(core, hierarchy) {
     auto maybe_children = parent_ref.get<Children>();
     ASSERT_TRUE(maybe_children.has_value()) << "parent missing Children after spawn via entity ref";
     const auto& children = maybe_children->get();
-    EXPECT_NE(children.entities().find(child1), children.entities().end())
+    EXPECT_TRUE(children.contains(child1))
         << "child1 not found in parent's Children after entity spawn";
 
     // now remove Parent from child1 and ensure parent's Children no longer contains it
@@ -35,7 +35,7 @@ TEST(core, hierarchy) {
 
     // check parent children
     maybe_children = parent_ref.get<Children>();
-    EXPECT_EQ(children.entities().find(child1), children.entities().end())
+    EXPECT_FALSE(children.contains(child1))
         << "child1 still present in parent's Children after removing Parent from child1";
 
     // spawn a child under parent; spawn via entity_mut to ensure hooks run
@@ -65,4 +65,62 @@ TEST(core, hierarchy) {
 
     // child should be despawned
     EXPECT_FALSE(world.get_entity(child2).has_value()) << "child2 still exists after parent despawn";
-}
\ No newline at end of file
+}
+namespace {
+struct TargetedBy;
+struct Targeting : epix::core::Relationship<Targeting, TargetedBy> {
+    using Relationship::Relationship;
+};
+struct TargetedBy : epix::core::RelationshipTarget<TargetedBy, Targeting> {};
+}  // namespace
+
+TEST(core, custom_relationship) {
+    using namespace epix::core;
+
+    World world(WorldId(1), std::make_shared<TypeRegistry>());
+    Entity target  = world.spawn().id();
+    Entity other   = world.spawn().id();
+    Entity hunter1 = world.spawn(Targeting{target}).id();
+    Entity hunter2 = world.spawn(Targeting{target}).id();
+
+    auto targeted = [&](Entity entity) {
+        return world.get_entity(entity)
+            .and_then([](EntityRef&& ref) { return ref.get<TargetedBy>(); })
+            .transform([](const TargetedBy& by) { return std::ranges::to<std::vector>(by.entities()); })
+            .value_or(std::vector<Entity>{});
+    };
+    EXPECT_EQ(targeted(target), (std::vector<Entity>{hunter1, hunter2}));
+
+    // retargeting detaches from the previous target first
+    world.entity_mut(hunter1).insert(Targeting{other});
+    EXPECT_EQ(targeted(target), (std::vector<Entity>{hunter2}));
+    EXPECT_EQ(targeted(other), (std::vector<Entity>{hunter1}));
+
+    // without linked despawn, sources survive and only lose their relationship
+    world.entity_mut(other).despawn();
+    ASSERT_TRUE(world.get_entity(hunter1).has_value());
+    EXPECT_FALSE(world.entity(hunter1).get<Targeting>().has_value());
+}
+
+TEST(core, hierarchy_bulk_despawn) {
+    using namespace epix::core;
+
+    World world(WorldId(1), std::make_shared<TypeRegistry>());
+    Entity root = world.spawn().id();
+    std::vector<Entity> descendants;
+    std::vector<Entity> level = {root};
+    for (int depth = 0; depth < 4; depth++) {
+        std::vector<Entity> next;
+        for (auto parent : level) {
+            for (int i = 0; i < 3; i++) next.push_back(world.spawn(Parent{parent}).id());
+        }
+        descendants.append_range(next);
+        level = std::move(next);
+    }
+    Entity unrelated = world.spawn().id();
+
+    world.entity_mut(root).despawn();
+
+    for (auto entity : descendants) EXPECT_FALSE(world.get_entity(entity).has_value());
+    EXPECT_TRUE(world.get_entity(unrelated).has_value());
+}
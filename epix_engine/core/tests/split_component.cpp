@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.core;
+
+using namespace epix::core;
+
+namespace {
+struct Particle {
+    float position = 0.0f;
+    float velocity = 0.0f;
+    int color      = 0;
+};
+}  // namespace
+
+template <>
+struct epix::core::split_component<Particle>
+    : split_fields<&Particle::position, &Particle::velocity, &Particle::color> {};
+
+TEST(core, split_component_columns) {
+    World world(0);
+    auto a = world.spawn(Particle{1.0f, 2.0f, 3}).id();
+    auto b = world.spawn(Particle{4.0f, 5.0f, 6}).id();
+    world.flush();
+
+    // single field columns are queryable on their own.
+    auto positions = world.query<Item<Field<&Particle::position>&, const Field<&Particle::velocity>&>>();
+    for (auto&& [position, velocity] : positions.iter(world)) position.value += velocity.value;
+
+    auto whole = world.query<Item<Entity, Split<Particle>>>();
+    std::size_t count = 0;
+    for (auto&& [entity, particle] : whole.iter(world)) {
+        Particle value = particle.load();
+        if (entity == a) {
+            EXPECT_EQ(value.position, 3.0f);
+            EXPECT_EQ(value.color, 3);
+        } else {
+            EXPECT_EQ(entity, b);
+            EXPECT_EQ(particle.get<&Particle::position>(), 9.0f);
+        }
+        count++;
+    }
+    EXPECT_EQ(count, 2);
+
+    auto writes = world.query<Item<Entity, SplitWrite<Particle>>>();
+    for (auto&& [entity, particle] : writes.iter(world)) {
+        if (entity == a) particle.store(Particle{0.0f, 0.0f, 7});
+    }
+    EXPECT_EQ(world.entity(a).get<Field<&Particle::color>>().value().get().value, 7);
+
+    world.entity_mut(b).remove<Particle>();
+    EXPECT_FALSE(world.entity(b).contains<Field<&Particle::position>>());
+    EXPECT_FALSE(world.entity(b).contains<Field<&Particle::color>>());
+}
@@ -298,6 +298,11 @@ export struct ImageLoader {
     static std::expected<Image, ImageLoadError> load(std::istream& reader,
                                                      const Settings& settings,
                                                      assets::LoadContext& context);
+    /** @brief Load an image asset from encoded bytes, used when the reader provides a zero-copy view.
+     * @param context Asset loading context. */
+    static std::expected<Image, ImageLoadError> load(std::span<const std::byte> bytes,
+                                                     const Settings& settings,
+                                                     assets::LoadContext& context);
 };
 /** @brief Plugin that registers the image asset loader and related
  * systems. */
@@ -600,13 +600,21 @@ std::span<std::string_view> ImageLoader::extensions() noexcept {
     return std::span<std::string_view>(exts.data(), exts.size());
 }
 std::expected<Image, ImageLoadError> ImageLoader::load(std::istream& reader,
-                                                       const Settings&,
+                                                       const Settings& settings,
                                                        assets::LoadContext& context) {
-    spdlog::trace("[image] Loading image from '{}'.", context.path().path.string());
     auto bytes = read_stream_bytes(reader);
     if (!bytes) return std::unexpected(bytes.error());
-
-    auto image = load_image_from_memory(bytes->data(), static_cast<int>(bytes->size()));
+    return load(std::as_bytes(std::span(*bytes)), settings, context);
+}
+std::expected<Image, ImageLoadError> ImageLoader::load(std::span<const std::byte> bytes,
+                                                       const Settings&,
+                                                       assets::LoadContext& context) {
+    spdlog::trace("[image] Loading image from '{}'.", context.path().path.string());
+    if (bytes.size() > static_cast<std::size_t>(std::numeric_limits<int>::max())) {
+        return std::unexpected(ImageLoadError::LoadFailed);
+    }
+    auto image =
+        load_image_from_memory(reinterpret_cast<const unsigned char*>(bytes.data()), static_cast<int>(bytes.size()));
     if (!image) return std::unexpected(image.error());
 
     auto result = std::move(*image);
@@ -179,6 +179,8 @@ constexpr std::string_view kMeshTexturedVertexShaderAssetPath      = "mesh/textu
 constexpr std::string_view kMeshTexturedVertexColorShaderAssetPath = "mesh/textured_vertex_color_vertex.slang";
 constexpr std::string_view kMeshColorFragmentShaderAssetPath       = "mesh/color_fragment.slang";
 constexpr std::string_view kMeshTexturedFragmentShaderAssetPath    = "mesh/textured_fragment.slang";
+/** @brief Name the pipelines of this plugin are recorded under in the pipeline manifest. */
+constexpr std::string_view kMeshPipelineSpecializer = "mesh2d";
 
 std::span<const std::byte> shader_bytes(std::string_view source) {
     return std::span<const std::byte>(reinterpret_cast<const std::byte*>(source.data()), source.size());
@@ -287,7 +289,7 @@ struct Mesh2dPipelineCache {
     assets::Handle<shader::Shader> textured_vertex_color_shader;
     assets::Handle<shader::Shader> color_fragment_shader;
     assets::Handle<shader::Shader> textured_fragment_shader;
-    std::unordered_map<Mesh2dPipelineKey, render::CachedPipelineId, Mesh2dPipelineKeyHash> pipelines;
+    render::SpecializedPipelines<Mesh2dPipelineKey, Mesh2dPipelineKeyHash> pipelines;
 
     explicit Mesh2dPipelineCache(World& world, const MeshShaderHandles& shader_handles)
         : view_layout(world.resource<render::view::ViewUniformBindingLayout>().layout),
@@ -360,10 +362,21 @@ struct Mesh2dPipelineCache {
             .primitive_type = layout.primitive_type,
             .color_format   = color_format,
         };
-        if (auto it = pipelines.find(key); it != pipelines.end()) {
-            return it->second;
+        auto [pipeline_id, inserted] = pipelines.specialize(pipeline_server, key, [&](const Mesh2dPipelineKey&) {
+            return descriptor(layout, color_format, alpha_mode, textured, variant);
+        });
+        if (inserted) {
+            pipeline_server.record_specialization(kMeshPipelineSpecializer,
+                                                  manifest_key(layout, color_format, alpha_mode, textured));
         }
+        return pipeline_id;
+    }
 
+    render::RenderPipelineDescriptor descriptor(const MeshAttributeLayout& layout,
+                                                wgpu::TextureFormat color_format,
+                                                MeshAlphaMode2d alpha_mode,
+                                                bool textured,
+                                                MeshShaderVariant variant) const {
         std::vector<wgpu::VertexBufferLayout> vertex_buffers = std::ranges::to<std::vector>(
             std::views::transform(std::views::values(layout), [](const MeshAttribute& attribute) {
                 return wgpu::VertexBufferLayout()
@@ -437,12 +450,62 @@ struct Mesh2dPipelineCache {
             .fragment    = std::move(fragment_state),
         };
 
-        auto pipeline_id = pipeline_server.queue_render_pipeline(std::move(pipeline_desc));
-        pipelines.emplace(key, pipeline_id);
-        return pipeline_id;
+        return pipeline_desc;
+    }
+
+    /** @brief Encode the arguments of `specialize` for the pipeline manifest, as
+     * `color_format alpha_mode textured primitive slot:format:name,...`. Attribute names are escaped with
+     * `PipelineManifest::escape_field`, as they may hold the separators. */
+    static std::string manifest_key(const MeshAttributeLayout& layout,
+                                    wgpu::TextureFormat color_format,
+                                    MeshAlphaMode2d alpha_mode,
+                                    bool textured) {
+        auto key = std::format("{} {} {} {} ", static_cast<std::uint32_t>(color_format), std::to_underlying(alpha_mode),
+                               textured ? 1 : 0, static_cast<std::uint32_t>(layout.primitive_type));
+        for (auto&& [slot, attribute] : layout) {
+            if (slot != layout.begin()->first) key.push_back(',');
+            std::format_to(std::back_inserter(key), "{}:{}:{}", slot, static_cast<std::uint32_t>(attribute.format),
+                           render::PipelineManifest::escape_field(attribute.name, " ,:"));
+        }
+        return key;
     }
 };
 
+/** @brief Replay `specialize` for a key recorded in the pipeline manifest on an earlier run, see
+ * `Mesh2dPipelineCache::manifest_key`. */
+std::optional<render::CachedPipelineId> replay_mesh_pipeline(World& world, std::string_view key) {
+    auto parse = [](std::string_view text, std::uint32_t& value) {
+        auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return ec == std::errc{} && end == text.data() + text.size();
+    };
+    auto fields = key | std::views::split(' ') |
+                  std::views::transform([](auto&& field) { return std::string_view(field.begin(), field.end()); }) |
+                  std::ranges::to<std::vector>();
+    std::uint32_t color_format = 0, alpha_mode = 0, textured = 0, primitive = 0;
+    if (fields.size() != 5 || !parse(fields[0], color_format) || !parse(fields[1], alpha_mode) ||
+        !parse(fields[2], textured) || !parse(fields[3], primitive)) {
+        return std::nullopt;
+    }
+    MeshAttributeLayout layout;
+    layout.primitive_type = static_cast<wgpu::PrimitiveTopology>(primitive);
+    for (auto&& range : fields[4] | std::views::split(',')) {
+        std::string_view attribute(range.begin(), range.end());
+        auto first         = attribute.find(':');
+        auto second        = attribute.find(':', first + 1);
+        std::uint32_t slot = 0, format = 0;
+        if (second == std::string_view::npos || !parse(attribute.substr(0, first), slot) ||
+            !parse(attribute.substr(first + 1, second - first - 1), format)) {
+            return std::nullopt;
+        }
+        auto name = render::PipelineManifest::unescape_field(attribute.substr(second + 1));
+        if (!name) return std::nullopt;
+        layout.add_attribute(MeshAttribute{std::move(*name), slot, static_cast<wgpu::VertexFormat>(format)});
+    }
+    return world.resource_mut<Mesh2dPipelineCache>().specialize(
+        world.resource_mut<render::PipelineServer>(), layout, static_cast<wgpu::TextureFormat>(color_format),
+        static_cast<MeshAlphaMode2d>(alpha_mode), textured != 0);
+}
+
 struct OpaqueMesh2dDrawFunction {
     render::phase::DrawFunctionId value;
 };
@@ -537,9 +600,9 @@ void prepare_mesh_instances(Query<Item<render::phase::RenderPhase<core_graph::co
                             Res<wgpu::Device> device,
                             Res<wgpu::Queue> queue,
                             Res<Mesh2dPipelineCache> pipeline_cache,
-                            ResMut<MeshInstanceBuffer> instance_buffer) {
+                            ResMut<MeshInstanceBuffer> instance_buffer,
+                            ResMut<render::BindGroupCache> bind_groups) {
     instance_buffer->instances.clear();
-    std::unordered_map<assets::AssetId<image::Image>, wgpu::BindGroup> texture_bind_group_cache;
 
     auto process_phase = [&](auto& phase) {
         std::optional<MeshBatchKey> current_key;
@@ -568,20 +631,18 @@ void prepare_mesh_instances(Query<Item<render::phase::RenderPhase<core_graph::co
                 batch.instance_start                = static_cast<std::uint32_t>(instance_buffer->instances.size());
 
                 if (extracted.texture) {
-                    if (auto it = texture_bind_group_cache.find(*extracted.texture);
-                        it != texture_bind_group_cache.end()) {
-                        batch.texture_bind_group = it->second;
-                    } else if (auto gpu_image = images->try_get(*extracted.texture); gpu_image) {
-                        auto tg = device->createBindGroup(
-                            wgpu::BindGroupDescriptor()
-                                .setLabel("Mesh2dTextureBindGroup")
-                                .setLayout(pipeline_cache->texture_layout)
-                                .setEntries(std::array{
-                                    wgpu::BindGroupEntry().setBinding(0).setSampler(gpu_image->sampler),
-                                    wgpu::BindGroupEntry().setBinding(1).setTextureView(gpu_image->view),
-                                }));
-                        texture_bind_group_cache.emplace(*extracted.texture, tg);
-                        batch.texture_bind_group = std::move(tg);
+                    if (auto gpu_image = images->try_get(*extracted.texture); gpu_image) {
+                        batch.texture_bind_group =
+                            bind_groups->get_or_create(pipeline_cache->texture_layout, *extracted.texture, [&] {
+                                return device->createBindGroup(
+                                    wgpu::BindGroupDescriptor()
+                                        .setLabel("Mesh2dTextureBindGroup")
+                                        .setLayout(pipeline_cache->texture_layout)
+                                        .setEntries(std::array{
+                                            wgpu::BindGroupEntry().setBinding(0).setSampler(gpu_image->sampler),
+                                            wgpu::BindGroupEntry().setBinding(1).setTextureView(gpu_image->view),
+                                        }));
+                            });
                     } else {
                         batch.texture_bind_group.reset();
                     }
@@ -762,6 +823,9 @@ void MeshRenderPlugin::finish(core::App& app) {
     if (!world.get_resource<Mesh2dPipelineCache>()) {
         world.insert_resource(Mesh2dPipelineCache(world, shader_handles->get()));
     }
+    if (auto warmup = world.get_resource<render::PipelineWarmup>()) {
+        warmup->get().add_specializer(std::string(kMeshPipelineSpecializer), replay_mesh_pipeline);
+    }
     auto& render_subapp = render_app->get();
     world.insert_resource(OpaqueMesh2dDrawFunction{
         .value = render::phase::app_add_render_commands<
@@ -4,6 +4,7 @@ import epix.assets;
 import epix.core;
 import std;
 
+import :bind_group_cache;
 import :extract;
 
 using namespace epix::core;
@@ -170,14 +171,18 @@ void extract_assets(ResMut<CachedExtractedAssets<T>> cache,
 template <RenderAssetImpl T>
 void process_render_assets(typename RenderAsset<T>::Param param,
                            ResMut<RenderAssets<T>> render_assets,
-                           ResMut<CachedExtractedAssets<T>> extracted_assets) {
+                           ResMut<CachedExtractedAssets<T>> extracted_assets,
+                           std::optional<Res<BindGroupInvalidations>> bind_group_invalidations) {
     RenderAsset<T> render_asset_impl;
     std::vector<std::pair<assets::AssetId<T>, std::exception_ptr>> exceptions;
+    std::vector<assets::UntypedAssetId> invalidated;
     for (const auto& id : extracted_assets->removed) {
         render_assets->remove(id);
+        invalidated.emplace_back(id);
     }
     for (auto&& [id, asset] : extracted_assets->extracted_assets) {
         render_assets->remove(id);  // remove old version if exists
+        invalidated.emplace_back(id);
         try {
             render_assets->insert(id, render_asset_impl.process(std::move(asset), param));
         } catch (...) {
@@ -186,6 +191,7 @@ void process_render_assets(typename RenderAsset<T>::Param param,
     }
     extracted_assets->extracted_assets.clear();
     extracted_assets->removed.clear();
+    if (bind_group_invalidations) (*bind_group_invalidations)->push(invalidated);
     if (!exceptions.empty()) {
         // Handle exceptions
         std::stringstream ss;
@@ -0,0 +1,152 @@
+module;
+
+export module epix.render:bind_group_cache;
+
+import epix.assets;
+import epix.core;
+import epix.utils;
+import webgpu;
+import std;
+
+using namespace epix::core;
+
+namespace epix::render {
+/** @brief Lookup counters of a BindGroupCache. */
+export struct BindGroupCacheStats {
+    /** @brief Lookups answered with a cached bind group. */
+    std::size_t hits = 0;
+    /** @brief Lookups that had to create a bind group. */
+    std::size_t misses = 0;
+    /** @brief Bind groups dropped because a resource changed or they went unused. */
+    std::size_t evictions = 0;
+
+    /** @brief Share of lookups answered from the cache, from 0 to 1. */
+    float hit_rate() const {
+        auto lookups = hits + misses;
+        return lookups == 0 ? 1.0f : static_cast<float>(hits) / static_cast<float>(lookups);
+    }
+};
+/** @brief Render assets processed again or removed since BindGroupCache last looked, queued by the
+ * render asset processing systems of every asset type.
+ *
+ * Queueing only needs the resource read-only, so the processing systems of different asset types still run
+ * in parallel instead of all waiting on the cache. BindGroupCache drains it after extraction.
+ */
+export struct BindGroupInvalidations {
+    /** @brief Queue `resources` for eviction from the BindGroupCache. */
+    void push(std::span<const assets::UntypedAssetId> resources) const;
+    /** @brief Take every queued resource. */
+    std::vector<assets::UntypedAssetId> take() const;
+
+   private:
+    std::shared_ptr<utils::Mutex<std::vector<assets::UntypedAssetId>>> m_queue =
+        std::make_shared<utils::Mutex<std::vector<assets::UntypedAssetId>>>();
+};
+/** @brief Render world resource keeping bind groups across frames, keyed by their layout and the render
+ * assets their entries come from.
+ *
+ * A bind group is evicted when one of its render assets is processed again or removed, and when it goes
+ * unused for `max_unused_frames()` frames. Prepare systems look their bind groups up here instead of
+ * creating them every frame:
+ *
+ * ```cpp
+ * batch.texture_bind_group = bind_groups->get_or_create(layout, image_id, [&] {
+ *     return device->createBindGroup(...);
+ * });
+ * ```
+ */
+export struct BindGroupCache {
+    /** @brief Default number of frames an unused bind group is kept for. */
+    static constexpr std::uint32_t DEFAULT_MAX_UNUSED_FRAMES = 60;
+
+    /** @brief Bind group of `layout` over `resources`, made by `create` on a miss.
+     * `resources` must identify everything the entries are made from, as `create` is not called again
+     * while the bind group is cached. */
+    template <std::invocable F>
+        requires std::convertible_to<std::invoke_result_t<F>, wgpu::BindGroup>
+    const wgpu::BindGroup& get_or_create(const wgpu::BindGroupLayout& layout,
+                                         std::span<const assets::UntypedAssetId> resources,
+                                         F&& create) {
+        KeyView key{static_cast<std::uint64_t>(layout.id()), resources};
+        if (auto it = m_entries.find(key); it != m_entries.end()) {
+            it->second.last_used = m_frame;
+            m_stats.hits++;
+            m_frame_stats.hits++;
+            return it->second.bind_group;
+        }
+        m_stats.misses++;
+        m_frame_stats.misses++;
+        return insert(key, std::invoke(std::forward<F>(create)));
+    }
+    /** @brief Bind group of `layout` over the single render asset `resource`, made by `create` on a miss. */
+    template <std::invocable F>
+        requires std::convertible_to<std::invoke_result_t<F>, wgpu::BindGroup>
+    const wgpu::BindGroup& get_or_create(const wgpu::BindGroupLayout& layout,
+                                         const assets::UntypedAssetId& resource,
+                                         F&& create) {
+        return get_or_create(layout, std::span(&resource, 1), std::forward<F>(create));
+    }
+    /** @brief Evict every bind group made from `resource`. */
+    void invalidate(const assets::UntypedAssetId& resource);
+    /** @brief Evict every bind group. */
+    void clear();
+    /** @brief Set how many frames an unused bind group is kept for. Zero evicts bind groups not used in
+     * the frame that just ended. */
+    void set_max_unused_frames(std::uint32_t frames) { m_max_unused_frames = frames; }
+    std::uint32_t max_unused_frames() const { return m_max_unused_frames; }
+    std::size_t size() const { return m_entries.size(); }
+    /** @brief Counters since the cache was created. */
+    const BindGroupCacheStats& stats() const { return m_stats; }
+    /** @brief Counters of the last finished frame. */
+    const BindGroupCacheStats& last_frame_stats() const { return m_last_frame_stats; }
+    /** @brief Evict bind groups unused for too long and start counting the next frame. */
+    void end_frame();
+
+    /** @brief Evict the bind groups of the render assets queued in BindGroupInvalidations. */
+    static void invalidate_system(ResMut<BindGroupCache> cache, Res<BindGroupInvalidations> invalidations);
+    /** @brief Run `end_frame()` on the render world's cache. */
+    static void end_frame_system(ResMut<BindGroupCache> cache) { cache->end_frame(); }
+
+   private:
+    struct Key {
+        std::uint64_t layout;
+        std::vector<assets::UntypedAssetId> resources;
+    };
+    struct KeyView {
+        std::uint64_t layout;
+        std::span<const assets::UntypedAssetId> resources;
+
+        KeyView(std::uint64_t layout, std::span<const assets::UntypedAssetId> resources)
+            : layout(layout), resources(resources) {}
+        KeyView(const Key& key) : layout(key.layout), resources(key.resources) {}
+    };
+    // lets hits look the key up without copying the resources into a vector.
+    struct KeyHash {
+        using is_transparent = void;
+        std::size_t operator()(const KeyView& key) const;
+    };
+    struct KeyEqual {
+        using is_transparent = void;
+        bool operator()(const KeyView& lhs, const KeyView& rhs) const {
+            return lhs.layout == rhs.layout && std::ranges::equal(lhs.resources, rhs.resources);
+        }
+    };
+    struct Entry {
+        wgpu::BindGroup bind_group;
+        std::uint64_t last_used = 0;
+    };
+    using Entries = std::unordered_map<Key, Entry, KeyHash, KeyEqual>;
+
+    const wgpu::BindGroup& insert(const KeyView& key, wgpu::BindGroup bind_group);
+    void erase(Entries::iterator it);
+
+    Entries m_entries;
+    // resource -> keys of the bind groups made from it. Keys of an unordered_map never move.
+    std::unordered_multimap<assets::UntypedAssetId, const Key*> m_users;
+    std::uint64_t m_frame             = 0;
+    std::uint32_t m_max_unused_frames = DEFAULT_MAX_UNUSED_FRAMES;
+    BindGroupCacheStats m_stats;
+    BindGroupCacheStats m_frame_stats;
+    BindGroupCacheStats m_last_frame_stats;
+};
+}  // namespace epix::render
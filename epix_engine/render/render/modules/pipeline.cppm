@@ -180,4 +180,93 @@ export struct ComputePipelineDescriptor {
         return std::forward<decltype(self)>(self);
     }
 };
+/** @brief Byte string identifying everything a render pipeline is built from except its label: bind group
+ * layouts, shaders, entry points, vertex layouts and fixed-function state. Descriptors with equal keys build
+ * the same pipeline.
+ *
+ * Chained extension structs (`nextInChain`) are not encoded, such as those of the primitive and depth-stencil
+ * state. Descriptors differing only in them get equal keys and SpecializedPipelines would share one pipeline
+ * between them, so specializers setting chained structs must queue those pipelines directly. */
+export std::string structural_key(const RenderPipelineDescriptor& descriptor);
+
+/** @brief Render pipelines specialized by a `Key`, such as a target format or a mesh variant.
+ *
+ * `specialize` looks the key up in a flat open-addressing table, so the per-frame path of a key seen before
+ * is one hash and a probe; its descriptor is only built the first time. New descriptors are interned by
+ * `structural_key`, and a key whose descriptor matches one already queued shares its pipeline.
+ */
+export template <typename Key, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+struct SpecializedPipelines {
+    /** @brief Return the pipeline of `key`, queueing `make_descriptor(key)` on `server` the first time.
+     * @return The pipeline id, and whether the key was new. */
+    template <typename Server, std::invocable<const Key&> MakeDescriptor>
+        requires std::convertible_to<std::invoke_result_t<MakeDescriptor, const Key&>, RenderPipelineDescriptor>
+    std::pair<shader::CachedPipelineId, bool> specialize(const Server& server,
+                                                         const Key& key,
+                                                         MakeDescriptor&& make_descriptor) {
+        std::size_t hash = mix(m_hash(key));
+        if (auto* slot = find(key, hash); slot && slot->entry) return {slot->entry->second, false};
+
+        RenderPipelineDescriptor descriptor = std::invoke(std::forward<MakeDescriptor>(make_descriptor), key);
+        auto [interned, queued]             = m_descriptors.try_emplace(structural_key(descriptor));
+        if (queued) interned->second = server.queue_render_pipeline(std::move(descriptor));
+
+        // at most 3/4 full, so probes stay short.
+        if ((m_size + 1) * 4 > m_slots.size() * 3) grow();
+        auto* slot = find(key, hash);
+        slot->hash = hash;
+        slot->entry.emplace(key, interned->second);
+        m_size++;
+        return {interned->second, true};
+    }
+    /** @brief The pipeline of `key`, if it was specialized before. */
+    std::optional<shader::CachedPipelineId> get(const Key& key) const {
+        auto* slot = find(key, mix(m_hash(key)));
+        if (!slot || !slot->entry) return std::nullopt;
+        return slot->entry->second;
+    }
+    /** @brief Number of keys specialized. */
+    std::size_t size() const { return m_size; }
+    /** @brief Number of distinct pipelines queued, at most `size()`. */
+    std::size_t pipeline_count() const { return m_descriptors.size(); }
+
+   private:
+    struct Slot {
+        std::size_t hash = 0;
+        std::optional<std::pair<Key, shader::CachedPipelineId>> entry;
+    };
+
+    // spread the identity hashes of small integer keys over the low bits used as the slot index.
+    static std::size_t mix(std::size_t hash) {
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccdull;
+        hash ^= hash >> 33;
+        return hash;
+    }
+    // The slot holding `key`, or the empty slot it would go in; nullptr while the table is empty.
+    auto find(this auto& self, const Key& key, std::size_t hash) -> decltype(self.m_slots.data()) {
+        if (self.m_slots.empty()) return nullptr;
+        std::size_t mask = self.m_slots.size() - 1;
+        for (std::size_t index = hash & mask;; index = (index + 1) & mask) {
+            auto& slot = self.m_slots[index];
+            if (!slot.entry || (slot.hash == hash && self.m_equal(slot.entry->first, key))) return &slot;
+        }
+    }
+    void grow() {
+        auto old = std::exchange(m_slots, std::vector<Slot>(std::max<std::size_t>(m_slots.size() * 2, 8)));
+        std::size_t mask = m_slots.size() - 1;
+        for (auto& slot : old) {
+            if (!slot.entry) continue;
+            std::size_t index = slot.hash & mask;
+            while (m_slots[index].entry) index = (index + 1) & mask;
+            m_slots[index] = std::move(slot);
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    std::size_t m_size = 0;
+    std::unordered_map<std::string, shader::CachedPipelineId> m_descriptors;
+    [[no_unique_address]] Hash m_hash;
+    [[no_unique_address]] KeyEqual m_equal;
+};
 }  // namespace epix::render
\ No newline at end of file
@@ -0,0 +1,75 @@
+module;
+
+export module epix.render:pipeline_manifest;
+
+import std;
+
+namespace epix::render {
+/** @brief One pipeline specialization recorded in a PipelineManifest. */
+export struct PipelineManifestEntry {
+    /** @brief Name of the specializer that built the pipeline, such as `sprite`. */
+    std::string specializer;
+    /** @brief Specializer-defined key holding everything needed to build the same pipeline again, such as
+     * the shader variant, the target format and the vertex layout. */
+    std::string key;
+
+    bool operator==(const PipelineManifestEntry&) const = default;
+};
+/** @brief Error returned when reading a PipelineManifest. */
+export enum class PipelineManifestError {
+    /** @brief The file could not be read or written. */
+    Io,
+    /** @brief The first line is not a manifest header of a supported version. */
+    BadHeader,
+    /** @brief A line is not a `specializer<TAB>key` pair. */
+    BadEntry,
+};
+/** @brief List of pipeline specializations used during a session, replayed by PipelineWarmup on later
+ * runs so pipelines are built during loading instead of on first use.
+ *
+ * Entries keep the order they were first recorded in, which is the order they are replayed in within
+ * the same specializer priority. Recording an entry again is a no-op.
+ *
+ * The file format is line based: a `epix-pipeline-manifest <version>` header, then one
+ * `specializer<TAB>key` line per entry. Names and keys may not contain tabs or line breaks; specializers
+ * embedding free-form text in their keys use `escape_field()` for it.
+ *
+ * Entries are not pruned by age: a run keeps the entries of earlier runs even if it does not use them.
+ * PipelineWarmup only `erase()`s entries whose specializer rejected them or whose pipeline failed to
+ * build. Deleting the file resets the manifest.
+ */
+export struct PipelineManifest {
+   public:
+    /** @brief Add an entry unless already present.
+     * @return True if the entry was added; false if it was present or contains a tab or line break. */
+    bool record(std::string_view specializer, std::string_view key);
+    /** @brief Record every entry of `other` after the entries of this manifest. */
+    void merge(const PipelineManifest& other);
+    /** @brief Remove an entry.
+     * @return True if the entry was present. */
+    bool erase(std::string_view specializer, std::string_view key);
+    bool contains(std::string_view specializer, std::string_view key) const;
+
+    const std::vector<PipelineManifestEntry>& entries() const { return m_entries; }
+    std::size_t size() const { return m_entries.size(); }
+    bool empty() const { return m_entries.empty(); }
+
+    std::string serialize() const;
+    static std::expected<PipelineManifest, PipelineManifestError> parse(std::string_view text);
+    /** @brief Write the manifest to `path`, through a temporary file so a crash never leaves half of it. */
+    std::expected<void, PipelineManifestError> save(const std::filesystem::path& path) const;
+    static std::expected<PipelineManifest, PipelineManifestError> load(const std::filesystem::path& path);
+
+    /** @brief Percent-encode `%`, tabs, line breaks and every character of `separators` in `field`, so a
+     * specializer can embed it in a key it splits on those separators. */
+    static std::string escape_field(std::string_view field, std::string_view separators);
+    /** @brief Reverse `escape_field()`.
+     * @return nullopt if `field` holds a malformed escape. */
+    static std::optional<std::string> unescape_field(std::string_view field);
+
+   private:
+    std::vector<PipelineManifestEntry> m_entries;
+    // `specializer<TAB>key` of every entry, for deduplication.
+    std::unordered_set<std::string> m_seen;
+};
+}  // namespace epix::render
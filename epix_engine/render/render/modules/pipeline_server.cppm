@@ -8,6 +8,7 @@ import epix.shader;
 import BS.thread_pool;
 
 import :pipeline;
+import :pipeline_manifest;
 
 using namespace epix::core;
 
@@ -113,7 +114,14 @@ struct PipelineServerData {
     std::vector<CachedPipeline> pipelines;
     std::unordered_set<CachedPipelineId> waiting_pipelines;
     utils::Mutex<std::vector<CachedPipeline>> new_pipelines;
+    utils::Mutex<PipelineManifest> manifest;
     std::unique_ptr<BS::thread_pool<BS::tp::none>> pipeline_create_task_pool;
+    // Pipelines rebuilt after a shader change, which keep their current state until the rebuild is ready.
+    std::deque<CachedPipelineId> rebuild_queue;
+    std::unordered_set<CachedPipelineId> rebuild_queued;
+    std::unordered_map<CachedPipelineId, PipelineStateCreating> rebuilding;
+    std::atomic<std::size_t> rebuilds_per_frame;
+    std::atomic<std::size_t> max_rebuilds_in_flight;
 
     PipelineServerData(wgpu::Device device);
 };
@@ -126,6 +134,14 @@ struct PipelineServerData {
  * allowing PipelineServer to exist in both the main app and render app.
  * Mutation methods are private and driven by RenderPlugin systems in
  * ExtractSchedule.
+ *
+ * When a shader changes, only pipelines using a variant the change alters
+ * are rebuilt. Pipelines that were ready keep being returned while they
+ * rebuild in the background, a few per frame within `set_rebuild_budget()`.
+ *
+ * Specializers report the pipelines they build with
+ * `record_specialization()`; the resulting `manifest()` is replayed by
+ * `PipelineWarmup` on later runs.
  */
 export struct PipelineServer {
    public:
@@ -155,6 +171,21 @@ export struct PipelineServer {
     CachedPipelineId queue_render_pipeline(RenderPipelineDescriptor descriptor) const;
     /** @brief Queue a compute pipeline for asynchronous creation. */
     CachedPipelineId queue_compute_pipeline(ComputePipelineDescriptor descriptor) const;
+    /** @brief Keep compiled shader variants in `disk_cache` across runs. The cache is trimmed to its
+     *  size limit in the background. */
+    void set_shader_disk_cache(std::shared_ptr<shader::ShaderDiskCache> disk_cache) const;
+    /** @brief Record that `specializer` built a pipeline for `key`, so the manifest replays it on later runs.
+     * @return True if the entry is new to the manifest. */
+    bool record_specialization(std::string_view specializer, std::string_view key) const;
+    /** @brief Record every entry of `manifest`, keeping entries of earlier runs that were not used in this one. */
+    void merge_manifest(const PipelineManifest& manifest) const;
+    /** @brief Drop a recorded entry that can no longer be replayed, so later runs stop warming it up. */
+    void forget_specialization(std::string_view specializer, std::string_view key) const;
+    /** @brief Snapshot of the specializations recorded so far. */
+    PipelineManifest manifest() const;
+    /** @brief Bound the rebuilds of ready pipelines after a shader change: each frame starts at most
+     *  `per_frame` of them, and at most `max_in_flight` compile at once. Both are at least one. */
+    void set_rebuild_budget(std::size_t per_frame, std::size_t max_in_flight) const;
 
    private:
     friend struct RenderPlugin;
@@ -163,6 +194,12 @@ export struct PipelineServer {
     void remove_shader(assets::AssetId<shader::Shader> id);
     void process_queue();
     void process_pipeline(CachedPipeline& cached_pipeline, CachedPipelineId id);
+    PipelineStateCreating create_pipeline(const PipelineDescriptor& pipeline_descriptor, CachedPipelineId id) const;
+    /** @brief Queue pipelines affected by a shader change: ready ones are rebuilt in the background, others
+     *  are created again. */
+    void invalidate_pipelines(std::span<const CachedPipelineId> ids);
+    /** @brief Swap in finished rebuilds and start queued ones within the rebuild budget. */
+    void process_rebuilds();
 
     static void process_pipeline_system(ResMut<PipelineServer> pipeline_server);
     static void extract_shaders(ResMut<PipelineServer> pipeline_server,
@@ -0,0 +1,91 @@
+module;
+
+export module epix.render:pipeline_warmup;
+
+import epix.core;
+import epix.utils;
+import std;
+
+import :pipeline_manifest;
+import :pipeline_server;
+
+using namespace epix::core;
+
+namespace epix::render {
+/** @brief Progress of a PipelineWarmup, for loading screens. */
+export struct PipelineWarmupProgress {
+    /** @brief Entries in the manifest being replayed. */
+    std::size_t total = 0;
+    /** @brief Entries handed to their specializer so far. */
+    std::size_t queued = 0;
+    /** @brief Entries whose pipeline finished building. */
+    std::size_t ready = 0;
+    /** @brief Entries without a specializer, rejected by it, or whose pipeline failed to build. */
+    std::size_t failed = 0;
+
+    /** @brief Returns `true` once every entry is either ready or failed. */
+    bool done() const { return ready + failed >= total; }
+    /** @brief Finished share of the entries, from 0 to 1. */
+    float fraction() const {
+        return total == 0 ? 1.0f : static_cast<float>(ready + failed) / static_cast<float>(total);
+    }
+};
+/** @brief Replays a PipelineManifest recorded on an earlier run, so pipelines are built during loading
+ * instead of stalling the first frame that needs them.
+ *
+ * Each specializer, such as the sprite or mesh pipeline cache, registers under the name it records
+ * entries with, and rebuilds the pipeline of a recorded key through its usual `specialize` path, so the
+ * replayed pipeline is the one later lookups find. Entries are replayed by descending specializer
+ * priority, then in the order they were first used, a few per frame so loading screens keep rendering.
+ *
+ * Entries their specializer rejects, or whose pipeline fails to build, are forgotten by the
+ * PipelineServer so the saved manifest stops replaying them. Entries without a registered specializer
+ * are kept, as the plugin recording them may come back on a later run.
+ *
+ * The data is shared across copies, so the main world can `start()` a warmup and watch `progress()`
+ * while the render world replays it.
+ */
+export struct PipelineWarmup {
+    /** @brief Rebuild the pipeline of a recorded key, returning its id, or nullopt if the key is not
+     * usable anymore. */
+    using Specializer = std::function<std::optional<CachedPipelineId>(World& render_world, std::string_view key)>;
+
+    /** @brief Default number of entries handed to specializers per frame. */
+    static constexpr std::size_t DEFAULT_ENTRIES_PER_FRAME = 8;
+
+    PipelineWarmup();
+
+    /** @brief Register the specializer that replays entries recorded under `name`. Higher priorities
+     * replay first. */
+    void add_specializer(std::string name, Specializer specializer, int priority = 0) const;
+    /** @brief Replay `manifest`, replacing any warmup in progress. */
+    void start(const PipelineManifest& manifest) const;
+    /** @brief Set how many entries are handed to specializers per frame. At least one is. */
+    void set_entries_per_frame(std::size_t count) const;
+    PipelineWarmupProgress progress() const;
+
+   private:
+    friend struct RenderPlugin;
+
+    struct SpecializerEntry {
+        Specializer specializer;
+        int priority = 0;
+    };
+    struct Data {
+        std::unordered_map<std::string, SpecializerEntry> specializers;
+        std::deque<PipelineManifestEntry> pending;
+        // cleared by start() and add_specializer(); pending is ordered by priority on the next replay.
+        bool sorted = true;
+        std::vector<std::pair<CachedPipelineId, PipelineManifestEntry>> building;
+        std::size_t entries_per_frame = DEFAULT_ENTRIES_PER_FRAME;
+        PipelineWarmupProgress progress;
+        // bumped by start(), so a replay racing with it does not count into the new progress.
+        std::uint64_t generation = 0;
+    };
+
+    /** @brief Hand this frame's entries to their specializers and count finished pipelines. */
+    static void replay_system(World& world);
+
+    std::shared_ptr<utils::Mutex<Data>> m_data;
+};
+}  // namespace epix::render
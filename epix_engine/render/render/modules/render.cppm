@@ -9,13 +9,17 @@ export import epix.shader;
 export import :schedule;
 export import :extract;
 export import :assets;
+export import :bind_group_cache;
 export import :graph;
 export import :image;
 export import :window;
 export import :pipeline;
 export import :pipeline_server;
+export import :pipeline_manifest;
+export import :pipeline_warmup;
 export import :render_phase;
 export import :view;
+export import :sync;
 
 namespace epix::render {
 /**
@@ -40,6 +44,17 @@ export struct RenderPlugin {
      * @param level the validation level to set
      */
     RenderPlugin& set_validation(int level = 0);
+    /** @brief Directory of the persistent shader cache, which keeps compiled shader variants across runs.
+     * Disabled when unset. */
+    std::optional<std::filesystem::path> shader_cache_path;
+    /** @brief Keep compiled shader variants in `path`, so later runs skip shader compilation. */
+    RenderPlugin& set_shader_cache_path(std::filesystem::path path);
+    /** @brief File of the pipeline manifest. When set, pipelines recorded there on earlier runs are
+     * replayed by `PipelineWarmup` at startup, and the pipelines used this run are added to it on exit.
+     * Disabled when unset. */
+    std::optional<std::filesystem::path> pipeline_manifest_path;
+    /** @brief Warm up the pipelines recorded in `path` at startup, and record this run's pipelines there. */
+    RenderPlugin& set_pipeline_manifest_path(std::filesystem::path path);
     void build(core::App&);
     void finalize(core::App&);
 };
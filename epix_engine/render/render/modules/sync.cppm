@@ -0,0 +1,177 @@
+export module epix.render:sync;
+
+import epix.core;
+import std;
+
+namespace epix::render {
+using namespace epix::core;
+
+/** @brief Component on a retained render-world entity pointing back to the
+ * main-world entity it mirrors. */
+export struct MainEntity {
+    /** @brief Source entity in the main world. */
+    Entity entity;
+};
+
+/** @brief Marker for render-world entities that survive the end-of-frame
+ * entity clear.
+ *
+ * Render-world entities are temporary by default and are despawned after
+ * `RenderSet::Cleanup`. Entities spawned through `RetainedEntities<T>` carry
+ * this marker and are only despawned when their main-world source is gone. */
+export struct RetainedRenderEntity {};
+
+/** @brief Per-frame bump allocator for transient render-world data.
+ *
+ * All memory handed out by `resource()` is released at once when the render
+ * world clears its temporary entities. Containers built on it must not
+ * outlive the frame. If a frame overflows the owned buffer, the buffer grows
+ * to the observed high-water mark on the next reset so steady-state frames
+ * never touch the upstream allocator.
+ *
+ * Only scratch containers of extract and cleanup systems are allocated here;
+ * components of render entities still live in the render world's own storage.
+ */
+export struct FrameArena {
+   public:
+    explicit FrameArena(std::size_t initial_capacity = 256 * 1024);
+    FrameArena(const FrameArena&)            = delete;
+    FrameArena(FrameArena&&)                 = default;
+    FrameArena& operator=(const FrameArena&) = delete;
+    FrameArena& operator=(FrameArena&&)      = default;
+
+    /** @brief Memory resource valid until the next `reset()`. */
+    std::pmr::memory_resource* resource() { return _resource.get(); }
+    /** @brief Create an empty frame-local vector. */
+    template <typename T>
+    std::pmr::vector<T> make_vector() {
+        return std::pmr::vector<T>(resource());
+    }
+    /** @brief Release every frame-local allocation and grow the owned buffer
+     * if the last frame overflowed it. */
+    void reset();
+    /** @brief Size of the owned buffer in bytes. */
+    std::size_t capacity() const { return _capacity; }
+    /** @brief Bytes requested from upstream during the last frame because the
+     * owned buffer was exhausted. */
+    std::size_t overflow_bytes() const { return _overflow ? _overflow->allocated : 0; }
+
+   private:
+    struct CountingUpstream : std::pmr::memory_resource {
+        std::size_t allocated = 0;
+
+       private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+            allocated += bytes;
+            return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+        }
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+            std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+    };
+
+    void rebuild();
+
+    std::size_t _capacity;
+    std::unique_ptr<std::byte[]> _buffer;
+    std::unique_ptr<CountingUpstream> _overflow;
+    std::unique_ptr<std::pmr::monotonic_buffer_resource> _resource;
+};
+
+/** @brief Stable mapping from main-world entities to retained render-world
+ * entities for one kind of extracted data.
+ *
+ * Extraction systems call `begin()`, then `touch()` every source entity that
+ * should still be rendered, spawning a render entity through `insert()` when
+ * `touch()` returns nothing and updating the existing one in place only when
+ * the source changed. `end()` despawns render entities whose source was not
+ * touched. Lookups are O(1) by source entity index.
+ *
+ * @tparam T Tag type, usually the extracted component, so different
+ * extraction systems keep independent mappings.
+ */
+export template <typename T>
+struct RetainedEntities {
+    /** @brief Mapping entry for one main-world entity. */
+    struct Entry {
+        /** @brief Source entity in the main world. */
+        Entity source;
+        /** @brief Retained entity in the render world. */
+        Entity render_entity;
+        /** @brief Extraction pass in which the source was last touched. */
+        std::uint64_t seen_pass = 0;
+        /** @brief Forces re-extraction on the next pass even if the source is
+         * unchanged, e.g. when data it depends on was not ready yet. */
+        bool needs_refresh = false;
+    };
+
+   public:
+    /** @brief Start a new extraction pass. */
+    void begin() { ++_pass; }
+    /** @brief Look up the render entity mirroring `source` and mark it as seen
+     * in the current pass. */
+    std::optional<std::reference_wrapper<Entry>> touch(Entity source) {
+        if (source.index >= _sparse.size()) return std::nullopt;
+        auto dense = _sparse[source.index];
+        if (dense == kInvalid || _dense[dense].source != source) return std::nullopt;
+        _dense[dense].seen_pass = _pass;
+        return std::ref(_dense[dense]);
+    }
+    /** @brief Record a newly spawned render entity for `source`, seen in the
+     * current pass. */
+    Entry& insert(Entity source, Entity render_entity) {
+        if (source.index >= _sparse.size()) _sparse.resize(static_cast<std::size_t>(source.index) + 1, kInvalid);
+        auto& dense = _sparse[source.index];
+        if (dense != kInvalid) {
+            // the slot was recycled by a new generation, the previous render entity is released in end().
+            _replaced.emplace_back(_dense[dense].source, _dense[dense].render_entity);
+            _dense[dense] = Entry{.source = source, .render_entity = render_entity, .seen_pass = _pass};
+            return _dense[dense];
+        }
+        dense = static_cast<std::uint32_t>(_dense.size());
+        return _dense.emplace_back(Entry{.source = source, .render_entity = render_entity, .seen_pass = _pass});
+    }
+    /** @brief Despawn every render entity whose source was not touched since
+     * `begin()`.
+     * @return Number of despawned render entities. */
+    std::size_t end(Commands& cmd, FrameArena& arena) {
+        auto stale = arena.make_vector<std::uint32_t>();
+        for (std::uint32_t i = 0; i < _dense.size(); ++i) {
+            if (_dense[i].seen_pass != _pass) stale.push_back(i);
+        }
+        // remove from the back so swap-removal never moves a stale entry.
+        for (auto it = stale.rbegin(); it != stale.rend(); ++it) {
+            auto index = *it;
+            cmd.entity(_dense[index].render_entity).despawn();
+            _sparse[_dense[index].source.index] = kInvalid;
+            if (index + 1 != _dense.size()) {
+                _dense[index]                       = _dense.back();
+                _sparse[_dense[index].source.index] = index;
+            }
+            _dense.pop_back();
+        }
+        for (auto&& [source, render_entity] : _replaced) {
+            cmd.entity(render_entity).despawn();
+        }
+        _replaced.clear();
+        return stale.size();
+    }
+    /** @brief Number of retained render entities. */
+    std::size_t size() const { return _dense.size(); }
+    /** @brief Iterate over all mapping entries. */
+    auto iter() const { return std::views::all(_dense); }
+
+   private:
+    static constexpr std::uint32_t kInvalid = std::numeric_limits<std::uint32_t>::max();
+
+    std::vector<std::uint32_t> _sparse;
+    std::vector<Entry> _dense;
+    std::vector<std::pair<Entity, Entity>> _replaced;
+    std::uint64_t _pass = 0;
+};
+
+/** @brief Despawn all non-retained render-world entities and reset the
+ * `FrameArena`. Falls back to a full clear when nothing is retained. */
+export void clear_render_entities(World& world);
+}  // namespace epix::render
@@ -0,0 +1,78 @@
+module;
+
+module epix.render;
+
+import std;
+
+import :bind_group_cache;
+
+namespace epix::render {
+void BindGroupInvalidations::push(std::span<const assets::UntypedAssetId> resources) const {
+    if (resources.empty()) return;
+    auto queue = m_queue->lock();
+    queue->insert(queue->end(), resources.begin(), resources.end());
+}
+
+std::vector<assets::UntypedAssetId> BindGroupInvalidations::take() const { return std::exchange(*m_queue->lock(), {}); }
+
+std::size_t BindGroupCache::KeyHash::operator()(const KeyView& key) const {
+    std::size_t hash = std::hash<std::uint64_t>()(key.layout);
+    for (auto& resource : key.resources) {
+        hash ^= std::hash<assets::UntypedAssetId>()(resource) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+const wgpu::BindGroup& BindGroupCache::insert(const KeyView& key, wgpu::BindGroup bind_group) {
+    auto [it, inserted] = m_entries.emplace(Key{key.layout, {key.resources.begin(), key.resources.end()}},
+                                            Entry{std::move(bind_group), m_frame});
+    for (auto& resource : it->first.resources) m_users.emplace(resource, &it->first);
+    return it->second.bind_group;
+}
+
+void BindGroupCache::erase(Entries::iterator it) {
+    for (auto& resource : it->first.resources) {
+        auto [begin, end] = m_users.equal_range(resource);
+        // a key listing the same resource twice has one m_users entry per listing; erase one at a time.
+        if (auto user = std::ranges::find(begin, end, &it->first, &decltype(m_users)::value_type::second);
+            user != end) {
+            m_users.erase(user);
+        }
+    }
+    m_entries.erase(it);
+    m_stats.evictions++;
+    m_frame_stats.evictions++;
+}
+
+void BindGroupCache::invalidate(const assets::UntypedAssetId& resource) {
+    auto [begin, end] = m_users.equal_range(resource);
+    std::vector<const Key*> keys;
+    for (auto it = begin; it != end; ++it) keys.push_back(it->second);
+    // a key listing the resource more than once is erased only once.
+    std::ranges::sort(keys);
+    auto [first, last] = std::ranges::unique(keys);
+    keys.erase(first, last);
+    for (auto key : keys) erase(m_entries.find(KeyView(*key)));
+}
+
+void BindGroupCache::clear() {
+    m_stats.evictions += m_entries.size();
+    m_frame_stats.evictions += m_entries.size();
+    m_entries.clear();
+    m_users.clear();
+}
+
+void BindGroupCache::invalidate_system(ResMut<BindGroupCache> cache, Res<BindGroupInvalidations> invalidations) {
+    for (auto& resource : invalidations->take()) cache->invalidate(resource);
+}
+
+void BindGroupCache::end_frame() {
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        auto next = std::next(it);
+        if (m_frame - it->second.last_used > m_max_unused_frames) erase(it);
+        it = next;
+    }
+    m_last_frame_stats = std::exchange(m_frame_stats, BindGroupCacheStats{});
+    m_frame++;
+}
+}  // namespace epix::render
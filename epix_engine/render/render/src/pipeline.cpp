@@ -0,0 +1,120 @@
+module;
+
+module epix.render;
+
+import std;
+import epix.assets;
+
+import :pipeline;
+
+namespace epix::render {
+namespace {
+/** @brief Appends the fields of a descriptor as bytes, length-prefixing variable-size parts so distinct
+ * descriptors never encode the same. */
+struct StructureEncoder {
+    std::string bytes;
+
+    template <typename T>
+    void value(const T& value) {
+        if constexpr (std::is_arithmetic_v<T> || std::is_enum_v<T>) {
+            auto raw = std::bit_cast<std::array<char, sizeof(T)>>(value);
+            bytes.append(raw.data(), raw.size());
+        } else {
+            // flag sets such as wgpu::ColorWriteMask.
+            this->value(static_cast<std::uint64_t>(value));
+        }
+    }
+    void text(std::string_view text) {
+        value(text.size());
+        bytes.append(text);
+    }
+    void entry_point(const std::optional<std::string>& entry_point) {
+        value(entry_point.has_value());
+        if (entry_point) text(*entry_point);
+    }
+    void shader(const assets::Handle<shader::Shader>& shader) {
+        text(std::format("{}", assets::UntypedAssetId(shader.id())));
+    }
+    void sequence(const auto& range, auto&& element) {
+        value(static_cast<std::uint64_t>(std::ranges::distance(range)));
+        for (const auto& item : range) element(item);
+    }
+    // Fields that are an optional or a pointer in the webgpu structs.
+    void maybe(const auto& field, auto&& present) {
+        if constexpr (requires { static_cast<bool>(field); *field; }) {
+            value(static_cast<bool>(field));
+            if (field) present(*field);
+        } else {
+            present(field);
+        }
+    }
+
+    void blend_component(const wgpu::BlendComponent& component) {
+        value(component.operation);
+        value(component.srcFactor);
+        value(component.dstFactor);
+    }
+    void stencil_face(const wgpu::StencilFaceState& face) {
+        value(face.compare);
+        value(face.failOp);
+        value(face.depthFailOp);
+        value(face.passOp);
+    }
+};
+}  // namespace
+
+std::string structural_key(const RenderPipelineDescriptor& descriptor) {
+    StructureEncoder encoder;
+    encoder.sequence(descriptor.layouts, [&](const wgpu::BindGroupLayout& layout) {
+        encoder.value(static_cast<std::uint64_t>(layout.id()));
+    });
+
+    encoder.shader(descriptor.vertex.shader);
+    encoder.entry_point(descriptor.vertex.entry_point);
+    encoder.sequence(descriptor.vertex.buffers, [&](const wgpu::VertexBufferLayout& buffer) {
+        encoder.value(buffer.arrayStride);
+        encoder.value(buffer.stepMode);
+        encoder.sequence(buffer.attributes, [&](const wgpu::VertexAttribute& attribute) {
+            encoder.value(attribute.format);
+            encoder.value(attribute.offset);
+            encoder.value(attribute.shaderLocation);
+        });
+    });
+
+    encoder.value(descriptor.primitive.topology);
+    encoder.value(descriptor.primitive.stripIndexFormat);
+    encoder.value(descriptor.primitive.frontFace);
+    encoder.value(descriptor.primitive.cullMode);
+
+    encoder.maybe(descriptor.depth_stencil, [&](const wgpu::DepthStencilState& depth_stencil) {
+        encoder.value(depth_stencil.format);
+        encoder.value(depth_stencil.depthWriteEnabled);
+        encoder.value(depth_stencil.depthCompare);
+        encoder.stencil_face(depth_stencil.stencilFront);
+        encoder.stencil_face(depth_stencil.stencilBack);
+        encoder.value(depth_stencil.stencilReadMask);
+        encoder.value(depth_stencil.stencilWriteMask);
+        encoder.value(depth_stencil.depthBias);
+        encoder.value(depth_stencil.depthBiasSlopeScale);
+        encoder.value(depth_stencil.depthBiasClamp);
+    });
+
+    encoder.value(descriptor.multisample.count);
+    encoder.value(descriptor.multisample.mask);
+    encoder.value(descriptor.multisample.alphaToCoverageEnabled);
+
+    encoder.maybe(descriptor.fragment, [&](const FragmentState& fragment) {
+        encoder.shader(fragment.shader);
+        encoder.entry_point(fragment.entry_point);
+        encoder.sequence(fragment.targets, [&](const wgpu::ColorTargetState& target) {
+            encoder.value(target.format);
+            encoder.maybe(target.blend, [&](const wgpu::BlendState& blend) {
+                encoder.blend_component(blend.color);
+                encoder.blend_component(blend.alpha);
+            });
+            encoder.value(target.writeMask);
+        });
+    });
+    return std::move(encoder.bytes);
+}
+}  // namespace epix::render
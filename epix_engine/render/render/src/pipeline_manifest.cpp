@@ -0,0 +1,131 @@
+module;
+
+module epix.render;
+
+import std;
+
+import :pipeline_manifest;
+
+namespace epix::render {
+namespace {
+constexpr std::string_view k_manifest_header = "epix-pipeline-manifest";
+/** @brief Bump when the line format changes; older manifests are then rejected instead of misread. */
+constexpr std::uint32_t k_manifest_version = 1;
+
+bool valid_field(std::string_view field) { return field.find_first_of("\t\r\n") == std::string_view::npos; }
+std::string seen_key(std::string_view specializer, std::string_view key) {
+    return std::format("{}\t{}", specializer, key);
+}
+}  // namespace
+
+bool PipelineManifest::record(std::string_view specializer, std::string_view key) {
+    if (specializer.empty() || !valid_field(specializer) || !valid_field(key)) return false;
+    if (!m_seen.insert(seen_key(specializer, key)).second) return false;
+    m_entries.push_back(PipelineManifestEntry{std::string(specializer), std::string(key)});
+    return true;
+}
+
+void PipelineManifest::merge(const PipelineManifest& other) {
+    for (auto& entry : other.m_entries) record(entry.specializer, entry.key);
+}
+
+bool PipelineManifest::erase(std::string_view specializer, std::string_view key) {
+    if (!m_seen.erase(seen_key(specializer, key))) return false;
+    std::erase_if(m_entries, [&](const PipelineManifestEntry& entry) {
+        return entry.specializer == specializer && entry.key == key;
+    });
+    return true;
+}
+
+bool PipelineManifest::contains(std::string_view specializer, std::string_view key) const {
+    return m_seen.contains(seen_key(specializer, key));
+}
+
+std::string PipelineManifest::serialize() const {
+    std::string text = std::format("{} {}\n", k_manifest_header, k_manifest_version);
+    for (auto& entry : m_entries) std::format_to(std::back_inserter(text), "{}\t{}\n", entry.specializer, entry.key);
+    return text;
+}
+
+std::expected<PipelineManifest, PipelineManifestError> PipelineManifest::parse(std::string_view text) {
+    // tolerate CRLF line ends from manifests edited by hand.
+    auto lines = text | std::views::split('\n') | std::views::transform([](auto&& range) {
+                     std::string_view line(range.begin(), range.end());
+                     return line.ends_with('\r') ? line.substr(0, line.size() - 1) : line;
+                 });
+    auto it = lines.begin();
+    if (it == lines.end() || *it != std::format("{} {}", k_manifest_header, k_manifest_version)) {
+        return std::unexpected(PipelineManifestError::BadHeader);
+    }
+    PipelineManifest manifest;
+    for (++it; it != lines.end(); ++it) {
+        std::string_view line = *it;
+        if (line.empty()) continue;
+        auto tab = line.find('\t');
+        if (tab == std::string_view::npos || tab == 0) return std::unexpected(PipelineManifestError::BadEntry);
+        manifest.record(line.substr(0, tab), line.substr(tab + 1));
+    }
+    return manifest;
+}
+
+std::expected<void, PipelineManifestError> PipelineManifest::save(const std::filesystem::path& path) const {
+    std::error_code ec;
+    if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+    auto temp = std::filesystem::path(path).concat(".tmp");
+    {
+        std::ofstream stream(temp, std::ios::binary | std::ios::trunc);
+        auto text = serialize();
+        stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+        stream.close();
+        if (stream.fail()) {
+            std::filesystem::remove(temp, ec);
+            return std::unexpected(PipelineManifestError::Io);
+        }
+    }
+    std::filesystem::rename(temp, path, ec);
+    if (ec) {
+        std::filesystem::remove(temp, ec);
+        return std::unexpected(PipelineManifestError::Io);
+    }
+    return {};
+}
+
+std::string PipelineManifest::escape_field(std::string_view field, std::string_view separators) {
+    std::string escaped;
+    escaped.reserve(field.size());
+    for (char c : field) {
+        if (c == '%' || c == '\t' || c == '\r' || c == '\n' || separators.contains(c)) {
+            std::format_to(std::back_inserter(escaped), "%{:02X}", static_cast<unsigned char>(c));
+        } else {
+            escaped.push_back(c);
+        }
+    }
+    return escaped;
+}
+
+std::optional<std::string> PipelineManifest::unescape_field(std::string_view field) {
+    std::string unescaped;
+    unescaped.reserve(field.size());
+    for (std::size_t i = 0; i < field.size(); ++i) {
+        if (field[i] != '%') {
+            unescaped.push_back(field[i]);
+            continue;
+        }
+        unsigned char c = 0;
+        if (i + 3 > field.size()) return std::nullopt;
+        auto [end, ec] = std::from_chars(field.data() + i + 1, field.data() + i + 3, c, 16);
+        if (ec != std::errc{} || end != field.data() + i + 3) return std::nullopt;
+        unescaped.push_back(static_cast<char>(c));
+        i += 2;
+    }
+    return unescaped;
+}
+
+std::expected<PipelineManifest, PipelineManifestError> PipelineManifest::load(const std::filesystem::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) return std::unexpected(PipelineManifestError::Io);
+    std::string text{std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()};
+    if (stream.bad()) return std::unexpected(PipelineManifestError::Io);
+    return parse(text);
+}
+}  // namespace epix::render
@@ -15,6 +15,7 @@ using Clock = std::chrono::steady_clock;
 
 constexpr auto k_recoverable_shader_error_log_timeout            = std::chrono::seconds(2);
 constexpr std::size_t k_recoverable_shader_error_log_retry_count = 120;
+constexpr std::size_t k_default_rebuilds_per_frame               = 4;
 
 void note_recoverable_shader_error(PipelineStateRecoverableShaderError& state,
                                    CachedPipelineId id,
@@ -81,7 +82,10 @@ PipelineServerData::PipelineServerData(wgpu::Device dev)
     : layout_cache(std::make_shared<utils::Mutex<LayoutCache>>()),
       shader_cache(std::make_shared<utils::Mutex<ShaderCache>>(dev, load_module)),
       device(std::move(dev)),
-      pipeline_create_task_pool(std::make_unique<BS::thread_pool<BS::tp::none>>(std::thread::hardware_concurrency())) {}
+      pipeline_create_task_pool(std::make_unique<BS::thread_pool<BS::tp::none>>(std::thread::hardware_concurrency())),
+      rebuilds_per_frame(k_default_rebuilds_per_frame),
+      // half the pool, so pipelines needed for the first time do not queue behind rebuilds.
+      max_rebuilds_in_flight(std::max<std::size_t>(std::thread::hardware_concurrency() / 2, 1)) {}
 
 PipelineServer::PipelineServer(wgpu::Device device) : m_data(std::make_shared<PipelineServerData>(std::move(device))) {}
 
@@ -166,25 +170,51 @@ CachedPipelineId PipelineServer::queue_compute_pipeline(ComputePipelineDescripto
     new_pipelines->push_back(CachedPipeline{std::move(descriptor), PipelineStateQueued{}});
     return id;
 }
+void PipelineServer::set_shader_disk_cache(std::shared_ptr<ShaderDiskCache> disk_cache) const {
+    if (disk_cache) {
+        spdlog::debug("[render.pipeline] Using shader disk cache at '{}'.", disk_cache->root().string());
+        m_data->pipeline_create_task_pool->detach_task([disk_cache] { disk_cache->collect_garbage(); });
+    }
+    m_data->shader_cache->lock()->set_disk_cache(std::move(disk_cache));
+}
+bool PipelineServer::record_specialization(std::string_view specializer, std::string_view key) const {
+    return m_data->manifest.lock()->record(specializer, key);
+}
+void PipelineServer::merge_manifest(const PipelineManifest& manifest) const {
+    m_data->manifest.lock()->merge(manifest);
+}
+void PipelineServer::forget_specialization(std::string_view specializer, std::string_view key) const {
+    m_data->manifest.lock()->erase(specializer, key);
+}
+PipelineManifest PipelineServer::manifest() const { return *m_data->manifest.lock(); }
+void PipelineServer::set_rebuild_budget(std::size_t per_frame, std::size_t max_in_flight) const {
+    m_data->rebuilds_per_frame.store(std::max<std::size_t>(per_frame, 1), std::memory_order_relaxed);
+    m_data->max_rebuilds_in_flight.store(std::max<std::size_t>(max_in_flight, 1), std::memory_order_relaxed);
+}
+void PipelineServer::invalidate_pipelines(std::span<const CachedPipelineId> ids) {
+    for (CachedPipelineId id : ids) {
+        auto& cached_pipeline = m_data->pipelines[id];
+        if (!std::holds_alternative<Pipeline>(cached_pipeline.state)) {
+            cached_pipeline.state = PipelineStateQueued{};
+            m_data->waiting_pipelines.insert(id);
+            continue;
+        }
+        // keep drawing with the current pipeline until its rebuild is ready; one already running is outdated.
+        m_data->rebuilding.erase(id);
+        if (m_data->rebuild_queued.insert(id).second) m_data->rebuild_queue.push_back(id);
+    }
+}
 void PipelineServer::set_shader(assets::AssetId<Shader> id, Shader shader) {
     // TODO: MSVC partial specialization workaround - cast AssetId<T> to UntypedAssetId
     spdlog::debug("[render.pipeline] Setting shader '{}' (path: {}).", assets::UntypedAssetId(id),
                   shader.path.string());
-    auto shader_cache       = m_data->shader_cache->lock();
-    auto affected_pipelines = shader_cache->set_shader(id, std::move(shader));
-    for (CachedPipelineId pipeline_id : affected_pipelines) {
-        m_data->pipelines[pipeline_id].state = PipelineStateQueued{};
-        m_data->waiting_pipelines.insert(pipeline_id);
-    }
+    auto shader_cache = m_data->shader_cache->lock();
+    invalidate_pipelines(shader_cache->set_shader(id, std::move(shader)));
 }
 void PipelineServer::remove_shader(assets::AssetId<Shader> id) {
     spdlog::debug("[render.pipeline] Removing shader '{}'.", assets::UntypedAssetId(id));
-    auto shader_cache       = m_data->shader_cache->lock();
-    auto affected_pipelines = shader_cache->remove(id);
-    for (CachedPipelineId pipeline_id : affected_pipelines) {
-        m_data->pipelines[pipeline_id].state = PipelineStateQueued{};
-        m_data->waiting_pipelines.insert(pipeline_id);
-    }
+    auto shader_cache = m_data->shader_cache->lock();
+    invalidate_pipelines(shader_cache->remove(id));
 }
 
 void PipelineServer::process_queue() {
@@ -204,11 +234,57 @@ void PipelineServer::process_queue() {
         // processing pipeline
         process_pipeline(m_data->pipelines[id], id);
     }
+    process_rebuilds();
 }
 
-void PipelineServer::process_pipeline(CachedPipeline& cached_pipeline, CachedPipelineId id) {
-    auto create_render_pipeline = [&](const RenderPipelineDescriptor& descriptor) mutable {
-        cached_pipeline.state = PipelineStateCreating{
+void PipelineServer::process_rebuilds() {
+    for (auto it = m_data->rebuilding.begin(); it != m_data->rebuilding.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) == std::future_status::timeout) {
+            ++it;
+            continue;
+        }
+        auto id     = it->first;
+        auto result = it->second.get();
+        it          = m_data->rebuilding.erase(it);
+        if (result) {
+            m_data->pipelines[id].state = std::move(result.value());
+            continue;
+        }
+        // the previous pipeline stays in use; the shader change that fixes the error queues another rebuild.
+        auto* shader_error = std::get_if<ShaderCacheError>(&result.error());
+        if (shader_error && shader_error->is_recoverable()) {
+            spdlog::debug("[render.pipeline] Rebuild of pipeline id={} is waiting on shaders: {}", id.get(),
+                          shader_error->message());
+        } else {
+            spdlog::error("[render.pipeline] Failed to rebuild pipeline id={}, keeping the previous version: {}",
+                          id.get(),
+                          shader_error ? shader_error->message() : std::string("pipeline creation failed"));
+        }
+    }
+
+    // starting a rebuild only submits its compile to the task pool, so the budget counts compiles started.
+    auto per_frame     = m_data->rebuilds_per_frame.load(std::memory_order_relaxed);
+    auto max_in_flight = m_data->max_rebuilds_in_flight.load(std::memory_order_relaxed);
+    for (std::size_t started = 0;
+         started < per_frame && !m_data->rebuild_queue.empty() && m_data->rebuilding.size() < max_in_flight;) {
+        auto id = m_data->rebuild_queue.front();
+        m_data->rebuild_queue.pop_front();
+        m_data->rebuild_queued.erase(id);
+        auto& cached_pipeline = m_data->pipelines[id];
+        // queued from scratch meanwhile, which replaces the rebuild.
+        if (!std::holds_alternative<Pipeline>(cached_pipeline.state)) continue;
+        m_data->rebuilding.emplace(id, create_pipeline(cached_pipeline.descriptor, id));
+        started++;
+    }
+    if (!m_data->rebuild_queue.empty()) {
+        spdlog::trace("[render.pipeline] {} pipeline rebuilds deferred to later frames.", m_data->rebuild_queue.size());
+    }
+}
+
+PipelineStateCreating PipelineServer::create_pipeline(const PipelineDescriptor& pipeline_descriptor,
+                                                      CachedPipelineId id) const {
+    auto create_render_pipeline = [&](const RenderPipelineDescriptor& descriptor) -> PipelineStateCreating {
+        return PipelineStateCreating{
             m_data->pipeline_create_task_pool->submit_task([device           = m_data->device, descriptor,
                                                             layout_cache_ptr = m_data->layout_cache,
                                                             shader_cache_ptr = m_data->shader_cache,
@@ -218,17 +294,27 @@ void PipelineServer::process_pipeline(CachedPipeline& cached_pipeline, CachedPip
                 std::optional<wgpu::ShaderModule> fragment_module;
                 wgpu::PipelineLayout layout;
                 {
-                    auto shader_cache = shader_cache_ptr->lock();
-                    auto layout_cache = layout_cache_ptr->lock();
-                    auto vertex_opt   = shader_cache->get(id, descriptor.vertex.shader, {});
+                    // only resolve under the lock; shaders compile below, concurrently with other pipelines.
+                    std::optional<PendingShaderModule> vertex;
+                    std::optional<PendingShaderModule> fragment;
+                    {
+                        auto shader_cache = shader_cache_ptr->lock();
+                        vertex.emplace(shader_cache->request(id, descriptor.vertex.shader, {}));
+                        if (descriptor.fragment) {
+                            fragment.emplace(shader_cache->request(id, descriptor.fragment->shader, {}));
+                        }
+                    }
+                    // the fragment is built even if the vertex failed: dropping its request would build it in
+                    // the destructor anyway, and the module is cached for the next request.
+                    auto vertex_opt   = vertex->wait();
+                    auto fragment_opt = fragment ? std::optional(fragment->wait()) : std::nullopt;
                     if (!vertex_opt) return std::unexpected(vertex_opt.error());
                     vertex_module = *vertex_opt.value();
-                    if (descriptor.fragment) {
-                        auto fragment_opt = shader_cache->get(id, descriptor.fragment->shader, {});
-                        if (!fragment_opt) return std::unexpected(fragment_opt.error());
-                        fragment_module = *fragment_opt.value();
+                    if (fragment_opt) {
+                        if (!*fragment_opt) return std::unexpected(fragment_opt->error());
+                        fragment_module = *fragment_opt->value();
                     }
-                    if (!descriptor.layouts.empty()) layout = layout_cache->get(device, descriptor.layouts);
+                    if (!descriptor.layouts.empty()) layout = layout_cache_ptr->lock()->get(device, descriptor.layouts);
                 }
                 pipelineDesc.setLabel(std::string_view(descriptor.label));
                 pipelineDesc.setLayout(layout);
@@ -255,8 +341,8 @@ void PipelineServer::process_pipeline(CachedPipeline& cached_pipeline, CachedPip
             }),
         };
     };
-    auto create_compute_pipeline = [&](const ComputePipelineDescriptor& descriptor) mutable {
-        cached_pipeline.state = PipelineStateCreating{
+    auto create_compute_pipeline = [&](const ComputePipelineDescriptor& descriptor) -> PipelineStateCreating {
+        return PipelineStateCreating{
             m_data->pipeline_create_task_pool->submit_task(
                 [device = m_data->device, descriptor, layout_cache_ptr = m_data->layout_cache,
                  shader_cache_ptr = m_data->shader_cache, id]() -> std::expected<Pipeline, PipelineServerError> {
@@ -264,12 +350,14 @@ void PipelineServer::process_pipeline(CachedPipeline& cached_pipeline, CachedPip
                     wgpu::PipelineLayout layout;
                     wgpu::ShaderModule module;
                     {
-                        auto layout_cache = layout_cache_ptr->lock();
-                        auto shader_cache = shader_cache_ptr->lock();
-                        auto shader_opt   = shader_cache->get(id, descriptor.shader, {});
+                        // only resolve under the lock; the shader compiles in wait(), concurrently with others.
+                        auto pending    = shader_cache_ptr->lock()->request(id, descriptor.shader, {});
+                        auto shader_opt = pending.wait();
                         if (!shader_opt) return std::unexpected(shader_opt.error());
                         module = *shader_opt.value();
-                        if (!descriptor.layouts.empty()) layout = layout_cache->get(device, descriptor.layouts);
+                        if (!descriptor.layouts.empty()) {
+                            layout = layout_cache_ptr->lock()->get(device, descriptor.layouts);
+                        }
                     }
                     desc.setLabel(std::string_view(descriptor.label))
                         .setLayout(layout)
@@ -282,6 +370,10 @@ void PipelineServer::process_pipeline(CachedPipeline& cached_pipeline, CachedPip
                 }),
         };
     };
+    return std::visit(utils::visitor{create_render_pipeline, create_compute_pipeline}, pipeline_descriptor);
+}
+
+void PipelineServer::process_pipeline(CachedPipeline& cached_pipeline, CachedPipelineId id) {
     auto pipeline_name = std::visit(utils::visitor{
                                         [](const RenderPipelineDescriptor& desc) { return desc.label; },
                                         [](const ComputePipelineDescriptor& desc) { return desc.label; },
@@ -296,7 +388,7 @@ void PipelineServer::process_pipeline(CachedPipeline& cached_pipeline, CachedPip
 
     if (std::holds_alternative<PipelineStateQueued>(cached_pipeline.state)) {
         spdlog::trace("[render.pipeline] Creating pipeline id={} name='{}'.", id.get(), pipeline_name);
-        std::visit(utils::visitor{create_render_pipeline, create_compute_pipeline}, cached_pipeline.descriptor);
+        cached_pipeline.state = create_pipeline(cached_pipeline.descriptor, id);
     }
 
     if (auto* creating_state = std::get_if<PipelineStateCreating>(&cached_pipeline.state)) {
@@ -346,10 +438,6 @@ void PipelineServer::extract_shaders(ResMut<PipelineServer> pipeline_server,
                                      Extract<Res<assets::Assets<Shader>>> shaders,
                                      Extract<EventReader<assets::AssetEvent<Shader>>> shader_events) {
     auto shader_cache = pipeline_server->m_data->shader_cache->lock();
-    auto affected     = shader_cache->sync(shader_events.read(), *shaders);
-    for (CachedPipelineId id : affected) {
-        pipeline_server->m_data->pipelines[id].state = PipelineStateQueued{};
-        pipeline_server->m_data->waiting_pipelines.insert(id);
-    }
+    pipeline_server->invalidate_pipelines(shader_cache->sync(shader_events.read(), *shaders));
 }
 }  // namespace epix::render
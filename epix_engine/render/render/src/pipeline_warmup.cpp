@@ -0,0 +1,104 @@
+module;
+
+#include <spdlog/spdlog.h>
+
+module epix.render;
+
+import std;
+
+import :pipeline_warmup;
+
+namespace epix::render {
+PipelineWarmup::PipelineWarmup() : m_data(std::make_shared<utils::Mutex<Data>>()) {}
+
+void PipelineWarmup::add_specializer(std::string name, Specializer specializer, int priority) const {
+    auto data = m_data->lock();
+    data->specializers.insert_or_assign(std::move(name), SpecializerEntry{std::move(specializer), priority});
+    data->sorted = false;
+}
+
+void PipelineWarmup::start(const PipelineManifest& manifest) const {
+    auto data     = m_data->lock();
+    data->pending = std::deque<PipelineManifestEntry>(manifest.entries().begin(), manifest.entries().end());
+    data->sorted  = false;
+    data->building.clear();
+    data->progress = PipelineWarmupProgress{.total = manifest.size()};
+    data->generation++;
+    spdlog::debug("[render.warmup] Replaying {} recorded pipelines.", manifest.size());
+}
+
+void PipelineWarmup::set_entries_per_frame(std::size_t count) const {
+    m_data->lock()->entries_per_frame = std::max<std::size_t>(count, 1);
+}
+
+PipelineWarmupProgress PipelineWarmup::progress() const { return m_data->lock()->progress; }
+
+void PipelineWarmup::replay_system(World& world) {
+    auto data_ptr               = world.resource<PipelineWarmup>().m_data;
+    const auto& pipeline_server = world.resource<PipelineServer>();
+
+    std::vector<std::pair<PipelineManifestEntry, Specializer>> batch;
+    std::uint64_t generation;
+    {
+        auto data  = data_ptr->lock();
+        generation = data->generation;
+        if (!data->sorted) {
+            auto priority = [&](const PipelineManifestEntry& entry) {
+                auto it = data->specializers.find(entry.specializer);
+                return it == data->specializers.end() ? std::numeric_limits<int>::min() : it->second.priority;
+            };
+            std::ranges::stable_sort(data->pending, std::greater{}, priority);
+            data->sorted = true;
+        }
+        while (batch.size() < data->entries_per_frame && !data->pending.empty()) {
+            auto entry = std::move(data->pending.front());
+            data->pending.pop_front();
+            data->progress.queued++;
+            auto it = data->specializers.find(entry.specializer);
+            if (it == data->specializers.end()) {
+                spdlog::debug("[render.warmup] No specializer '{}' for recorded pipeline '{}'.", entry.specializer,
+                              entry.key);
+                data->progress.failed++;
+                continue;
+            }
+            batch.emplace_back(std::move(entry), it->second.specializer);
+        }
+    }
+
+    // specializers take their own resources from the world, so they run without the lock.
+    std::vector<std::pair<CachedPipelineId, PipelineManifestEntry>> queued;
+    std::size_t rejected = 0;
+    for (auto& [entry, specializer] : batch) {
+        if (auto id = specializer(world, entry.key)) {
+            queued.emplace_back(*id, std::move(entry));
+        } else {
+            spdlog::debug("[render.warmup] Specializer '{}' rejected recorded pipeline '{}'.", entry.specializer,
+                          entry.key);
+            pipeline_server.forget_specialization(entry.specializer, entry.key);
+            rejected++;
+        }
+    }
+
+    auto data = data_ptr->lock();
+    // a warmup started meanwhile replaced this one, and counts its own entries.
+    if (data->generation != generation) return;
+    data->progress.failed += rejected;
+    data->building.insert(data->building.end(), std::make_move_iterator(queued.begin()),
+                          std::make_move_iterator(queued.end()));
+    std::erase_if(data->building, [&](const std::pair<CachedPipelineId, PipelineManifestEntry>& building) {
+        auto& [id, entry] = building;
+        // pipelines queued this frame have no state until the next extract.
+        auto state = pipeline_server.get_pipeline_state(id);
+        if (!state) return false;
+        if (std::holds_alternative<Pipeline>(state->get())) {
+            data->progress.ready++;
+        } else if (std::holds_alternative<PipelineServerError>(state->get())) {
+            pipeline_server.forget_specialization(entry.specializer, entry.key);
+            data->progress.failed++;
+        } else {
+            return false;
+        }
+        return true;
+    });
+}
+}  // namespace epix::render
@@ -18,6 +18,14 @@ RenderPlugin& RenderPlugin::set_validation(int level) {
     validation = level;
     return *this;
 }
+RenderPlugin& RenderPlugin::set_shader_cache_path(std::filesystem::path path) {
+    shader_cache_path = std::move(path);
+    return *this;
+}
+RenderPlugin& RenderPlugin::set_pipeline_manifest_path(std::filesystem::path path) {
+    pipeline_manifest_path = std::move(path);
+    return *this;
+}
 
 void epix::render::render_system(World& world) {
     auto&& graph  = world.resource_mut<graph::RenderGraph>();
@@ -40,6 +48,7 @@ void RenderPlugin::build(App& app) {
             .set_extract_fn([](App& render_app, World& main_world) { render_app.run_schedule(ExtractSchedule); });
         render_app.schedule_order().insert_begin(render::Render);
         render_app.world_mut().emplace_resource<graph::RenderGraph>();
+        render_app.world_mut().init_resource<FrameArena>();
     });
 
     wgpu::Instance instance = wgpu::createInstance();
@@ -125,17 +134,48 @@ void RenderPlugin::build(App& app) {
             .sampler = default_sampler,
         });
         PipelineServer pipeline_server(device.clone());
+        if (shader_cache_path) {
+            pipeline_server.set_shader_disk_cache(std::make_shared<epix::shader::ShaderDiskCache>(*shader_cache_path));
+        }
+        PipelineWarmup warmup;
+        if (pipeline_manifest_path) {
+            if (auto manifest = PipelineManifest::load(*pipeline_manifest_path)) {
+                // keep pipelines of earlier runs in the manifest even if this run does not use them.
+                pipeline_server.merge_manifest(*manifest);
+                warmup.start(*manifest);
+            } else if (manifest.error() != PipelineManifestError::Io) {
+                spdlog::warn("[render] Ignoring malformed pipeline manifest '{}'.", pipeline_manifest_path->string());
+            }
+            app.add_systems(Exit, into([path = *pipeline_manifest_path](Res<PipelineServer> pipeline_server) {
+                                      if (!pipeline_server->manifest().save(path)) {
+                                          spdlog::warn("[render] Failed to write pipeline manifest '{}'.",
+                                                       path.string());
+                                      }
+                                  }).set_name("save pipeline manifest"));
+        }
+        app.world_mut().insert_resource(warmup);
+        render_app.world_mut().insert_resource(std::move(warmup));
         app.world_mut().insert_resource(pipeline_server);
         render_app.world_mut().insert_resource(std::move(pipeline_server));
+        render_app.world_mut().init_resource<BindGroupCache>();
+        render_app.world_mut().init_resource<BindGroupInvalidations>();
         render_app
             .add_systems(ExtractSchedule, into(PipelineServer::extract_shaders, PipelineServer::process_pipeline_system)
                                               .chain()
                                               .set_names(std::array{"extract shaders", "process pipeline"}))
             .add_systems(Render, into([](Res<wgpu::Device> device) { device->poll(false); },
-                                      [](World& world) { world.clear_entities(); })
+                                      clear_render_entities)
                                      .set_names(std::array{"device poll", "clear render entities"})
                                      .after(RenderSet::Cleanup))
             .add_systems(Render, into(render_system).in_set(RenderSet::Render).set_name("render system"))
+            .add_systems(Render,
+                         into(PipelineWarmup::replay_system).in_set(RenderSet::Queue).set_name("pipeline warmup"))
+            .add_systems(Render, into(BindGroupCache::invalidate_system)
+                                     .in_set(RenderSet::PostExtract)
+                                     .set_name("invalidate bind groups"))
+            .add_systems(Render, into(BindGroupCache::end_frame_system)
+                                     .in_set(RenderSet::Cleanup)
+                                     .set_name("evict unused bind groups"))
             .add_systems(Render,
                          into([](ParamSet<World&, ResMut<core::Schedules>> params) {
                              auto&& [world, schedules] = params.get();
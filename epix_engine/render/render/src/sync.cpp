@@ -0,0 +1,50 @@
+module epix.render;
+
+import std;
+
+import :sync;
+
+namespace epix::render {
+
+FrameArena::FrameArena(std::size_t initial_capacity) : _capacity(std::max<std::size_t>(initial_capacity, 1024)) {
+    rebuild();
+}
+
+void FrameArena::rebuild() {
+    _buffer   = std::make_unique_for_overwrite<std::byte[]>(_capacity);
+    _overflow = std::make_unique<CountingUpstream>();
+    _resource = std::make_unique<std::pmr::monotonic_buffer_resource>(_buffer.get(), _capacity, _overflow.get());
+}
+
+void FrameArena::reset() {
+    if (_overflow->allocated == 0) {
+        _resource->release();
+        return;
+    }
+    _capacity = std::bit_ceil(_capacity + _overflow->allocated);
+    // destroy the resource first, it returns its overflow chunks to the counting upstream.
+    _resource.reset();
+    rebuild();
+}
+
+void clear_render_entities(World& world) {
+    bool has_retained = false;
+    for (auto&& entity : world.query_filtered<Entity, With<RetainedRenderEntity>>().iter(world)) {
+        has_retained = true;
+        break;
+    }
+    if (!has_retained) {
+        world.clear_entities();
+    } else {
+        auto& arena    = world.resource_or_init<FrameArena>();
+        auto temporary = arena.make_vector<Entity>();
+        for (auto&& entity : world.query_filtered<Entity, Without<RetainedRenderEntity>>().iter(world)) {
+            temporary.push_back(entity);
+        }
+        for (auto entity : temporary) {
+            world.entity_mut(entity).despawn();
+        }
+    }
+    world.resource_or_init<FrameArena>().reset();
+}
+}  // namespace epix::render
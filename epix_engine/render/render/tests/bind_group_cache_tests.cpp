@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+import std;
+import webgpu;
+import epix.assets;
+import epix.render;
+
+using namespace epix;
+using namespace epix::render;
+
+namespace {
+// ids of different asset types never compare equal, which gives distinct resources without an asset server.
+const assets::UntypedAssetId k_image   = assets::AssetId<int>::invalid();
+const assets::UntypedAssetId k_sampler = assets::AssetId<float>::invalid();
+const assets::UntypedAssetId k_buffer  = assets::AssetId<std::string>::invalid();
+}  // namespace
+
+TEST(BindGroupCache, GetOrCreateCreatesOnMissOnly) {
+    BindGroupCache cache;
+    wgpu::BindGroupLayout layout;
+    int created = 0;
+    auto create = [&] {
+        created++;
+        return wgpu::BindGroup{};
+    };
+
+    cache.get_or_create(layout, k_image, create);
+    cache.get_or_create(layout, k_image, create);
+    cache.get_or_create(layout, std::array{k_image, k_sampler}, create);
+    cache.get_or_create(layout, std::array{k_image, k_sampler}, create);
+    EXPECT_EQ(created, 2);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.stats().hits, 2u);
+    EXPECT_EQ(cache.stats().misses, 2u);
+    EXPECT_FLOAT_EQ(cache.stats().hit_rate(), 0.5f);
+}
+
+TEST(BindGroupCache, ResourceOrderIsPartOfTheKey) {
+    BindGroupCache cache;
+    wgpu::BindGroupLayout layout;
+    cache.get_or_create(layout, std::array{k_image, k_sampler}, [] { return wgpu::BindGroup{}; });
+    cache.get_or_create(layout, std::array{k_sampler, k_image}, [] { return wgpu::BindGroup{}; });
+    EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(BindGroupCache, InvalidateEvictsEveryUser) {
+    BindGroupCache cache;
+    wgpu::BindGroupLayout layout;
+    cache.get_or_create(layout, k_image, [] { return wgpu::BindGroup{}; });
+    cache.get_or_create(layout, std::array{k_image, k_buffer}, [] { return wgpu::BindGroup{}; });
+    cache.get_or_create(layout, k_sampler, [] { return wgpu::BindGroup{}; });
+
+    cache.invalidate(k_image);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.stats().evictions, 2u);
+
+    int created = 0;
+    auto create = [&] {
+        created++;
+        return wgpu::BindGroup{};
+    };
+    cache.get_or_create(layout, k_sampler, create);
+    cache.get_or_create(layout, k_image, create);
+    EXPECT_EQ(created, 1);
+}
+
+TEST(BindGroupCache, InvalidateKeyListingResourceTwice) {
+    BindGroupCache cache;
+    wgpu::BindGroupLayout layout;
+    cache.get_or_create(layout, std::array{k_image, k_sampler, k_image}, [] { return wgpu::BindGroup{}; });
+    cache.get_or_create(layout, k_image, [] { return wgpu::BindGroup{}; });
+
+    cache.invalidate(k_image);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.stats().evictions, 2u);
+    // the other resource of the evicted key has no users left.
+    cache.invalidate(k_sampler);
+    EXPECT_EQ(cache.stats().evictions, 2u);
+
+    // a recreated key is tracked again, once per listing.
+    cache.get_or_create(layout, std::array{k_image, k_sampler, k_image}, [] { return wgpu::BindGroup{}; });
+    cache.invalidate(k_sampler);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.stats().evictions, 3u);
+    cache.invalidate(k_image);
+    EXPECT_EQ(cache.stats().evictions, 3u);
+}
+
+TEST(BindGroupCache, QueuedInvalidationsAreDrained) {
+    BindGroupInvalidations invalidations;
+    invalidations.push(std::array{k_image, k_sampler});
+    invalidations.push(std::array{k_buffer});
+    EXPECT_EQ(invalidations.take(), (std::vector{k_image, k_sampler, k_buffer}));
+    EXPECT_TRUE(invalidations.take().empty());
+}
+
+TEST(BindGroupCache, UnusedBindGroupsAreEvicted) {
+    BindGroupCache cache;
+    cache.set_max_unused_frames(1);
+    wgpu::BindGroupLayout layout;
+    cache.get_or_create(layout, k_image, [] { return wgpu::BindGroup{}; });
+    cache.get_or_create(layout, k_sampler, [] { return wgpu::BindGroup{}; });
+    cache.end_frame();
+
+    // k_sampler is kept through one unused frame, and evicted at the end of the second.
+    cache.get_or_create(layout, k_image, [] { return wgpu::BindGroup{}; });
+    cache.end_frame();
+    EXPECT_EQ(cache.size(), 2u);
+    cache.get_or_create(layout, k_image, [] { return wgpu::BindGroup{}; });
+    cache.end_frame();
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.last_frame_stats().evictions, 1u);
+    EXPECT_EQ(cache.last_frame_stats().hits, 1u);
+    EXPECT_EQ(cache.stats().misses, 2u);
+
+    cache.end_frame();
+    cache.end_frame();
+    EXPECT_EQ(cache.size(), 0u);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.render;
+
+using namespace epix::render;
+
+TEST(PipelineManifest, RecordKeepsFirstUseOrderAndIgnoresDuplicates) {
+    PipelineManifest manifest;
+    EXPECT_TRUE(manifest.record("sprite", "b"));
+    EXPECT_TRUE(manifest.record("mesh2d", "a"));
+    EXPECT_FALSE(manifest.record("sprite", "b"));
+    ASSERT_EQ(manifest.size(), 2u);
+    EXPECT_EQ(manifest.entries()[0], (PipelineManifestEntry{"sprite", "b"}));
+    EXPECT_EQ(manifest.entries()[1], (PipelineManifestEntry{"mesh2d", "a"}));
+    EXPECT_TRUE(manifest.contains("mesh2d", "a"));
+    EXPECT_FALSE(manifest.contains("mesh2d", "b"));
+}
+
+TEST(PipelineManifest, RecordRejectsTabsAndLineBreaks) {
+    PipelineManifest manifest;
+    EXPECT_FALSE(manifest.record("", "key"));
+    EXPECT_FALSE(manifest.record("sprite", "a\tb"));
+    EXPECT_FALSE(manifest.record("sprite", "a\nb"));
+    EXPECT_FALSE(manifest.record("spr\rite", "key"));
+    EXPECT_TRUE(manifest.empty());
+}
+
+TEST(PipelineManifest, SerializeParseRoundTrip) {
+    PipelineManifest manifest;
+    manifest.record("sprite", "23 0");
+    manifest.record("mesh2d", "23 1 0 3 0:31:position");
+    auto parsed = PipelineManifest::parse(manifest.serialize());
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->entries(), manifest.entries());
+}
+
+TEST(PipelineManifest, ParseEmptyManifest) {
+    auto parsed = PipelineManifest::parse(PipelineManifest{}.serialize());
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_TRUE(parsed->empty());
+}
+
+TEST(PipelineManifest, ParseToleratesCrlfAndBlankLines) {
+    auto parsed = PipelineManifest::parse("epix-pipeline-manifest 1\r\nsprite\ta\r\n\r\nmesh2d\tb c\r\n");
+    ASSERT_TRUE(parsed.has_value());
+    ASSERT_EQ(parsed->size(), 2u);
+    EXPECT_EQ(parsed->entries()[0], (PipelineManifestEntry{"sprite", "a"}));
+    EXPECT_EQ(parsed->entries()[1], (PipelineManifestEntry{"mesh2d", "b c"}));
+}
+
+TEST(PipelineManifest, ParseRejectsMissingOrWrongHeader) {
+    EXPECT_EQ(PipelineManifest::parse("").error(), PipelineManifestError::BadHeader);
+    EXPECT_EQ(PipelineManifest::parse("sprite\ta\n").error(), PipelineManifestError::BadHeader);
+    EXPECT_EQ(PipelineManifest::parse("epix-pipeline-manifest 0\nsprite\ta\n").error(),
+              PipelineManifestError::BadHeader);
+    EXPECT_EQ(PipelineManifest::parse("epix-pipeline-manifest 2\nsprite\ta\n").error(),
+              PipelineManifestError::BadHeader);
+}
+
+TEST(PipelineManifest, ParseRejectsLinesWithoutSpecializer) {
+    EXPECT_EQ(PipelineManifest::parse("epix-pipeline-manifest 1\nsprite a\n").error(),
+              PipelineManifestError::BadEntry);
+    EXPECT_EQ(PipelineManifest::parse("epix-pipeline-manifest 1\n\ta\n").error(), PipelineManifestError::BadEntry);
+}
+
+TEST(PipelineManifest, MergeAppendsNewEntriesAfterExisting) {
+    PipelineManifest current;
+    current.record("sprite", "a");
+    PipelineManifest earlier;
+    earlier.record("mesh2d", "b");
+    earlier.record("sprite", "a");
+    current.merge(earlier);
+    ASSERT_EQ(current.size(), 2u);
+    EXPECT_EQ(current.entries()[0], (PipelineManifestEntry{"sprite", "a"}));
+    EXPECT_EQ(current.entries()[1], (PipelineManifestEntry{"mesh2d", "b"}));
+}
+
+TEST(PipelineManifest, EraseRemovesEntry) {
+    PipelineManifest manifest;
+    manifest.record("sprite", "a");
+    manifest.record("sprite", "b");
+    EXPECT_TRUE(manifest.erase("sprite", "a"));
+    EXPECT_FALSE(manifest.erase("sprite", "a"));
+    EXPECT_FALSE(manifest.contains("sprite", "a"));
+    ASSERT_EQ(manifest.size(), 1u);
+    EXPECT_EQ(manifest.entries()[0], (PipelineManifestEntry{"sprite", "b"}));
+    EXPECT_TRUE(manifest.record("sprite", "a"));
+}
+
+TEST(PipelineManifest, EscapeFieldRoundTrip) {
+    std::string name = "uv 0,set:1%\tx";
+    auto escaped     = PipelineManifest::escape_field(name, " ,:");
+    EXPECT_EQ(escaped.find_first_of(" ,:\t"), std::string::npos);
+    EXPECT_EQ(PipelineManifest::unescape_field(escaped), name);
+    EXPECT_EQ(PipelineManifest::escape_field("position", " ,:"), "position");
+}
+
+TEST(PipelineManifest, UnescapeRejectsMalformedEscapes) {
+    EXPECT_FALSE(PipelineManifest::unescape_field("a%").has_value());
+    EXPECT_FALSE(PipelineManifest::unescape_field("a%2").has_value());
+    EXPECT_FALSE(PipelineManifest::unescape_field("a%zz").has_value());
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+import std;
+import webgpu;
+import epix.assets;
+import epix.shader;
+import epix.render;
+
+using namespace epix;
+using namespace epix::render;
+
+namespace {
+/** @brief Stands in for PipelineServer, handing out ids in queue order. */
+struct FakeServer {
+    mutable std::vector<RenderPipelineDescriptor> queued;
+
+    shader::CachedPipelineId queue_render_pipeline(RenderPipelineDescriptor descriptor) const {
+        queued.push_back(std::move(descriptor));
+        return shader::CachedPipelineId(queued.size() - 1);
+    }
+};
+
+/** @brief Descriptor whose structure is set by `samples` alone. */
+RenderPipelineDescriptor descriptor_with_samples(std::uint32_t samples) {
+    RenderPipelineDescriptor descriptor{
+        .vertex = VertexState{.shader = assets::AssetId<shader::Shader>::invalid()},
+    };
+    descriptor.multisample.count = samples;
+    return descriptor;
+}
+
+/** @brief Sends every key to the same slot, so lookups must probe. */
+struct CollidingHash {
+    std::size_t operator()(int) const { return 0; }
+};
+}  // namespace
+
+TEST(SpecializedPipelines, KnownKeyIsNotBuiltAgain) {
+    FakeServer server;
+    SpecializedPipelines<int> pipelines;
+    int built = 0;
+    auto make = [&](int key) {
+        built++;
+        return descriptor_with_samples(static_cast<std::uint32_t>(key));
+    };
+
+    auto [first, first_new] = pipelines.specialize(server, 1, make);
+    auto [again, again_new] = pipelines.specialize(server, 1, make);
+    EXPECT_TRUE(first_new);
+    EXPECT_FALSE(again_new);
+    EXPECT_EQ(first, again);
+    EXPECT_EQ(built, 1);
+    EXPECT_EQ(server.queued.size(), 1u);
+    EXPECT_EQ(pipelines.get(1), first);
+    EXPECT_FALSE(pipelines.get(2).has_value());
+}
+
+TEST(SpecializedPipelines, CollidingKeysStayDistinct) {
+    FakeServer server;
+    SpecializedPipelines<int, CollidingHash> pipelines;
+    auto make = [](int key) { return descriptor_with_samples(static_cast<std::uint32_t>(key)); };
+    std::vector<shader::CachedPipelineId> ids;
+    for (int key = 0; key < 5; key++) {
+        auto [id, added] = pipelines.specialize(server, key, make);
+        EXPECT_TRUE(added);
+        ids.push_back(id);
+    }
+    EXPECT_EQ(pipelines.size(), 5u);
+    EXPECT_EQ(pipelines.pipeline_count(), 5u);
+    for (int key = 0; key < 5; key++) EXPECT_EQ(pipelines.get(key), ids[key]);
+    EXPECT_FALSE(pipelines.get(5).has_value());
+}
+
+TEST(SpecializedPipelines, GrowingKeepsEveryKey) {
+    FakeServer server;
+    SpecializedPipelines<int> pipelines;
+    // well past the 3/4 load factor of the first tables, so the table grows several times.
+    constexpr int count = 100;
+    auto make           = [](int key) { return descriptor_with_samples(static_cast<std::uint32_t>(key)); };
+    std::vector<shader::CachedPipelineId> ids;
+    for (int key = 0; key < count; key++) ids.push_back(pipelines.specialize(server, key, make).first);
+    EXPECT_EQ(pipelines.size(), static_cast<std::size_t>(count));
+    for (int key = 0; key < count; key++) {
+        EXPECT_EQ(pipelines.get(key), ids[key]);
+        EXPECT_FALSE(pipelines.specialize(server, key, [](int) -> RenderPipelineDescriptor {
+            ADD_FAILURE() << "descriptor built for a known key";
+            return descriptor_with_samples(1);
+        }).second);
+    }
+    EXPECT_EQ(server.queued.size(), static_cast<std::size_t>(count));
+}
+
+TEST(SpecializedPipelines, KeysWithEqualDescriptorsSharePipeline) {
+    FakeServer server;
+    SpecializedPipelines<int> pipelines;
+    // keys 1 and 2 build the same structure under different labels.
+    auto make = [](int key) {
+        auto descriptor  = descriptor_with_samples(key == 3 ? 4 : 1);
+        descriptor.label = std::format("pipeline {}", key);
+        return descriptor;
+    };
+
+    auto [one, one_new] = pipelines.specialize(server, 1, make);
+    auto [two, two_new] = pipelines.specialize(server, 2, make);
+    auto [three, _]     = pipelines.specialize(server, 3, make);
+    EXPECT_TRUE(one_new);
+    EXPECT_TRUE(two_new);
+    EXPECT_EQ(one, two);
+    EXPECT_NE(one, three);
+    EXPECT_EQ(pipelines.size(), 3u);
+    EXPECT_EQ(pipelines.pipeline_count(), 2u);
+    EXPECT_EQ(server.queued.size(), 2u);
+}
+
+TEST(StructuralKey, IgnoresLabelOnly) {
+    auto a  = descriptor_with_samples(1);
+    auto b  = descriptor_with_samples(1);
+    b.label = "other";
+    EXPECT_EQ(structural_key(a), structural_key(b));
+    EXPECT_NE(structural_key(a), structural_key(descriptor_with_samples(4)));
+}
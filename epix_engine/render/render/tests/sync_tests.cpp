@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.core;
+import epix.render;
+
+using namespace epix::core;
+using namespace epix::render;
+
+namespace {
+struct Source {
+    int value = 0;
+};
+struct Mirror {
+    int value  = 0;
+    int writes = 0;
+};
+struct SyncTestSubApp {};
+struct SyncTestScheduleT {
+} SyncTestSchedule;
+
+/** @brief Extracts `Source` the way retained extraction systems do: spawn once, update only when changed. */
+void extract_sources(Commands cmd,
+                     Extract<Query<Item<Entity, Ref<Source>>>> sources,
+                     Query<Item<Mirror&>, With<RetainedRenderEntity>> mirrors,
+                     ResMut<RetainedEntities<Source>> retained,
+                     ResMut<FrameArena> arena) {
+    retained->begin();
+    for (auto&& [entity, source] : sources.iter()) {
+        auto entry = retained->touch(entity);
+        if (!entry) {
+            auto render_entity =
+                cmd.spawn(Mirror{.value = source->value, .writes = 1}, MainEntity{entity}, RetainedRenderEntity{})
+                    .id();
+            retained->insert(entity, render_entity);
+        } else if (source.is_modified()) {
+            if (auto target = mirrors.get(entry->get().render_entity)) {
+                auto&& [mirror] = *target;
+                mirror.value    = source->value;
+                mirror.writes++;
+            }
+        }
+    }
+    retained->end(cmd, *arena);
+}
+
+struct SyncTest : ::testing::Test {
+    App app         = App::create();
+    App& render_app = app.sub_app_or_insert(AppLabel::from_type<SyncTestSubApp>());
+
+    SyncTest() {
+        render_app.add_schedule(Schedule(SyncTestSchedule))
+            .set_extract_fn([](App& sub, World&) { sub.run_schedule(SyncTestSchedule); });
+        render_app.world_mut().init_resource<RetainedEntities<Source>>();
+        render_app.world_mut().init_resource<FrameArena>();
+        render_app.add_systems(SyncTestSchedule, into(extract_sources));
+    }
+
+    std::vector<Mirror> mirrors() {
+        auto& world = render_app.world_mut();
+        std::vector<Mirror> result;
+        for (auto&& [mirror] : world.query<Item<const Mirror&>>().iter(world)) result.push_back(mirror);
+        return result;
+    }
+    Entity render_entity_of(Entity source) {
+        for (auto& entry : render_app.world().resource<RetainedEntities<Source>>().iter()) {
+            if (entry.source == source) return entry.render_entity;
+        }
+        ADD_FAILURE() << "no render entity retained for the source";
+        return source;
+    }
+};
+}  // namespace
+
+TEST_F(SyncTest, RetainedEntityIsSpawnedOnce) {
+    auto source = app.world_mut().spawn(Source{.value = 1}).id();
+    render_app.extract(app);
+    auto render_entity = render_entity_of(source);
+    render_app.extract(app);
+    render_app.extract(app);
+
+    auto extracted = mirrors();
+    ASSERT_EQ(extracted.size(), 1u);
+    EXPECT_EQ(extracted[0].value, 1);
+    EXPECT_EQ(extracted[0].writes, 1);
+    EXPECT_EQ(render_app.world().resource<RetainedEntities<Source>>().size(), 1u);
+    EXPECT_EQ(render_entity_of(source), render_entity);
+}
+
+TEST_F(SyncTest, RetainedEntityIsUpdatedInPlaceOnlyWhenChanged) {
+    auto source = app.world_mut().spawn(Source{.value = 1}).id();
+    render_app.extract(app);
+    auto render_entity = render_entity_of(source);
+
+    app.world_mut().entity_mut(source).get_mut<Source>().value().get_mut().value = 2;
+    render_app.extract(app);
+    render_app.extract(app);
+
+    auto extracted = mirrors();
+    ASSERT_EQ(extracted.size(), 1u);
+    EXPECT_EQ(extracted[0].value, 2);
+    EXPECT_EQ(extracted[0].writes, 2);
+    EXPECT_EQ(render_entity_of(source), render_entity);
+}
+
+TEST_F(SyncTest, RetainedEntityIsDespawnedWithItsSource) {
+    auto kept    = app.world_mut().spawn(Source{.value = 1}).id();
+    auto dropped = app.world_mut().spawn(Source{.value = 2}).id();
+    render_app.extract(app);
+    ASSERT_EQ(mirrors().size(), 2u);
+    auto dropped_render_entity = render_entity_of(dropped);
+
+    app.world_mut().entity_mut(dropped).despawn();
+    render_app.extract(app);
+
+    auto extracted = mirrors();
+    ASSERT_EQ(extracted.size(), 1u);
+    EXPECT_EQ(extracted[0].value, 1);
+    EXPECT_EQ(render_app.world().resource<RetainedEntities<Source>>().size(), 1u);
+    EXPECT_FALSE(render_app.world().get_entity(dropped_render_entity).has_value());
+    render_entity_of(kept);
+}
+
+TEST_F(SyncTest, ClearKeepsRetainedEntitiesOnly) {
+    app.world_mut().spawn(Source{.value = 1});
+    render_app.extract(app);
+    auto temporary = render_app.world_mut().spawn(Mirror{.value = 5}).id();
+
+    clear_render_entities(render_app.world_mut());
+    EXPECT_FALSE(render_app.world().get_entity(temporary).has_value());
+    auto extracted = mirrors();
+    ASSERT_EQ(extracted.size(), 1u);
+    EXPECT_EQ(extracted[0].value, 1);
+}
+
+TEST(FrameArena, ResetReleasesFrameAllocations) {
+    FrameArena arena(4096);
+    // without the reset, the second frame would overflow the owned buffer.
+    for (int frame = 0; frame < 2; frame++) {
+        auto bytes = arena.make_vector<std::byte>();
+        bytes.reserve(3000);
+        EXPECT_EQ(arena.overflow_bytes(), 0u);
+        arena.reset();
+    }
+    EXPECT_EQ(arena.capacity(), 4096u);
+}
+
+TEST(FrameArena, ResetGrowsToTheOverflowingFrame) {
+    FrameArena arena(4096);
+    {
+        auto bytes = arena.make_vector<std::byte>();
+        bytes.reserve(8192);
+        EXPECT_GT(arena.overflow_bytes(), 0u);
+    }
+    arena.reset();
+    EXPECT_GE(arena.capacity(), 4096u + 8192u);
+    EXPECT_EQ(arena.overflow_bytes(), 0u);
+
+    auto bytes = arena.make_vector<std::byte>();
+    bytes.reserve(8192);
+    EXPECT_EQ(arena.overflow_bytes(), 0u);
+}
+
+TEST(FrameArena, ClearRenderEntitiesResetsTheArena) {
+    World world(0);
+    world.init_resource<FrameArena>();
+    {
+        auto& arena = world.resource_mut<FrameArena>();
+        auto bytes  = arena.make_vector<std::byte>();
+        bytes.reserve(arena.capacity() * 2);
+        EXPECT_GT(arena.overflow_bytes(), 0u);
+    }
+    clear_render_entities(world);
+    EXPECT_EQ(world.resource<FrameArena>().overflow_bytes(), 0u);
+}
@@ -2,4 +2,5 @@
 
 export import :shader;
 export import :shader_composer;
+export import :shader_disk_cache;
 export import :shader_cache;
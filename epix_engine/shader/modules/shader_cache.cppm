@@ -6,6 +6,7 @@ import epix.core;
 import epix.utils;
 import :shader;
 import :shader_composer;
+import :shader_disk_cache;
 
 namespace epix::shader {
 
@@ -40,6 +41,15 @@ export struct ShaderData {
     std::unordered_map<ShaderImport, assets::AssetId<Shader>> resolved_imports;
     /** @brief Shaders that depend on this shader. */
     std::unordered_set<assets::AssetId<Shader>> dependents;
+    /** @brief Hash of the shader's path, source and default definitions, for `ShaderDiskCache` keys. */
+    assets::AssetHash content_hash{};
+    /** @brief Like `content_hash`, but with comments and whitespace stripped from text sources, so edits
+     *  that leave every token in place keep the compiled variants. */
+    assets::AssetHash token_hash{};
+    /** @brief Pipelines using each variant, so a change only rebuilds the pipelines of variants it alters. */
+    std::unordered_map<std::vector<ShaderDefVal>, std::unordered_set<CachedPipelineId>> variant_pipelines;
+    /** @brief Token hash of each WGSL variant's composed source, compared after a change to an import. */
+    std::unordered_map<std::vector<ShaderDefVal>, assets::AssetHash> variant_hashes;
 };
 
 /** @brief Source payload passed to the backend shader-module loader. */
@@ -159,17 +169,61 @@ export struct ShaderCacheError {
     }
 };
 
+/** @brief A shader variant requested from `ShaderCache::request`, possibly still to be built.
+ *
+ * Requests for a variant that is already being built share its result. The
+ * request that started the build runs it in `wait()`, so call `wait()` without
+ * holding any lock on the cache: variants requested from different threads then
+ * compile concurrently. Dropping that request without waiting runs the build in
+ * the destructor, so the requests sharing it still finish.
+ */
+export struct PendingShaderModule {
+    using Result = std::expected<std::shared_ptr<wgpu::ShaderModule>, ShaderCacheError>;
+
+    PendingShaderModule(PendingShaderModule&&) noexcept            = default;
+    PendingShaderModule& operator=(PendingShaderModule&&) noexcept = delete;
+    ~PendingShaderModule() {
+        if (task_) (*task_)();
+    }
+
+    /** @brief Build the variant if this request started it, then wait for the result. */
+    Result wait() {
+        if (auto task = std::move(task_)) (*task)();
+        return result_.get();
+    }
+    /** @brief Returns `true` if this request started the build, so `wait()` runs it. */
+    bool builds() const { return task_ != nullptr; }
+
+   private:
+    friend struct ShaderCache;
+
+    PendingShaderModule(std::shared_future<Result> result, std::unique_ptr<std::packaged_task<Result()>> task)
+        : result_(std::move(result)), task_(std::move(task)) {}
+    static PendingShaderModule ready(Result result) {
+        std::promise<Result> promise;
+        promise.set_value(std::move(result));
+        return PendingShaderModule(promise.get_future().share(), nullptr);
+    }
+
+    std::shared_future<Result> result_;
+    std::unique_ptr<std::packaged_task<Result()>> task_;
+};
+
 /** @brief Runtime cache for resolved and compiled shaders.
  *
  * Typical flow:
  *
  * - call `set_shader(...)` when a shader asset is loaded or changed,
- * - call `get(...)` when a pipeline needs a compiled shader variant,
+ * - call `get(...)` when a pipeline needs a compiled shader variant, or
+ *   `request(...)` to build it after releasing the lock guarding the cache,
  * - call `remove(...)` or `sync(...)` when assets are removed or events arrive.
  *
  * `ShaderCache` resolves recursive imports, composes WGSL, compiles Slang,
  * caches compiled modules by definition set, and tells you which pipelines need
  * to rebuild when something changes.
+ *
+ * With a `ShaderDiskCache` set, composed WGSL and Slang-compiled SPIR-V are also
+ * kept on disk, so later runs create modules without compiling again.
  */
 export struct ShaderCache {
     /** @brief Callback that turns final WGSL or SPIR-V into a backend shader module. */
@@ -192,11 +246,38 @@ export struct ShaderCache {
     std::expected<std::shared_ptr<wgpu::ShaderModule>, ShaderCacheError> get(CachedPipelineId pipeline,
                                                                              assets::AssetId<Shader> id,
                                                                              std::span<const ShaderDefVal> shader_defs);
+    /** @brief Like `get`, but leave the expensive part of the build to `PendingShaderModule::wait()`.
+     *
+     * Import resolution and WGSL composition happen here. Slang compilation,
+     * the disk cache lookup of Slang variants and backend module creation happen
+     * in `wait()`, which is safe to call after releasing the lock guarding this
+     * cache, since it does not touch the cache. WGSL variants are looked up on
+     * disk here, under the lock: composing them on a miss needs the composer,
+     * and the lookup only maps the entry. Requests for a variant already being
+     * built share that build. Finished builds are cached by the next `request`
+     * or `get`.
+     *
+     * A request that started a build and is dropped without `wait()` still
+     * builds, synchronously, in its destructor on the dropping thread, because
+     * other requests may share the build. That includes early returns between
+     * `request` and `wait()`; drop requests only where a compile may block,
+     * such as a task pool thread, and never while holding the cache's lock.
+     */
+    PendingShaderModule request(CachedPipelineId pipeline,
+                                assets::AssetId<Shader> id,
+                                std::span<const ShaderDefVal> shader_defs);
 
     /** @brief Insert or replace one shader in the cache.
      *
      * This updates import resolution, clears stale compiled variants, and
      * returns pipeline ids that should rebuild.
+     *
+     * Only variants the change alters are rebuilt. An edit that leaves every
+     * token of the shader in place, such as a comment or formatting change,
+     * keeps all its variants. Otherwise each cached WGSL variant of the shader
+     * and of its dependents is composed again, and kept when its composed
+     * tokens are unchanged, for example when the edit is inside a `#ifdef`
+     * block the variant does not enable.
      */
     std::vector<CachedPipelineId> set_shader(assets::AssetId<Shader> id, Shader shader);
     /** @brief Remove one shader from the cache and return affected pipelines. */
@@ -212,9 +293,17 @@ export struct ShaderCache {
     std::vector<CachedPipelineId> sync(utils::input_iterable<assets::AssetEvent<Shader>> events,
                                        const assets::Assets<Shader>& shaders);
 
+    /** @brief Keep compiled variants in `disk_cache` across runs, or stop with `nullptr`. */
+    void set_disk_cache(std::shared_ptr<ShaderDiskCache> disk_cache) { disk_cache_ = std::move(disk_cache); }
+    const std::shared_ptr<ShaderDiskCache>& disk_cache() const { return disk_cache_; }
+
    private:
     wgpu::Device device_;
     std::unordered_map<assets::AssetId<Shader>, ShaderData> data_;
+    // Variants being built, by definition set; moved to ShaderData::processed_shaders once done.
+    std::unordered_map<assets::AssetId<Shader>,
+                       std::unordered_map<std::vector<ShaderDefVal>, std::shared_future<PendingShaderModule::Result>>>
+        building_;
     LoadModuleFn load_module_;
     std::unordered_map<assets::AssetId<Shader>, Shader> shaders_;
     std::unordered_map<ShaderImport, assets::AssetId<Shader>> import_path_shaders_;
@@ -223,8 +312,29 @@ export struct ShaderCache {
 
     struct SlangCompiler;
     std::shared_ptr<SlangCompiler> slang_;
+    std::shared_ptr<ShaderDiskCache> disk_cache_;
+
+    // A compiled variant set aside by clear(), kept if composing it again gives the same tokens.
+    struct StaleVariant {
+        assets::AssetId<Shader> id;
+        std::vector<ShaderDefVal> defs;
+        std::shared_ptr<wgpu::ShaderModule> module;
+    };
 
-    std::vector<CachedPipelineId> clear(assets::AssetId<Shader> id);
+    // Drop the variants of `id` and its dependents, returning their pipelines. With `stale`, variants with
+    // a composed hash are moved there instead, and their pipelines are left to revalidate().
+    std::vector<CachedPipelineId> clear(assets::AssetId<Shader> id, std::vector<StaleVariant>* stale = nullptr);
+    // Restore the stale variants whose composed tokens are unchanged, adding the pipelines of the others.
+    void revalidate(std::vector<StaleVariant> stale, std::unordered_set<CachedPipelineId>& affected);
+    // Token hash of a WGSL variant composed from the current sources, or nullopt if it cannot be composed.
+    std::optional<assets::AssetHash> composed_hash(assets::AssetId<Shader> id,
+                                                   std::span<const ShaderDefVal> merged_defs);
+    // Move finished builds of `id` into processed_shaders, dropping failed ones.
+    void collect_built(assets::AssetId<Shader> id);
+    // Key of a compiled variant in disk_cache_, or nullopt when it is not disk cached.
+    std::optional<assets::AssetHash> disk_cache_key(assets::AssetId<Shader> id,
+                                                    const Shader& shader,
+                                                    std::span<const ShaderDefVal> shader_defs) const;
 
     // Register/unregister the secondary import name (asset path from file path)
     // when it differs from the primary import_path.
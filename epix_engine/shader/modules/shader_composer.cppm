@@ -35,8 +35,24 @@ export struct ComposeError {
  *   active definitions contain `USE_FOG`.
  *
  * This is only for WGSL. Slang uses its own import system.
+ *
+ * Sources are tokenized once into conditional blocks when a module is added,
+ * and each module's expansion is memoized by the values of the definitions it
+ * and its imports can read, so variants that differ only in other definitions
+ * reuse it. Adding or removing a module drops the expansions of every module
+ * that imports it.
  */
 export struct ShaderComposer {
+    /** @brief Counters of the expansion memo, for diagnostics and tests. */
+    struct Stats {
+        /** @brief Module expansions reused from the memo. */
+        std::size_t fragment_hits = 0;
+        /** @brief Module expansions computed and stored. */
+        std::size_t fragment_misses = 0;
+        /** @brief Sources tokenized, modules and roots together. */
+        std::size_t parses = 0;
+    };
+
     /** @brief Register one WGSL module.
      *
      * `module_name` must match what appears in source, for example
@@ -61,37 +77,62 @@ export struct ShaderComposer {
      * This expands all `#import ...` directives and evaluates simple
      * conditionals like `#ifdef`, `#ifndef`, `#if`, `#else`, and `#endif`.
      * The returned string is the final WGSL text ready to pass to shader
-     * module creation.
+     * module creation. The tokenized `source` is kept per `file_path` and
+     * reused while the source is unchanged.
      */
     std::expected<std::string, ComposeError> compose(std::string_view source,
                                                      std::string_view file_path,
                                                      std::span<const ShaderDefVal> additional_defs);
 
+    Stats stats() const { return stats_; }
+
    private:
+    // Tokenized source: text runs, imports and conditional blocks. Defined in shader_composer.cpp.
+    struct ParsedSource;
+    // Definitions by name, sorted, for binary search.
+    using DefList = std::vector<const ShaderDefVal*>;
+
+    // Expansion of one module, with every module inlined into it for cycle checks on reuse.
+    struct Fragment {
+        std::string text;
+        std::vector<std::string> modules;
+    };
     struct ModuleEntry {
         std::string source;                   // original source (with directives)
         std::vector<ShaderDefVal> base_defs;  // the module's own always-active defs
+        std::shared_ptr<const ParsedSource> parsed;
+        // Names of the defs this module and its imports read, sorted; reset when an import changes.
+        std::optional<std::vector<std::string>> referenced_defs;
+        // Expansions by the values of referenced_defs.
+        std::unordered_map<std::string, Fragment> fragments;
     };
 
     std::unordered_map<std::string, ModuleEntry> modules_;
+    // Tokenized root sources by file path.
+    std::unordered_map<std::string, std::shared_ptr<const ParsedSource>> roots_;
+    Stats stats_;
+
+    // Build a sorted name→value lookup for evaluating conditions. Later defs win on collision.
+    static DefList build_def_list(std::span<const ShaderDefVal> defs);
+
+    // Drop the memoized expansions of `module_name` and of every module importing it.
+    void invalidate(const std::string& module_name);
+    const std::vector<std::string>& referenced_defs(const std::string& module_name,
+                                                    std::vector<std::string>& visiting);
 
-    // Build a name→value lookup for quick evaluation of #ifdef conditions.
-    static std::unordered_map<std::string, const ShaderDefVal*> build_def_map(std::span<const ShaderDefVal> a,
-                                                                              std::span<const ShaderDefVal> b = {});
-
-    // Evaluate a single #if / #ifdef / #ifndef condition against defs.
-    // Returns true if the block should be included.
-    static bool eval_condition(std::string_view directive,
-                               std::string_view expr,
-                               const std::unordered_map<std::string, const ShaderDefVal*>& defs);
-
-    // Internal recursive compose.
-    // visiting: set of module names currently being inlined (cycle detection).
-    std::expected<std::string, ComposeError> compose_internal(
-        std::string_view source,
-        std::string_view context_name,
-        const std::unordered_map<std::string, const ShaderDefVal*>& defs,
-        std::vector<std::string>& visiting);
+    // Expand the nodes of a parsed source into `out`.
+    // visiting: module names currently being inlined (cycle detection).
+    std::expected<void, ComposeError> expand(const ParsedSource& parsed,
+                                             std::string_view context_name,
+                                             const DefList& defs,
+                                             std::vector<std::string>& visiting,
+                                             Fragment& out);
+    // Inline one imported module into `out`, through the memo.
+    std::expected<void, ComposeError> expand_import(const std::string& module_name,
+                                                    std::string_view context_name,
+                                                    const DefList& defs,
+                                                    std::vector<std::string>& visiting,
+                                                    Fragment& out);
 };
 
 }  // namespace epix::shader
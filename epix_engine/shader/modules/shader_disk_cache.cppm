@@ -0,0 +1,94 @@
+module;
+
+export module epix.shader:shader_disk_cache;
+
+import epix.assets;
+import std;
+
+import :shader;
+
+namespace epix::shader {
+
+/** @brief Default size limit of a ShaderDiskCache, 256 MiB. */
+export inline constexpr std::uint64_t DEFAULT_SHADER_DISK_CACHE_SIZE = std::uint64_t{256} << 20;
+
+/** @brief Kind of artifact stored in a ShaderDiskCache entry. */
+export enum class ShaderArtifactKind : std::uint8_t {
+    SpirV,
+    Wgsl,
+};
+
+/** @brief A persistent cache of compiled shader variants, so later runs skip Slang compilation and WGSL
+ *  composition for shaders that did not change.
+ *
+ *  Entries are keyed by a hash `ShaderCache` computes over the source of the shader and of its
+ *  transitive imports, the sorted shader defs, the target and the Slang version; see `ShaderDiskCacheKey`.
+ *  A changed input yields a different key, so stale entries are never found and only age out through
+ *  `collect_garbage`.
+ *
+ *  Each entry is one file in an assets::DiskCacheStore under `root`, with a small header checked on read;
+ *  entries that fail the check are removed. Thread-safe. */
+export struct ShaderDiskCache {
+    /** @brief A cached compiled shader. */
+    struct Artifact {
+        ShaderArtifactKind kind;
+        /** @brief The compiled shader, viewed in place through a read-only mapping of the entry file. */
+        assets::AssetBytes bytes;
+
+        std::span<const std::uint8_t> data() const {
+            return {reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size()};
+        }
+    };
+    using Stats = assets::DiskCacheStats;
+
+   private:
+    assets::DiskCacheStore m_store;
+    assets::FileAssetReader m_reader;
+    std::uint64_t m_max_bytes;
+
+   public:
+    /** @param max_bytes Size `collect_garbage` trims the cache to. */
+    explicit ShaderDiskCache(std::filesystem::path root, std::uint64_t max_bytes = DEFAULT_SHADER_DISK_CACHE_SIZE);
+
+    /** @brief Look up an entry, marking it used for garbage collection. The entry is memory-mapped, not
+     *  copied; while the artifact is held, a store replacing the entry may fail on Windows. */
+    std::optional<Artifact> find(const assets::AssetHash& key);
+    /** @brief Store a compiled shader, replacing an existing entry.
+     *  @return False if the entry could not be written; the cache is left unchanged then. */
+    bool store(const assets::AssetHash& key, ShaderArtifactKind kind, std::span<const std::uint8_t> bytes);
+    /** @brief Remove the least recently used entries until the cache fits `max_bytes`, and any leftover
+     *  of interrupted stores.
+     *  @return The number of bytes removed. */
+    std::uint64_t collect_garbage() { return m_store.collect_garbage(m_max_bytes); }
+    /** @brief Remove every entry. */
+    void clear() { m_store.clear(); }
+
+    Stats stats() const { return m_store.stats(); }
+    const std::filesystem::path& root() const { return m_store.root(); }
+    std::uint64_t max_bytes() const { return m_max_bytes; }
+};
+
+/** @brief Builds the key of a compiled shader variant in a ShaderDiskCache.
+ *
+ *  Every input that changes the compiled output goes in: the target and compiler version, the shader
+ *  defs in name order, and the content hash of each shader the variant is built from. Shaders may be
+ *  added in any order. */
+export struct ShaderDiskCacheKey {
+   private:
+    std::string m_target;
+    std::string m_defs;
+    std::vector<std::pair<std::string, assets::AssetHash>> m_shaders;
+
+   public:
+    /** @param target Output format and profile, such as `spirv_1_3`.
+     *  @param compiler_version Version of the compiler producing the output, empty for none. */
+    ShaderDiskCacheKey(std::string_view target, std::string_view compiler_version);
+
+    /** @brief Set the defs the variant is compiled with. Names must be unique. */
+    ShaderDiskCacheKey& defs(std::span<const ShaderDefVal> defs);
+    /** @brief Add a shader by its canonical path and content hash. */
+    ShaderDiskCacheKey& shader(std::string identity, const assets::AssetHash& content_hash);
+
+    assets::AssetHash hash() const;
+};
+}  // namespace epix::shader
@@ -15,6 +15,8 @@ namespace epix::shader {
 namespace {
 
 constexpr std::string_view k_shader_custom_source = "shader_custom";
+// SPIR-V profile Slang compiles to; part of the disk cache key.
+constexpr std::string_view k_slang_spirv_profile = "spirv_1_3";
 
 std::string normalize_path_string(std::string path) {
     std::ranges::replace(path, '\\', '/');
@@ -244,6 +246,99 @@ std::vector<ShaderImport> missing_imports_for_shader(
     return missing;
 }
 
+std::string shader_hash_header(const Shader& shader) {
+    auto header = std::format("{}\n{}\n", canonical_asset_path_string(shader.path), shader.source.data.index());
+    for (const auto& def : shader.shader_defs) {
+        std::format_to(std::back_inserter(header), "{}:{}={}\n", def.name, def.value.index(), def.value_as_string());
+    }
+    return header;
+}
+
+assets::AssetHash shader_content_hash(const Shader& shader) {
+    auto header  = shader_hash_header(shader);
+    auto payload = std::visit(
+        []<typename T>(const T& source) -> std::span<const std::byte> {
+            if constexpr (requires(const T& s) { s.code; }) {
+                return std::as_bytes(std::span(source.code));
+            } else {
+                return std::as_bytes(std::span(source.bytes));
+            }
+        },
+        shader.source.data);
+    return assets::get_asset_hash(std::as_bytes(std::span(header)), payload);
+}
+
+// WGSL text without comments, blank lines, or indentation, with whitespace runs collapsed, so edits that
+// only touch those compare equal. Line breaks are kept since preprocessor directives are line based.
+std::string strip_wgsl_comments(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    bool in_block_comment = false;
+    bool pending_space    = false;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        char c    = text[i];
+        char next = i + 1 < text.size() ? text[i + 1] : '\0';
+        if (in_block_comment) {
+            if (c == '*' && next == '/') {
+                in_block_comment = false;
+                pending_space    = true;
+                ++i;
+            }
+            continue;
+        }
+        if (c == '/' && next == '*') {
+            in_block_comment = true;
+            ++i;
+            continue;
+        }
+        if (c == '/' && next == '/') {
+            i = text.find('\n', i);
+            if (i == std::string_view::npos) break;
+            c = '\n';
+        }
+        if (c == '\n') {
+            if (!out.empty() && out.back() != '\n') out.push_back('\n');
+            pending_space = false;
+        } else if (c == ' ' || c == '\t' || c == '\r') {
+            pending_space = true;
+        } else {
+            if (pending_space && !out.empty() && out.back() != '\n') out.push_back(' ');
+            pending_space = false;
+            out.push_back(c);
+        }
+    }
+    return out;
+}
+
+assets::AssetHash wgsl_token_hash(std::string_view wgsl) {
+    auto stripped = strip_wgsl_comments(wgsl);
+    return assets::get_asset_hash({}, std::as_bytes(std::span(stripped)));
+}
+
+// Content hash that ignores comments and formatting of WGSL sources. Other sources hash as-is: Slang has
+// string literals a comment marker may appear in.
+assets::AssetHash shader_token_hash(const Shader& shader) {
+    if (!shader.source.is_wgsl()) return shader_content_hash(shader);
+    auto header   = shader_hash_header(shader);
+    auto stripped = strip_wgsl_comments(shader.source.as_str());
+    return assets::get_asset_hash(std::as_bytes(std::span(header)), std::as_bytes(std::span(stripped)));
+}
+
+// Shaders a variant of `root` is built from: the root and its resolved imports, transitively.
+std::vector<assets::AssetId<Shader>> import_closure(
+    const std::unordered_map<assets::AssetId<Shader>, ShaderData>& data, assets::AssetId<Shader> root) {
+    std::vector<assets::AssetId<Shader>> closure{root};
+    std::unordered_set<assets::AssetId<Shader>> visited{root};
+    for (std::size_t i = 0; i < closure.size(); ++i) {
+        auto dit = data.find(closure[i]);
+        if (dit == data.end()) continue;
+        for (const auto& [_, provider_id] : dit->second.resolved_imports) {
+            if (visited.insert(provider_id).second) closure.push_back(provider_id);
+        }
+    }
+    return closure;
+}
+
 // ─── Slang compilation helpers ─────────────────────────────────────────────
 
 std::string format_diagnostics(std::string prefix, slang::IBlob* diagnostics) {
@@ -265,11 +360,13 @@ Slang::ComPtr<ISlangBlob> make_string_blob(std::string_view text) {
 // VFS backed by canonical asset-path strings.  Preprocessing already rewrites
 // every import/module path to its canonical form, so no runtime path resolution
 // is needed — the VFS is a flat string→source map.
+// Shared by concurrent compiles while shaders are set, so every access locks.
 class SlangVFS : public ISlangFileSystemExt {
     struct Entry {
         std::string source;
         std::string identity;  // canonical file path (shared across aliases)
     };
+    mutable std::shared_mutex mutex_;
     std::unordered_map<std::string, Entry> files_;
 
     // Slang may append .slang when resolving imports — fall back to the
@@ -285,12 +382,20 @@ class SlangVFS : public ISlangFileSystemExt {
 
    public:
     void add(const std::string& key, const std::string& source, const std::string& identity) {
+        std::unique_lock lock(mutex_);
         files_.insert_or_assign(key, Entry{source, identity});
     }
 
-    void remove(const std::string& key) { files_.erase(key); }
+    void remove(const std::string& key) {
+        std::unique_lock lock(mutex_);
+        files_.erase(key);
+    }
 
-    const std::string& get_source(const std::string& key) const { return files_.at(key).source; }
+    std::optional<std::string> get_source(const std::string& key) const {
+        std::shared_lock lock(mutex_);
+        auto it = files_.find(key);
+        return it == files_.end() ? std::nullopt : std::optional(it->second.source);
+    }
 
     // ── ISlangUnknown / ISlangCastable ──
     SLANG_NO_THROW SlangResult SLANG_MCALL queryInterface(SlangUUID const& uuid, void** outObject) override {
@@ -314,6 +419,7 @@ class SlangVFS : public ISlangFileSystemExt {
 
     // ── ISlangFileSystem ──
     SLANG_NO_THROW SlangResult SLANG_MCALL loadFile(char const* path, ISlangBlob** outBlob) override {
+        std::shared_lock lock(mutex_);
         auto* entry = find_entry(path);
         if (!entry) {
             *outBlob = nullptr;
@@ -326,6 +432,7 @@ class SlangVFS : public ISlangFileSystemExt {
     // ── ISlangFileSystemExt ──
     SLANG_NO_THROW SlangResult SLANG_MCALL getFileUniqueIdentity(const char* path,
                                                                  ISlangBlob** outUniqueIdentity) override {
+        std::shared_lock lock(mutex_);
         auto* entry = find_entry(path);
         if (!entry) {
             *outUniqueIdentity = nullptr;
@@ -345,6 +452,7 @@ class SlangVFS : public ISlangFileSystemExt {
     }
 
     SLANG_NO_THROW SlangResult SLANG_MCALL getPathType(const char* path, SlangPathType* pathTypeOut) override {
+        std::shared_lock lock(mutex_);
         if (find_entry(path)) {
             *pathTypeOut = SLANG_PATH_TYPE_FILE;
             return SLANG_OK;
@@ -370,18 +478,53 @@ class SlangVFS : public ISlangFileSystemExt {
 
 // ─── SlangCompiler ─────────────────────────────────────────────────────────
 
-struct ShaderCache::SlangCompiler {
-    Slang::ComPtr<slang::IGlobalSession> global_session;
+namespace {
+
+// One registered Slang-family shader, as a compile preloads it into its session.
+struct SlangModuleSource {
+    std::string identity;
+    std::string import_name;
+    // Set for pre-compiled Slang IR shaders, which load from their own bytes.
+    std::optional<std::vector<std::uint8_t>> ir_bytes;
+};
+
+// Everything one Slang compile reads from the ShaderCache, copied under its lock so the
+// compile itself can run on any thread.
+struct SlangCompileJob {
+    Shader root;
+    std::vector<ShaderDefVal> defs;
+    // Modules to preload; the root is excluded unless it is itself an IR module.
+    std::vector<SlangModuleSource> modules;
+};
+
+// What a variant is built from once the ShaderCache lock is released: SPIR-V bytes, composed
+// WGSL, an entry of the disk cache, or a Slang compile still to run.
+using CompileInput = std::variant<std::vector<std::uint8_t>, std::string, SlangCompileJob, ShaderDiskCache::Artifact>;
+
+}  // namespace
 
+// Thread-safe: compiles of independent variants run concurrently, each on a global
+// session of its own, since Slang global sessions may only be used by one thread at a time.
+struct ShaderCache::SlangCompiler {
     SlangCompiler() {
-        if (SLANG_FAILED(slang::createGlobalSession(global_session.writeRef()))) {
+        auto session = create_global_session();
+        if (!session) {
             spdlog::error("[shader.cache] Failed to create Slang global session.");
+            return;
         }
+        version_ = session->getBuildTagString();
+        idle_sessions_.push_back(std::move(session));
     }
 
+    // Build tag of the Slang library, so a Slang upgrade misses every disk cache entry.
+    std::string_view version() const { return version_; }
+
     void invalidate(const assets::AssetPath& path) {
         auto key = canonical_asset_path_string(path);
-        module_ir_cache_.erase(key);
+        {
+            std::lock_guard lock(ir_cache_mutex_);
+            module_ir_cache_.erase(key);
+        }
         vfs_.remove(key);
     }
 
@@ -396,44 +539,47 @@ struct ShaderCache::SlangCompiler {
         if (import_key != identity) vfs_.add(import_key, preprocessed, identity);
     }
 
-    std::expected<std::vector<std::uint8_t>, ShaderCacheError> compile(
-        assets::AssetId<Shader> id,
-        const Shader& shader,
-        std::span<const ShaderDefVal> shader_defs,
-        const std::unordered_map<assets::AssetId<Shader>, Shader>& shaders) {
+    static SlangModuleSource module_source(const Shader& shader) {
+        return SlangModuleSource{
+            .identity    = canonical_asset_path_string(shader.path),
+            .import_name = shader.import_path.is_custom()
+                               ? canonical_asset_path_string(shader_custom_path(shader.import_path.as_custom_path()))
+                               : canonical_asset_path_string(shader.import_path.as_asset_path()),
+            .ir_bytes    = shader.source.is_slang_ir()
+                               ? std::optional(std::get<Source::SlangIr>(shader.source.data).bytes)
+                               : std::nullopt,
+        };
+    }
+
+    // Compile a Slang text root, or a SlangIr root as processed .slang assets may carry, to SPIR-V.
+    std::expected<std::vector<std::uint8_t>, ShaderCacheError> compile(const SlangCompileJob& job) {
         using Stage = ShaderCacheError::SlangCompileError::Stage;
 
-        if (!global_session) {
+        SessionLease lease{*this, acquire_global_session()};
+        if (!lease.session) {
             return std::unexpected(
                 ShaderCacheError::slang_error(Stage::SessionCreation, "Slang global session not available"));
         }
+        auto& global_session = lease.session;
+        const Shader& shader = job.root;
+        const bool ir_root   = shader.source.is_slang_ir();
 
         auto root_path = canonical_asset_path_string(shader.path);
-        // Use the pre-cached preprocessed source (computed at set_shader time);
-        // fall back to computing it here if somehow absent.
-        const std::string* preprocessed_ptr = nullptr;
-        std::string preprocessed_fallback;
-        try {
-            preprocessed_ptr = &vfs_.get_source(root_path);
-        } catch (const std::out_of_range&) {
-            preprocessed_fallback = preprocess_slang_compile_source(shader.source.as_str(), shader.path);
-            preprocessed_ptr      = &preprocessed_fallback;
-        }
-        auto defs_key = defs_cache_key(shader_defs);
+        auto defs_key  = defs_cache_key(job.defs);
 
         // Session-level preprocessor macros.
         std::vector<std::string> def_values;
         std::vector<slang::PreprocessorMacroDesc> macros;
-        def_values.reserve(shader_defs.size());
-        macros.reserve(shader_defs.size());
-        for (const auto& def : shader_defs) {
+        def_values.reserve(job.defs.size());
+        macros.reserve(job.defs.size());
+        for (const auto& def : job.defs) {
             def_values.push_back(def.value_as_string());
             macros.push_back({def.name.c_str(), def_values.back().c_str()});
         }
 
         slang::TargetDesc target_desc = {};
         target_desc.format            = SLANG_SPIRV;
-        target_desc.profile           = global_session->findProfile("spirv_1_3");
+        target_desc.profile           = global_session->findProfile(k_slang_spirv_profile.data());
         target_desc.flags             = SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY;
 
         const char* search_paths[]                     = {""};
@@ -461,20 +607,34 @@ struct ShaderCache::SlangCompiler {
         }
 
         // Pre-load cached dependency modules from serialized IR blobs.
-        // Do not preload the root itself; it is loaded explicitly below as the
-        // compile target and double-loading the same identity can trip Slang's
-        // internal dictionary asserts.
-        std::unordered_map<assets::AssetId<Shader>, Shader> deps_only = shaders;
-        deps_only.erase(id);
-        preload_cached_modules(session.get(), defs_key, deps_only);
-
-        // Load root module from preprocessed source.
+        // A text root is not among the job's modules: it is loaded explicitly
+        // below as the compile target and double-loading the same identity can
+        // trip Slang's internal dictionary asserts.
+        preload_cached_modules(session.get(), defs_key, job.modules);
+
         Slang::ComPtr<slang::IBlob> diagnostics;
-        slang::IModule* mod = session->loadModuleFromSourceString("shader", root_path.c_str(),
-                                                                  preprocessed_ptr->c_str(), diagnostics.writeRef());
-        if (!mod) {
-            return std::unexpected(ShaderCacheError::slang_error(
-                Stage::ModuleLoad, format_diagnostics("Slang compilation failed", diagnostics.get())));
+        slang::IModule* mod = nullptr;
+        if (ir_root) {
+            const auto& ir_bytes = std::get<Source::SlangIr>(shader.source.data).bytes;
+            Slang::ComPtr<ISlangBlob> ir_blob;
+            ir_blob.attach(slang_createBlob(ir_bytes.data(), ir_bytes.size()));
+            mod = session->loadModuleFromIRBlob(root_path.c_str(), root_path.c_str(), ir_blob.get(),
+                                                diagnostics.writeRef());
+            if (!mod) {
+                return std::unexpected(ShaderCacheError::slang_error(
+                    Stage::ModuleLoad, format_diagnostics("Slang IR root load failed", diagnostics.get())));
+            }
+        } else {
+            // Use the pre-cached preprocessed source (computed at set_shader time);
+            // fall back to computing it here if somehow absent.
+            auto preprocessed = vfs_.get_source(root_path);
+            if (!preprocessed) preprocessed = preprocess_slang_compile_source(shader.source.as_str(), shader.path);
+            mod = session->loadModuleFromSourceString("shader", root_path.c_str(), preprocessed->c_str(),
+                                                      diagnostics.writeRef());
+            if (!mod) {
+                return std::unexpected(ShaderCacheError::slang_error(
+                    Stage::ModuleLoad, format_diagnostics("Slang compilation failed", diagnostics.get())));
+            }
         }
 
         // Cache any newly compiled dependency modules for future reuse.
@@ -536,138 +696,55 @@ struct ShaderCache::SlangCompiler {
         return std::vector<std::uint8_t>(ptr, ptr + spirv_code->getBufferSize());
     }
 
-    std::expected<std::vector<std::uint8_t>, ShaderCacheError> compile_ir_root(
-        assets::AssetId<Shader> id,
-        const Shader& shader,
-        std::span<const ShaderDefVal> shader_defs,
-        const std::unordered_map<assets::AssetId<Shader>, Shader>& shaders) {
-        using Stage = ShaderCacheError::SlangCompileError::Stage;
-
-        if (!global_session) {
-            return std::unexpected(
-                ShaderCacheError::slang_error(Stage::SessionCreation, "Slang global session not available"));
-        }
-
-        auto root_path = canonical_asset_path_string(shader.path);
-        auto defs_key  = defs_cache_key(shader_defs);
-
-        std::vector<std::string> def_values;
-        std::vector<slang::PreprocessorMacroDesc> macros;
-        def_values.reserve(shader_defs.size());
-        macros.reserve(shader_defs.size());
-        for (const auto& def : shader_defs) {
-            def_values.push_back(def.value_as_string());
-            macros.push_back({def.name.c_str(), def_values.back().c_str()});
-        }
-
-        slang::TargetDesc target_desc = {};
-        target_desc.format            = SLANG_SPIRV;
-        target_desc.profile           = global_session->findProfile("spirv_1_3");
-        target_desc.flags             = SLANG_TARGET_FLAG_GENERATE_SPIRV_DIRECTLY;
-
-        const char* search_paths[]                     = {""};
-        slang::CompilerOptionEntry compiler_options[1] = {};
-        compiler_options[0].name                       = slang::CompilerOptionName::VulkanUseEntryPointName;
-        compiler_options[0].value.kind                 = slang::CompilerOptionValueKind::Int;
-        compiler_options[0].value.intValue0            = 1;
-
-        slang::SessionDesc session_desc       = {};
-        session_desc.targets                  = &target_desc;
-        session_desc.targetCount              = 1;
-        session_desc.defaultMatrixLayoutMode  = SLANG_MATRIX_LAYOUT_COLUMN_MAJOR;
-        session_desc.searchPaths              = search_paths;
-        session_desc.searchPathCount          = 1;
-        session_desc.preprocessorMacros       = macros.data();
-        session_desc.preprocessorMacroCount   = static_cast<SlangInt>(macros.size());
-        session_desc.compilerOptionEntries    = compiler_options;
-        session_desc.compilerOptionEntryCount = 1;
-        session_desc.fileSystem               = &vfs_;
-
-        Slang::ComPtr<slang::ISession> session;
-        if (SLANG_FAILED(global_session->createSession(session_desc, session.writeRef()))) {
-            return std::unexpected(
-                ShaderCacheError::slang_error(Stage::SessionCreation, "Failed to create Slang session"));
-        }
-
-        preload_cached_modules(session.get(), defs_key, shaders);
-
-        const auto& ir_bytes = std::get<Source::SlangIr>(shader.source.data).bytes;
-        Slang::ComPtr<ISlangBlob> ir_blob;
-        ir_blob.attach(slang_createBlob(ir_bytes.data(), ir_bytes.size()));
-
-        Slang::ComPtr<slang::IBlob> diagnostics;
-        slang::IModule* mod =
-            session->loadModuleFromIRBlob(root_path.c_str(), root_path.c_str(), ir_blob.get(), diagnostics.writeRef());
-        if (!mod) {
-            return std::unexpected(ShaderCacheError::slang_error(
-                Stage::ModuleLoad, format_diagnostics("Slang IR root load failed", diagnostics.get())));
-        }
-
-        cache_loaded_modules(session.get(), defs_key, root_path);
-
-        std::vector<slang::IComponentType*> components;
-        components.push_back(mod);
-        SlangInt ep_count = mod->getDefinedEntryPointCount();
-
-        // SPIR-V requires at least one entry point.  Library-only shaders cannot
-        // be used as root pipeline modules; the caller must use them as imports.
-        if (ep_count == 0) {
-            return std::unexpected(ShaderCacheError::slang_error(
-                Stage::NoEntryPoints,
-                "shader has no entry points and cannot be compiled to SPIR-V directly; "
-                "use it as an imported library module instead"));
-        }
-
-        std::vector<Slang::ComPtr<slang::IEntryPoint>> entry_points(ep_count);
-        for (SlangInt i = 0; i < ep_count; ++i) {
-            mod->getDefinedEntryPoint(i, entry_points[i].writeRef());
-            components.push_back(entry_points[i].get());
-        }
-
-        Slang::ComPtr<slang::IComponentType> composed;
-        {
-            Slang::ComPtr<slang::IBlob> diag;
-            if (SLANG_FAILED(session->createCompositeComponentType(components.data(),
-                                                                   static_cast<SlangInt>(components.size()),
-                                                                   composed.writeRef(), diag.writeRef()))) {
-                return std::unexpected(ShaderCacheError::slang_error(
-                    Stage::Compose, format_diagnostics("Slang compose failed", diag.get())));
-            }
-        }
-
-        Slang::ComPtr<slang::IComponentType> linked;
-        {
-            Slang::ComPtr<slang::IBlob> diag;
-            if (SLANG_FAILED(composed->link(linked.writeRef(), diag.writeRef()))) {
-                return std::unexpected(
-                    ShaderCacheError::slang_error(Stage::Link, format_diagnostics("Slang link failed", diag.get())));
-            }
+   private:
+    // Returns a borrowed global session to the idle pool when the compile ends.
+    struct SessionLease {
+        SlangCompiler& compiler;
+        Slang::ComPtr<slang::IGlobalSession> session;
+        ~SessionLease() {
+            if (!session) return;
+            std::lock_guard lock(compiler.sessions_mutex_);
+            compiler.idle_sessions_.push_back(std::move(session));
         }
+    };
 
-        Slang::ComPtr<slang::IBlob> spirv_code;
-        {
-            Slang::ComPtr<slang::IBlob> diag;
-            if (SLANG_FAILED(linked->getTargetCode(0, spirv_code.writeRef(), diag.writeRef()))) {
-                return std::unexpected(ShaderCacheError::slang_error(
-                    Stage::CodeGeneration, format_diagnostics("Slang code generation failed", diag.get())));
-            }
-        }
+    std::string version_;
+    // Global sessions not used by a compile right now. Overlapping compiles create more, up to
+    // the number of threads compiling at once.
+    std::mutex sessions_mutex_;
+    std::vector<Slang::ComPtr<slang::IGlobalSession>> idle_sessions_;
 
-        auto* ptr = static_cast<const std::uint8_t*>(spirv_code->getBufferPointer());
-        return std::vector<std::uint8_t>(ptr, ptr + spirv_code->getBufferSize());
-    }
-
-   private:
     // Precompiled module IR cache: identity → (defs_key → serialized IR blob).
     // Session-level macros affect all modules, so blobs are keyed by both
     // the module identity and the definition set used during compilation.
     // Invalidation by identity removes all def variants at once.
+    std::mutex ir_cache_mutex_;
     std::unordered_map<std::string, std::unordered_map<std::string, Slang::ComPtr<ISlangBlob>>> module_ir_cache_;
     // Persistent VFS: populated at set_shader time with preprocessed Slang
     // sources for all registered shaders.  Serves as both the preprocessed-
     // source cache and the file system passed to each Slang session.
     SlangVFS vfs_;
 
+    static Slang::ComPtr<slang::IGlobalSession> create_global_session() {
+        Slang::ComPtr<slang::IGlobalSession> session;
+        if (SLANG_FAILED(slang::createGlobalSession(session.writeRef()))) return {};
+        return session;
+    }
+
+    Slang::ComPtr<slang::IGlobalSession> acquire_global_session() {
+        {
+            std::lock_guard lock(sessions_mutex_);
+            if (!idle_sessions_.empty()) {
+                auto session = std::move(idle_sessions_.back());
+                idle_sessions_.pop_back();
+                return session;
+            }
+        }
+        if (version_.empty()) return {};
+        spdlog::debug("[shader.cache] Creating another Slang global session for a concurrent compile.");
+        return create_global_session();
+    }
+
     static std::string defs_cache_key(std::span<const ShaderDefVal> defs) {
         std::string key;
         for (const auto& d : defs) {
@@ -680,49 +757,53 @@ struct ShaderCache::SlangCompiler {
     }
 
     // Pre-load cached dependency modules into the session from serialized IR.
-    // Iterates all registered shaders (same policy as populate_vfs).
+    // Iterates all registered Slang-family shaders the job captured.
     //
-    // For SlangIr shaders the IR bytes are read directly from dep.source — they
-    // bypass module_ir_cache_ entirely (no defs-key concept; IR has any defs
-    // baked in).
+    // For SlangIr shaders the IR bytes are read directly from the module —
+    // they bypass module_ir_cache_ entirely (no defs-key concept; IR has any
+    // defs baked in).
     //
     // For Slang-text shaders the blob is looked up in module_ir_cache_ for the
     // exact defs_key; no fallback to other keys, preserving cache correctness.
     void preload_cached_modules(slang::ISession* session,
                                 const std::string& defs_key,
-                                const std::unordered_map<assets::AssetId<Shader>, Shader>& shaders) {
-        for (const auto& [_, dep] : shaders) {
-            // Only handle Slang-family sources.
-            if (!dep.source.is_slang() && !dep.source.is_slang_ir()) continue;
-
-            auto identity    = canonical_asset_path_string(dep.path);
-            auto import_name = dep.import_path.is_custom()
-                                   ? canonical_asset_path_string(shader_custom_path(dep.import_path.as_custom_path()))
-                                   : canonical_asset_path_string(dep.import_path.as_asset_path());
-
-            if (dep.source.is_slang_ir()) {
+                                std::span<const SlangModuleSource> modules) {
+        for (const auto& dep : modules) {
+            if (dep.ir_bytes) {
                 // Load the pre-compiled IR blob from the live source bytes —
                 // independent of any compiled-with-defs cache.
-                const auto& ir_bytes = std::get<Source::SlangIr>(dep.source.data).bytes;
                 Slang::ComPtr<ISlangBlob> ir_blob;
-                ir_blob.attach(slang_createBlob(ir_bytes.data(), ir_bytes.size()));
+                ir_blob.attach(slang_createBlob(dep.ir_bytes->data(), dep.ir_bytes->size()));
                 Slang::ComPtr<slang::IBlob> diag;
-                session->loadModuleFromIRBlob(import_name.c_str(), identity.c_str(), ir_blob.get(), diag.writeRef());
+                session->loadModuleFromIRBlob(dep.import_name.c_str(), dep.identity.c_str(), ir_blob.get(),
+                                              diag.writeRef());
                 continue;
             }
 
             // Slang text shader: look up compiled IR for this exact defs_key.
-            auto outer_it = module_ir_cache_.find(identity);
-            if (outer_it == module_ir_cache_.end()) continue;
-            auto inner_it = outer_it->second.find(defs_key);
-            if (inner_it == outer_it->second.end()) continue;
+            Slang::ComPtr<ISlangBlob> blob;
+            {
+                std::lock_guard lock(ir_cache_mutex_);
+                auto outer_it = module_ir_cache_.find(dep.identity);
+                if (outer_it == module_ir_cache_.end()) continue;
+                auto inner_it = outer_it->second.find(defs_key);
+                if (inner_it == outer_it->second.end()) continue;
+                blob = inner_it->second;
+            }
 
             Slang::ComPtr<slang::IBlob> diag;
-            auto* loaded = session->loadModuleFromIRBlob(import_name.c_str(), identity.c_str(), inner_it->second.get(),
+            auto* loaded = session->loadModuleFromIRBlob(dep.import_name.c_str(), dep.identity.c_str(), blob.get(),
                                                          diag.writeRef());
             if (!loaded) {
-                spdlog::debug("[shader.cache] Cached IR blob stale for '{}', evicting.", identity);
-                outer_it->second.erase(inner_it);
+                spdlog::debug("[shader.cache] Cached IR blob stale for '{}', evicting.", dep.identity);
+                std::lock_guard lock(ir_cache_mutex_);
+                auto outer_it = module_ir_cache_.find(dep.identity);
+                if (outer_it == module_ir_cache_.end()) continue;
+                // another compile may have replaced it meanwhile.
+                if (auto inner_it = outer_it->second.find(defs_key);
+                    inner_it != outer_it->second.end() && inner_it->second.get() == blob.get()) {
+                    outer_it->second.erase(inner_it);
+                }
                 if (outer_it->second.empty()) module_ir_cache_.erase(outer_it);
             }
         }
@@ -741,11 +822,18 @@ struct ShaderCache::SlangCompiler {
             // Skip root module — it varies by preprocessor macros and is already
             // cached at the ShaderData::processed_shaders level.
             if (identity == root_identity) continue;
-            if (module_ir_cache_[identity].contains(defs_key)) continue;
+            {
+                std::lock_guard lock(ir_cache_mutex_);
+                if (auto it = module_ir_cache_.find(identity); it != module_ir_cache_.end() &&
+                                                               it->second.contains(defs_key)) {
+                    continue;
+                }
+            }
 
             Slang::ComPtr<ISlangBlob> blob;
             if (SLANG_SUCCEEDED(loaded_mod->serialize(blob.writeRef())) && blob) {
                 spdlog::trace("[shader.cache] Cached serialized IR for '{}' (defs='{}').", identity, defs_key);
+                std::lock_guard lock(ir_cache_mutex_);
                 module_ir_cache_[identity].emplace(defs_key, std::move(blob));
             }
         }
@@ -795,7 +883,7 @@ std::expected<void, ShaderCacheError> ShaderCache::add_import_to_composer(
     return {};
 }
 
-std::vector<CachedPipelineId> ShaderCache::clear(assets::AssetId<Shader> id) {
+std::vector<CachedPipelineId> ShaderCache::clear(assets::AssetId<Shader> id, std::vector<StaleVariant>* stale) {
     std::unordered_set<CachedPipelineId> affected;
 
     std::queue<assets::AssetId<Shader>> work;
@@ -809,9 +897,29 @@ std::vector<CachedPipelineId> ShaderCache::clear(assets::AssetId<Shader> id) {
 
         auto dit = data_.find(cur);
         if (dit != data_.end()) {
-            affected.insert(dit->second.pipelines.begin(), dit->second.pipelines.end());
-            dit->second.processed_shaders.clear();
-            for (auto dep_id : dit->second.dependents) work.push(dep_id);
+            auto& shader_data = dit->second;
+            // pipelines of variants set aside are left to revalidate(), unless another variant drops them.
+            std::unordered_set<CachedPipelineId> deferred;
+            std::unordered_set<CachedPipelineId> dropped;
+            std::unordered_map<std::vector<ShaderDefVal>, assets::AssetHash> stale_hashes;
+            for (auto& [defs, module] : shader_data.processed_shaders) {
+                const auto& pipelines = shader_data.variant_pipelines[defs];
+                auto hit              = shader_data.variant_hashes.find(defs);
+                if (stale && hit != shader_data.variant_hashes.end()) {
+                    deferred.insert(pipelines.begin(), pipelines.end());
+                    stale_hashes.insert(*hit);
+                    stale->push_back(StaleVariant{cur, defs, std::move(module)});
+                } else {
+                    dropped.insert(pipelines.begin(), pipelines.end());
+                }
+            }
+            for (auto pipeline : shader_data.pipelines) {
+                if (!deferred.contains(pipeline) || dropped.contains(pipeline)) affected.insert(pipeline);
+            }
+            shader_data.processed_shaders.clear();
+            shader_data.variant_hashes = std::move(stale_hashes);
+            building_.erase(cur);
+            for (auto dep_id : shader_data.dependents) work.push(dep_id);
         }
 
         auto sit = shaders_.find(cur);
@@ -825,10 +933,62 @@ std::vector<CachedPipelineId> ShaderCache::clear(assets::AssetId<Shader> id) {
     return {affected.begin(), affected.end()};
 }
 
+std::optional<assets::AssetHash> ShaderCache::disk_cache_key(assets::AssetId<Shader> id,
+                                                            const Shader& shader,
+                                                            std::span<const ShaderDefVal> shader_defs) const {
+    // SPIR-V sources are used as-is, there is nothing to save.
+    if (!disk_cache_ || shader.source.is_spirv()) return std::nullopt;
+
+    auto key = shader.source.is_wgsl() ? ShaderDiskCacheKey("wgsl", "")
+                                       : ShaderDiskCacheKey(k_slang_spirv_profile, slang_->version());
+    key.defs(shader_defs);
+    auto add_shader = [&](assets::AssetId<Shader> shader_id) {
+        auto sit = shaders_.find(shader_id);
+        auto dit = data_.find(shader_id);
+        if (sit != shaders_.end() && dit != data_.end()) {
+            key.shader(canonical_asset_path_string(sit->second.path), dit->second.content_hash);
+        }
+    };
+    if (shader.source.is_slang_ir()) {
+        // an IR root's imports are opaque; it may use any module preloaded into its session.
+        for (const auto& [shader_id, dep] : shaders_) {
+            if (dep.source.is_slang() || dep.source.is_slang_ir()) add_shader(shader_id);
+        }
+    } else {
+        for (auto shader_id : import_closure(data_, id)) add_shader(shader_id);
+    }
+    return key.hash();
+}
+
 std::expected<std::shared_ptr<wgpu::ShaderModule>, ShaderCacheError> ShaderCache::get(
     CachedPipelineId pipeline, assets::AssetId<Shader> id, std::span<const ShaderDefVal> shader_defs) {
+    auto result = request(pipeline, id, shader_defs).wait();
+    collect_built(id);
+    return result;
+}
+
+void ShaderCache::collect_built(assets::AssetId<Shader> id) {
+    auto bit = building_.find(id);
+    if (bit == building_.end()) return;
+    for (auto it = bit->second.begin(); it != bit->second.end();) {
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            ++it;
+            continue;
+        }
+        // failures are not cached, the next request builds again, as a shader change would.
+        if (auto& result = it->second.get(); result) data_[id].processed_shaders.emplace(it->first, *result);
+        it = bit->second.erase(it);
+    }
+    if (bit->second.empty()) building_.erase(bit);
+}
+
+PendingShaderModule ShaderCache::request(CachedPipelineId pipeline,
+                                         assets::AssetId<Shader> id,
+                                         std::span<const ShaderDefVal> shader_defs) {
+    using Result = PendingShaderModule::Result;
+
     auto sit = shaders_.find(id);
-    if (sit == shaders_.end()) return std::unexpected(ShaderCacheError::not_loaded(id));
+    if (sit == shaders_.end()) return PendingShaderModule::ready(std::unexpected(ShaderCacheError::not_loaded(id)));
     const Shader& shader = sit->second;
 
     auto& shader_data = data_[id];
@@ -837,63 +997,121 @@ std::expected<std::shared_ptr<wgpu::ShaderModule>, ShaderCacheError> ShaderCache
 
     auto missing_imports = missing_imports_for_shader(shaders_, data_, id);
     if (!missing_imports.empty()) {
-        return std::unexpected(ShaderCacheError::import_not_available(std::move(missing_imports)));
+        return PendingShaderModule::ready(
+            std::unexpected(ShaderCacheError::import_not_available(std::move(missing_imports))));
     }
 
     auto merged_defs = merge_shader_defs(shader_defs, shader);
+    shader_data.variant_pipelines[merged_defs].insert(pipeline);
 
+    collect_built(id);
     auto cache_it = shader_data.processed_shaders.find(merged_defs);
     if (cache_it != shader_data.processed_shaders.end()) {
         spdlog::trace("[shader.cache] Cache hit for shader '{}'.", assets::UntypedAssetId(id));
-        return cache_it->second;
+        return PendingShaderModule::ready(cache_it->second);
+    }
+    if (auto bit = building_.find(id); bit != building_.end()) {
+        if (auto it = bit->second.find(merged_defs); it != bit->second.end()) {
+            spdlog::trace("[shader.cache] Joining build of shader '{}'.", assets::UntypedAssetId(id));
+            return PendingShaderModule(it->second, nullptr);
+        }
     }
 
     spdlog::debug("[shader.cache] Compiling shader '{}' with {} defs.", assets::UntypedAssetId(id), merged_defs.size());
 
-    ShaderCacheSource source;
-    std::vector<std::uint8_t> slang_spirv_bytes;  // backing storage for Slang-compiled SPIR-V
-    std::string composed_wgsl;                    // backing storage for WGSL composition
+    // Only what needs the cache's state happens here; the build below runs in PendingShaderModule::wait.
+    auto disk_key = disk_cache_key(id, shader, merged_defs);
+    CompileInput input;
+    // only variants composed here get a hash; the others are always rebuilt after a change.
+    shader_data.variant_hashes.erase(merged_defs);
     if (std::holds_alternative<Source::SpirV>(shader.source.data)) {
-        const auto& bytes = std::get<Source::SpirV>(shader.source.data).bytes;
-        source            = ShaderCacheSource{ShaderCacheSource::SpirV{std::span<const std::uint8_t>(bytes)}};
-    } else if (std::holds_alternative<Source::Slang>(shader.source.data)) {
-        auto spirv = slang_->compile(id, shader, merged_defs, shaders_);
-        if (!spirv) return std::unexpected(spirv.error());
-        slang_spirv_bytes = std::move(spirv.value());
-        source = ShaderCacheSource{ShaderCacheSource::SpirV{std::span<const std::uint8_t>(slang_spirv_bytes)}};
-    } else if (std::holds_alternative<Source::SlangIr>(shader.source.data)) {
+        input = std::get<Source::SpirV>(shader.source.data).bytes;
+    } else if (std::holds_alternative<Source::Slang>(shader.source.data) ||
+               std::holds_alternative<Source::SlangIr>(shader.source.data)) {
         // Keep explicit .slang-module assets as dependency-only modules.
-        if (shader.path.path.extension() == ".slang-module") {
-            return std::unexpected(
+        if (shader.source.is_slang_ir() && shader.path.path.extension() == ".slang-module") {
+            return PendingShaderModule::ready(std::unexpected(
                 ShaderCacheError::slang_error(ShaderCacheError::SlangCompileError::Stage::ModuleLoad,
                                               "Root shader cannot be a pre-compiled Slang IR module (.slang-module); "
-                                              "SlangIr sources are only valid as imported dependencies"));
+                                              "SlangIr sources are only valid as imported dependencies")));
         }
 
         // Processed .slang assets may carry SlangIr roots when
-        // preprocess_slang_to_ir is enabled. Compile those as root modules.
-        auto spirv = slang_->compile_ir_root(id, shader, merged_defs, shaders_);
-        if (!spirv) return std::unexpected(spirv.error());
-        slang_spirv_bytes = std::move(spirv.value());
-        source = ShaderCacheSource{ShaderCacheSource::SpirV{std::span<const std::uint8_t>(slang_spirv_bytes)}};
+        // preprocess_slang_to_ir is enabled. Those are compiled as root modules
+        // and preload every module, themselves included.
+        SlangCompileJob job{.root = shader, .defs = merged_defs};
+        for (const auto& [dep_id, dep] : shaders_) {
+            if (!dep.source.is_slang() && !dep.source.is_slang_ir()) continue;
+            if (dep_id == id && shader.source.is_slang()) continue;
+            job.modules.push_back(SlangCompiler::module_source(dep));
+        }
+        input = std::move(job);
+    } else if (auto cached = disk_key ? disk_cache_->find(*disk_key) : std::nullopt) {
+        spdlog::trace("[shader.cache] Disk cache hit for shader '{}'.", assets::UntypedAssetId(id));
+        input = std::move(*cached);
     } else {
         for (const auto& imp : shader.imports) {
             if (auto res = add_import_to_composer(composer_, data_, shaders_, id, imp); !res)
-                return std::unexpected(res.error());
+                return PendingShaderModule::ready(std::unexpected(res.error()));
         }
         auto composed =
             composer_.compose(shader.source.as_str(), canonical_asset_path_string(shader.path), merged_defs);
-        if (!composed) return std::unexpected(ShaderCacheError::process_error(std::move(composed.error())));
-        composed_wgsl = std::move(composed.value());
-        source = ShaderCacheSource{ShaderCacheSource::Wgsl{std::string_view(composed_wgsl)}};
+        if (!composed) {
+            return PendingShaderModule::ready(
+                std::unexpected(ShaderCacheError::process_error(std::move(composed.error()))));
+        }
+        shader_data.variant_hashes.insert_or_assign(merged_defs, wgsl_token_hash(*composed));
+        input = std::move(composed.value());
     }
 
-    auto module_result = load_module_(device_, source, shader.validate_shader);
-    if (!module_result) return std::unexpected(module_result.error());
+    auto build = [id, input = std::move(input), disk_key, slang = slang_, load_module = load_module_,
+                  device = device_, disk_cache = disk_cache_, validate = shader.validate_shader]() mutable -> Result {
+        if (auto* job = std::get_if<SlangCompileJob>(&input)) {
+            if (auto cached = disk_key ? disk_cache->find(*disk_key) : std::nullopt) {
+                spdlog::trace("[shader.cache] Disk cache hit for shader '{}'.", assets::UntypedAssetId(id));
+                input = std::move(*cached);
+            } else {
+                auto spirv = slang->compile(*job);
+                if (!spirv) return std::unexpected(spirv.error());
+                input = std::move(spirv.value());
+            }
+        }
+
+        auto* wgsl   = std::get_if<std::string>(&input);
+        auto* spirv  = std::get_if<std::vector<std::uint8_t>>(&input);
+        auto* cached = std::get_if<ShaderDiskCache::Artifact>(&input);
+        auto source  = [&]() -> ShaderCacheSource {
+            // a cached entry is handed to the backend straight from its mapping.
+            if (cached && cached->kind == ShaderArtifactKind::Wgsl) {
+                return {ShaderCacheSource::Wgsl{
+                    std::string_view(reinterpret_cast<const char*>(cached->bytes.data()), cached->bytes.size())}};
+            }
+            if (cached) return {ShaderCacheSource::SpirV{cached->data()}};
+            if (wgsl) return {ShaderCacheSource::Wgsl{std::string_view(*wgsl)}};
+            return {ShaderCacheSource::SpirV{std::span<const std::uint8_t>(*spirv)}};
+        }();
+
+        auto module_result = load_module(device, source, validate);
+        if (!module_result) return std::unexpected(module_result.error());
+
+        // stored only once the backend accepted it, so a bad compile is not replayed on every run.
+        if (disk_key && !cached) {
+            bool stored = wgsl ? disk_cache->store(*disk_key, ShaderArtifactKind::Wgsl,
+                                                   std::span(reinterpret_cast<const std::uint8_t*>(wgsl->data()),
+                                                             wgsl->size()))
+                               : disk_cache->store(*disk_key, ShaderArtifactKind::SpirV, *spirv);
+            if (!stored) {
+                spdlog::warn("[shader.cache] Failed to write shader '{}' to the disk cache at '{}'.",
+                             assets::UntypedAssetId(id), disk_cache->root().string());
+            }
+        }
+        return std::make_shared<wgpu::ShaderModule>(std::move(module_result.value()));
+    };
 
-    auto ptr = std::make_shared<wgpu::ShaderModule>(std::move(module_result.value()));
-    shader_data.processed_shaders.emplace(merged_defs, ptr);
-    return ptr;
+    auto task   = std::make_unique<std::packaged_task<Result()>>(std::move(build));
+    auto result = task->get_future().share();
+    building_[id].emplace(std::move(merged_defs), result);
+    return PendingShaderModule(std::move(result), std::move(task));
 }
 
 void ShaderCache::register_import_names(const Shader& shader, assets::AssetId<Shader> id) {
@@ -909,8 +1127,26 @@ void ShaderCache::unregister_import_names(const Shader& shader) {
 }
 
 std::vector<CachedPipelineId> ShaderCache::set_shader(assets::AssetId<Shader> id, Shader shader) {
-    auto cleared = clear(id);
+    auto token_hash = shader_token_hash(shader);
+    if (auto existing = shaders_.find(id); existing != shaders_.end() && data_[id].token_hash == token_hash) {
+        // same tokens, path and defs: every compiled variant, here and in dependents, is still valid.
+        for (const auto& visible_name : visible_imports(existing->second)) {
+            composer_.remove_module(visible_name.module_name());
+        }
+        slang_->invalidate(existing->second.path);
+        existing->second       = std::move(shader);
+        data_[id].content_hash = shader_content_hash(existing->second);
+        slang_->set_preprocessed(existing->second);
+        spdlog::debug("[shader.cache] Set shader '{}'. Only comments or whitespace changed, no pipelines affected.",
+                      assets::UntypedAssetId(id));
+        return {};
+    }
+
+    std::vector<StaleVariant> stale;
+    auto cleared = clear(id, &stale);
     std::unordered_set<CachedPipelineId> affected(cleared.begin(), cleared.end());
+    // importers linked again below; clear() and revalidate() already decided which of their pipelines rebuild.
+    auto relinked = data_[id].dependents;
 
     if (auto existing = shaders_.find(id); existing != shaders_.end()) {
         slang_->invalidate(existing->second.path);
@@ -923,6 +1159,8 @@ std::vector<CachedPipelineId> ShaderCache::set_shader(assets::AssetId<Shader> id
     shaders_[id]                = shader;
     const Shader& stored_shader = shaders_.at(id);
     auto& shader_data           = data_[id];
+    shader_data.content_hash    = shader_content_hash(stored_shader);
+    shader_data.token_hash      = token_hash;
 
     slang_->set_preprocessed(stored_shader);
     register_import_names(stored_shader, id);
@@ -950,7 +1188,8 @@ std::vector<CachedPipelineId> ShaderCache::set_shader(assets::AssetId<Shader> id
                 shader_data.dependents.insert(waiting_id);
             }
 
-            if (std::ranges::all_of(waiter_it->second.imports, [&](const ShaderImport& import_ref) {
+            if (!relinked.contains(waiting_id) &&
+                std::ranges::all_of(waiter_it->second.imports, [&](const ShaderImport& import_ref) {
                     return waiter_data.resolved_imports.contains(import_ref);
                 })) {
                 affected.insert(waiter_data.pipelines.begin(), waiter_data.pipelines.end());
@@ -972,11 +1211,47 @@ std::vector<CachedPipelineId> ShaderCache::set_shader(assets::AssetId<Shader> id
         }
     }
 
+    revalidate(std::move(stale), affected);
+
     spdlog::debug("[shader.cache] Set shader '{}'. {} pipelines affected.", assets::UntypedAssetId(id),
                   affected.size());
     return {affected.begin(), affected.end()};
 }
 
+void ShaderCache::revalidate(std::vector<StaleVariant> stale, std::unordered_set<CachedPipelineId>& affected) {
+    std::size_t kept = 0;
+    for (auto& variant : stale) {
+        auto hash         = composed_hash(variant.id, variant.defs);
+        auto& shader_data = data_[variant.id];
+        auto hit          = shader_data.variant_hashes.find(variant.defs);
+        if (hash && hit != shader_data.variant_hashes.end() && hit->second == *hash) {
+            shader_data.processed_shaders.emplace(std::move(variant.defs), std::move(variant.module));
+            kept++;
+            continue;
+        }
+        if (hit != shader_data.variant_hashes.end()) shader_data.variant_hashes.erase(hit);
+        const auto& pipelines = shader_data.variant_pipelines[variant.defs];
+        affected.insert(pipelines.begin(), pipelines.end());
+    }
+    if (!stale.empty()) {
+        spdlog::debug("[shader.cache] Kept {} of {} compiled variants the change did not alter.", kept, stale.size());
+    }
+}
+
+std::optional<assets::AssetHash> ShaderCache::composed_hash(assets::AssetId<Shader> id,
+                                                            std::span<const ShaderDefVal> merged_defs) {
+    auto sit = shaders_.find(id);
+    if (sit == shaders_.end() || !sit->second.source.is_wgsl()) return std::nullopt;
+    if (!missing_imports_for_shader(shaders_, data_, id).empty()) return std::nullopt;
+    for (const auto& imp : sit->second.imports) {
+        if (!add_import_to_composer(composer_, data_, shaders_, id, imp)) return std::nullopt;
+    }
+    auto composed =
+        composer_.compose(sit->second.source.as_str(), canonical_asset_path_string(sit->second.path), merged_defs);
+    if (!composed) return std::nullopt;
+    return wgsl_token_hash(*composed);
+}
+
 std::vector<CachedPipelineId> ShaderCache::remove(assets::AssetId<Shader> id) {
     auto sit = shaders_.find(id);
     if (sit != shaders_.end()) slang_->invalidate(sit->second.path);
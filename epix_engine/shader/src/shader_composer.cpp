@@ -93,28 +93,47 @@ static std::string canonicalize_import_name(std::string_view context_name, std::
     return epix::shader::ShaderImport::asset_path(std::move(resolved)).module_name();
 }
 
+// Expansions kept per module before its memo is dropped and rebuilt from the variants still in use.
+static constexpr std::size_t k_max_fragments_per_module = 256;
+
+// ─── Definition lookup ─────────────────────────────────────────────────────
+// Definitions are kept as a vector sorted by name; a composition looks up a
+// handful of names, which binary search does without hashing or allocating.
+static std::string_view def_name(const ShaderDefVal* def) { return def->name; }
+
+static const ShaderDefVal* find_def(const std::vector<const ShaderDefVal*>& defs, std::string_view name) {
+    auto it = std::ranges::lower_bound(defs, name, {}, def_name);
+    return it != defs.end() && (*it)->name == name ? *it : nullptr;
+}
+
+// Add `extra` defs that are not already present; existing entries win.
+static std::vector<const ShaderDefVal*> merge_defs(const std::vector<const ShaderDefVal*>& defs,
+                                                   std::span<const ShaderDefVal> extra) {
+    std::vector<const ShaderDefVal*> merged = defs;
+    for (const auto& d : extra) {
+        auto it = std::ranges::lower_bound(merged, std::string_view(d.name), {}, def_name);
+        if (it == merged.end() || (*it)->name != d.name) merged.insert(it, &d);
+    }
+    return merged;
+}
+
 // ─── substitute_defs ───────────────────────────────────────────────────────
 // Replace #{NAME} and #NAME occurrences in a line with their def values.
 // #{NAME} is always matched (braced form); #NAME is matched only when the
 // character(s) after the name are non-alphanumeric/non-underscore (word boundary).
-static std::string substitute_defs(std::string_view line,
-                                   const std::unordered_map<std::string, const ShaderDefVal*>& defs) {
-    std::string out;
-    out.reserve(line.size());
+static void substitute_defs(std::string& out, std::string_view line, const std::vector<const ShaderDefVal*>& defs) {
     std::size_t i = 0;
     while (i < line.size()) {
-        if (line[i] != '#') {
-            out += line[i++];
-            continue;
-        }
+        auto hash = line.find('#', i);
+        out.append(line.substr(i, hash == std::string_view::npos ? std::string_view::npos : hash - i));
+        if (hash == std::string_view::npos) return;
+        i = hash;
         // Try braced form: #{NAME}
         if (i + 1 < line.size() && line[i + 1] == '{') {
             auto close = line.find('}', i + 2);
             if (close != std::string_view::npos) {
-                std::string name(line.substr(i + 2, close - i - 2));
-                auto it = defs.find(name);
-                if (it != defs.end()) {
-                    out += it->second->value_as_string();
+                if (auto* def = find_def(defs, line.substr(i + 2, close - i - 2))) {
+                    out += def->value_as_string();
                     i = close + 1;
                     continue;
                 }
@@ -124,193 +143,205 @@ static std::string substitute_defs(std::string_view line,
         if (i + 1 < line.size() && (std::isalpha(static_cast<unsigned char>(line[i + 1])) || line[i + 1] == '_')) {
             std::size_t j = i + 1;
             while (j < line.size() && (std::isalnum(static_cast<unsigned char>(line[j])) || line[j] == '_')) ++j;
-            std::string name(line.substr(i + 1, j - i - 1));
             // Only substitute if the name is a known def (avoids clobbering #ifdef etc.)
-            auto it = defs.find(name);
-            if (it != defs.end()) {
-                out += it->second->value_as_string();
+            if (auto* def = find_def(defs, line.substr(i + 1, j - i - 1))) {
+                out += def->value_as_string();
                 i = j;
                 continue;
             }
         }
         out += line[i++];
     }
-    return out;
-}
-
-// ─── ShaderComposer member implementations ────────────────────────────────
-
-std::expected<void, ComposeError> ShaderComposer::add_module(const std::string& module_name,
-                                                             std::string_view source,
-                                                             std::span<const ShaderDefVal> defs) {
-    auto normalized_name = module_name;
-    if (!looks_like_asset_context(normalized_name) &&
-        !(normalized_name.size() >= 2 && normalized_name.front() == '"' && normalized_name.back() == '"')) {
-        normalized_name = canonicalize_custom_module_name(module_name);
-    }
-
-    if (normalized_name.empty()) {
-        return std::unexpected(ComposeError{ComposeError::ParseError{module_name, "empty module name"}});
-    }
-    modules_[normalized_name] = ModuleEntry{
-        std::string(source),
-        std::vector<ShaderDefVal>(defs.begin(), defs.end()),
-    };
-    spdlog::trace("[shader.composer] Registered module '{}'.", normalized_name);
-    return {};
 }
 
-void ShaderComposer::remove_module(const std::string& module_name) {
-    if (!looks_like_asset_context(module_name) &&
-        !(module_name.size() >= 2 && module_name.front() == '"' && module_name.back() == '"')) {
-        modules_.erase(canonicalize_custom_module_name(module_name));
-        return;
+// Names a line could substitute, as substitute_defs would look them up.
+static void collect_substitution_names(std::string_view line, std::vector<std::string>& names) {
+    for (auto i = line.find('#'); i != std::string_view::npos; i = line.find('#', i + 1)) {
+        if (i + 1 < line.size() && line[i + 1] == '{') {
+            if (auto close = line.find('}', i + 2); close != std::string_view::npos) {
+                names.emplace_back(line.substr(i + 2, close - i - 2));
+            }
+        }
+        std::size_t j = i + 1;
+        while (j < line.size() && (std::isalnum(static_cast<unsigned char>(line[j])) || line[j] == '_')) ++j;
+        if (j > i + 1) names.emplace_back(line.substr(i + 1, j - i - 1));
     }
-    modules_.erase(module_name);
 }
 
-bool ShaderComposer::contains_module(const std::string& module_name) const {
-    if (!looks_like_asset_context(module_name) &&
-        !(module_name.size() >= 2 && module_name.front() == '"' && module_name.back() == '"')) {
-        return modules_.contains(canonicalize_custom_module_name(module_name));
-    }
-    return modules_.contains(module_name);
+static void sort_unique(std::vector<std::string>& names) {
+    std::ranges::sort(names);
+    auto [first, last] = std::ranges::unique(names);
+    names.erase(first, last);
 }
 
-// ─── build_def_map ─────────────────────────────────────────────────────────
-std::unordered_map<std::string, const ShaderDefVal*> ShaderComposer::build_def_map(std::span<const ShaderDefVal> a,
-                                                                                   std::span<const ShaderDefVal> b) {
-    std::unordered_map<std::string, const ShaderDefVal*> map;
-    for (const auto& d : a) map[d.name] = &d;
-    for (const auto& d : b) map[d.name] = &d;  // b wins on collision
-    return map;
-}
+// ─── ParsedSource ──────────────────────────────────────────────────────────
+// A source split once into runs of text, imports and conditional blocks, so a
+// composition walks the directive tree instead of re-parsing lines.
+struct ShaderComposer::ParsedSource {
+    struct Condition {
+        enum class Kind : std::uint8_t {
+            Defined,
+            NotDefined,
+            Equal,
+            NotEqual,
+            Greater,
+            GreaterEqual,
+            Less,
+            LessEqual,
+        };
+        Kind kind = Kind::Defined;
+        std::string name;
+        std::string value;
+        // `value` as a number for ordered comparisons; nullopt makes them false.
+        std::optional<std::int64_t> number;
+
+        bool eval(const DefList& defs) const {
+            auto* def = find_def(defs, name);
+            switch (kind) {
+                case Kind::Defined:
+                    return def != nullptr;
+                case Kind::NotDefined:
+                    return def == nullptr;
+                case Kind::Equal:
+                    return def && def->value_as_string() == value;  // not defined → eq is false
+                case Kind::NotEqual:
+                    return !def || def->value_as_string() != value;  // not defined → ne is true
+                default:
+                    break;
+            }
+            // Ordered comparisons: parse both sides as int64 for numeric comparison.
+            if (!def || !number) return false;  // not defined or non-numeric → false
+            std::int64_t lhs{};
+            auto lhs_str = def->value_as_string();
+            if (std::from_chars(lhs_str.data(), lhs_str.data() + lhs_str.size(), lhs).ec != std::errc{}) return false;
+            switch (kind) {
+                case Kind::Greater:
+                    return lhs > *number;
+                case Kind::GreaterEqual:
+                    return lhs >= *number;
+                case Kind::Less:
+                    return lhs < *number;
+                default:
+                    return lhs <= *number;
+            }
+        }
+    };
+    struct Node;
+    // Consecutive lines without directives; `substitutes` when one of them contains '#'.
+    struct Text {
+        std::string text;
+        bool substitutes = false;
+    };
+    struct Import {
+        std::string module_name;
+    };
+    struct Block {
+        Condition condition;
+        std::vector<Node> then_nodes;
+        std::vector<Node> else_nodes;
+    };
+    struct Node {
+        std::variant<Text, Import, Block> data;
+    };
 
-// ─── eval_condition ────────────────────────────────────────────────────────
-// directive: "ifdef" | "ifndef" | "if"
-// expr: the rest of the line after the directive keyword
-bool ShaderComposer::eval_condition(std::string_view directive,
-                                    std::string_view expr,
-                                    const std::unordered_map<std::string, const ShaderDefVal*>& defs) {
-    std::string e = trim(expr);
-    if (directive == "ifdef") {
-        return defs.contains(e);
-    }
-    if (directive == "ifndef") {
-        return !defs.contains(e);
-    }
-    if (directive == "if") {
+    std::string source;
+    std::vector<Node> nodes;
+    // Def names read by conditions or substitutions, sorted and unique.
+    std::vector<std::string> defs;
+    // Modules imported in any branch, sorted and unique.
+    std::vector<std::string> imports;
+
+    // directive: "ifdef" | "ifndef" | "if"
+    // expr: the rest of the line after the directive keyword
+    static Condition parse_condition(std::string_view directive, std::string_view expr) {
+        std::string e = trim(expr);
+        if (directive == "ifdef") return Condition{.kind = Condition::Kind::Defined, .name = std::move(e)};
+        if (directive == "ifndef") return Condition{.kind = Condition::Kind::NotDefined, .name = std::move(e)};
         // Ordered operators: >=, <=, >, < (checked before == / != to avoid prefix ambiguity)
-        static constexpr std::array<std::pair<std::string_view, int>, 6> kOps{{
-            {" >= ", 4},
-            {" <= ", 4},
-            {" > ", 3},
-            {" < ", 3},
-            {" != ", 4},
-            {" == ", 4},
+        static constexpr std::array<std::pair<std::string_view, Condition::Kind>, 6> kOps{{
+            {" >= ", Condition::Kind::GreaterEqual},
+            {" <= ", Condition::Kind::LessEqual},
+            {" > ", Condition::Kind::Greater},
+            {" < ", Condition::Kind::Less},
+            {" != ", Condition::Kind::NotEqual},
+            {" == ", Condition::Kind::Equal},
         }};
-
-        for (const auto& [op, len] : kOps) {
+        for (const auto& [op, kind] : kOps) {
             auto pos = e.find(op);
             if (pos == std::string::npos) continue;
-
-            std::string lhs_name = trim(e.substr(0, pos));
-            std::string rhs_str  = trim(e.substr(pos + len));
-            auto it              = defs.find(lhs_name);
-
-            if (op == " == ") {
-                if (it == defs.end()) return false;  // not defined → eq is false
-                return it->second->value_as_string() == rhs_str;
-            }
-            if (op == " != ") {
-                if (it == defs.end()) return true;  // not defined → ne is true
-                return it->second->value_as_string() != rhs_str;
+            Condition condition{.kind = kind, .name = trim(e.substr(0, pos)), .value = trim(e.substr(pos + op.size()))};
+            std::int64_t number{};
+            auto& value = condition.value;
+            if (std::from_chars(value.data(), value.data() + value.size(), number).ec == std::errc{}) {
+                condition.number = number;
             }
-
-            // Ordered comparisons: parse both sides as int64 for numeric comparison.
-            if (it == defs.end()) return false;  // not defined → ordered compare is false
-            std::int64_t lhs_n{}, rhs_n{};
-            auto lhs_str = it->second->value_as_string();
-            auto r1      = std::from_chars(lhs_str.data(), lhs_str.data() + lhs_str.size(), lhs_n);
-            auto r2      = std::from_chars(rhs_str.data(), rhs_str.data() + rhs_str.size(), rhs_n);
-            if (r1.ec != std::errc{} || r2.ec != std::errc{}) return false;  // non-numeric → false
-
-            if (op == " >= ") return lhs_n >= rhs_n;
-            if (op == " <= ") return lhs_n <= rhs_n;
-            if (op == " > ") return lhs_n > rhs_n;
-            if (op == " < ") return lhs_n < rhs_n;
+            return condition;
         }
-
         // bare #if NAME - treat as #ifdef
-        return defs.contains(e);
+        return Condition{.kind = Condition::Kind::Defined, .name = std::move(e)};
     }
-    return true;  // unknown directive: include by default
-}
 
-// ─── compose_internal ──────────────────────────────────────────────────────
-std::expected<std::string, ComposeError> ShaderComposer::compose_internal(
-    std::string_view source,
-    std::string_view context_name,
-    const std::unordered_map<std::string, const ShaderDefVal*>& defs,
-    std::vector<std::string>& visiting) {
-    std::string output;
-    output.reserve(source.size());
-
-    // Conditional stack: each entry = (active, else_seen)
-    struct CondFrame {
-        bool active;
-        bool else_seen;
-    };
-    std::vector<CondFrame> cond_stack;
-
-    auto is_active = [&]() {
-        for (const auto& f : cond_stack)
-            if (!f.active) return false;
-        return true;
-    };
+    static std::shared_ptr<const ParsedSource> parse(std::string_view source, std::string_view context_name) {
+        auto parsed    = std::make_shared<ParsedSource>();
+        parsed->source = std::string(source);
+
+        // Open blocks, innermost last; `in_else` once their #else was seen.
+        struct OpenBlock {
+            Block* block;
+            bool in_else;
+        };
+        std::vector<OpenBlock> open;
+        auto current = [&]() -> std::vector<Node>& {
+            if (open.empty()) return parsed->nodes;
+            return open.back().in_else ? open.back().block->else_nodes : open.back().block->then_nodes;
+        };
+        auto append_text = [&](std::string_view line) {
+            auto& nodes = current();
+            if (nodes.empty() || !std::holds_alternative<Text>(nodes.back().data)) nodes.push_back(Node{Text{}});
+            auto& text = std::get<Text>(nodes.back().data);
+            text.text += line;
+            if (line.find('#') != std::string_view::npos) {
+                text.substitutes = true;
+                collect_substitution_names(line, parsed->defs);
+            }
+        };
+
+        // Parse source line by line
+        std::size_t pos = 0;
+        while (pos <= source.size()) {
+            std::size_t nl = source.find('\n', pos);
+            std::string_view line_raw =
+                (nl == std::string_view::npos) ? source.substr(pos) : source.substr(pos, nl - pos + 1);
+            pos = (nl == std::string_view::npos) ? source.size() + 1 : nl + 1;
+
+            std::string_view line_trimmed = trim_sv(line_raw);
+            if (!line_trimmed.starts_with('#')) {
+                append_text(line_raw);
+                continue;
+            }
 
-    // Parse source line by line
-    std::size_t pos = 0;
-    while (pos <= source.size()) {
-        std::size_t nl = source.find('\n', pos);
-        std::string_view line_raw =
-            (nl == std::string_view::npos) ? source.substr(pos) : source.substr(pos, nl - pos + 1);
-        pos = (nl == std::string_view::npos) ? source.size() + 1 : nl + 1;
-
-        std::string_view line_trimmed = trim_sv(line_raw);
-
-        // ── preprocessor directives ───────────────────────────────────────
-        if (line_trimmed.starts_with('#')) {
-            std::size_t sp = line_trimmed.find_first_of(" \t", 1);
-            std::string directive =
-                std::string(sp == std::string_view::npos ? line_trimmed.substr(1) : line_trimmed.substr(1, sp - 1));
+            // ── preprocessor directives ───────────────────────────────────
+            std::size_t sp            = line_trimmed.find_first_of(" \t", 1);
+            std::string_view directive = sp == std::string_view::npos ? line_trimmed.substr(1)
+                                                                       : line_trimmed.substr(1, sp - 1);
             std::string_view rest =
                 (sp == std::string_view::npos) ? std::string_view{} : trim_sv(line_trimmed.substr(sp + 1));
 
             if (directive == "ifdef" || directive == "ifndef" || directive == "if") {
-                bool result = is_active() && eval_condition(directive, rest, defs);
-                cond_stack.push_back({result, false});
+                auto& nodes = current();
+                nodes.push_back(Node{Block{.condition = parse_condition(directive, rest)}});
+                auto& block = std::get<Block>(nodes.back().data);
+                parsed->defs.push_back(block.condition.name);
+                open.push_back(OpenBlock{&block, false});
                 continue;
             }
             if (directive == "else") {
-                if (!cond_stack.empty()) {
-                    auto& top = cond_stack.back();
-                    if (!top.else_seen) {
-                        // Determine if the parent scope is active
-                        bool parent_active = true;
-                        for (std::size_t i = 0; i + 1 < cond_stack.size(); ++i)
-                            if (!cond_stack[i].active) {
-                                parent_active = false;
-                                break;
-                            }
-                        top.active    = parent_active && !top.active;
-                        top.else_seen = true;
-                    }
-                }
+                // A second #else in the same block is ignored.
+                if (!open.empty()) open.back().in_else = true;
                 continue;
             }
             if (directive == "endif") {
-                if (!cond_stack.empty()) cond_stack.pop_back();
+                if (!open.empty()) open.pop_back();
                 continue;
             }
             if (directive == "define_import_path") {
@@ -318,7 +349,6 @@ std::expected<std::string, ComposeError> ShaderComposer::compose_internal(
                 continue;
             }
             if (directive == "import") {
-                if (!is_active()) continue;
                 // Determine module name from rest
                 std::string import_name;
                 std::string_view r = trim_sv(rest);
@@ -329,58 +359,221 @@ std::expected<std::string, ComposeError> ShaderComposer::compose_internal(
                     auto sp2    = r.find_first_of(" \t");
                     import_name = canonicalize_custom_module_name(sp2 == std::string_view::npos ? r : r.substr(0, sp2));
                 }
+                parsed->imports.push_back(import_name);
+                current().push_back(Node{Import{std::move(import_name)}});
+                continue;
+            }
+            // Any other # directive (e.g. #define) - pass through if active
+            append_text(line_raw);
+        }
 
-                // Cycle detection
-                for (const auto& v : visiting) {
-                    if (v == import_name) {
-                        std::vector<std::string> cycle(visiting.begin(), visiting.end());
-                        cycle.push_back(import_name);
-                        return std::unexpected(ComposeError{ComposeError::CircularImport{std::move(cycle)}});
-                    }
-                }
+        sort_unique(parsed->defs);
+        sort_unique(parsed->imports);
+        return parsed;
+    }
+};
 
-                // Look up registered module
-                auto it = modules_.find(import_name);
-                if (it == modules_.end()) {
-                    spdlog::warn("[shader.composer] Import '{}' not found (from '{}').", import_name, context_name);
-                    return std::unexpected(ComposeError{ComposeError::ImportNotFound{import_name}});
-                }
+// ─── ShaderComposer member implementations ────────────────────────────────
 
-                // Merge base defs of the imported module with current defs
-                auto merged = defs;
-                for (const auto& d : it->second.base_defs) merged.emplace(d.name, &d);
+std::expected<void, ComposeError> ShaderComposer::add_module(const std::string& module_name,
+                                                             std::string_view source,
+                                                             std::span<const ShaderDefVal> defs) {
+    auto normalized_name = module_name;
+    if (!looks_like_asset_context(normalized_name) &&
+        !(normalized_name.size() >= 2 && normalized_name.front() == '"' && normalized_name.back() == '"')) {
+        normalized_name = canonicalize_custom_module_name(module_name);
+    }
+
+    if (normalized_name.empty()) {
+        return std::unexpected(ComposeError{ComposeError::ParseError{module_name, "empty module name"}});
+    }
+    if (auto it = modules_.find(normalized_name); it != modules_.end() && it->second.source == source &&
+                                                   std::ranges::equal(it->second.base_defs, defs)) {
+        // unchanged: keep the memoized expansions.
+        return {};
+    }
+    stats_.parses++;
+    modules_.insert_or_assign(normalized_name, ModuleEntry{
+                                                   .source    = std::string(source),
+                                                   .base_defs = std::vector<ShaderDefVal>(defs.begin(), defs.end()),
+                                                   .parsed    = ParsedSource::parse(source, normalized_name),
+                                               });
+    invalidate(normalized_name);
+    spdlog::trace("[shader.composer] Registered module '{}'.", normalized_name);
+    return {};
+}
 
-                visiting.push_back(import_name);
-                auto inlined = compose_internal(it->second.source, import_name, merged, visiting);
-                visiting.pop_back();
+void ShaderComposer::remove_module(const std::string& module_name) {
+    auto normalized_name = module_name;
+    if (!looks_like_asset_context(module_name) &&
+        !(module_name.size() >= 2 && module_name.front() == '"' && module_name.back() == '"')) {
+        normalized_name = canonicalize_custom_module_name(module_name);
+    }
+    if (modules_.erase(normalized_name)) invalidate(normalized_name);
+}
 
-                if (!inlined) return std::unexpected(inlined.error());
-                output += inlined.value();
-                output += '\n';
-                continue;
-            }
-            // Any other # directive (e.g. #define) - pass through if active
-            if (is_active()) {
-                output += substitute_defs(line_raw, defs);
+bool ShaderComposer::contains_module(const std::string& module_name) const {
+    if (!looks_like_asset_context(module_name) &&
+        !(module_name.size() >= 2 && module_name.front() == '"' && module_name.back() == '"')) {
+        return modules_.contains(canonicalize_custom_module_name(module_name));
+    }
+    return modules_.contains(module_name);
+}
+
+// ─── build_def_list ────────────────────────────────────────────────────────
+ShaderComposer::DefList ShaderComposer::build_def_list(std::span<const ShaderDefVal> defs) {
+    DefList list;
+    list.reserve(defs.size());
+    // walk backwards so the last def of a name is the one kept.
+    for (const auto& d : defs | std::views::reverse) {
+        auto it = std::ranges::lower_bound(list, std::string_view(d.name), {}, def_name);
+        if (it == list.end() || (*it)->name != d.name) list.insert(it, &d);
+    }
+    return list;
+}
+
+// ─── Memo invalidation ─────────────────────────────────────────────────────
+void ShaderComposer::invalidate(const std::string& module_name) {
+    std::vector<std::string> work{module_name};
+    std::unordered_set<std::string> seen;
+    while (!work.empty()) {
+        auto current = std::move(work.back());
+        work.pop_back();
+        if (!seen.insert(current).second) continue;
+        if (auto it = modules_.find(current); it != modules_.end()) {
+            it->second.fragments.clear();
+            it->second.referenced_defs.reset();
+        }
+        for (const auto& [name, entry] : modules_) {
+            if (std::ranges::binary_search(entry.parsed->imports, current)) work.push_back(name);
+        }
+    }
+}
+
+const std::vector<std::string>& ShaderComposer::referenced_defs(const std::string& module_name,
+                                                                std::vector<std::string>& visiting) {
+    static const std::vector<std::string> empty;
+    auto it = modules_.find(module_name);
+    if (it == modules_.end()) return empty;
+    if (it->second.referenced_defs) return *it->second.referenced_defs;
+    // a cycle fails to compose anyway; the partial set is dropped with the module that breaks it.
+    if (std::ranges::contains(visiting, module_name)) return it->second.parsed->defs;
+
+    visiting.push_back(module_name);
+    std::vector<std::string> names = it->second.parsed->defs;
+    for (const auto& d : it->second.base_defs) names.push_back(d.name);
+    for (const auto& import : it->second.parsed->imports) {
+        auto& imported = referenced_defs(import, visiting);
+        names.insert(names.end(), imported.begin(), imported.end());
+    }
+    visiting.pop_back();
+    sort_unique(names);
+    return it->second.referenced_defs.emplace(std::move(names));
+}
+
+// ─── expand ────────────────────────────────────────────────────────────────
+std::expected<void, ComposeError> ShaderComposer::expand(const ParsedSource& parsed,
+                                                         std::string_view context_name,
+                                                         const DefList& defs,
+                                                         std::vector<std::string>& visiting,
+                                                         Fragment& out) {
+    auto expand_nodes = [&](this auto&& self,
+                            const std::vector<ParsedSource::Node>& nodes) -> std::expected<void, ComposeError> {
+        for (const auto& node : nodes) {
+            if (auto* text = std::get_if<ParsedSource::Text>(&node.data)) {
+                if (text->substitutes) {
+                    substitute_defs(out.text, text->text, defs);
+                } else {
+                    out.text += text->text;
+                }
+            } else if (auto* import = std::get_if<ParsedSource::Import>(&node.data)) {
+                if (auto res = expand_import(import->module_name, context_name, defs, visiting, out); !res) return res;
+            } else {
+                auto& block = std::get<ParsedSource::Block>(node.data);
+                if (auto res = self(block.condition.eval(defs) ? block.then_nodes : block.else_nodes); !res) {
+                    return res;
+                }
             }
-            continue;
         }
+        return {};
+    };
+    return expand_nodes(parsed.nodes);
+}
+
+std::expected<void, ComposeError> ShaderComposer::expand_import(const std::string& module_name,
+                                                                std::string_view context_name,
+                                                                const DefList& defs,
+                                                                std::vector<std::string>& visiting,
+                                                                Fragment& out) {
+    // Cycle detection
+    if (std::ranges::contains(visiting, module_name)) {
+        std::vector<std::string> cycle(visiting.begin(), visiting.end());
+        cycle.push_back(module_name);
+        return std::unexpected(ComposeError{ComposeError::CircularImport{std::move(cycle)}});
+    }
 
-        // ── regular code line ─────────────────────────────────────────────
-        if (is_active()) {
-            output += substitute_defs(line_raw, defs);
+    // Look up registered module
+    auto it = modules_.find(module_name);
+    if (it == modules_.end()) {
+        spdlog::warn("[shader.composer] Import '{}' not found (from '{}').", module_name, context_name);
+        return std::unexpected(ComposeError{ComposeError::ImportNotFound{module_name}});
+    }
+
+    // Merge base defs of the imported module with current defs
+    auto merged = merge_defs(defs, it->second.base_defs);
+
+    // The expansion only depends on the defs the module and its imports read.
+    std::vector<std::string> referenced_visiting;
+    std::string key;
+    for (const auto& name : referenced_defs(module_name, referenced_visiting)) {
+        if (auto* def = find_def(merged, name)) {
+            std::format_to(std::back_inserter(key), "{}={}\n", name, def->value_as_string());
         }
     }
 
-    return output;
+    auto& entry = it->second;
+    auto hit    = entry.fragments.find(key);
+    // reused only if nothing it inlined is being expanded above it, which would be a cycle.
+    if (hit != entry.fragments.end() &&
+        std::ranges::none_of(hit->second.modules, [&](auto& name) { return std::ranges::contains(visiting, name); })) {
+        stats_.fragment_hits++;
+    } else {
+        Fragment fragment;
+        auto parsed = entry.parsed;
+        visiting.push_back(module_name);
+        auto inlined = expand(*parsed, module_name, merged, visiting, fragment);
+        visiting.pop_back();
+        if (!inlined) return std::unexpected(inlined.error());
+
+        stats_.fragment_misses++;
+        // bound the memo of modules used with many def combinations.
+        if (entry.fragments.size() >= k_max_fragments_per_module) entry.fragments.clear();
+        hit = entry.fragments.insert_or_assign(std::move(key), std::move(fragment)).first;
+    }
+
+    out.text += hit->second.text;
+    out.text += '\n';
+    out.modules.insert(out.modules.end(), hit->second.modules.begin(), hit->second.modules.end());
+    out.modules.push_back(module_name);
+    return {};
 }
 
 // ─── compose (public) ──────────────────────────────────────────────────────
 std::expected<std::string, ComposeError> ShaderComposer::compose(std::string_view source,
                                                                  std::string_view file_path,
                                                                  std::span<const ShaderDefVal> additional_defs) {
-    auto defs = build_def_map(additional_defs);
+    auto& root = roots_[std::string(file_path)];
+    if (!root || root->source != source) {
+        stats_.parses++;
+        root = ParsedSource::parse(source, file_path);
+    }
+    auto parsed = root;
+
+    auto defs = build_def_list(additional_defs);
     std::vector<std::string> visiting;
     visiting.push_back(std::string(file_path));
-    return compose_internal(source, file_path, defs, visiting);
+    Fragment out;
+    out.text.reserve(source.size());
+    if (auto res = expand(*parsed, file_path, defs, visiting, out); !res) return std::unexpected(res.error());
+    return std::move(out.text);
 }
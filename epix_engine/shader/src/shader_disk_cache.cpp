@@ -0,0 +1,98 @@
+module;
+
+module epix.shader;
+
+import :shader_disk_cache;
+
+namespace epix::shader {
+namespace {
+constexpr std::string_view ENTRY_EXTENSION = ".shader";
+/** @brief Bump when the entry layout or the key inputs change, so older entries are never read. */
+constexpr std::uint32_t ENTRY_FORMAT_VERSION = 1;
+constexpr std::array<char, 4> ENTRY_MAGIC{'E', 'S', 'H', 'C'};
+
+struct EntryHeader {
+    std::array<char, 4> magic = ENTRY_MAGIC;
+    std::uint32_t version     = ENTRY_FORMAT_VERSION;
+    std::uint32_t kind        = 0;
+    std::uint32_t reserved    = 0;
+    std::uint64_t size        = 0;
+};
+static_assert(std::is_trivially_copyable_v<EntryHeader> && sizeof(EntryHeader) == 24);
+}  // namespace
+
+ShaderDiskCache::ShaderDiskCache(std::filesystem::path root, std::uint64_t max_bytes)
+    : m_store(std::move(root), std::string(ENTRY_EXTENSION)), m_reader(m_store.root()), m_max_bytes(max_bytes) {}
+
+std::optional<ShaderDiskCache::Artifact> ShaderDiskCache::find(const assets::AssetHash& key) {
+    auto mapped = m_reader.read_bytes_view(assets::DiskCacheStore::entry_name(key, ENTRY_EXTENSION));
+    if (!mapped) {
+        m_store.record_miss();
+        return std::nullopt;
+    }
+    EntryHeader header;
+    bool valid = mapped->size() >= sizeof(header);
+    if (valid) {
+        std::memcpy(&header, mapped->data(), sizeof(header));
+        valid = header.magic == ENTRY_MAGIC && header.version == ENTRY_FORMAT_VERSION &&
+                header.kind <= std::to_underlying(ShaderArtifactKind::Wgsl) &&
+                mapped->size() == sizeof(header) + header.size;
+    }
+    if (!valid) {
+        // truncated by a crash or written by an incompatible build; it would only miss again.
+        mapped.reset();
+        std::error_code ec;
+        std::filesystem::remove(m_store.entry_path(key, ENTRY_EXTENSION), ec);
+        m_store.record_miss();
+        return std::nullopt;
+    }
+    m_store.touch(key);
+    m_store.record_hit();
+    return Artifact{
+        .kind  = static_cast<ShaderArtifactKind>(header.kind),
+        .bytes = assets::AssetBytes(mapped->owner(), mapped->bytes().subspan(sizeof(header))),
+    };
+}
+
+bool ShaderDiskCache::store(const assets::AssetHash& key,
+                            ShaderArtifactKind kind,
+                            std::span<const std::uint8_t> bytes) {
+    EntryHeader header{.kind = std::to_underlying(kind), .size = bytes.size()};
+    return m_store.store(key, {{ENTRY_EXTENSION, {std::as_bytes(std::span(&header, 1)), std::as_bytes(bytes)}}});
+}
+
+ShaderDiskCacheKey::ShaderDiskCacheKey(std::string_view target, std::string_view compiler_version)
+    : m_target(std::format("{}\n{}\n{}", ENTRY_FORMAT_VERSION, target, compiler_version)) {}
+
+ShaderDiskCacheKey& ShaderDiskCacheKey::defs(std::span<const ShaderDefVal> defs) {
+    std::vector<const ShaderDefVal*> sorted = defs | std::views::transform([](auto& def) { return &def; }) |
+                                              std::ranges::to<std::vector>();
+    std::ranges::sort(sorted, {}, [](const ShaderDefVal* def) -> std::string_view { return def->name; });
+    m_defs.clear();
+    for (auto* def : sorted) {
+        // the value type is part of the key: a bool and an integer def are different defines.
+        std::format_to(std::back_inserter(m_defs), "{}:{}={}\n", def->name, def->value.index(),
+                       def->value_as_string());
+    }
+    return *this;
+}
+
+ShaderDiskCacheKey& ShaderDiskCacheKey::shader(std::string identity, const assets::AssetHash& content_hash) {
+    m_shaders.emplace_back(std::move(identity), content_hash);
+    return *this;
+}
+
+assets::AssetHash ShaderDiskCacheKey::hash() const {
+    auto shaders = m_shaders;
+    std::ranges::sort(shaders);
+    std::string bytes = m_target;
+    bytes += '\n';
+    bytes += m_defs;
+    for (auto& [identity, content_hash] : shaders) {
+        bytes += identity;
+        bytes.push_back('\0');
+        bytes.append(reinterpret_cast<const char*>(content_hash.data()), content_hash.size());
+    }
+    return assets::get_asset_hash({}, std::as_bytes(std::span(bytes)));
+}
+}  // namespace epix::shader
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.assets;
+import epix.shader;
+import webgpu;
+
+using namespace epix::shader;
+using namespace epix::assets;
+
+namespace {
+AssetId<Shader> shader_id() {
+    std::array<std::uint8_t, 16> id_bytes{0x4a};
+    return AssetId<Shader>(uuids::uuid(id_bytes));
+}
+
+/** @brief A ShaderCache whose backend counts the modules it creates. */
+struct CountingCache {
+    std::atomic<std::size_t> loads = 0;
+    ShaderCache cache{wgpu::Device{},
+                      [this](const wgpu::Device&, const ShaderCacheSource&,
+                             ValidateShader) -> std::expected<wgpu::ShaderModule, ShaderCacheError> {
+                          loads.fetch_add(1, std::memory_order_relaxed);
+                          return wgpu::ShaderModule{};
+                      }};
+    AssetId<Shader> id = shader_id();
+
+    CountingCache() {
+        cache.set_shader(id, Shader::from_wgsl(R"(@fragment
+fn main() -> @location(0) vec4<f32> { return vec4<f32>(1.0); }
+)",
+                                               AssetPath("shaders/main.wgsl")));
+    }
+};
+}  // namespace
+
+TEST(ShaderCacheRequest, SharesAnInFlightBuild) {
+    CountingCache env;
+    auto first  = env.cache.request(CachedPipelineId{1}, env.id, {});
+    auto second = env.cache.request(CachedPipelineId{2}, env.id, {});
+    EXPECT_TRUE(first.builds());
+    EXPECT_FALSE(second.builds());
+    EXPECT_EQ(env.loads.load(), 0u);
+
+    auto built  = first.wait();
+    auto joined = second.wait();
+    ASSERT_TRUE(built.has_value());
+    ASSERT_TRUE(joined.has_value());
+    EXPECT_EQ(*built, *joined);
+    EXPECT_EQ(env.loads.load(), 1u);
+
+    // the finished build is cached for later requests.
+    auto cached = env.cache.get(CachedPipelineId{3}, env.id, {});
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(*cached, *built);
+    EXPECT_EQ(env.loads.load(), 1u);
+}
+
+TEST(ShaderCacheRequest, DroppedRequestStillBuilds) {
+    CountingCache env;
+    auto joined = [&] {
+        auto first = env.cache.request(CachedPipelineId{1}, env.id, {});
+        return env.cache.request(CachedPipelineId{2}, env.id, {});
+    }();
+    EXPECT_FALSE(joined.builds());
+    EXPECT_TRUE(joined.wait().has_value());
+    EXPECT_EQ(env.loads.load(), 1u);
+}
+
+TEST(ShaderCacheRequest, VariantsBuildOnWaitingThreads) {
+    CountingCache env;
+    std::vector<PendingShaderModule> pending;
+    for (std::uint32_t i = 0; i < 4; i++) {
+        std::array defs{ShaderDefVal::from_uint("VARIANT", i)};
+        pending.push_back(env.cache.request(CachedPipelineId{i}, env.id, defs));
+    }
+    std::vector<std::jthread> threads;
+    std::atomic<std::size_t> built = 0;
+    for (auto& request : pending) {
+        threads.emplace_back([&] {
+            if (request.wait().has_value()) built.fetch_add(1, std::memory_order_relaxed);
+        });
+    }
+    threads.clear();
+    EXPECT_EQ(built.load(), 4u);
+    EXPECT_EQ(env.loads.load(), 4u);
+}
+
+namespace {
+/** @brief A CountingCache whose main shader imports a lighting module with an optional shadows block. */
+struct ImportingCache : CountingCache {
+    AssetId<Shader> lighting_id = AssetId<Shader>(uuids::uuid(std::array<std::uint8_t, 16>{0x5b}));
+
+    ImportingCache() {
+        set_lighting("fn shadow() -> f32 { return 0.5; }");
+        cache.set_shader(id, Shader::from_wgsl(R"(#import lighting
+@fragment
+fn main() -> @location(0) vec4<f32> { return vec4<f32>(ambient()); }
+)",
+                                               AssetPath("shaders/main.wgsl")));
+    }
+
+    std::vector<CachedPipelineId> set_lighting(std::string_view shadow_body) {
+        return cache.set_shader(lighting_id, Shader::from_wgsl(std::format(R"(#define_import_path lighting
+// ambient term
+fn ambient() -> f32 {{ return 0.1; }}
+#ifdef SHADOWS
+{}
+#endif
+)",
+                                                                           shadow_body),
+                                                               AssetPath("shaders/lighting.wgsl")));
+    }
+};
+}  // namespace
+
+TEST(ShaderCacheChanges, CommentOnlyEditKeepsVariants) {
+    CountingCache env;
+    ASSERT_TRUE(env.cache.get(CachedPipelineId{1}, env.id, {}).has_value());
+
+    auto affected = env.cache.set_shader(env.id, Shader::from_wgsl(R"(// entry point
+@fragment
+fn main() -> @location(0) vec4<f32> {  return vec4<f32>(1.0);  }  // constant color
+)",
+                                                                   AssetPath("shaders/main.wgsl")));
+    EXPECT_TRUE(affected.empty());
+    ASSERT_TRUE(env.cache.get(CachedPipelineId{1}, env.id, {}).has_value());
+    EXPECT_EQ(env.loads.load(), 1u);
+}
+
+TEST(ShaderCacheChanges, ImportEditOnlyRebuildsVariantsItReaches) {
+    ImportingCache env;
+    std::array shadow_defs{ShaderDefVal::from_bool("SHADOWS")};
+    ASSERT_TRUE(env.cache.get(CachedPipelineId{1}, env.id, {}).has_value());
+    ASSERT_TRUE(env.cache.get(CachedPipelineId{2}, env.id, shadow_defs).has_value());
+    EXPECT_EQ(env.loads.load(), 2u);
+
+    // only the SHADOWS variant includes the edited block.
+    auto affected = env.set_lighting("fn shadow() -> f32 { return 0.25; }");
+    EXPECT_EQ(affected, std::vector{CachedPipelineId{2}});
+
+    ASSERT_TRUE(env.cache.get(CachedPipelineId{1}, env.id, {}).has_value());
+    EXPECT_EQ(env.loads.load(), 2u);
+    ASSERT_TRUE(env.cache.get(CachedPipelineId{2}, env.id, shadow_defs).has_value());
+    EXPECT_EQ(env.loads.load(), 3u);
+}
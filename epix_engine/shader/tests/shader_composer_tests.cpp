@@ -52,4 +52,80 @@ TEST(ShaderComposerWgsl, ImportsInsideActiveConditionalAreInlined) {
     ASSERT_TRUE(without_import.has_value());
     EXPECT_EQ(without_import->find("fn optional_value()"), std::string::npos);
     EXPECT_NE(without_import->find("return 0;"), std::string::npos);
-}
\ No newline at end of file
+}
+TEST(ShaderComposerWgsl, ImportsAreReusedAcrossUnrelatedDefs) {
+    ShaderComposer composer;
+    ASSERT_TRUE(composer
+                    .add_module("math::scale",
+                                "#ifdef DOUBLE\n"
+                                "const SCALE: f32 = 2.0;\n"
+                                "#else\n"
+                                "const SCALE: f32 = 1.0;\n"
+                                "#endif\n",
+                                {})
+                    .has_value());
+    const char* source =
+        "#import math::scale\n"
+        "const OFFSET: i32 = #OFFSET;\n";
+
+    const std::array first_defs = {ShaderDefVal::from_int("OFFSET", 1)};
+    auto first                  = composer.compose(source, "main.wgsl", first_defs);
+    ASSERT_TRUE(first.has_value());
+    EXPECT_NE(first->find("SCALE: f32 = 1.0"), std::string::npos);
+    EXPECT_NE(first->find("OFFSET: i32 = 1;"), std::string::npos);
+
+    // OFFSET is not read by math::scale, so its expansion is shared.
+    const std::array second_defs = {ShaderDefVal::from_int("OFFSET", 2)};
+    auto second                  = composer.compose(source, "main.wgsl", second_defs);
+    ASSERT_TRUE(second.has_value());
+    EXPECT_NE(second->find("OFFSET: i32 = 2;"), std::string::npos);
+    EXPECT_EQ(composer.stats().fragment_misses, 1u);
+    EXPECT_EQ(composer.stats().fragment_hits, 1u);
+
+    const std::array double_defs = {ShaderDefVal::from_int("OFFSET", 2), ShaderDefVal::from_bool("DOUBLE")};
+    auto doubled                 = composer.compose(source, "main.wgsl", double_defs);
+    ASSERT_TRUE(doubled.has_value());
+    EXPECT_NE(doubled->find("SCALE: f32 = 2.0"), std::string::npos);
+    EXPECT_EQ(composer.stats().fragment_misses, 2u);
+}
+
+TEST(ShaderComposerWgsl, ChangedModulesInvalidateImporters) {
+    ShaderComposer composer;
+    ASSERT_TRUE(composer.add_module("lib::leaf", "fn leaf() -> i32 { return 1; }\n", {}).has_value());
+    ASSERT_TRUE(composer.add_module("lib::middle", "#import lib::leaf\nfn middle() -> i32 { return leaf(); }\n", {})
+                    .has_value());
+    const char* source = "#import lib::middle\n";
+
+    auto before = composer.compose(source, "main.wgsl", {});
+    ASSERT_TRUE(before.has_value());
+    EXPECT_NE(before->find("return 1;"), std::string::npos);
+
+    // registering the same source again keeps the memo.
+    ASSERT_TRUE(composer.add_module("lib::leaf", "fn leaf() -> i32 { return 1; }\n", {}).has_value());
+    ASSERT_TRUE(composer.compose(source, "main.wgsl", {}).has_value());
+    EXPECT_EQ(composer.stats().fragment_misses, 2u);
+
+    ASSERT_TRUE(composer.add_module("lib::leaf", "fn leaf() -> i32 { return 2; }\n", {}).has_value());
+    auto after = composer.compose(source, "main.wgsl", {});
+    ASSERT_TRUE(after.has_value());
+    EXPECT_NE(after->find("return 2;"), std::string::npos);
+    EXPECT_EQ(after->find("return 1;"), std::string::npos);
+
+    composer.remove_module("lib::leaf");
+    auto missing = composer.compose(source, "main.wgsl", {});
+    ASSERT_FALSE(missing.has_value());
+    EXPECT_TRUE(std::holds_alternative<ComposeError::ImportNotFound>(missing.error().data));
+}
+
+TEST(ShaderComposerWgsl, ChangedRootSourceIsReparsed) {
+    ShaderComposer composer;
+    auto first = composer.compose("fn value() -> i32 { return 1; }\n", "main.wgsl", {});
+    ASSERT_TRUE(first.has_value());
+    ASSERT_TRUE(composer.compose("fn value() -> i32 { return 1; }\n", "main.wgsl", {}).has_value());
+    EXPECT_EQ(composer.stats().parses, 1u);
+
+    auto second = composer.compose("fn value() -> i32 { return 2; }\n", "main.wgsl", {});
+    ASSERT_TRUE(second.has_value());
+    EXPECT_NE(second->find("return 2;"), std::string::npos);
+    EXPECT_EQ(composer.stats().parses, 2u);
+}
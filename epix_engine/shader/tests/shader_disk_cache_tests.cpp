@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+import std;
+import epix.assets;
+import epix.shader;
+import webgpu;
+
+#include "../../assets/tests/temp_dir.hpp"
+
+using namespace epix::shader;
+using namespace epix::assets;
+
+namespace {
+std::vector<std::uint8_t> bytes_of(std::string_view s) { return {s.begin(), s.end()}; }
+AssetHash content(std::string_view s) { return get_asset_hash({}, std::as_bytes(std::span(s))); }
+
+std::filesystem::path entry_path(const std::filesystem::path& root, const AssetHash& key) {
+    return root / DiskCacheStore::entry_name(key, ".shader");
+}
+
+AssetHash key_with(std::span<const ShaderDefVal> defs, std::string_view compiler = "slang-1") {
+    return ShaderDiskCacheKey("spirv_1_3", compiler).defs(defs).shader("a.slang", content("a")).hash();
+}
+
+/** @brief A ShaderCache whose backend records the WGSL it is given. */
+struct RecordingCache {
+    std::vector<std::string> loaded;
+    ShaderCache cache{wgpu::Device{},
+                      [this](const wgpu::Device&, const ShaderCacheSource& source,
+                             ValidateShader) -> std::expected<wgpu::ShaderModule, ShaderCacheError> {
+                          if (auto* wgsl = std::get_if<ShaderCacheSource::Wgsl>(&source.data)) {
+                              loaded.emplace_back(wgsl->source);
+                          }
+                          return wgpu::ShaderModule{};
+                      }};
+};
+
+constexpr std::string_view k_wgsl = R"(@fragment
+fn main() -> @location(0) vec4<f32> { return vec4<f32>(1.0); }
+)";
+}  // namespace
+
+TEST(ShaderDiskCache, StoreAndFind) {
+    TempDir dir;
+    ShaderDiskCache cache(dir.path);
+    auto key = key_with({});
+
+    EXPECT_FALSE(cache.find(key).has_value());
+    ASSERT_TRUE(cache.store(key, ShaderArtifactKind::SpirV, bytes_of("spirv")));
+
+    auto artifact = cache.find(key);
+    ASSERT_TRUE(artifact.has_value());
+    EXPECT_EQ(artifact->kind, ShaderArtifactKind::SpirV);
+    EXPECT_TRUE(std::ranges::equal(artifact->data(), bytes_of("spirv")));
+    EXPECT_EQ(cache.stats().hits, 1u);
+    EXPECT_EQ(cache.stats().misses, 1u);
+    EXPECT_EQ(cache.stats().stores, 1u);
+
+    // another instance, as in a later run, finds the entry.
+    EXPECT_TRUE(ShaderDiskCache(dir.path).find(key).has_value());
+}
+
+TEST(ShaderDiskCache, TruncatedEntryIsMissingAndRemoved) {
+    TempDir dir;
+    ShaderDiskCache cache(dir.path);
+    auto key = key_with({});
+    ASSERT_TRUE(cache.store(key, ShaderArtifactKind::Wgsl, bytes_of("fn main() {}")));
+
+    auto path = entry_path(dir.path, key);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    EXPECT_FALSE(cache.find(key).has_value());
+    EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+TEST(ShaderDiskCache, CollectsLeastRecentlyUsed) {
+    TempDir dir;
+    // room for two entries: a 24 byte header and 10 bytes each.
+    ShaderDiskCache cache(dir.path, 68);
+    std::vector<AssetHash> keys;
+    for (auto name : {"a", "b", "c"}) {
+        keys.push_back(ShaderDiskCacheKey("wgsl", "").shader(name, content(name)).hash());
+        ASSERT_TRUE(cache.store(keys.back(), ShaderArtifactKind::SpirV, bytes_of("0123456789")));
+    }
+    // make `a` the most recently used: file times are what the collection orders by.
+    auto now = std::filesystem::file_time_type::clock::now();
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        std::filesystem::last_write_time(entry_path(dir.path, keys[i]),
+                                         now - std::chrono::hours(i == 0 ? 0 : 10 - i));
+    }
+
+    EXPECT_EQ(cache.collect_garbage(), 34u);
+    EXPECT_EQ(cache.stats().evicted, 1u);
+    EXPECT_TRUE(cache.find(keys[0]).has_value());
+    EXPECT_FALSE(cache.find(keys[1]).has_value());
+    EXPECT_TRUE(cache.find(keys[2]).has_value());
+}
+
+TEST(ShaderDiskCacheKey, DefsOrderDoesNotMatter) {
+    std::array defs{ShaderDefVal::from_bool("A"), ShaderDefVal::from_int("B", 2)};
+    std::array reversed{defs[1], defs[0]};
+    EXPECT_EQ(key_with(defs), key_with(reversed));
+}
+
+TEST(ShaderDiskCacheKey, EveryInputChangesTheKey) {
+    std::array defs{ShaderDefVal::from_uint("N", 1)};
+    std::array other_value{ShaderDefVal::from_uint("N", 2)};
+    std::array other_type{ShaderDefVal::from_int("N", 1)};
+    auto key = key_with(defs);
+
+    EXPECT_NE(key, key_with(other_value));
+    EXPECT_NE(key, key_with(other_type));
+    EXPECT_NE(key, key_with(defs, "slang-2"));
+    EXPECT_NE(key, ShaderDiskCacheKey("spirv_1_4", "slang-1").defs(defs).shader("a.slang", content("a")).hash());
+    EXPECT_NE(key, ShaderDiskCacheKey("spirv_1_3", "slang-1").defs(defs).shader("a.slang", content("b")).hash());
+    // an import is part of the key, in any order.
+    auto with_import =
+        ShaderDiskCacheKey("wgsl", "").shader("a.wgsl", content("a")).shader("b.wgsl", content("b")).hash();
+    EXPECT_EQ(with_import,
+              ShaderDiskCacheKey("wgsl", "").shader("b.wgsl", content("b")).shader("a.wgsl", content("a")).hash());
+    EXPECT_NE(with_import, ShaderDiskCacheKey("wgsl", "").shader("a.wgsl", content("a")).hash());
+}
+
+TEST(ShaderCacheDiskCache, LaterRunReusesComposedWgsl) {
+    TempDir dir;
+    auto disk_cache = std::make_shared<ShaderDiskCache>(dir.path);
+    std::array<std::uint8_t, 16> id_bytes{0x5d};
+    auto id = AssetId<Shader>(uuids::uuid(id_bytes));
+
+    RecordingCache first;
+    first.cache.set_disk_cache(disk_cache);
+    first.cache.set_shader(id, Shader::from_wgsl(std::string(k_wgsl), AssetPath("shaders/main.wgsl")));
+    ASSERT_TRUE(first.cache.get(CachedPipelineId{1}, id, {}).has_value());
+    EXPECT_EQ(disk_cache->stats().stores, 1u);
+
+    RecordingCache second;
+    second.cache.set_disk_cache(disk_cache);
+    second.cache.set_shader(id, Shader::from_wgsl(std::string(k_wgsl), AssetPath("shaders/main.wgsl")));
+    ASSERT_TRUE(second.cache.get(CachedPipelineId{1}, id, {}).has_value());
+    EXPECT_EQ(disk_cache->stats().hits, 1u);
+    ASSERT_EQ(second.loaded.size(), 1u);
+    EXPECT_EQ(second.loaded, first.loaded);
+
+    // a changed source misses and is stored again.
+    second.cache.set_shader(
+        id, Shader::from_wgsl(std::string(k_wgsl) + "const UNUSED: f32 = 0.0;\n", AssetPath("shaders/main.wgsl")));
+    ASSERT_TRUE(second.cache.get(CachedPipelineId{1}, id, {}).has_value());
+    EXPECT_EQ(disk_cache->stats().hits, 1u);
+    EXPECT_EQ(disk_cache->stats().stores, 2u);
+}
@@ -73,6 +73,8 @@ float4 main(FragmentInput input) : SV_Target {
 
 constexpr std::string_view kSpriteVertexShaderAssetPath   = "sprite/sprite_vertex.slang";
 constexpr std::string_view kSpriteFragmentShaderAssetPath = "sprite/sprite_fragment.slang";
+/** @brief Name the pipelines of this plugin are recorded under in the pipeline manifest. */
+constexpr std::string_view kSpritePipelineSpecializer = "sprite";
 
 std::span<const std::byte> shader_bytes(std::string_view source) {
     return std::span<const std::byte>(reinterpret_cast<const std::byte*>(source.data()), source.size());
@@ -108,7 +110,7 @@ struct SpritePipelineCache {
     wgpu::BindGroupLayout texture_layout;
     assets::Handle<shader::Shader> vertex_shader;
     assets::Handle<shader::Shader> fragment_shader;
-    std::unordered_map<std::uint32_t, render::CachedPipelineId> pipelines;
+    render::SpecializedPipelines<std::uint32_t> pipelines;
 
     explicit SpritePipelineCache(World& world, const SpriteShaderHandles& shader_handles)
         : view_layout(world.resource<render::view::ViewUniformBindingLayout>().layout),
@@ -145,11 +147,14 @@ struct SpritePipelineCache {
 
     std::optional<render::CachedPipelineId> specialize(render::PipelineServer& pipeline_server,
                                                        wgpu::TextureFormat color_format) {
-        auto key = static_cast<std::uint32_t>(color_format);
-        if (auto it = pipelines.find(key); it != pipelines.end()) {
-            return it->second;
-        }
+        auto key                     = static_cast<std::uint32_t>(color_format);
+        auto [pipeline_id, inserted] = pipelines.specialize(pipeline_server, key,
+                                                            [&](std::uint32_t) { return descriptor(color_format); });
+        if (inserted) pipeline_server.record_specialization(kSpritePipelineSpecializer, std::to_string(key));
+        return pipeline_id;
+    }
 
+    render::RenderPipelineDescriptor descriptor(wgpu::TextureFormat color_format) const {
         std::vector<wgpu::VertexBufferLayout> vertex_buffers;
         vertex_buffers.reserve(2);
         vertex_buffers.push_back(
@@ -201,12 +206,19 @@ struct SpritePipelineCache {
             .fragment      = std::move(fragment_state),
         };
 
-        auto pipeline_id = pipeline_server.queue_render_pipeline(std::move(pipeline_desc));
-        pipelines.emplace(key, pipeline_id);
-        return pipeline_id;
+        return pipeline_desc;
     }
 };
 
+/** @brief Replay `specialize` for a color format recorded in the pipeline manifest on an earlier run. */
+std::optional<render::CachedPipelineId> replay_sprite_pipeline(World& world, std::string_view key) {
+    std::uint32_t format = 0;
+    auto [end, ec]       = std::from_chars(key.data(), key.data() + key.size(), format);
+    if (ec != std::errc{} || end != key.data() + key.size()) return std::nullopt;
+    return world.resource_mut<SpritePipelineCache>().specialize(world.resource_mut<render::PipelineServer>(),
+                                                                static_cast<wgpu::TextureFormat>(format));
+}
+
 struct TransparentSpriteDrawFunction {
     render::phase::DrawFunctionId value;
 };
@@ -297,28 +309,58 @@ bool sprite_may_be_visible(const ExtractedSprite& sprite, const render::view::Ex
     return !(outside_left || outside_right || outside_bottom || outside_top || outside_near || outside_far);
 }
 
-void extract_sprites(
-    Commands cmd,
-    Extract<Query<Item<Entity, const Sprite&, const transform::GlobalTransform&, const assets::Handle<image::Image>&>,
-                  Without<render::CustomRendered>>> sprites,
-    Extract<Res<assets::Assets<image::Image>>> images) {
+void extract_sprites(Commands cmd,
+                     Extract<Query<Item<Entity,
+                                        Ref<Sprite>,
+                                        Ref<transform::GlobalTransform>,
+                                        Ref<assets::Handle<image::Image>>>,
+                                   Without<render::CustomRendered>>> sprites,
+                     Extract<Res<assets::Assets<image::Image>>> images,
+                     Extract<EventReader<assets::AssetEvent<image::Image>>> image_events,
+                     Query<Item<ExtractedSprite&>, With<render::RetainedRenderEntity>> extracted_sprites,
+                     ResMut<render::RetainedEntities<ExtractedSprite>> retained,
+                     ResMut<render::FrameArena> arena) {
+    // sprites of a reloaded or edited image re-read its size.
+    auto modified_images = arena->make_vector<assets::AssetId<image::Image>>();
+    for (const auto& event : image_events.read()) {
+        if (event.is_modified()) modified_images.push_back(event.id);
+    }
+    retained->begin();
     for (auto&& [entity, sprite, global_transform, texture] : sprites.iter()) {
+        auto entry   = retained->touch(entity);
+        bool changed = sprite.is_modified() || global_transform.is_modified() || texture.is_modified() ||
+                       std::ranges::contains(modified_images, texture->id());
+        if (entry && !changed && !entry->get().needs_refresh) {
+            continue;
+        }
+
         glm::vec2 image_size = glm::vec2(1.0f, 1.0f);
-        if (auto image = images->get(texture.id()); image) {
+        auto image           = images->get(texture->id());
+        if (image) {
             image_size = glm::vec2(static_cast<float>(image->get().width()), static_cast<float>(image->get().height()));
         }
 
-        cmd.spawn(
-            ExtractedSprite{
-                .source_entity = entity,
-                .sprite        = sprite,
-                .model         = global_transform.matrix,
-                .depth         = global_transform.matrix[3][2],
-                .texture       = texture.id(),
-                .image_size    = image_size,
-            },
-            SpriteBatch{});
+        ExtractedSprite extracted{
+            .source_entity = entity,
+            .sprite        = *sprite,
+            .model         = global_transform->matrix,
+            .depth         = global_transform->matrix[3][2],
+            .texture       = texture->id(),
+            .image_size    = image_size,
+        };
+        if (!entry) {
+            auto render_entity = cmd.spawn(std::move(extracted), SpriteBatch{}, render::MainEntity{entity},
+                                           render::RetainedRenderEntity{})
+                                     .id();
+            entry = std::ref(retained->insert(entity, render_entity));
+        } else if (auto target = extracted_sprites.get(entry->get().render_entity)) {
+            auto&& [extracted_sprite] = *target;
+            extracted_sprite          = std::move(extracted);
+        }
+        // the image size is read from the loaded asset, re-extract until it is available.
+        entry->get().needs_refresh = !image.has_value();
     }
+    retained->end(cmd, *arena);
 }
 
 void queue_sprites_2d(Query<Item<render::phase::RenderPhase<core_graph::core_2d::Transparent2D>&,
@@ -364,9 +406,9 @@ void prepare_sprite_batches(Query<Item<render::phase::RenderPhase<core_graph::co
                             Res<wgpu::Device> device,
                             Res<wgpu::Queue> queue,
                             Res<SpritePipelineCache> pipeline_cache,
-                            ResMut<SpriteInstanceBuffer> instance_buffer) {
+                            ResMut<SpriteInstanceBuffer> instance_buffer,
+                            ResMut<render::BindGroupCache> bind_groups) {
     instance_buffer->instances.clear();
-    std::unordered_map<assets::AssetId<image::Image>, wgpu::BindGroup> texture_bind_group_cache;
 
     for (auto&& [phase] : views.iter()) {
         std::optional<assets::AssetId<image::Image>> current_texture;
@@ -393,19 +435,17 @@ void prepare_sprite_batches(Query<Item<render::phase::RenderPhase<core_graph::co
                 batch_head                          = item_index;
                 phase.items[batch_head].batch_count = 0;
                 batch.instance_start                = static_cast<std::uint32_t>(instance_buffer->instances.size());
-                if (auto it = texture_bind_group_cache.find(sprite.texture); it != texture_bind_group_cache.end()) {
-                    batch.texture_bind_group = it->second;
-                } else {
-                    batch.texture_bind_group = device->createBindGroup(
-                        wgpu::BindGroupDescriptor()
-                            .setLabel("SpriteTextureBindGroup")
-                            .setLayout(pipeline_cache->texture_layout)
-                            .setEntries(std::array{
-                                wgpu::BindGroupEntry().setBinding(0).setSampler(gpu_image->sampler),
-                                wgpu::BindGroupEntry().setBinding(1).setTextureView(gpu_image->view),
-                            }));
-                    texture_bind_group_cache.emplace(sprite.texture, batch.texture_bind_group);
-                }
+                batch.texture_bind_group =
+                    bind_groups->get_or_create(pipeline_cache->texture_layout, sprite.texture, [&] {
+                        return device->createBindGroup(
+                            wgpu::BindGroupDescriptor()
+                                .setLabel("SpriteTextureBindGroup")
+                                .setLayout(pipeline_cache->texture_layout)
+                                .setEntries(std::array{
+                                    wgpu::BindGroupEntry().setBinding(0).setSampler(gpu_image->sampler),
+                                    wgpu::BindGroupEntry().setBinding(1).setTextureView(gpu_image->view),
+                                }));
+                    });
                 current_texture = sprite.texture;
             }
 
@@ -463,6 +503,10 @@ void SpritePlugin::finish(core::App& app) {
     if (!world.get_resource<SpritePipelineCache>()) {
         world.insert_resource(SpritePipelineCache(world, shader_handles->get()));
     }
+    if (auto warmup = world.get_resource<render::PipelineWarmup>()) {
+        warmup->get().add_specializer(std::string(kSpritePipelineSpecializer), replay_sprite_pipeline);
+    }
+    world.init_resource<render::RetainedEntities<ExtractedSprite>>();
     auto& render_subapp = render_app->get();
     world.insert_resource(TransparentSpriteDrawFunction{
         .value = render::phase::app_add_render_commands<
@@ -66,6 +66,8 @@ float4 main(FragmentInput input) : SV_Target {
 
 constexpr std::string_view kTextVertexShaderAssetPath   = "text/text_vertex.slang";
 constexpr std::string_view kTextFragmentShaderAssetPath = "text/text_fragment.slang";
+/** @brief Name the pipelines of this plugin are recorded under in the pipeline manifest. */
+constexpr std::string_view kTextPipelineSpecializer = "text2d";
 
 std::span<const std::byte> shader_bytes(std::string_view source) {
     return std::span<const std::byte>(reinterpret_cast<const std::byte*>(source.data()), source.size());
@@ -127,7 +129,7 @@ struct Text2dPipelineCache {
     wgpu::BindGroupLayout texture_layout;
     assets::Handle<shader::Shader> vertex_shader;
     assets::Handle<shader::Shader> fragment_shader;
-    std::unordered_map<std::uint32_t, render::CachedPipelineId> pipelines;
+    render::SpecializedPipelines<std::uint32_t> pipelines;
 
     explicit Text2dPipelineCache(World& world, const TextShaderHandles& shader_handles)
         : view_layout(world.resource<render::view::ViewUniformBindingLayout>().layout),
@@ -164,11 +166,14 @@ struct Text2dPipelineCache {
 
     std::optional<render::CachedPipelineId> specialize(render::PipelineServer& pipeline_server,
                                                        wgpu::TextureFormat color_format) {
-        auto key = static_cast<std::uint32_t>(color_format);
-        if (auto it = pipelines.find(key); it != pipelines.end()) {
-            return it->second;
-        }
+        auto key                     = static_cast<std::uint32_t>(color_format);
+        auto [pipeline_id, inserted] = pipelines.specialize(pipeline_server, key,
+                                                            [&](std::uint32_t) { return descriptor(color_format); });
+        if (inserted) pipeline_server.record_specialization(kTextPipelineSpecializer, std::to_string(key));
+        return pipeline_id;
+    }
 
+    render::RenderPipelineDescriptor descriptor(wgpu::TextureFormat color_format) const {
         std::array vertex_buffers = {
             wgpu::VertexBufferLayout()
                 .setArrayStride(sizeof(glm::vec3))
@@ -218,12 +223,19 @@ struct Text2dPipelineCache {
             .fragment      = std::move(fragment_state),
         };
 
-        auto pipeline_id = pipeline_server.queue_render_pipeline(std::move(pipeline_desc));
-        pipelines.emplace(key, pipeline_id);
-        return pipeline_id;
+        return pipeline_desc;
     }
 };
 
+/** @brief Replay `specialize` for a color format recorded in the pipeline manifest on an earlier run. */
+std::optional<render::CachedPipelineId> replay_text_pipeline(World& world, std::string_view key) {
+    std::uint32_t format = 0;
+    auto [end, ec]       = std::from_chars(key.data(), key.data() + key.size(), format);
+    if (ec != std::errc{} || end != key.data() + key.size()) return std::nullopt;
+    return world.resource_mut<Text2dPipelineCache>().specialize(world.resource_mut<render::PipelineServer>(),
+                                                                static_cast<wgpu::TextureFormat>(format));
+}
+
 struct TransparentTextDrawFunction {
     render::phase::DrawFunctionId value;
 };
@@ -452,9 +464,9 @@ void prepare_text_batches(Query<Item<render::phase::RenderPhase<core_graph::core
                           Res<wgpu::Device> device,
                           Res<wgpu::Queue> queue,
                           Res<Text2dPipelineCache> pipeline_cache,
-                          ResMut<TextInstanceBuffer> instance_buffer) {
+                          ResMut<TextInstanceBuffer> instance_buffer,
+                          ResMut<render::BindGroupCache> bind_groups) {
     instance_buffer->instances.clear();
-    std::unordered_map<assets::AssetId<image::Image>, wgpu::BindGroup> texture_bind_group_cache;
 
     for (auto&& [phase] : views.iter()) {
         for (std::size_t item_index = 0; item_index < phase.items.size(); ++item_index) {
@@ -471,19 +483,17 @@ void prepare_text_batches(Query<Item<render::phase::RenderPhase<core_graph::core
             }
 
             batch.instance_start = static_cast<std::uint32_t>(instance_buffer->instances.size());
-            if (auto it = texture_bind_group_cache.find(text.font_image); it != texture_bind_group_cache.end()) {
-                batch.texture_bind_group = it->second;
-            } else {
-                batch.texture_bind_group = device->createBindGroup(
-                    wgpu::BindGroupDescriptor()
-                        .setLabel("TextTextureBindGroup")
-                        .setLayout(pipeline_cache->texture_layout)
-                        .setEntries(std::array{
-                            wgpu::BindGroupEntry().setBinding(0).setSampler(gpu_image->sampler),
-                            wgpu::BindGroupEntry().setBinding(1).setTextureView(gpu_image->view),
-                        }));
-                texture_bind_group_cache.emplace(text.font_image, *batch.texture_bind_group);
-            }
+            batch.texture_bind_group =
+                bind_groups->get_or_create(pipeline_cache->texture_layout, text.font_image, [&] {
+                    return device->createBindGroup(
+                        wgpu::BindGroupDescriptor()
+                            .setLabel("TextTextureBindGroup")
+                            .setLayout(pipeline_cache->texture_layout)
+                            .setEntries(std::array{
+                                wgpu::BindGroupEntry().setBinding(0).setSampler(gpu_image->sampler),
+                                wgpu::BindGroupEntry().setBinding(1).setTextureView(gpu_image->view),
+                            }));
+                });
 
             instance_buffer->instances.push_back(TextInstanceData{.model = text.model, .color = text.color});
             item.batch_count = 1;
@@ -577,6 +587,9 @@ void TextRenderPlugin::finish(App& app) {
     if (!world.get_resource<Text2dPipelineCache>()) {
         world.insert_resource(Text2dPipelineCache(world, shader_handles->get()));
     }
+    if (auto warmup = world.get_resource<render::PipelineWarmup>()) {
+        warmup->get().add_specializer(std::string(kTextPipelineSpecializer), replay_text_pipeline);
+    }
     auto& render_subapp = render_app->get();
     world.insert_resource(TransparentTextDrawFunction{
         .value =
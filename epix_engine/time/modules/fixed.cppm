@@ -7,6 +7,32 @@ import :virt;
 
 namespace epix::time {
 
+/** @brief What happens to accumulated time that could not be simulated because
+ *  the per-frame step budget of `Time<Fixed>` was exhausted. */
+export enum class FixedOverrunPolicy {
+    /** @brief Drop the unsimulated whole timesteps. The fixed clock falls behind
+     *  virtual time, i.e. the simulation is dilated during the hitch. */
+    Dilate,
+    /** @brief Keep at most one frame budget of backlog, later frames catch up on it.
+     *  Anything beyond that is dropped as with `Dilate`. */
+    CatchUp,
+};
+
+/** @brief Per-frame statistics of the fixed-step driver. */
+export struct FixedStepStats {
+    /** @brief Fixed steps run in the current (or last finished) frame. */
+    std::uint32_t steps = 0;
+    /** @brief Whether the step budget stopped the frame with whole timesteps left over. */
+    bool budget_exhausted = false;
+    /** @brief Overstep left after the most recent step, i.e. how far the fixed clock
+     *  lags behind virtual time while that step runs. */
+    std::chrono::nanoseconds overshoot{0};
+    /** @brief Largest overshoot seen during the frame. */
+    std::chrono::nanoseconds peak_overshoot{0};
+    /** @brief Time dropped by the overrun policy at the end of the frame. */
+    std::chrono::nanoseconds discarded{0};
+};
+
 /** @brief Context for `Time<Fixed>`. Stores the fixed timestep duration
  *  and the accumulated overstep from real/virtual time. */
 export struct Fixed {
@@ -14,11 +40,18 @@ export struct Fixed {
     std::chrono::nanoseconds timestep = std::chrono::microseconds(15625);  // 64 Hz
     /** @brief Accumulated real time not yet consumed by a fixed step. */
     std::chrono::nanoseconds overstep{0};
+    /** @brief Maximum number of fixed steps per frame, 0 for no limit. */
+    std::uint32_t max_steps_per_frame = 0;
+    /** @brief Handling of the backlog left when `max_steps_per_frame` is reached. */
+    FixedOverrunPolicy overrun_policy = FixedOverrunPolicy::Dilate;
+    /** @brief Statistics of the current frame. */
+    FixedStepStats stats{};
 };
 
 /** @brief Fixed-timestep time. Each tick advances by exactly one timestep.
- *  Used in the FixedMain schedule loop; `expend()` is called repeatedly
- *  to consume accumulated overstep one timestep at a time. */
+ *  Used in the FixedMain schedule loop: `begin_frame()`, then `expend()` is called
+ *  repeatedly to consume accumulated overstep one timestep at a time within the
+ *  per-frame step budget, then `end_frame()` applies the overrun policy. */
 export template <>
 struct Time<Fixed> : private Time<> {
     /** @brief Default timestep (64 Hz, ~15.625 ms). */
@@ -113,17 +146,54 @@ struct Time<Fixed> : private Time<> {
                std::chrono::duration<double>(m_context.timestep).count();
     }
 
+    /** @brief Get the maximum number of fixed steps per frame (0 = unlimited). */
+    std::uint32_t max_steps_per_frame() const { return m_context.max_steps_per_frame; }
+    /** @brief Limit the number of fixed steps per frame, 0 for no limit.
+     *  Bounds the cost of a frame after a hitch instead of spiralling. */
+    void set_max_steps_per_frame(std::uint32_t max_steps) { m_context.max_steps_per_frame = max_steps; }
+    /** @brief Get the policy applied to the backlog when the step budget is exhausted. */
+    FixedOverrunPolicy overrun_policy() const { return m_context.overrun_policy; }
+    /** @brief Set the policy applied to the backlog when the step budget is exhausted. */
+    void set_overrun_policy(FixedOverrunPolicy policy) { m_context.overrun_policy = policy; }
+    /** @brief Statistics of the current frame, or of the last one outside the fixed loop. */
+    const FixedStepStats& stats() const { return m_context.stats; }
+
+    /** @brief Start a new frame of fixed steps: resets the step budget and statistics. */
+    void begin_frame() { m_context.stats = FixedStepStats{}; }
+
     /** @brief Try to consume one timestep from overstep. If enough time has
-     *  accumulated, subtracts one timestep, advances the clock, and returns true.
-     *  Returns false if not enough overstep remains. */
+     *  accumulated and the frame's step budget allows it, subtracts one timestep,
+     *  advances the clock, and returns true. Returns false otherwise. */
     bool expend() {
-        auto ts = timestep();
-        if (m_context.overstep >= ts) {
-            m_context.overstep -= ts;
-            advance_by(ts);
-            return true;
+        auto ts     = timestep();
+        auto& stats = m_context.stats;
+        if (m_context.overstep < ts) return false;
+        if (m_context.max_steps_per_frame != 0 && stats.steps >= m_context.max_steps_per_frame) {
+            stats.budget_exhausted = true;
+            return false;
+        }
+        m_context.overstep -= ts;
+        advance_by(ts);
+        stats.steps++;
+        stats.overshoot      = m_context.overstep;
+        stats.peak_overshoot = std::max(stats.peak_overshoot, m_context.overstep);
+        return true;
+    }
+
+    /** @brief Finish a frame of fixed steps. If the step budget was exhausted, applies
+     *  the overrun policy to the remaining backlog. The fractional part of a timestep
+     *  is always kept so `overstep_fraction()` stays usable for interpolation. */
+    void end_frame() {
+        auto& stats = m_context.stats;
+        if (!stats.budget_exhausted) return;
+        auto ts       = timestep();
+        auto fraction = m_context.overstep % ts;
+        auto keep     = fraction;
+        if (m_context.overrun_policy == FixedOverrunPolicy::CatchUp) {
+            keep = std::min(m_context.overstep, fraction + ts * m_context.max_steps_per_frame);
         }
-        return false;
+        stats.discarded    = m_context.overstep - keep;
+        m_context.overstep = keep;
     }
 
     /** @brief Get const reference to the Fixed context. */
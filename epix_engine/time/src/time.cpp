@@ -12,8 +12,11 @@ using namespace epix::core;
 namespace epix::time {
 
 /** @brief Custom executor for FixedMain that runs the fixed sub-schedules
- *  (FixedFirst, FixedPreUpdate, FixedUpdate, FixedPostUpdate, FixedLast) in order,
- *  ignoring FixedMain's own systems. */
+ *  (FixedFirst, FixedPreUpdate, FixedUpdate, FixedPostUpdate, FixedLast) in order
+ *  once per fixed step, ignoring FixedMain's own systems.
+ *
+ *  All catch-up steps of a frame run back to back: the sub-schedules are taken
+ *  out of `Schedules` once and stay prepared and initialized across steps. */
 struct FixedMainExecutor : ScheduleExecutor {
     std::array<ScheduleLabel, 5> sub_schedules = {
         ScheduleLabel(FixedFirst),      ScheduleLabel(FixedPreUpdate), ScheduleLabel(FixedUpdate),
@@ -21,16 +24,29 @@ struct FixedMainExecutor : ScheduleExecutor {
     };
 
     void execute(ScheduleSystems& /*unused*/, World& world, const ExecutorConfig& /*unused*/) override {
-        auto& schedules = world.resource_mut<Schedules>();
-        for (auto& label : sub_schedules) {
-            auto schedule = schedules.remove_schedule(label);
-            if (schedule) {
-                schedule->execute(world);
-                schedules.add_schedule(std::move(*schedule));
+        std::array<std::optional<Schedule>, 5> schedules;
+        {
+            auto& all = world.resource_mut<Schedules>();
+            for (auto&& [label, schedule] : std::views::zip(sub_schedules, schedules)) {
+                schedule = all.remove_schedule(label);
             }
         }
+        while (true) {
+            auto& fixed_time = world.resource_mut<Time<Fixed>>();
+            if (!fixed_time.expend()) break;
+            world.resource_mut<Time<>>() = fixed_time.as_generic();
+            for (auto& schedule : schedules) {
+                if (schedule) schedule->execute(world);
+            }
+        }
+        auto& all = world.resource_mut<Schedules>();
+        for (auto& schedule : schedules) {
+            if (schedule) all.add_schedule(std::move(*schedule));
+        }
     }
     meta::type_index type() const override { return meta::type_id<FixedMainExecutor>(); }
+    // runs the sub-schedules and writes Schedules and the clocks itself.
+    bool runs_own_systems_only() const override { return false; }
 };
 
 void TimePlugin::build(App& app) {
@@ -70,23 +86,28 @@ void TimePlugin::build(App& app) {
     app.add_schedule(Schedule(FixedPostUpdate));
     app.add_schedule(Schedule(FixedLast));
 
-    // Register FixedMain schedule with loop condition and custom executor
-    ScheduleConfig fixed_config;
-    fixed_config.loop_condition = [](World& world) -> bool {
-        auto& fixed_time = world.resource_mut<Time<Fixed>>();
-        if (!fixed_time.expend()) return false;
-        world.resource_mut<Time<>>() = fixed_time.as_generic();
-        return true;
-    };
-
+    // Register FixedMain schedule with the fixed-step executor, it loops over the steps of a frame itself
     app.add_schedule(Schedule(FixedMain)
-                         .with_schedule_config(fixed_config)
                          .with_executor(std::make_unique<FixedMainExecutor>())
                          .then([](Schedule& sche) {
                              sche.add_pre_systems(
                                  into([](ResMut<Time<Fixed>> fixed_time, Res<Time<Virtual>> virtual_time) {
+                                     fixed_time->begin_frame();
                                      fixed_time->accumulate_overstep(virtual_time->delta());
                                  }).set_name("accumulate_fixed_overstep"));
+                             sche.add_post_systems(into([](ResMut<Time<Fixed>> fixed_time) {
+                                                       fixed_time->end_frame();
+                                                       auto& stats = fixed_time->stats();
+                                                       if (stats.discarded.count() > 0) {
+                                                           spdlog::debug(
+                                                               "[time] Fixed step budget of {} exhausted, dropped "
+                                                               "{}us of accumulated time.",
+                                                               fixed_time->max_steps_per_frame(),
+                                                               std::chrono::duration_cast<std::chrono::microseconds>(
+                                                                   stats.discarded)
+                                                                   .count());
+                                                       }
+                                                   }).set_name("apply_fixed_overrun_policy"));
                              sche.add_post_systems(into([](ResMut<Time<>> time, Res<Time<Virtual>> virtual_time) {
                                                        *time = virtual_time->as_generic();
                                                    }).set_name("restore_virtual_time"));
@@ -1,8 +1,10 @@
 #include <gtest/gtest.h>
 
 import std;
+import epix.core;
 import epix.time;
 
+using namespace epix::core;
 using namespace epix::time;
 using namespace std::chrono_literals;
 
@@ -96,6 +98,48 @@ TEST(TimeFixed, ExpendMultiple) {
     EXPECT_EQ(t.overstep(), 1s);
 }
 
+TEST(TimeFixed, StepBudgetDilate) {
+    auto t = Time<Fixed>::from_duration(10ms);
+    t.set_max_steps_per_frame(3);
+
+    t.begin_frame();
+    t.accumulate_overstep(105ms);
+    int steps = 0;
+    while (t.expend()) steps++;
+    EXPECT_EQ(steps, 3);
+    EXPECT_TRUE(t.stats().budget_exhausted);
+    EXPECT_EQ(t.stats().overshoot, 75ms);
+    EXPECT_EQ(t.stats().peak_overshoot, 95ms);
+
+    t.end_frame();
+    EXPECT_EQ(t.overstep(), 5ms);
+    EXPECT_EQ(t.stats().discarded, 70ms);
+    EXPECT_EQ(t.elapsed(), 30ms);
+}
+
+TEST(TimeFixed, StepBudgetCatchUp) {
+    auto t = Time<Fixed>::from_duration(10ms);
+    t.set_max_steps_per_frame(2);
+    t.set_overrun_policy(FixedOverrunPolicy::CatchUp);
+
+    t.begin_frame();
+    t.accumulate_overstep(105ms);
+    while (t.expend()) {
+    }
+    t.end_frame();
+    // one more frame budget of backlog is kept for the next frames.
+    EXPECT_EQ(t.overstep(), 25ms);
+    EXPECT_EQ(t.stats().discarded, 60ms);
+
+    t.begin_frame();
+    int steps = 0;
+    while (t.expend()) steps++;
+    t.end_frame();
+    EXPECT_EQ(steps, 2);
+    EXPECT_FALSE(t.stats().budget_exhausted);
+    EXPECT_EQ(t.overstep(), 5ms);
+}
+
 TEST(TimeFixed, DiscardOverstep) {
     auto t = Time<Fixed>::from_seconds(1.0);
 
@@ -118,4 +162,28 @@ TEST(TimeFixed, AsGeneric) {
     EXPECT_EQ(g.delta(), 1s);
     EXPECT_EQ(g.elapsed(), 1s);
 }
+
+TEST(TimeFixed, FixedMainRunsBudgetedSteps) {
+    App app    = App::create();
+    auto fixed = Time<Fixed>::from_duration(10ms);
+    fixed.set_max_steps_per_frame(3);
+    app.world_mut().insert_resource(std::move(fixed));
+    app.world_mut().insert_resource(
+        TimeUpdateConfig{.strategy = TimeUpdateStrategy::ManualDuration, .manual_duration = 105ms});
+    app.add_plugins(TimePlugin{});
+    std::vector<std::chrono::nanoseconds> step_deltas;
+    app.add_systems(FixedUpdate, into([&](Res<Time<>> time) { step_deltas.push_back(time->delta()); }));
+
+    // the first update only records the start instant.
+    app.run_schedules(First, FixedMain);
+    EXPECT_TRUE(step_deltas.empty());
+
+    app.run_schedules(First, FixedMain);
+    EXPECT_EQ(step_deltas, std::vector<std::chrono::nanoseconds>(3, 10ms));
+    auto& fixed_time = app.world_mut().resource<Time<Fixed>>();
+    EXPECT_EQ(fixed_time.overstep(), 5ms);
+    EXPECT_EQ(fixed_time.stats().discarded, 70ms);
+    // schedules after FixedMain see virtual time again.
+    EXPECT_EQ(app.world_mut().resource<Time<>>().delta(), 105ms);
+}
 
\ No newline at end of file